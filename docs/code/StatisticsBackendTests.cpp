@@ -36,6 +36,13 @@ class CustomPhysicalListener : public PhysicalListener
 
 void init_monitor_examples()
 {
+    {
+        //CONF-INGESTION-THREADS-EXAMPLE
+        // Store the statistics data of the monitors with 4 threads.
+        // It must be called before initializing any monitor.
+        StatisticsBackend::set_ingestion_threads(4);
+        //!--
+    }
     {
         //CONF-INIT-MONITOR-EXAMPLE
         // Init a monitor in DDS domain 0 with no listener associated.
@@ -156,6 +163,19 @@ void clear_examples()
         StatisticsBackend::clear_monitor(domain_monitor_id);
         //!--
     }
+    {
+        //CONF-RETENTION-POLICY-EXAMPLE
+        RetentionPolicy policy;
+        // Keep the latencies of the last hour, and the rest of the data regardless of its age
+        policy.max_age[DataKind::FASTDDS_LATENCY] = std::chrono::hours(1);
+        policy.max_age[DataKind::NETWORK_LATENCY] = std::chrono::hours(1);
+        // Keep at most 100000 samples of each series
+        policy.max_samples_per_series = 100000;
+        // Keep the statistics data under 512 MB
+        policy.memory_budget = 512 * 1024 * 1024;
+        StatisticsBackend::set_retention_policy(policy);
+        //!--
+    }
 }
 
 void reset_examples()
@@ -297,6 +317,38 @@ void get_data_examples()
             now);                                                        // t_to
         //!--
     }
+    {
+        EntityId participant_id;
+
+        //CONF-GET-DATA-ROLLUPS-EXAMPLE
+        /* Keep rollups of the data at 1 second, 10 seconds, 1 minute and 10 minutes */
+        StatisticsBackend::set_rollup_resolutions({
+                    std::chrono::seconds(1),
+                    std::chrono::seconds(10),
+                    std::chrono::minutes(1),
+                    std::chrono::minutes(10)});
+
+        std::vector<EntityId> participant_datawriters = StatisticsBackend::get_entities(EntityKind::DATAWRITER,
+                        participant_id);
+
+        /* Get the current time, aligned to the coarsest rollup */
+        std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+        now -= now.time_since_epoch() % std::chrono::minutes(10);
+
+        /*
+         * Get the mean of the DATA_COUNT of the last 24 hours, divided into 144 bins of 10 minutes.
+         * Each bin is computed from a single rollup value per DataWriter, instead of from every
+         * DATA_COUNT data point received during those 10 minutes.
+         */
+        std::vector<StatisticsData> data = StatisticsBackend::get_data(
+            DataKind::DATA_COUNT,                                        // DataKind
+            participant_datawriters,                                     // Source entities
+            144,                                                         // Number of bins
+            now - std::chrono::hours(24),                                // t_from
+            now,                                                         // t_to
+            StatisticKind::MEAN);                                        // Statistic
+        //!--
+    }
 }
 
 void get_data_supported_entity_kinds_examples()
@@ -497,6 +549,33 @@ void dump_load_examples()
         StatisticsBackend::dump_database("new_backend_dump.json", true);
         //!--
     }
+    {
+        //CONF-DUMP-BINARY-EXAMPLE
+        // Save the database to a binary snapshot
+        StatisticsBackend::dump_database("new_backend_dump.bin", false, DumpFormat::BINARY);
+
+        // Reset the Backend to empty the current database contents
+        StatisticsBackend::reset();
+
+        // Load the snapshot to the emptied Backend
+        StatisticsBackend::load_database("new_backend_dump.bin");
+        //!--
+    }
+    {
+        //CONF-DUMP-DELTA-EXAMPLE
+        // Append the whole database to the file
+        DumpWatermark watermark = StatisticsBackend::dump_database_delta("backend_dump.json");
+
+        // Later on, append only the statistics data received since the previous dump
+        watermark = StatisticsBackend::dump_database_delta("backend_dump.json", watermark);
+
+        // Reset the Backend to empty the current database contents
+        StatisticsBackend::reset();
+
+        // Load the first dump and merge the incremental ones that follow it
+        StatisticsBackend::load_database("backend_dump.json");
+        //!--
+    }
 }
 
 void get_entities_example()
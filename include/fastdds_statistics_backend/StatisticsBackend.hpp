@@ -20,6 +20,7 @@
 #define _EPROSIMA_FASTDDS_STATISTICS_BACKEND_STATISTICSBACKEND_HPP_
 
 #include <chrono>
+#include <cstdint>
 #include <string>
 
 #include <fastdds_statistics_backend/fastdds_statistics_backend_dll.h>
@@ -417,19 +418,43 @@ public:
      *
      * @param filename The name of the file where the database is dumped.
      * @param clear If true, clear all the statistics data of all entities.
+     * @param format Format of the file. Both formats hold the same entities and statistics data.
      */
     static void dump_database(
             const std::string& filename,
-            bool clear);
+            bool clear,
+            DumpFormat format = DumpFormat::JSON);
+
+    /**
+     * @brief Append an incremental dump of Fast DDS Statistics Backend's database to a file.
+     *
+     * An incremental dump holds every entity of the database, but only the statistics data received after
+     * the dump that returned \c since, so periodic dumps do not write the whole history again.
+     * The first incremental dump, taken with the default watermark, holds all the statistics data.
+     * The statistics data is not removed from the database.
+     *
+     * @param filename The name of the file to which the incremental dump is appended.
+     * @param since Watermark returned by the previous incremental dump appended to the file.
+     * @return The watermark to give to the next incremental dump.
+     * @throws eprosima::statistics_backend::BadParameter if the file cannot be opened.
+     */
+    static DumpWatermark dump_database_delta(
+            const std::string& filename,
+            const DumpWatermark& since = DumpWatermark());
 
     /**
      * @brief Load Fast DDS Statistics Backend's database from a file.
      *
+     * The format of the file, JSON or binary, is detected from its contents.
+     * The incremental dumps appended to a JSON file by dump_database_delta are merged in order.
+     *
      * @pre The Backend's database has no data. This means that no monitors were initialized
      *      since the Backend started, or that the Backend has been reset().
      *
      * @param filename The name of the file from which where the database is loaded.
      * @throws eprosima::statistics_backend::BadParameter if the file does not exist.
+     * @throws eprosima::statistics_backend::CorruptedFile if the file is a binary snapshot that is not valid,
+     *         or its incremental dumps are not a chain.
      */
     static void load_database(
             const std::string& filename);
@@ -445,6 +470,57 @@ public:
     //! Remove all inactive entities from database.
     static void clear_inactive_entities();
 
+    /**
+     * @brief Keep pre-aggregated summaries (rollups) of the statistics data at the given resolutions.
+     *
+     * For each entity and data kind, the count, sum, minimum, maximum and sum of squares of the values received
+     * during each interval of every resolution are kept, and updated as data is received or cleared.
+     * Calls to get_data with a \c COUNT, \c SUM, \c MEAN, \c MAX, \c MIN or \c STANDARD_DEVIATION statistic,
+     * and with a bin duration multiple of any of the resolutions, are then computed from the coarsest of those
+     * rollups, instead of from every data value.
+     * The rollups are aligned to multiples of their resolution since the epoch, so aligning \c t_from too
+     * avoids visiting any data value.
+     *
+     * Rollups are disabled by default. They are not kept for \c DISCOVERY_TIME and \c SAMPLE_DATAS.
+     *
+     * @param resolutions Durations of the intervals of each rollup, for example 1s, 10s, 1min and 10min.
+     *                    An empty collection disables the rollups.
+     */
+    static void set_rollup_resolutions(
+            const std::vector<Timestamp::duration>& resolutions);
+
+    /**
+     * @brief Set the limits on the statistics data kept by the backend.
+     *
+     * The limits are enforced incrementally by the thread that stores the statistics data as it is received, in
+     * slices of at most \c policy.slice_duration, so that queries are never blocked for longer than that.
+     * A slice waits for the queries in progress to finish, so the data they are reading is not removed.
+     * While no statistics data is received, the limits are still enforced every \c policy.enforcement_period.
+     * Unlike @ref clear_statistics_data, this does not need to be called periodically.
+     *
+     * @param policy The retention policy. A policy without limits, which is the default one, keeps all the data.
+     * @throws eprosima::statistics_backend::BadParameter if the slice duration or the enforcement period is not
+     * positive, or any maximum age is negative.
+     */
+    static void set_retention_policy(
+            const RetentionPolicy& policy);
+
+    /**
+     * @brief Set the number of threads that store the statistics data received by the monitors.
+     *
+     * The statistics data are distributed among the threads by the DomainParticipant they refer to, so the data of
+     * each entity are stored in the order they are received.
+     * A single thread is used by default.
+     * The statistics data wait for their thread in a bounded queue. If the threads do not keep up with the
+     * received data, so that the queue fills up, the oldest data is discarded and a warning is logged,
+     * as the listeners of the monitors never wait for them.
+     *
+     * @param threads Number of threads. 0 is the same as 1.
+     * @throws eprosima::statistics_backend::PreconditionNotMet if there is any monitor.
+     */
+    static void set_ingestion_threads(
+            uint32_t threads);
+
     /**
      * @brief Resets the Fast DDS Statistics Backend.
      *
@@ -19,6 +19,8 @@
 #ifndef _EPROSIMA_FASTDDS_STATISTICS_BACKEND_TYPES_ENTITYID_HPP_
 #define _EPROSIMA_FASTDDS_STATISTICS_BACKEND_TYPES_ENTITYID_HPP_
 
+#include <cstdint>
+#include <functional>
 #include <ostream>
 
 #include <fastdds_statistics_backend/fastdds_statistics_backend_dll.h>
@@ -213,4 +215,22 @@ FASTDDS_STATISTICS_BACKEND_DllAPI inline bool operator !=(
 } // namespace statistics_backend
 } // namespace eprosima
 
+namespace std {
+
+/**
+ * @brief Hash an EntityId so it can be used as key of unordered containers
+ */
+template<>
+struct hash<eprosima::statistics_backend::EntityId>
+{
+    size_t operator ()(
+            const eprosima::statistics_backend::EntityId& entity_id) const noexcept
+    {
+        return hash<int64_t>()(entity_id.value());
+    }
+
+};
+
+} // namespace std
+
 #endif //_EPROSIMA_FASTDDS_STATISTICS_BACKEND_TYPES_ENTITYID_HPP_
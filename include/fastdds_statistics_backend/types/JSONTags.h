@@ -38,6 +38,18 @@ constexpr const char* ACTUAL_DUMP_VERSION           = "0.0";
 //! Key Tag for version
 constexpr const char* VERSION_TAG                   = "version";
 
+/////
+// Incremental dumps
+
+//! Key Tag for the watermark of the previous dump, from which an incremental dump is taken
+constexpr const char* DELTA_SINCE_TAG               = "since";
+//! Key Tag for the watermark of an incremental dump, from which the next one is taken
+constexpr const char* DELTA_UNTIL_TAG               = "until";
+//! Key Tag for the insertion epoch of a watermark
+constexpr const char* WATERMARK_EPOCH_TAG           = "epoch";
+//! Key Tag for the next entity ID of a watermark
+constexpr const char* WATERMARK_NEXT_ENTITY_TAG     = "next_entity_id";
+
 /////
 // Entity containers
 
@@ -25,6 +25,9 @@
 #include <fastdds_statistics_backend/types/EntityId.hpp>
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
 
 namespace eprosima {
 namespace statistics_backend {
@@ -259,14 +262,86 @@ enum class StatisticKind
     /// Minimum value in the set
     MIN,
 
-    /// Median value of the set
+    /// Median value of the set, estimated on large sets
     MEDIAN,
 
     /// Amount of values in the set
     COUNT,
 
     /// Summation of the values in the set
-    SUM
+    SUM,
+
+    /// 50th percentile of the values in the set, estimated on large sets
+    PERCENTILE_50,
+
+    /// 90th percentile of the values in the set, estimated on large sets
+    PERCENTILE_90,
+
+    /// 99th percentile of the values in the set, estimated on large sets
+    PERCENTILE_99,
+
+    /// 99.9th percentile of the values in the set, estimated on large sets
+    PERCENTILE_99_9
+};
+
+/*
+ * Formats in which the database can be dumped to a file.
+ */
+enum class DumpFormat
+{
+    /// Human readable JSON document, as returned by StatisticsBackend::dump_database
+    JSON,
+
+    /// Compact binary snapshot, faster to write and load than the JSON document
+    BINARY
+};
+
+/**
+ * Limits on the statistics data kept by the backend.
+ *
+ * The data exceeding any of the limits is removed, oldest first. Every limit is disabled by default.
+ */
+struct RetentionPolicy
+{
+    /// Maximum age of the data of each kind. The data of the kinds not present is kept regardless of its age.
+    std::map<DataKind, Timestamp::duration> max_age;
+
+    /// Maximum number of samples of each series, i.e. of each data kind of each entity and remote entity or locator.
+    /// The sample datas of a DataWriter are a single series. 0 means no limit.
+    std::size_t max_samples_per_series = 0;
+
+    /// Approximate maximum amount of memory, in bytes, used by the statistics data of all the entities.
+    /// When it is exceeded, the oldest samples of every series are removed in the same proportion. 0 means no limit.
+    std::size_t memory_budget = 0;
+
+    /// Maximum time spent enforcing the limits at once, during which the database cannot be queried
+    std::chrono::microseconds slice_duration = std::chrono::microseconds(500);
+
+    /// Maximum time between two enforcements of the limits. They are enforced at least this often even if no
+    /// statistics data is received, so that the data exceeding the maximum age is removed from an idle backend too.
+    std::chrono::milliseconds enforcement_period = std::chrono::milliseconds(1000);
+
+    /// Whether any limit is enabled
+    bool enabled() const
+    {
+        return !max_age.empty() || 0 != max_samples_per_series || 0 != memory_budget;
+    }
+};
+
+/**
+ * Point of the history of the database up to which an incremental dump has been taken.
+ *
+ * Each incremental dump holds the entities and the statistics data newer than the watermark it is given,
+ * and returns the watermark to give to the next one. The default watermark precedes the whole history.
+ */
+struct DumpWatermark
+{
+    /// Point of the insertion of statistics data reached by the dump. Only the samples of the already dumped
+    /// entities inserted after it are dumped
+    uint64_t epoch = 0;
+
+    /// Entities with this ID or greater were created after the dump, so all their data is dumped
+    int64_t next_entity_id = 0;
 };
 
 
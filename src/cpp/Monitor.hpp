@@ -78,10 +78,9 @@ struct Monitor
     //! Holds the datareader object created for each of the statistics topics
     std::map<std::string, fastdds::dds::DataReader*> readers{};
 
-    //! The listener linked to the \c readers
-    //! All readers will use the same listener
-    //! The listener will decide how to process the data according to the topic of the reader
-    fastdds::dds::DataReaderListener* reader_listener = nullptr;
+    //! Holds the listener linked to each of the \c readers, by statistics topic
+    //! Each listener knows the kind of the data of its topic, so it does not need to look it up on every message
+    std::map<std::string, fastdds::dds::DataReaderListener*> reader_listeners{};
 
     //! Participant discovery status. Used in the participant discovery user callback
     DomainListener::Status participant_status_{};
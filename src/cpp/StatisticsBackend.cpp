@@ -47,6 +47,7 @@
 
 #include <database/database_queue.hpp>
 #include <database/database.hpp>
+#include <database/snapshot.hpp>
 #include <subscriber/StatisticsParticipantListener.hpp>
 #include <subscriber/StatisticsReaderListener.hpp>
 #include <topic_types/typesPubSubTypes.h>
@@ -218,9 +219,15 @@ EntityId create_and_register_monitor(
         backend_data->data_queue_);
     auto se_participant_listener_ = EPROSIMA_BACKEND_MAKE_SCOPE_EXIT(delete monitor->participant_listener);
 
-    monitor->reader_listener = new subscriber::StatisticsReaderListener(
-        backend_data->data_queue_);
-    auto se_reader_listener_ = EPROSIMA_BACKEND_MAKE_SCOPE_EXIT(delete monitor->reader_listener);
+    auto se_reader_listeners_ =
+            EPROSIMA_BACKEND_MAKE_SCOPE_EXIT(
+            {
+                for (auto& it : monitor->reader_listeners)
+                {
+                    delete it.second;
+                }
+            }
+        );
 
     /* Create DomainParticipant */
     StatusMask participant_mask = StatusMask::all();
@@ -284,11 +291,14 @@ EntityId create_and_register_monitor(
             throw Error("Error registering topic " + std::string(topic) + " : " + e.what());
         }
 
-        /* Create DataReaders */
+        /* Create DataReaders, each one with a listener specialized in the data of its topic */
+        monitor->reader_listeners[topic] = new subscriber::StatisticsReaderListener(
+            backend_data->data_queue_,
+            topic);
         monitor->readers[topic] = monitor->subscriber->create_datareader(
             monitor->topics[topic],
             eprosima::fastdds::statistics::dds::STATISTICS_DATAREADER_QOS,
-            monitor->reader_listener,
+            monitor->reader_listeners[topic],
             StatusMask::all());
 
         if (monitor->readers[topic] == nullptr)
@@ -299,7 +309,7 @@ EntityId create_and_register_monitor(
 
     se_erase_monitor_database_.cancel();
     se_participant_listener_.cancel();
-    se_reader_listener_.cancel();
+    se_reader_listeners_.cancel();
     se_participant_.cancel();
     se_subscriber_.cancel();
     se_topics_datareaders_.cancel();
@@ -665,26 +675,47 @@ std::vector<StatisticsData> StatisticsBackend::get_data(
         {
             for (EntityId target_id : entity_ids_target)
             {
-                auto data = db->select(data_type, source_id, target_id, t_from, t_to_select);
-                auto iterators = get_iterators(data_type, data);
-
-                for (auto& it = *iterators.first; it != *iterators.second; ++it)
-                {
-                    ret_val.emplace_back(it.get_timestamp(), it.get_value());
-                }
+                auto data = db->select_spans(data_type, source_id, target_id, t_from, t_to_select);
+                for_each_sample(data_type, data.spans, [&ret_val](
+                            const Timestamp& src_ts,
+                            double value)
+                        {
+                            ret_val.emplace_back(src_ts, value);
+                        });
             }
         }
     }
     else
     {
+        // Answer from the summaries kept by the database if possible, without visiting every sample
+        if (is_summary_statistic(statistic))
+        {
+            details::RollupBins summaries(bins, t_from, t_to);
+            for (EntityId source_id : entity_ids_source)
+            {
+                for (EntityId target_id : entity_ids_target)
+                {
+                    if (!db->select_summaries(data_type, source_id, target_id, summaries))
+                    {
+                        break;
+                    }
+                }
+            }
+
+            if (summaries.complete)
+            {
+                get_data_from_summaries(statistic, summaries, ret_val);
+                return ret_val;
+            }
+        }
+
         auto processor = get_data_aggregator(bins, t_from, t_to, statistic, ret_val);
         for (EntityId source_id : entity_ids_source)
         {
             for (EntityId target_id : entity_ids_target)
             {
-                auto data = db->select(data_type, source_id, target_id, t_from, t_to_select);
-                auto iterators = get_iterators(data_type, data);
-                processor->add_data(iterators);
+                auto data = db->select_spans(data_type, source_id, target_id, t_from, t_to_select);
+                processor->add_data(data_type, data.spans);
             }
         }
         processor->finish();
@@ -727,23 +758,41 @@ std::vector<StatisticsData> StatisticsBackend::get_data(
     {
         for (EntityId id : entity_ids)
         {
-            auto data = db->select(data_type, id, t_from, t_to_select);
-            auto iterators = get_iterators(data_type, data);
-
-            for (auto& it = *iterators.first; it != *iterators.second; ++it)
-            {
-                ret_val.emplace_back(it.get_timestamp(), it.get_value());
-            }
+            auto data = db->select_spans(data_type, id, t_from, t_to_select);
+            for_each_sample(data_type, data.spans, [&ret_val](
+                        const Timestamp& src_ts,
+                        double value)
+                    {
+                        ret_val.emplace_back(src_ts, value);
+                    });
         }
     }
     else
     {
+        // Answer from the summaries kept by the database if possible, without visiting every sample
+        if (is_summary_statistic(statistic))
+        {
+            details::RollupBins summaries(bins, t_from, t_to);
+            for (EntityId id : entity_ids)
+            {
+                if (!db->select_summaries(data_type, id, summaries))
+                {
+                    break;
+                }
+            }
+
+            if (summaries.complete)
+            {
+                get_data_from_summaries(statistic, summaries, ret_val);
+                return ret_val;
+            }
+        }
+
         auto processor = get_data_aggregator(bins, t_from, t_to, statistic, ret_val);
         for (EntityId id : entity_ids)
         {
-            auto data = db->select(data_type, id, t_from, t_to_select);
-            auto iterators = get_iterators(data_type, data);
-            processor->add_data(iterators);
+            auto data = db->select_spans(data_type, id, t_from, t_to_select);
+            processor->add_data(data_type, data.spans);
         }
         processor->finish();
     }
@@ -796,17 +845,41 @@ DatabaseDump StatisticsBackend::dump_database(
 
 void StatisticsBackend::dump_database(
         const std::string& filename,
-        const bool clear)
+        const bool clear,
+        DumpFormat format /* = DumpFormat::JSON */)
 {
     // Open the file
-    std::ofstream file(filename);
+    std::ofstream file(filename, std::ios::binary);
     if (!file.good())
     {
         throw BadParameter("Error opening file " + filename + " to dump the database");
     }
 
     // Dump the data
-    file << StatisticsBackend::dump_database(clear);
+    if (DumpFormat::BINARY == format)
+    {
+        StatisticsBackendData::get_instance()->database_->dump_snapshot(file, clear);
+    }
+    else
+    {
+        StatisticsBackendData::get_instance()->database_->dump_database(file, clear);
+    }
+}
+
+DumpWatermark StatisticsBackend::dump_database_delta(
+        const std::string& filename,
+        const DumpWatermark& since /* = DumpWatermark() */)
+{
+    // Each incremental dump is appended after the previous ones
+    std::ofstream file(filename, std::ios::binary | std::ios::app);
+    if (!file.good())
+    {
+        throw BadParameter("Error opening file " + filename + " to dump the database");
+    }
+
+    DumpWatermark watermark = StatisticsBackendData::get_instance()->database_->dump_database_delta(file, since);
+    file << '\n';
+    return watermark;
 }
 
 void StatisticsBackend::clear_statistics_data(
@@ -820,21 +893,54 @@ void StatisticsBackend::clear_inactive_entities()
     details::StatisticsBackendData::get_instance()->database_->clear_inactive_entities();
 }
 
+void StatisticsBackend::set_rollup_resolutions(
+        const std::vector<Timestamp::duration>& resolutions)
+{
+    details::StatisticsBackendData::get_instance()->database_->set_rollup_resolutions(resolutions);
+}
+
+void StatisticsBackend::set_retention_policy(
+        const RetentionPolicy& policy)
+{
+    details::StatisticsBackendData::get_instance()->database_->set_retention_policy(policy);
+}
+
+void StatisticsBackend::set_ingestion_threads(
+        uint32_t threads)
+{
+    // The listeners of the monitors push to the data queue, whose shards cannot change meanwhile
+    if (!StatisticsBackendData::get_instance()->monitors_by_entity_.empty())
+    {
+        throw PreconditionNotMet("The number of ingestion threads cannot be changed while there are monitors");
+    }
+    StatisticsBackendData::get_instance()->data_queue_->set_shard_count(threads);
+}
+
 void StatisticsBackend::load_database(
         const std::string& filename)
 {
     // Check if the file exists
-    std::ifstream file(filename);
+    std::ifstream file(filename, std::ios::binary);
     if (!file.good())
     {
         throw BadParameter("File " + filename + " does not exist");
     }
 
-    // Get the json file
-    DatabaseDump dump;
-    file >> dump;
+    // Binary snapshots are loaded as they are read
+    if (database::SnapshotReader::is_snapshot(file))
+    {
+        StatisticsBackendData::get_instance()->database_->load_snapshot(file);
+        return;
+    }
 
-    StatisticsBackendData::get_instance()->database_->load_database(dump);
+    // JSON dumps are also loaded as they are read, followed by the incremental dumps appended to them
+    StatisticsBackendData::get_instance()->database_->load_database(file);
+    file >> std::ws;
+    while (file.peek() != std::ifstream::traits_type::eof())
+    {
+        StatisticsBackendData::get_instance()->database_->load_database_delta(file);
+        file >> std::ws;
+    }
 }
 
 void StatisticsBackend::reset()
@@ -46,12 +46,13 @@ SingletonType StatisticsBackendData::instance_;
 StatisticsBackendData::StatisticsBackendData()
     : database_(new database::Database)
     , entity_queue_(new database::DatabaseEntityQueue(database_.get()))
-    , data_queue_(new database::DatabaseDataQueue(database_.get()))
+    , data_queue_(new database::ShardedDatabaseDataQueue(database_.get()))
     , physical_listener_(nullptr)
     , lock_(mutex_, std::defer_lock)
     , participant_factory_instance_(eprosima::fastdds::dds::DomainParticipantFactory::get_shared_instance())
 {
-    // Do nothing
+    // Data of entities being discovered wait for their discovery instead of being discarded
+    entity_queue_->set_data_queue(data_queue_);
 }
 
 StatisticsBackendData::~StatisticsBackendData()
@@ -385,9 +386,9 @@ void StatisticsBackendData::stop_monitor(
         fastdds::dds::DomainParticipantFactory::get_instance()->delete_participant(monitor->participant);
     }
 
-    if (monitor->reader_listener)
+    for (auto& reader_listener : monitor->reader_listeners)
     {
-        delete monitor->reader_listener;
+        delete reader_listener.second;
     }
 
     if (monitor->participant_listener)
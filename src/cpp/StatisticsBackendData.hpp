@@ -42,7 +42,7 @@ namespace statistics_backend {
 namespace database {
 
 class DatabaseEntityQueue;
-class DatabaseDataQueue;
+class ShardedDatabaseDataQueue;
 
 } // namespace database
 
@@ -85,7 +85,7 @@ public:
     database::DatabaseEntityQueue* entity_queue_;
 
     //! Reference to the Database data queue
-    database::DatabaseDataQueue* data_queue_;
+    database::ShardedDatabaseDataQueue* data_queue_;
 
     /**
      * @brief Collection of active monitors
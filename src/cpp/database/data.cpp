@@ -15,10 +15,88 @@
 
 #include "data.hpp"
 
+#include <algorithm>
+#include <iterator>
+
 namespace eprosima {
 namespace statistics_backend {
 namespace database {
 
+namespace {
+
+/**
+ * Number of elements of a series that must be kept to remove a proportion of them.
+ *
+ * The amount removed is rounded down, so that short series are not emptied by small proportions.
+ */
+std::size_t kept_size_(
+        std::size_t size,
+        double eviction_ratio)
+{
+    return size - static_cast<std::size_t>(static_cast<double>(size) * eviction_ratio);
+}
+
+//! Time previous to which the data of a kind is too old, or the epoch if its age is not limited
+Timestamp max_age_limit_(
+        const RetentionPolicy& policy,
+        DataKind data_kind,
+        const Timestamp& now)
+{
+    auto max_age = policy.max_age.find(data_kind);
+    if (max_age == policy.max_age.end() || max_age->second >= now.time_since_epoch())
+    {
+        return Timestamp();
+    }
+    return now - max_age->second;
+}
+
+template<typename Series>
+void enforce_retention_(
+        Series& series,
+        DataKind data_kind,
+        const RetentionPolicy& policy,
+        const Timestamp& now,
+        double eviction_ratio)
+{
+    Timestamp t_to = max_age_limit_(policy, data_kind, now);
+    if (t_to > Timestamp())
+    {
+        series.clear(t_to);
+    }
+    if (0 != policy.max_samples_per_series)
+    {
+        series.trim(policy.max_samples_per_series);
+    }
+    if (eviction_ratio > 0.0)
+    {
+        series.trim(kept_size_(series.size(), eviction_ratio));
+    }
+}
+
+template<typename K, typename T>
+void enforce_retention_(
+        details::MapDataContainer<K, T>& series_map,
+        DataKind data_kind,
+        const RetentionPolicy& policy,
+        const Timestamp& now,
+        double eviction_ratio)
+{
+    for (auto it = series_map.begin(); it != series_map.end();)
+    {
+        enforce_retention_(it->second, data_kind, policy, now, eviction_ratio);
+        if (it->second.empty())
+        {
+            it = series_map.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+} // namespace
+
 void RTPSData::clear(
         const Timestamp& t_to,
         bool clear_last_reported)
@@ -36,6 +114,32 @@ void RTPSData::clear(
     }
 }
 
+void RTPSData::enable_rollups(
+        const std::vector<Timestamp::duration>& resolutions)
+{
+    rtps_packets_sent.enable_rollups(resolutions);
+    rtps_bytes_sent.enable_rollups(resolutions);
+    rtps_packets_lost.enable_rollups(resolutions);
+    rtps_bytes_lost.enable_rollups(resolutions);
+}
+
+void RTPSData::enforce_retention(
+        const RetentionPolicy& policy,
+        const Timestamp& now,
+        double eviction_ratio)
+{
+    enforce_retention_(rtps_packets_sent, DataKind::RTPS_PACKETS_SENT, policy, now, eviction_ratio);
+    enforce_retention_(rtps_bytes_sent, DataKind::RTPS_BYTES_SENT, policy, now, eviction_ratio);
+    enforce_retention_(rtps_packets_lost, DataKind::RTPS_PACKETS_LOST, policy, now, eviction_ratio);
+    enforce_retention_(rtps_bytes_lost, DataKind::RTPS_BYTES_LOST, policy, now, eviction_ratio);
+}
+
+std::size_t RTPSData::memory_usage() const
+{
+    return rtps_packets_sent.memory_usage() + rtps_bytes_sent.memory_usage() + rtps_packets_lost.memory_usage() +
+           rtps_bytes_lost.memory_usage();
+}
+
 void DomainParticipantData::clear(
         const Timestamp& t_to,
         bool clear_last_reported)
@@ -52,6 +156,33 @@ void DomainParticipantData::clear(
     }
 }
 
+void DomainParticipantData::enable_rollups(
+        const std::vector<Timestamp::duration>& resolutions)
+{
+    RTPSData::enable_rollups(resolutions);
+    pdp_packets.enable_rollups(resolutions);
+    edp_packets.enable_rollups(resolutions);
+    network_latency_per_locator.enable_rollups(resolutions);
+}
+
+void DomainParticipantData::enforce_retention(
+        const RetentionPolicy& policy,
+        const Timestamp& now,
+        double eviction_ratio)
+{
+    RTPSData::enforce_retention(policy, now, eviction_ratio);
+    enforce_retention_(discovered_entity, DataKind::DISCOVERY_TIME, policy, now, eviction_ratio);
+    enforce_retention_(pdp_packets, DataKind::PDP_PACKETS, policy, now, eviction_ratio);
+    enforce_retention_(edp_packets, DataKind::EDP_PACKETS, policy, now, eviction_ratio);
+    enforce_retention_(network_latency_per_locator, DataKind::NETWORK_LATENCY, policy, now, eviction_ratio);
+}
+
+std::size_t DomainParticipantData::memory_usage() const
+{
+    return RTPSData::memory_usage() + discovered_entity.memory_usage() + pdp_packets.memory_usage() +
+           edp_packets.memory_usage() + network_latency_per_locator.memory_usage();
+}
+
 void DataReaderData::clear(
         const Timestamp& t_to,
         bool clear_last_reported)
@@ -66,6 +197,29 @@ void DataReaderData::clear(
     }
 }
 
+void DataReaderData::enable_rollups(
+        const std::vector<Timestamp::duration>& resolutions)
+{
+    subscription_throughput.enable_rollups(resolutions);
+    acknack_count.enable_rollups(resolutions);
+    nackfrag_count.enable_rollups(resolutions);
+}
+
+void DataReaderData::enforce_retention(
+        const RetentionPolicy& policy,
+        const Timestamp& now,
+        double eviction_ratio)
+{
+    enforce_retention_(subscription_throughput, DataKind::SUBSCRIPTION_THROUGHPUT, policy, now, eviction_ratio);
+    enforce_retention_(acknack_count, DataKind::ACKNACK_COUNT, policy, now, eviction_ratio);
+    enforce_retention_(nackfrag_count, DataKind::NACKFRAG_COUNT, policy, now, eviction_ratio);
+}
+
+std::size_t DataReaderData::memory_usage() const
+{
+    return subscription_throughput.memory_usage() + acknack_count.memory_usage() + nackfrag_count.memory_usage();
+}
+
 void DataWriterData::clear(
         const Timestamp& t_to,
         bool clear_last_reported)
@@ -86,6 +240,52 @@ void DataWriterData::clear(
     }
 }
 
+void DataWriterData::enable_rollups(
+        const std::vector<Timestamp::duration>& resolutions)
+{
+    history2history_latency.enable_rollups(resolutions);
+    publication_throughput.enable_rollups(resolutions);
+    resent_datas.enable_rollups(resolutions);
+    heartbeat_count.enable_rollups(resolutions);
+    gap_count.enable_rollups(resolutions);
+    data_count.enable_rollups(resolutions);
+}
+
+void DataWriterData::enforce_retention(
+        const RetentionPolicy& policy,
+        const Timestamp& now,
+        double eviction_ratio)
+{
+    enforce_retention_(history2history_latency, DataKind::FASTDDS_LATENCY, policy, now, eviction_ratio);
+    enforce_retention_(publication_throughput, DataKind::PUBLICATION_THROUGHPUT, policy, now, eviction_ratio);
+    enforce_retention_(resent_datas, DataKind::RESENT_DATA, policy, now, eviction_ratio);
+    enforce_retention_(heartbeat_count, DataKind::HEARTBEAT_COUNT, policy, now, eviction_ratio);
+    enforce_retention_(gap_count, DataKind::GAP_COUNT, policy, now, eviction_ratio);
+    enforce_retention_(data_count, DataKind::DATA_COUNT, policy, now, eviction_ratio);
+
+    // Each container of the sample datas holds the only sample of a sequence number, so the whole map is a single
+    // series, sorted by sequence number and thus by time
+    Timestamp t_to = max_age_limit_(policy, DataKind::SAMPLE_DATAS, now);
+    if (t_to > Timestamp())
+    {
+        sample_datas.clear(t_to);
+    }
+    std::size_t max_size = sample_datas.size();
+    if (0 != policy.max_samples_per_series)
+    {
+        max_size = (std::min)(max_size, policy.max_samples_per_series);
+    }
+    max_size = (std::min)(max_size, kept_size_(sample_datas.size(), eviction_ratio));
+    sample_datas.erase(sample_datas.begin(), std::next(sample_datas.begin(), sample_datas.size() - max_size));
+}
+
+std::size_t DataWriterData::memory_usage() const
+{
+    return history2history_latency.memory_usage() + publication_throughput.memory_usage() +
+           resent_datas.memory_usage() + heartbeat_count.memory_usage() + gap_count.memory_usage() +
+           data_count.memory_usage() + sample_datas.memory_usage();
+}
+
 } //namespace database
 } //namespace statistics_backend
 } //namespace eprosima
@@ -21,10 +21,13 @@
 #define _EPROSIMA_FASTDDS_STATISTICS_BACKEND_DATABASE_DATA_HPP_
 
 #include <chrono>
+#include <cstddef>
+#include <shared_mutex>
 #include <vector>
 
 #include <fastdds_statistics_backend/nlohmann-json/json.hpp>
 #include <fastdds_statistics_backend/types/EntityId.hpp>
+#include <fastdds_statistics_backend/types/types.hpp>
 #include <fastdds_statistics_backend/types/utils.hpp>
 
 #include <types/DataContainer.hpp>
@@ -48,6 +51,20 @@ using Qos = nlohmann::json;
  */
 struct Data
 {
+    Data() = default;
+
+    //! The base holds no series, only the mutex that guards those of the derived class, which is not copied
+    Data(
+            const Data&)
+    {
+    }
+
+    //! The base holds no series, only the mutex that guards those of the derived class, which is not copied
+    Data& operator =(
+            const Data&)
+    {
+        return *this;
+    }
 
     /**
      * @brief Removes those internal data from the substructures that are previous to the time given.
@@ -84,6 +101,41 @@ struct Data
         clear(the_end_of_time());
     }
 
+    /**
+     * @brief Keep summaries of the values of every internal series at the given resolutions.
+     *
+     * Series that only hold events, like discovery times or sample datas, are not summarized.
+     *
+     * @param resolutions Durations of the buckets of each tier of summaries. An empty collection disables them.
+     */
+    virtual void enable_rollups(
+            const std::vector<Timestamp::duration>& resolutions) = 0;
+
+    /**
+     * @brief Remove the oldest data of every internal series that exceeds the limits of a retention policy.
+     *
+     * @param policy The retention policy to enforce.
+     * @param now The current time, from which the age of the data is measured.
+     * @param eviction_ratio Proportion of the data of every series to remove, besides the one that exceeds the
+     * limits of the policy, in order to reduce the memory used.
+     */
+    virtual void enforce_retention(
+            const RetentionPolicy& policy,
+            const Timestamp& now,
+            double eviction_ratio) = 0;
+
+    //! Approximate amount of memory used by the internal series, in bytes
+    virtual std::size_t memory_usage() const = 0;
+
+    /**
+     * Guards the internal series against concurrent insertions and selections.
+     *
+     * Samples of different entities are inserted and selected concurrently while the database mutex is taken in
+     * shared mode, and the samples selected as \c SampleSpans are read without holding the database mutex at all.
+     * Hence, the series are modified holding this mutex exclusively even if the database mutex is held exclusively.
+     */
+    mutable std::shared_timed_mutex mutex;
+
 };
 
 /**
@@ -99,6 +151,19 @@ struct RTPSData : public Data
             const Timestamp& t_to,
             bool clear_last_reported) override;
 
+    // Implement Data::enable_rollups virtual method
+    virtual void enable_rollups(
+            const std::vector<Timestamp::duration>& resolutions) override;
+
+    // Implement Data::enforce_retention virtual method
+    virtual void enforce_retention(
+            const RetentionPolicy& policy,
+            const Timestamp& now,
+            double eviction_ratio) override;
+
+    // Implement Data::memory_usage virtual method
+    virtual std::size_t memory_usage() const override;
+
     /*
      * Packet count data reported by topic: eprosima::fastdds::statistics::RTPS_SENT_TOPIC
      *
@@ -171,6 +236,19 @@ struct DomainParticipantData : public RTPSData
             const Timestamp& t_to,
             bool clear_last_reported) override;
 
+    // Implement Data::enable_rollups virtual method
+    virtual void enable_rollups(
+            const std::vector<Timestamp::duration>& resolutions) override;
+
+    // Implement Data::enforce_retention virtual method
+    virtual void enforce_retention(
+            const RetentionPolicy& policy,
+            const Timestamp& now,
+            double eviction_ratio) override;
+
+    // Implement Data::memory_usage virtual method
+    virtual std::size_t memory_usage() const override;
+
     /*
      * Data reported by topic: eprosima::fastdds::statistics::DISCOVERY_TOPIC
      *
@@ -229,6 +307,19 @@ struct DataReaderData : public Data
             const Timestamp& t_to,
             bool clear_last_reported) override;
 
+    // Implement Data::enable_rollups virtual method
+    virtual void enable_rollups(
+            const std::vector<Timestamp::duration>& resolutions) override;
+
+    // Implement Data::enforce_retention virtual method
+    virtual void enforce_retention(
+            const RetentionPolicy& policy,
+            const Timestamp& now,
+            double eviction_ratio) override;
+
+    // Implement Data::memory_usage virtual method
+    virtual std::size_t memory_usage() const override;
+
     /*
      * Data reported by topic: eprosima::fastdds::statistics::SUBSCRIPTION_THROUGHPUT_TOPIC
      */
@@ -274,6 +365,19 @@ struct DataWriterData : public Data
             const Timestamp& t_to,
             bool clear_last_reported) override;
 
+    // Implement Data::enable_rollups virtual method
+    virtual void enable_rollups(
+            const std::vector<Timestamp::duration>& resolutions) override;
+
+    // Implement Data::enforce_retention virtual method
+    virtual void enforce_retention(
+            const RetentionPolicy& policy,
+            const Timestamp& now,
+            double eviction_ratio) override;
+
+    // Implement Data::memory_usage virtual method
+    virtual std::size_t memory_usage() const override;
+
     /*
      * Data reported by topic: eprosima::fastdds::statistics::PUBLICATION_THROUGHPUT_TOPIC
      */
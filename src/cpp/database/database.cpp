@@ -16,11 +16,15 @@
 #include "database.hpp"
 
 #include <algorithm>
+#include <cctype>
 #include <chrono>
+#include <functional>
 #include <iostream>
 #include <mutex>  // For std::unique_lock
 #include <shared_mutex>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <fastdds_statistics_backend/exception/Exception.hpp>
@@ -30,23 +34,52 @@
 
 #include "database_queue.hpp"
 #include "samples.hpp"
+#include "snapshot.hpp"
 
 namespace eprosima {
 namespace statistics_backend {
 namespace database {
 
-template<typename E>
-void clear_inactive_entities_from_map_(
-        std::map<EntityId, std::shared_ptr<E>>& map)
+/**
+ * @brief Take the mutex of the statistics data of an entity in shared mode.
+ *
+ * @param entity The entity whose data is going to be read.
+ * @return The lock of the mutex, which does not own any mutex if the entity holds no statistics data.
+ */
+static std::shared_lock<std::shared_timed_mutex> lock_entity_data_(
+        const std::shared_ptr<const Entity>& entity)
+{
+    switch (entity->kind)
+    {
+        case EntityKind::PARTICIPANT:
+            return std::shared_lock<std::shared_timed_mutex>(
+                std::static_pointer_cast<const DomainParticipant>(entity)->data.mutex);
+        case EntityKind::DATAWRITER:
+            return std::shared_lock<std::shared_timed_mutex>(
+                std::static_pointer_cast<const DataWriter>(entity)->data.mutex);
+        case EntityKind::DATAREADER:
+            return std::shared_lock<std::shared_timed_mutex>(
+                std::static_pointer_cast<const DataReader>(entity)->data.mutex);
+        default:
+            return std::shared_lock<std::shared_timed_mutex>();
+    }
+}
+
+template<typename E, typename Predicate, typename Functor>
+void erase_entities_from_map_(
+        std::map<EntityId, std::shared_ptr<E>>& map,
+        const Predicate& erase,
+        const Functor& on_erase)
 {
     static_assert(std::is_base_of<Entity, E>::value, "Class does not inherit from Entity.");
 
-    // Iterate over whole loop and remove those entities that are not alive
+    // Iterate over whole loop and remove those entities that satisfy the predicate
     for (auto it = map.cbegin(); it != map.cend(); /* no increment */)
     {
-        if (!it->second->active)
+        if (erase(it->second))
         {
-            // Remove it and have reference to next element
+            // Notify the removal, remove it and have reference to next element
+            on_erase(it->second);
             it = map.erase(it);
         }
         else
@@ -56,18 +89,32 @@ void clear_inactive_entities_from_map_(
     }
 }
 
-template<typename E>
-void clear_inactive_entities_from_map_(
-        std::map<EntityId, std::map<EntityId, std::shared_ptr<E>>>& map)
+template<typename E, typename Predicate, typename Functor>
+void erase_entities_from_map_(
+        std::map<EntityId, std::map<EntityId, std::shared_ptr<E>>>& map,
+        const Predicate& erase,
+        const Functor& on_erase)
 {
     // The higher map will not be removed because it holds the domain, so
     // we should just iterate over the internal map.
     for (auto& it : map)
     {
-        clear_inactive_entities_from_map_(it.second);
+        erase_entities_from_map_(it.second, erase, on_erase);
     }
 }
 
+template<typename Map, typename Functor>
+void clear_inactive_entities_from_map_(
+        Map& map,
+        const Functor& on_erase)
+{
+    // Remove those entities that are not alive
+    erase_entities_from_map_(map, [](const std::shared_ptr<Entity>& entity)
+            {
+                return !entity->active;
+            }, on_erase);
+}
+
 template<typename E>
 void clear_inactive_entities_from_map_(
         std::map<EntityId, details::fragile_ptr<E>>& map)
@@ -121,16 +168,14 @@ void Database::insert_nts(
             }
 
             /* Check that this is indeed a new host, and that its name is unique */
-            for (const auto& host_it: hosts_)
+            auto host_it = entities_by_id_.find(host->id);
+            if (host_it != entities_by_id_.end() && host.get() == host_it->second.get())
             {
-                if (host.get() == host_it.second.get())
-                {
-                    throw BadParameter("Host already exists in the database");
-                }
-                if (host->name == host_it.second->name)
-                {
-                    throw BadParameter("Host with name " + host->name + " already exists in the database");
-                }
+                throw BadParameter("Host already exists in the database");
+            }
+            if (!get_entities_by_name_nts(EntityKind::HOST, host->name).empty())
+            {
+                throw BadParameter("Host with name " + host->name + " already exists in the database");
             }
 
             // Add id to the entity
@@ -146,6 +191,7 @@ void Database::insert_nts(
 
             /* Insert host in the database */
             hosts_[host->id] = host;
+            index_entity_nts_(host);
             break;
         }
         case EntityKind::USER:
@@ -159,26 +205,15 @@ void Database::insert_nts(
             }
 
             /* Check that this is indeed a new user */
-            for (const auto& user_it: users_)
+            auto existing_user_it = users_.find(user->id);
+            if (existing_user_it != users_.end() && user.get() == existing_user_it->second.get())
             {
-                if (user.get() == user_it.second.get())
-                {
-                    throw BadParameter("User already exists in the database");
-                }
+                throw BadParameter("User already exists in the database");
             }
 
             /* Check that host exits */
-            bool host_exists = false;
-            for (const auto& host_it : hosts_)
-            {
-                if (user->host.get() == host_it.second.get())
-                {
-                    host_exists = true;
-                    break;
-                }
-            }
-
-            if (!host_exists)
+            auto parent_host_it = hosts_.find(user->host->id);
+            if (parent_host_it == hosts_.end() || user->host.get() != parent_host_it->second.get())
             {
                 throw BadParameter("Parent host does not exist in the database");
             }
@@ -207,6 +242,7 @@ void Database::insert_nts(
 
             /* Add user to users collection */
             users_[user->id] = user;
+            index_entity_nts_(user);
 
             /* Add user to host's users collection */
             user->host->users[user->id] = user;
@@ -229,26 +265,15 @@ void Database::insert_nts(
             }
 
             /* Check that this is indeed a new process */
-            for (const auto& process_it: processes_)
+            auto existing_process_it = processes_.find(process->id);
+            if (existing_process_it != processes_.end() && process.get() == existing_process_it->second.get())
             {
-                if (process.get() == process_it.second.get())
-                {
-                    throw BadParameter("Process already exists in the database");
-                }
+                throw BadParameter("Process already exists in the database");
             }
 
             /* Check that user exits */
-            bool user_exists = false;
-            for (const auto& user_it : users_)
-            {
-                if (process->user.get() == user_it.second.get())
-                {
-                    user_exists = true;
-                    break;
-                }
-            }
-
-            if (!user_exists)
+            auto parent_user_it = users_.find(process->user->id);
+            if (parent_user_it == users_.end() || process->user.get() != parent_user_it->second.get())
             {
                 throw BadParameter("Parent user does not exist in the database");
             }
@@ -280,6 +305,7 @@ void Database::insert_nts(
 
             /* Add process to processes collection */
             processes_[process->id] = process;
+            index_entity_nts_(process);
 
             /* Add process to user's processes collection */
             process->user->processes[process->id] = process;
@@ -296,17 +322,15 @@ void Database::insert_nts(
             }
 
             /* Check that this is indeed a new domain and that its name is unique */
-            for (const auto& domain_it: domains_)
+            auto domain_it = entities_by_id_.find(domain->id);
+            if (domain_it != entities_by_id_.end() && domain.get() == domain_it->second.get())
             {
-                if (domain.get() == domain_it.second.get())
-                {
-                    throw BadParameter("Domain already exists in the database");
-                }
-                if (domain->name == domain_it.second->name)
-                {
-                    throw BadParameter(
-                              "A Domain with name '" + domain->name + "' already exists in the database");
-                }
+                throw BadParameter("Domain already exists in the database");
+            }
+            if (!get_entities_by_name_nts(EntityKind::DOMAIN, domain->name).empty())
+            {
+                throw BadParameter(
+                          "A Domain with name '" + domain->name + "' already exists in the database");
             }
 
             // Add id to the entity
@@ -322,6 +346,7 @@ void Database::insert_nts(
 
             /* Insert domain in the database */
             domains_[domain->id] = domain;
+            index_entity_nts_(domain);
             break;
         }
         case EntityKind::TOPIC:
@@ -341,40 +366,27 @@ void Database::insert_nts(
             }
 
             /* Check that domain exits */
-            bool domain_exists = false;
-            for (const auto& domain_it : domains_)
-            {
-                if (topic->domain.get() == domain_it.second.get())
-                {
-                    domain_exists = true;
-                    break;
-                }
-            }
-
-            if (!domain_exists)
+            auto parent_domain_it = domains_.find(topic->domain->id);
+            if (parent_domain_it == domains_.end() || topic->domain.get() != parent_domain_it->second.get())
             {
                 throw BadParameter("Parent domain does not exist in the database");
             }
 
             /* Check that this is indeed a new topic and that its name and type combination is unique in the domain */
-            auto domain_topics = topics_.find(topic->domain->id);
-            if (domain_topics != topics_.end())
+            auto topic_it = entities_by_id_.find(topic->id);
+            if (topic_it != entities_by_id_.end() && topic.get() == topic_it->second.get())
             {
-                for (const auto& topic_it: domain_topics->second)
-                {
-                    if (topic.get() == topic_it.second.get())
-                    {
-                        throw BadParameter("Topic already exists in the database");
-                    }
-                    if (topic->name == topic_it.second->name &&
-                            topic->data_type == topic_it.second->data_type)
-                    {
-                        throw BadParameter(
-                                  "A topic with name '" + topic->name +
-                                  "' and type '" + topic->data_type +
-                                  "' already exists in the database for the same domain");
-                    }
-                }
+                throw BadParameter("Topic already exists in the database");
+            }
+            auto domain_topics = topics_by_name_and_type_.find(topic->domain->id);
+            if (domain_topics != topics_by_name_and_type_.end() &&
+                    domain_topics->second.find(std::make_pair(topic->name, topic->data_type)) !=
+                    domain_topics->second.end())
+            {
+                throw BadParameter(
+                          "A topic with name '" + topic->name +
+                          "' and type '" + topic->data_type +
+                          "' already exists in the database for the same domain");
             }
 
             // Add id to the entity
@@ -393,6 +405,7 @@ void Database::insert_nts(
 
             /* Insert topic in the database */
             topics_[topic->domain->id][topic->id] = topic;
+            index_entity_nts_(topic);
             break;
         }
         case EntityKind::PARTICIPANT:
@@ -418,39 +431,24 @@ void Database::insert_nts(
             }
 
             /* Check that domain exits */
-            bool domain_exists = false;
-            for (const auto& domain_it : domains_)
-            {
-                if (participant->domain.get() == domain_it.second.get())
-                {
-                    domain_exists = true;
-                    break;
-                }
-            }
-
-            if (!domain_exists)
+            auto parent_domain_it = domains_.find(participant->domain->id);
+            if (parent_domain_it == domains_.end() || participant->domain.get() != parent_domain_it->second.get())
             {
                 throw BadParameter("Parent domain does not exist in the database");
             }
 
             /* Check that this is indeed a new participant and that its GUID is unique */
-            for (const auto& domain_it : participants_)
+            auto participant_it = entities_by_id_.find(participant->id);
+            if (participant_it != entities_by_id_.end() && participant.get() == participant_it->second.get())
             {
-                for (const auto& participant_it : domain_it.second)
-                {
-                    // Check that participant is new
-                    if (participant.get() == participant_it.second.get())
-                    {
-                        throw BadParameter("Participant already exists in the database");
-                    }
-                    // Check GUID uniqueness
-                    if (participant->guid == participant_it.second->guid)
-                    {
-                        throw BadParameter(
-                                  "A participant with GUID '" + participant->guid +
-                                  "' already exists in the database for the same domain");
-                    }
-                }
+                throw BadParameter("Participant already exists in the database");
+            }
+            auto& participants_by_guid = entities_by_guid_[EntityKind::PARTICIPANT];
+            if (participants_by_guid.find(participant->guid) != participants_by_guid.end())
+            {
+                throw BadParameter(
+                          "A participant with GUID '" + participant->guid +
+                          "' already exists in the database for the same domain");
             }
 
             // Add id to the entity
@@ -467,8 +465,15 @@ void Database::insert_nts(
             /* Add participant to domain's collection */
             participant->domain->participants[participant->id] = participant;
 
+            /* Summarize the statistics data of the participant if required */
+            if (!rollup_resolutions_.empty())
+            {
+                participant->data.enable_rollups(rollup_resolutions_);
+            }
+
             /* Insert participant in the database */
             participants_[participant->domain->id][participant->id] = participant;
+            index_entity_nts_(participant);
             break;
         }
         case EntityKind::DATAREADER:
@@ -494,16 +499,14 @@ void Database::insert_nts(
             }
 
             /* Check that this is indeed a new locator, and that its name is unique */
-            for (const auto& locator_it: locators_)
+            auto locator_it = entities_by_id_.find(locator->id);
+            if (locator_it != entities_by_id_.end() && locator.get() == locator_it->second.get())
             {
-                if (locator.get() == locator_it.second.get())
-                {
-                    throw BadParameter("Locator already exists in the database");
-                }
-                if (locator->name == locator_it.second->name)
-                {
-                    throw BadParameter("Locator with name " + locator->name + " already exists in the database");
-                }
+                throw BadParameter("Locator already exists in the database");
+            }
+            if (!get_entities_by_name_nts(EntityKind::LOCATOR, locator->name).empty())
+            {
+                throw BadParameter("Locator with name " + locator->name + " already exists in the database");
             }
 
             // Add id to the entity
@@ -519,6 +522,7 @@ void Database::insert_nts(
 
             /* Insert locator in the database */
             locators_[locator->id] = locator;
+            index_entity_nts_(locator);
             break;
         }
         default:
@@ -533,11 +537,87 @@ void Database::insert(
         const EntityId& entity_id,
         const StatisticsSample& sample)
 {
-    std::lock_guard<std::shared_timed_mutex> guard(mutex_);
+    {
+        // The topology is only read, and the data of the entity is guarded by its own mutex
+        std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+        if (!sample_creates_entities_nts(sample))
+        {
+            insert_nts(domain_id, entity_id, sample);
+            return;
+        }
+    }
 
+    std::lock_guard<std::shared_timed_mutex> guard(mutex_);
     insert_nts(domain_id, entity_id, sample);
 }
 
+void Database::insert(
+        std::vector<SampleInsertion>& samples)
+{
+    auto insert_or_store_error = [this](SampleInsertion& insertion)
+            {
+                try
+                {
+                    insert_nts(insertion.domain_id, insertion.entity_id, *insertion.sample);
+                }
+                catch (const Exception& e)
+                {
+                    insertion.error = e.what();
+                }
+            };
+
+    // Samples that create entities are deferred. All the samples of their series are deferred as well,
+    // as they refer to the same missing locator, so the order within each series is kept.
+    std::vector<SampleInsertion*> deferred;
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+        for (auto& insertion : samples)
+        {
+            if (sample_creates_entities_nts(*insertion.sample))
+            {
+                deferred.push_back(&insertion);
+            }
+            else
+            {
+                insert_or_store_error(insertion);
+            }
+        }
+    }
+
+    if (!deferred.empty())
+    {
+        std::lock_guard<std::shared_timed_mutex> guard(mutex_);
+        for (auto insertion : deferred)
+        {
+            insert_or_store_error(*insertion);
+        }
+    }
+}
+
+bool Database::sample_creates_entities_nts(
+        const StatisticsSample& sample) const
+{
+    EntityId remote_locator;
+    switch (sample.kind)
+    {
+        case DataKind::RTPS_PACKETS_SENT:
+            remote_locator = dynamic_cast<const RtpsPacketsSentSample&>(sample).remote_locator;
+            break;
+        case DataKind::RTPS_BYTES_SENT:
+            remote_locator = dynamic_cast<const RtpsBytesSentSample&>(sample).remote_locator;
+            break;
+        case DataKind::RTPS_PACKETS_LOST:
+            remote_locator = dynamic_cast<const RtpsPacketsLostSample&>(sample).remote_locator;
+            break;
+        case DataKind::RTPS_BYTES_LOST:
+            remote_locator = dynamic_cast<const RtpsBytesLostSample&>(sample).remote_locator;
+            break;
+        default:
+            return false;
+    }
+    return locators_.find(remote_locator) == locators_.end();
+}
+
 std::shared_ptr<Locator> Database::get_locator_nts(
         EntityId const& entity_id)
 {
@@ -562,6 +642,208 @@ std::shared_ptr<Locator> Database::get_locator_nts(
     return locator;
 }
 
+/**
+ * @brief Parse the string representation of a GUID, as written by Fast DDS, into its binary form.
+ *
+ * The expected format is the 12 octets of the GUID prefix written as 2 hexadecimal digits separated by dots,
+ * followed by '|' and the 4 octets of the entity id written as hexadecimal numbers separated by dots,
+ * i.e. 01.0f.00.00.00.00.00.00.00.00.00.00|0.0.1.c1
+ *
+ * @param guid_str The string representation of the GUID.
+ * @param guid Buffer to receive the binary GUID.
+ * @return true if \c guid_str follows the expected format, false otherwise.
+ */
+bool string_to_guid_(
+        const std::string& guid_str,
+        fastrtps::rtps::GUID_t& guid)
+{
+    constexpr size_t octets = fastrtps::rtps::GuidPrefix_t::size + fastrtps::rtps::EntityId_t::size;
+    size_t pos = 0;
+
+    for (size_t i = 0; i < octets; ++i)
+    {
+        // Each octet is written with one or two hexadecimal digits
+        unsigned int value = 0;
+        size_t digits = 0;
+        while (pos < guid_str.size() && digits < 2 && std::isxdigit(static_cast<unsigned char>(guid_str[pos])))
+        {
+            char c = static_cast<char>(std::tolower(static_cast<unsigned char>(guid_str[pos])));
+            value = value * 16 + static_cast<unsigned int>(c <= '9' ? c - '0' : c - 'a' + 10);
+            ++digits;
+            ++pos;
+        }
+        if (0 == digits)
+        {
+            return false;
+        }
+
+        if (i < fastrtps::rtps::GuidPrefix_t::size)
+        {
+            guid.guidPrefix.value[i] = static_cast<fastrtps::rtps::octet>(value);
+        }
+        else
+        {
+            guid.entityId.value[i - fastrtps::rtps::GuidPrefix_t::size] = static_cast<fastrtps::rtps::octet>(value);
+        }
+
+        // Octets are separated by dots, except the prefix and the entity id that are separated by '|'
+        if (i + 1 < octets)
+        {
+            char separator = (i + 1 == fastrtps::rtps::GuidPrefix_t::size) ? '|' : '.';
+            if (pos >= guid_str.size() || guid_str[pos] != separator)
+            {
+                return false;
+            }
+            ++pos;
+        }
+    }
+
+    return pos == guid_str.size();
+}
+
+/**
+ * @brief Get the EntityId of the Domain to which an entity belongs.
+ *
+ * @param entity The entity.
+ * @return The EntityId of the Domain of the entity, the EntityId of the entity itself if it is a Domain,
+ *         or EntityId::invalid() for physical entities, as they do not belong to a Domain.
+ */
+EntityId domain_of_entity_(
+        const std::shared_ptr<Entity>& entity)
+{
+    switch (entity->kind)
+    {
+        case EntityKind::DOMAIN:
+        {
+            return entity->id;
+        }
+        case EntityKind::TOPIC:
+        {
+            return std::static_pointer_cast<Topic>(entity)->domain->id;
+        }
+        case EntityKind::PARTICIPANT:
+        {
+            return std::static_pointer_cast<DomainParticipant>(entity)->domain->id;
+        }
+        case EntityKind::DATAREADER:
+        case EntityKind::DATAWRITER:
+        {
+            return std::static_pointer_cast<DDSEndpoint>(entity)->participant->domain->id;
+        }
+        default:
+        {
+            return EntityId::invalid();
+        }
+    }
+}
+
+void Database::index_entity_nts_(
+        const std::shared_ptr<Entity>& entity)
+{
+    entities_by_id_[entity->id] = entity;
+
+    EntityId domain_id = domain_of_entity_(entity);
+    entities_by_name_[entity->kind][entity->name].insert(std::make_pair(domain_id, entity->id));
+
+    if (EntityKind::TOPIC == entity->kind)
+    {
+        const std::string& data_type = std::static_pointer_cast<Topic>(entity)->data_type;
+        topics_by_name_and_type_[domain_id][std::make_pair(entity->name, data_type)] = entity->id;
+        return;
+    }
+
+    if (EntityKind::PARTICIPANT != entity->kind &&
+            EntityKind::DATAREADER != entity->kind &&
+            EntityKind::DATAWRITER != entity->kind)
+    {
+        // Only DDS entities are indexed by GUID
+        return;
+    }
+
+    const std::string& guid_str = std::static_pointer_cast<DDSEntity>(entity)->guid;
+    entities_by_guid_[entity->kind][guid_str] = std::make_pair(domain_id, entity->id);
+
+    fastrtps::rtps::GUID_t guid;
+    if (string_to_guid_(guid_str, guid))
+    {
+        entities_by_binary_guid_[entity->kind][guid] = std::make_pair(domain_id, entity->id);
+    }
+}
+
+void Database::unindex_entity_nts_(
+        const std::shared_ptr<Entity>& entity)
+{
+    entities_by_id_.erase(entity->id);
+
+    // The parents of the entity may have already been destroyed, so its Domain cannot be retrieved from them.
+    // The entries of the indexes by name are found by the EntityId of the entity instead.
+    auto& entities_by_name = entities_by_name_[entity->kind];
+    auto name_it = entities_by_name.find(entity->name);
+    if (name_it != entities_by_name.end())
+    {
+        for (auto it = name_it->second.begin(); it != name_it->second.end(); ++it)
+        {
+            if (it->second == entity->id)
+            {
+                name_it->second.erase(it);
+                break;
+            }
+        }
+        if (name_it->second.empty())
+        {
+            entities_by_name.erase(name_it);
+        }
+    }
+
+    if (EntityKind::TOPIC == entity->kind)
+    {
+        const std::string& data_type = std::static_pointer_cast<Topic>(entity)->data_type;
+        for (auto domain_topics = topics_by_name_and_type_.begin(); domain_topics != topics_by_name_and_type_.end();
+                ++domain_topics)
+        {
+            auto topic_it = domain_topics->second.find(std::make_pair(entity->name, data_type));
+            if (topic_it != domain_topics->second.end() && topic_it->second == entity->id)
+            {
+                domain_topics->second.erase(topic_it);
+                if (domain_topics->second.empty())
+                {
+                    topics_by_name_and_type_.erase(domain_topics);
+                }
+                break;
+            }
+        }
+        return;
+    }
+
+    if (EntityKind::PARTICIPANT != entity->kind &&
+            EntityKind::DATAREADER != entity->kind &&
+            EntityKind::DATAWRITER != entity->kind)
+    {
+        return;
+    }
+
+    // An entity rediscovered with another spelling of its GUID replaces this one in the binary index,
+    // so the entries are only removed if they still refer to this entity
+    const std::string& guid_str = std::static_pointer_cast<DDSEntity>(entity)->guid;
+    auto& entities_by_guid = entities_by_guid_[entity->kind];
+    auto guid_str_it = entities_by_guid.find(guid_str);
+    if (guid_str_it != entities_by_guid.end() && guid_str_it->second.second == entity->id)
+    {
+        entities_by_guid.erase(guid_str_it);
+    }
+
+    fastrtps::rtps::GUID_t guid;
+    if (string_to_guid_(guid_str, guid))
+    {
+        auto& entities_by_binary_guid = entities_by_binary_guid_[entity->kind];
+        auto guid_it = entities_by_binary_guid.find(guid);
+        if (guid_it != entities_by_binary_guid.end() && guid_it->second.second == entity->id)
+        {
+            entities_by_binary_guid.erase(guid_it);
+        }
+    }
+}
+
 void Database::notify_locator_discovery (
         const EntityId& locator_id)
 {
@@ -597,8 +879,11 @@ void Database::insert_nts(
                 auto writer = domain_writers->second.find(entity_id);
                 if (writer != domain_writers->second.end())
                 {
+                    std::lock_guard<std::shared_timed_mutex> data_guard(writer->second->data.mutex);
+
                     const HistoryLatencySample& fastdds_latency = dynamic_cast<const HistoryLatencySample&>(sample);
-                    writer->second->data.history2history_latency[fastdds_latency.reader].push_back(fastdds_latency);
+                    writer->second->data.history2history_latency[fastdds_latency.reader].push_back(fastdds_latency,
+                            insertion_epoch_);
                     break;
                 }
             }
@@ -615,9 +900,11 @@ void Database::insert_nts(
                 auto participant = domain_participants->second.find(entity_id);
                 if (participant != domain_participants->second.end())
                 {
+                    std::lock_guard<std::shared_timed_mutex> data_guard(participant->second->data.mutex);
+
                     const NetworkLatencySample& network_latency = dynamic_cast<const NetworkLatencySample&>(sample);
                     participant->second->data.network_latency_per_locator[network_latency.remote_locator].push_back(
-                        network_latency);
+                        network_latency, insertion_epoch_);
                     break;
                 }
             }
@@ -634,9 +921,11 @@ void Database::insert_nts(
                 auto writer = domain_writers->second.find(entity_id);
                 if (writer != domain_writers->second.end())
                 {
+                    std::lock_guard<std::shared_timed_mutex> data_guard(writer->second->data.mutex);
+
                     const PublicationThroughputSample& publication_throughput =
                             dynamic_cast<const PublicationThroughputSample&>(sample);
-                    writer->second->data.publication_throughput.push_back(publication_throughput);
+                    writer->second->data.publication_throughput.push_back(publication_throughput, insertion_epoch_);
                     break;
                 }
             }
@@ -653,9 +942,11 @@ void Database::insert_nts(
                 auto reader = domain_readers->second.find(entity_id);
                 if (reader != domain_readers->second.end())
                 {
+                    std::lock_guard<std::shared_timed_mutex> data_guard(reader->second->data.mutex);
+
                     const SubscriptionThroughputSample& subscription_throughput =
                             dynamic_cast<const SubscriptionThroughputSample&>(sample);
-                    reader->second->data.subscription_throughput.push_back(subscription_throughput);
+                    reader->second->data.subscription_throughput.push_back(subscription_throughput, insertion_epoch_);
                     break;
                 }
             }
@@ -672,6 +963,8 @@ void Database::insert_nts(
                 auto participant = domain_participants->second.find(entity_id);
                 if (participant != domain_participants->second.end())
                 {
+                    std::lock_guard<std::shared_timed_mutex> data_guard(participant->second->data.mutex);
+
                     const RtpsPacketsSentSample& rtps_packets_sent = dynamic_cast<const RtpsPacketsSentSample&>(sample);
 
                     // Create remote_locator if it does not exist
@@ -691,7 +984,7 @@ void Database::insert_nts(
                         {
                             // Store data directly
                             participant->second->data.rtps_packets_sent[rtps_packets_sent.remote_locator].push_back(
-                                rtps_packets_sent);
+                                rtps_packets_sent, insertion_epoch_);
                         }
                     }
                     else
@@ -700,7 +993,7 @@ void Database::insert_nts(
                         participant->second->data.rtps_packets_sent[rtps_packets_sent.remote_locator].push_back(
                             rtps_packets_sent -
                             participant->second->data.last_reported_rtps_packets_sent_count[rtps_packets_sent.
-                                    remote_locator]);
+                                    remote_locator], insertion_epoch_);
                         // Update last report
                         participant->second->data.last_reported_rtps_packets_sent_count[rtps_packets_sent.remote_locator
                         ] =
@@ -723,6 +1016,8 @@ void Database::insert_nts(
                 auto participant = domain_participants->second.find(entity_id);
                 if (participant != domain_participants->second.end())
                 {
+                    std::lock_guard<std::shared_timed_mutex> data_guard(participant->second->data.mutex);
+
                     const RtpsBytesSentSample& rtps_bytes_sent = dynamic_cast<const RtpsBytesSentSample&>(sample);
 
                     // Create remote_locator if it does not exist
@@ -742,7 +1037,7 @@ void Database::insert_nts(
                         {
                             // Store data directly
                             participant->second->data.rtps_bytes_sent[rtps_bytes_sent.remote_locator].push_back(
-                                rtps_bytes_sent);
+                                rtps_bytes_sent, insertion_epoch_);
                         }
                     }
                     else
@@ -750,7 +1045,8 @@ void Database::insert_nts(
                         // Store the increment since the last report
                         participant->second->data.rtps_bytes_sent[rtps_bytes_sent.remote_locator].push_back(
                             rtps_bytes_sent -
-                            participant->second->data.last_reported_rtps_bytes_sent_count[rtps_bytes_sent.remote_locator]);
+                            participant->second->data.last_reported_rtps_bytes_sent_count[rtps_bytes_sent.remote_locator],
+                            insertion_epoch_);
                         // Update last report
                         participant->second->data.last_reported_rtps_bytes_sent_count[rtps_bytes_sent.remote_locator] =
                                 rtps_bytes_sent;
@@ -772,6 +1068,8 @@ void Database::insert_nts(
                 auto participant = domain_participants->second.find(entity_id);
                 if (participant != domain_participants->second.end())
                 {
+                    std::lock_guard<std::shared_timed_mutex> data_guard(participant->second->data.mutex);
+
                     const RtpsPacketsLostSample& rtps_packets_lost = dynamic_cast<const RtpsPacketsLostSample&>(sample);
 
                     // Create remote_locator if it does not exist
@@ -791,7 +1089,7 @@ void Database::insert_nts(
                         {
                             // Store data directly
                             participant->second->data.rtps_packets_lost[rtps_packets_lost.remote_locator].push_back(
-                                rtps_packets_lost);
+                                rtps_packets_lost, insertion_epoch_);
                         }
                     }
                     else
@@ -800,7 +1098,7 @@ void Database::insert_nts(
                         participant->second->data.rtps_packets_lost[rtps_packets_lost.remote_locator].push_back(
                             rtps_packets_lost -
                             participant->second->data.last_reported_rtps_packets_lost_count[rtps_packets_lost.
-                                    remote_locator]);
+                                    remote_locator], insertion_epoch_);
                         // Update last report
                         participant->second->data.last_reported_rtps_packets_lost_count[rtps_packets_lost.remote_locator
                         ] =
@@ -823,6 +1121,8 @@ void Database::insert_nts(
                 auto participant = domain_participants->second.find(entity_id);
                 if (participant != domain_participants->second.end())
                 {
+                    std::lock_guard<std::shared_timed_mutex> data_guard(participant->second->data.mutex);
+
                     const RtpsBytesLostSample& rtps_bytes_lost = dynamic_cast<const RtpsBytesLostSample&>(sample);
 
                     // Create remote_locator if it does not exist
@@ -842,7 +1142,7 @@ void Database::insert_nts(
                         {
                             // Store data directly
                             participant->second->data.rtps_bytes_lost[rtps_bytes_lost.remote_locator].push_back(
-                                rtps_bytes_lost);
+                                rtps_bytes_lost, insertion_epoch_);
                         }
                     }
                     else
@@ -850,7 +1150,8 @@ void Database::insert_nts(
                         // Store the increment since the last report
                         participant->second->data.rtps_bytes_lost[rtps_bytes_lost.remote_locator].push_back(
                             rtps_bytes_lost -
-                            participant->second->data.last_reported_rtps_bytes_lost_count[rtps_bytes_lost.remote_locator]);
+                            participant->second->data.last_reported_rtps_bytes_lost_count[rtps_bytes_lost.remote_locator],
+                            insertion_epoch_);
                         // Update last report
                         participant->second->data.last_reported_rtps_bytes_lost_count[rtps_bytes_lost.remote_locator] =
                                 rtps_bytes_lost;
@@ -872,6 +1173,8 @@ void Database::insert_nts(
                 auto writer = domain_writers->second.find(entity_id);
                 if (writer != domain_writers->second.end())
                 {
+                    std::lock_guard<std::shared_timed_mutex> data_guard(writer->second->data.mutex);
+
                     const ResentDataSample& resent_datas = dynamic_cast<const ResentDataSample&>(sample);
 
                     // Check if the insertion is from the load
@@ -885,14 +1188,14 @@ void Database::insert_nts(
                         else
                         {
                             // Store data directly
-                            writer->second->data.resent_datas.push_back(resent_datas);
+                            writer->second->data.resent_datas.push_back(resent_datas, insertion_epoch_);
                         }
                     }
                     else
                     {
                         // Store the increment since the last report
                         writer->second->data.resent_datas.push_back(
-                            resent_datas - writer->second->data.last_reported_resent_datas);
+                            resent_datas - writer->second->data.last_reported_resent_datas, insertion_epoch_);
                         // Update last report
                         writer->second->data.last_reported_resent_datas = resent_datas;
                     }
@@ -913,6 +1216,8 @@ void Database::insert_nts(
                 auto writer = domain_writers->second.find(entity_id);
                 if (writer != domain_writers->second.end())
                 {
+                    std::lock_guard<std::shared_timed_mutex> data_guard(writer->second->data.mutex);
+
                     const HeartbeatCountSample& heartbeat_count = dynamic_cast<const HeartbeatCountSample&>(sample);
 
                     // Check if the insertion is from the load
@@ -926,14 +1231,14 @@ void Database::insert_nts(
                         else
                         {
                             // Store data directly
-                            writer->second->data.heartbeat_count.push_back(heartbeat_count);
+                            writer->second->data.heartbeat_count.push_back(heartbeat_count, insertion_epoch_);
                         }
                     }
                     else
                     {
                         // Store the increment since the last report
                         writer->second->data.heartbeat_count.push_back(heartbeat_count -
-                                writer->second->data.last_reported_heartbeat_count);
+                                writer->second->data.last_reported_heartbeat_count, insertion_epoch_);
                         // Update last report
                         writer->second->data.last_reported_heartbeat_count = heartbeat_count;
                     }
@@ -954,6 +1259,8 @@ void Database::insert_nts(
                 auto reader = domain_readers->second.find(entity_id);
                 if (reader != domain_readers->second.end())
                 {
+                    std::lock_guard<std::shared_timed_mutex> data_guard(reader->second->data.mutex);
+
                     const AcknackCountSample& acknack_count = dynamic_cast<const AcknackCountSample&>(sample);
 
                     // Check if the insertion is from the load
@@ -967,14 +1274,14 @@ void Database::insert_nts(
                         else
                         {
                             // Store data directly
-                            reader->second->data.acknack_count.push_back(acknack_count);
+                            reader->second->data.acknack_count.push_back(acknack_count, insertion_epoch_);
                         }
                     }
                     else
                     {
                         // Store the increment since the last report
                         reader->second->data.acknack_count.push_back(
-                            acknack_count - reader->second->data.last_reported_acknack_count);
+                            acknack_count - reader->second->data.last_reported_acknack_count, insertion_epoch_);
                         // Update last report
                         reader->second->data.last_reported_acknack_count = acknack_count;
                     }
@@ -995,6 +1302,8 @@ void Database::insert_nts(
                 auto reader = domain_readers->second.find(entity_id);
                 if (reader != domain_readers->second.end())
                 {
+                    std::lock_guard<std::shared_timed_mutex> data_guard(reader->second->data.mutex);
+
                     const NackfragCountSample& nackfrag_count = dynamic_cast<const NackfragCountSample&>(sample);
 
                     // Check if the insertion is from the load
@@ -1008,14 +1317,14 @@ void Database::insert_nts(
                         else
                         {
                             // Store data directly
-                            reader->second->data.nackfrag_count.push_back(nackfrag_count);
+                            reader->second->data.nackfrag_count.push_back(nackfrag_count, insertion_epoch_);
                         }
                     }
                     else
                     {
                         // Store the increment since the last report
                         reader->second->data.nackfrag_count.push_back(
-                            nackfrag_count - reader->second->data.last_reported_nackfrag_count);
+                            nackfrag_count - reader->second->data.last_reported_nackfrag_count, insertion_epoch_);
                         // Update last report
                         reader->second->data.last_reported_nackfrag_count = nackfrag_count;
                     }
@@ -1036,6 +1345,8 @@ void Database::insert_nts(
                 auto writer = domain_writers->second.find(entity_id);
                 if (writer != domain_writers->second.end())
                 {
+                    std::lock_guard<std::shared_timed_mutex> data_guard(writer->second->data.mutex);
+
                     const GapCountSample& gap_count = dynamic_cast<const GapCountSample&>(sample);
 
                     // Check if the insertion is from the load
@@ -1049,14 +1360,14 @@ void Database::insert_nts(
                         else
                         {
                             // Store data directly
-                            writer->second->data.gap_count.push_back(gap_count);
+                            writer->second->data.gap_count.push_back(gap_count, insertion_epoch_);
                         }
                     }
                     else
                     {
                         // Store the increment since the last report
                         writer->second->data.gap_count.push_back(
-                            gap_count - writer->second->data.last_reported_gap_count);
+                            gap_count - writer->second->data.last_reported_gap_count, insertion_epoch_);
                         // Update last report
                         writer->second->data.last_reported_gap_count = gap_count;
                     }
@@ -1077,6 +1388,8 @@ void Database::insert_nts(
                 auto writer = domain_writers->second.find(entity_id);
                 if (writer != domain_writers->second.end())
                 {
+                    std::lock_guard<std::shared_timed_mutex> data_guard(writer->second->data.mutex);
+
                     const DataCountSample& data_count = dynamic_cast<const DataCountSample&>(sample);
 
                     // Check if the insertion is from the load
@@ -1090,14 +1403,14 @@ void Database::insert_nts(
                         else
                         {
                             // Store data directly
-                            writer->second->data.data_count.push_back(data_count);
+                            writer->second->data.data_count.push_back(data_count, insertion_epoch_);
                         }
                     }
                     else
                     {
                         // Store the increment since the last report
                         writer->second->data.data_count.push_back(
-                            data_count - writer->second->data.last_reported_data_count);
+                            data_count - writer->second->data.last_reported_data_count, insertion_epoch_);
                         // Update last report
                         writer->second->data.last_reported_data_count = data_count;
                     }
@@ -1118,6 +1431,8 @@ void Database::insert_nts(
                 auto participant = domain_participants->second.find(entity_id);
                 if (participant != domain_participants->second.end())
                 {
+                    std::lock_guard<std::shared_timed_mutex> data_guard(participant->second->data.mutex);
+
                     const PdpCountSample& pdp_packets = dynamic_cast<const PdpCountSample&>(sample);
 
                     // Check if the insertion is from the load
@@ -1131,7 +1446,7 @@ void Database::insert_nts(
                         else
                         {
                             // Store data directly
-                            participant->second->data.pdp_packets.push_back(pdp_packets);
+                            participant->second->data.pdp_packets.push_back(pdp_packets, insertion_epoch_);
                         }
 
                     }
@@ -1139,7 +1454,7 @@ void Database::insert_nts(
                     {
                         // Store the increment since the last report
                         participant->second->data.pdp_packets.push_back(
-                            pdp_packets - participant->second->data.last_reported_pdp_packets);
+                            pdp_packets - participant->second->data.last_reported_pdp_packets, insertion_epoch_);
                         // Update last report
                         participant->second->data.last_reported_pdp_packets = pdp_packets;
                     }
@@ -1160,6 +1475,8 @@ void Database::insert_nts(
                 auto participant = domain_participants->second.find(entity_id);
                 if (participant != domain_participants->second.end())
                 {
+                    std::lock_guard<std::shared_timed_mutex> data_guard(participant->second->data.mutex);
+
                     const EdpCountSample& edp_packets = dynamic_cast<const EdpCountSample&>(sample);
 
                     // Check if the insertion is from the load
@@ -1173,14 +1490,14 @@ void Database::insert_nts(
                         else
                         {
                             // Store data directly
-                            participant->second->data.edp_packets.push_back(edp_packets);
+                            participant->second->data.edp_packets.push_back(edp_packets, insertion_epoch_);
                         }
                     }
                     else
                     {
                         // Store the increment since the last report
                         participant->second->data.edp_packets.push_back(
-                            edp_packets - participant->second->data.last_reported_edp_packets);
+                            edp_packets - participant->second->data.last_reported_edp_packets, insertion_epoch_);
                         // Update last report
                         participant->second->data.last_reported_edp_packets = edp_packets;
                     }
@@ -1201,8 +1518,11 @@ void Database::insert_nts(
                 auto participant = domain_participants->second.find(entity_id);
                 if (participant != domain_participants->second.end())
                 {
+                    std::lock_guard<std::shared_timed_mutex> data_guard(participant->second->data.mutex);
+
                     const DiscoveryTimeSample& discovery_time = dynamic_cast<const DiscoveryTimeSample&>(sample);
-                    participant->second->data.discovered_entity[discovery_time.remote_entity].push_back(discovery_time);
+                    participant->second->data.discovered_entity[discovery_time.remote_entity].push_back(discovery_time,
+                            insertion_epoch_);
                     break;
                 }
             }
@@ -1219,10 +1539,13 @@ void Database::insert_nts(
                 auto writer = domain_writers->second.find(entity_id);
                 if (writer != domain_writers->second.end())
                 {
+                    std::lock_guard<std::shared_timed_mutex> data_guard(writer->second->data.mutex);
+
                     const SampleDatasCountSample& sample_datas = dynamic_cast<const SampleDatasCountSample&>(sample);
                     // Only save the last received sample for each sequence number
                     writer->second->data.sample_datas[sample_datas.sequence_number].clear();
-                    writer->second->data.sample_datas[sample_datas.sequence_number].push_back(sample_datas);
+                    writer->second->data.sample_datas[sample_datas.sequence_number].push_back(sample_datas,
+                            insertion_epoch_);
                     break;
                 }
             }
@@ -1316,202 +1639,39 @@ const std::shared_ptr<const Entity> Database::get_entity(
 const std::shared_ptr<const Entity> Database::get_entity_nts(
         const EntityId& entity_id) const
 {
-    /* Iterate over all the collections looking for the entity */
-    for (const auto& host_it : hosts_)
-    {
-        if (host_it.second->id == entity_id)
-        {
-            return host_it.second;
-        }
-    }
-    for (const auto& process_it : processes_)
-    {
-        if (process_it.second->id == entity_id)
-        {
-            return process_it.second;
-        }
-    }
-    for (const auto& user_it : users_)
-    {
-        if (user_it.second->id == entity_id)
-        {
-            return user_it.second;
-        }
-    }
-    for (const auto& domain_it : domains_)
-    {
-        if (domain_it.second->id == entity_id)
-        {
-            return domain_it.second;
-        }
-    }
-    for (const auto& domain_it : topics_)
-    {
-        for (const auto& topic_it : domain_it.second)
-        {
-            if (topic_it.second->id == entity_id)
-            {
-                return topic_it.second;
-            }
-        }
-    }
-    for (const auto& domain_it : participants_)
-    {
-        for (const auto& participant_it : domain_it.second)
-        {
-            if (participant_it.second->id == entity_id)
-            {
-                return participant_it.second;
-            }
-        }
-    }
-    for (const auto& domain_it : datareaders_)
-    {
-        for (const auto& datareader_it : domain_it.second)
-        {
-            if (datareader_it.second->id == entity_id)
-            {
-                return datareader_it.second;
-            }
-        }
-    }
-    for (const auto& domain_it : datawriters_)
-    {
-        for (const auto& datawriter_it : domain_it.second)
-        {
-            if (datawriter_it.second->id == entity_id)
-            {
-                return datawriter_it.second;
-            }
-        }
-    }
-    for (const auto& locator_it : locators_)
+    auto entity_it = entities_by_id_.find(entity_id);
+    if (entity_it == entities_by_id_.end())
     {
-        if (locator_it.second->id == entity_id)
-        {
-            return locator_it.second;
-        }
+        /* The entity has not been found */
+        throw BadParameter("Database does not contain an entity with ID " + std::to_string(entity_id.value()));
     }
-    /* The entity has not been found */
-    throw BadParameter("Database does not contain an entity with ID " + std::to_string(entity_id.value()));
+    return entity_it->second;
 }
 
 std::vector<std::pair<EntityId, EntityId>> Database::get_entities_by_name(
         EntityKind entity_kind,
         const std::string& name) const
 {
-    std::vector<std::pair<EntityId, EntityId>> entities;
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    return get_entities_by_name_nts(entity_kind, name);
+}
+
+std::vector<std::pair<EntityId, EntityId>> Database::get_entities_by_name_nts(
+        EntityKind entity_kind,
+        const std::string& name) const
+{
     switch (entity_kind)
     {
         case EntityKind::HOST:
-        {
-            for (const auto& host_it : hosts_)
-            {
-                if (host_it.second->name == name)
-                {
-                    entities.push_back(std::pair<EntityId, EntityId>(EntityId(), host_it.first));
-                }
-            }
-            break;
-        }
         case EntityKind::USER:
-        {
-            for (const auto& user_it : users_)
-            {
-                if (user_it.second->name == name)
-                {
-                    entities.push_back(std::pair<EntityId, EntityId>(EntityId(), user_it.first));
-                }
-            }
-            break;
-        }
         case EntityKind::PROCESS:
-        {
-            for (const auto& process_it : processes_)
-            {
-                if (process_it.second->name == name)
-                {
-                    entities.push_back(std::pair<EntityId, EntityId>(EntityId(), process_it.first));
-                }
-            }
-            break;
-        }
         case EntityKind::DOMAIN:
-        {
-            for (const auto& domain_it : domains_)
-            {
-                if (domain_it.second->name == name)
-                {
-                    entities.push_back(std::pair<EntityId, EntityId>(domain_it.first, domain_it.first));
-                }
-            }
-            break;
-        }
         case EntityKind::PARTICIPANT:
-        {
-            for (const auto& domain_it : participants_)
-            {
-                for (const auto& participant_it : domain_it.second)
-                {
-                    if (participant_it.second->name == name)
-                    {
-                        entities.push_back(std::pair<EntityId, EntityId>(domain_it.first, participant_it.first));
-                    }
-                }
-            }
-            break;
-        }
         case EntityKind::TOPIC:
-        {
-            for (const auto& domain_it : topics_)
-            {
-                for (const auto& topic_it : domain_it.second)
-                {
-                    if (topic_it.second->name == name)
-                    {
-                        entities.push_back(std::pair<EntityId, EntityId>(domain_it.first, topic_it.first));
-                    }
-                }
-            }
-            break;
-        }
         case EntityKind::DATAREADER:
-        {
-            for (const auto& domain_it : datareaders_)
-            {
-                for (const auto& datareader_it : domain_it.second)
-                {
-                    if (datareader_it.second->name == name)
-                    {
-                        entities.push_back(std::pair<EntityId, EntityId>(domain_it.first, datareader_it.first));
-                    }
-                }
-            }
-            break;
-        }
         case EntityKind::DATAWRITER:
-        {
-            for (const auto& domain_it : datawriters_)
-            {
-                for (const auto& datawriter_it : domain_it.second)
-                {
-                    if (datawriter_it.second->name == name)
-                    {
-                        entities.push_back(std::pair<EntityId, EntityId>(domain_it.first, datawriter_it.first));
-                    }
-                }
-            }
-            break;
-        }
         case EntityKind::LOCATOR:
         {
-            for (const auto& locator_it : locators_)
-            {
-                if (locator_it.second->name == name)
-                {
-                    entities.push_back(std::pair<EntityId, EntityId>(EntityId(), locator_it.first));
-                }
-            }
             break;
         }
         default:
@@ -1519,9 +1679,38 @@ std::vector<std::pair<EntityId, EntityId>> Database::get_entities_by_name(
             throw BadParameter("Incorrect EntityKind");
         }
     }
+
+    std::vector<std::pair<EntityId, EntityId>> entities;
+    auto kind_it = entities_by_name_.find(entity_kind);
+    if (kind_it != entities_by_name_.end())
+    {
+        auto name_it = kind_it->second.find(name);
+        if (name_it != kind_it->second.end())
+        {
+            entities.assign(name_it->second.begin(), name_it->second.end());
+        }
+    }
     return entities;
 }
 
+EntityId Database::get_topic_by_name_and_type(
+        const EntityId& domain_id,
+        const std::string& name,
+        const std::string& data_type) const
+{
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    auto domain_topics = topics_by_name_and_type_.find(domain_id);
+    if (domain_topics != topics_by_name_and_type_.end())
+    {
+        auto topic_it = domain_topics->second.find(std::make_pair(name, data_type));
+        if (topic_it != domain_topics->second.end())
+        {
+            return topic_it->second;
+        }
+    }
+    return EntityId::invalid();
+}
+
 void Database::erase(
         EntityId& domain_id)
 {
@@ -1535,7 +1724,12 @@ void Database::erase(
 
     // The mutex should be taken only once. get_entity_kind already locks.
     std::lock_guard<std::shared_timed_mutex> guard(mutex_);
+    erase_nts_(domain_id);
+}
 
+void Database::erase_nts_(
+        const EntityId& domain_id)
+{
     for (auto& reader : datareaders_[domain_id])
     {
         // Unlink related locators
@@ -1545,6 +1739,10 @@ void Database::erase(
         }
     }
     // Erase datareaders map element
+    for (const auto& reader : datareaders_[domain_id])
+    {
+        unindex_entity_nts_(reader.second);
+    }
     datareaders_.erase(domain_id);
 
     // Remove datawriters and unlink related locators
@@ -1557,9 +1755,17 @@ void Database::erase(
         }
     }
     // Erase datawriters map element
+    for (const auto& writer : datawriters_[domain_id])
+    {
+        unindex_entity_nts_(writer.second);
+    }
     datawriters_.erase(domain_id);
 
     // Erase topics map element
+    for (const auto& topic : topics_[domain_id])
+    {
+        unindex_entity_nts_(topic.second);
+    }
     topics_.erase(domain_id);
 
     // Remove participants and unlink related process
@@ -1589,18 +1795,192 @@ void Database::erase(
         }
     }
     // Erase participants map element
+    for (const auto& participant : participants_[domain_id])
+    {
+        unindex_entity_nts_(participant.second);
+    }
     participants_.erase(domain_id);
 
     // Erase domain map element
+    unindex_entity_nts_(domains_[domain_id]);
     domains_.erase(domain_id);
 }
 
-std::vector<const StatisticsSample*> Database::select(
+/**
+ * @brief Add to a vector of samples the samples of a container with a timestamp in a closed interval.
+ *
+ * The container is sorted by timestamp, so the limits of the interval are found with a binary search.
+ *
+ * @param data The container with the samples.
+ * @param t_from Minimum time included in the interval.
+ * @param t_to Maximum time included in the interval.
+ * @param samples The vector where the samples are added.
+ */
+template <typename T>
+void select_samples_(
+        const details::DataContainer<T>& data,
+        const Timestamp& t_from,
+        const Timestamp& t_to,
+        std::vector<const StatisticsSample*>& samples)
+{
+    auto limits = data.get_closed_interval_limits(t_from, t_to);
+    for (auto it = limits.first; it != limits.second; ++it)
+    {
+        samples.push_back(&(*it));
+    }
+}
+
+/**
+ * @brief Add to a vector of blocks of samples the samples of a container with a timestamp in a closed interval.
+ *
+ * The samples are not copied, but referenced by the blocks of contiguous memory where the container stores them.
+ *
+ * @param data The container with the samples.
+ * @param t_from Minimum time included in the interval.
+ * @param t_to Maximum time included in the interval.
+ * @param samples The vector where the blocks are added.
+ */
+template <typename T>
+void select_samples_(
+        const details::DataContainer<T>& data,
+        const Timestamp& t_from,
+        const Timestamp& t_to,
+        SampleSpans& samples)
+{
+    data.for_each_block(t_from, t_to, [&samples](
+                const T* first,
+                std::size_t size)
+            {
+                samples.spans.emplace_back(first, size);
+            });
+}
+
+/**
+ * @brief Add to the summaries of some bins the samples of a container, using its rollups.
+ *
+ * Each bin is summarized from the buckets of the coarsest tier of rollups whose resolution divides the duration of
+ * the bins. Only the samples at the edges of the bins that do not fill a whole bucket, because the bins are not
+ * aligned with the buckets, are visited.
+ * If the container has no suitable tier, \c bins.complete is set to false.
+ *
+ * @param data The container with the samples.
+ * @param bins The bins where the samples are summarized. Their interval is the one summarized.
+ */
+template <typename T>
+void select_samples_(
+        const details::DataContainer<T>& data,
+        const Timestamp& /*t_from*/,
+        const Timestamp& /*t_to*/,
+        details::RollupBins& bins)
+{
+    if (!bins.complete)
+    {
+        return;
+    }
+
+    const details::RollupSeries* rollups = data.rollups();
+    const details::RollupTier* tier = rollups ? rollups->tier_for(bins.interval) : nullptr;
+    if (nullptr == tier)
+    {
+        bins.complete = false;
+        return;
+    }
+
+    // Summarize the samples in [from, to)
+    auto add_samples = [&data](
+        const Timestamp& from,
+        const Timestamp& to,
+        details::RollupSummary& summary)
+            {
+                if (from < to)
+                {
+                    data.for_each_block(from, to - Timestamp::duration(1), [&summary](
+                                const T* first,
+                                std::size_t size)
+                            {
+                                for (const T* last = first + size; first != last; ++first)
+                                {
+                                    summary.add(detail::get_value(*first));
+                                }
+                            });
+                }
+            };
+
+    for (std::size_t i = 0; i < bins.summaries.size(); ++i)
+    {
+        Timestamp start = bins.bin_start(i);
+        Timestamp end = bins.bin_end(i);
+        details::RollupSummary& summary = bins.summaries[i];
+
+        // Whole buckets inside the bin
+        Timestamp first_bucket = tier->bucket_start(start);
+        if (first_bucket < start)
+        {
+            first_bucket += tier->resolution();
+        }
+        Timestamp last_bucket = tier->bucket_start(end);
+
+        if (first_bucket < last_bucket)
+        {
+            add_samples(start, first_bucket, summary);
+            tier->summarize(first_bucket, last_bucket, summary);
+            add_samples(last_bucket, end, summary);
+        }
+        else
+        {
+            add_samples(start, end, summary);
+        }
+    }
+}
+
+//! Timestamp of a selected sample
+const Timestamp& select_timestamp_(
+        const StatisticsSample* sample)
+{
+    return sample->src_ts;
+}
+
+//! Timestamp of the first sample of a selected block of samples
+const Timestamp& select_timestamp_(
+        const SampleSpan& span)
+{
+    return span.first->src_ts;
+}
+
+//! Sort selected samples or blocks of samples by timestamp
+template <typename Sample>
+void sort_by_timestamp_(
+        std::vector<Sample>& samples)
+{
+    std::sort(samples.begin(), samples.end(), [](
+                const Sample& first,
+                const Sample& second)
+            {
+                return select_timestamp_(first) < select_timestamp_(second);
+            });
+}
+
+//! Sort selected blocks of samples by timestamp
+void sort_by_timestamp_(
+        SampleSpans& samples)
+{
+    sort_by_timestamp_(samples.spans);
+}
+
+//! Summaries do not depend on the order of the samples
+void sort_by_timestamp_(
+        details::RollupBins& /*bins*/)
+{
+}
+
+template<typename Samples>
+void Database::select_(
         DataKind data_type,
         EntityId entity_id_source,
         EntityId entity_id_target,
         Timestamp t_from,
-        Timestamp t_to)
+        Timestamp t_to,
+        Samples& samples)
 {
     /* Check that the given timestamps are consistent */
     if (t_to <= t_from)
@@ -1611,8 +1991,9 @@ std::vector<const StatisticsSample*> Database::select(
     auto source_entity = get_entity(entity_id_source);
     auto target_entity = get_entity(entity_id_target);
 
+    // Insertions on other entities may run concurrently, so only the data of the source entity is locked
     std::shared_lock<std::shared_timed_mutex> lock(mutex_);
-    std::vector<const StatisticsSample*> samples;
+    auto data_lock = lock_entity_data_(source_entity);
     switch (data_type)
     {
         case DataKind::FASTDDS_LATENCY:
@@ -1625,20 +2006,7 @@ std::vector<const StatisticsSample*> Database::select(
             if (reader != writer->data.history2history_latency.end())
             {
                 /* Look for the samples between the given timestamps */
-                // TODO(jlbueno) Knowing that the samples are ordered by timestamp it would be more efficient to
-                // implement a binary search (PR#58 Originally posted by @IkerLuengo in
-                // https://github.com/eProsima/Fast-DDS-statistics-backend/pull/58#discussion_r629383536)
-                for (auto& sample : reader->second)
-                {
-                    if (sample.src_ts >= t_from && sample.src_ts <= t_to)
-                    {
-                        samples.push_back(&sample);
-                    }
-                    else if (sample.src_ts > t_to)
-                    {
-                        break;
-                    }
-                }
+                select_samples_(reader->second, t_from, t_to, samples);
             }
             break;
         }
@@ -1652,17 +2020,7 @@ std::vector<const StatisticsSample*> Database::select(
             if (remote_locator != participant->data.network_latency_per_locator.end())
             {
                 /* Look for the samples between the given timestamps */
-                for (auto& sample : remote_locator->second)
-                {
-                    if (sample.src_ts >= t_from && sample.src_ts <= t_to)
-                    {
-                        samples.push_back(&sample);
-                    }
-                    else if (sample.src_ts > t_to)
-                    {
-                        break;
-                    }
-                }
+                select_samples_(remote_locator->second, t_from, t_to, samples);
             }
             break;
         }
@@ -1676,17 +2034,7 @@ std::vector<const StatisticsSample*> Database::select(
             if (locator != participant->data.rtps_packets_sent.end())
             {
                 /* Look for the samples between the given timestamps */
-                for (auto& sample : locator->second)
-                {
-                    if (sample.src_ts >= t_from && sample.src_ts <= t_to)
-                    {
-                        samples.push_back(&sample);
-                    }
-                    else if (sample.src_ts > t_to)
-                    {
-                        break;
-                    }
-                }
+                select_samples_(locator->second, t_from, t_to, samples);
             }
             break;
         }
@@ -1700,17 +2048,7 @@ std::vector<const StatisticsSample*> Database::select(
             if (locator != participant->data.rtps_bytes_sent.end())
             {
                 /* Look for the samples between the given timestamps */
-                for (auto& sample : locator->second)
-                {
-                    if (sample.src_ts >= t_from && sample.src_ts <= t_to)
-                    {
-                        samples.push_back(&sample);
-                    }
-                    else if (sample.src_ts > t_to)
-                    {
-                        break;
-                    }
-                }
+                select_samples_(locator->second, t_from, t_to, samples);
             }
             break;
         }
@@ -1724,17 +2062,7 @@ std::vector<const StatisticsSample*> Database::select(
             if (locator != participant->data.rtps_packets_lost.end())
             {
                 /* Look for the samples between the given timestamps */
-                for (auto& sample : locator->second)
-                {
-                    if (sample.src_ts >= t_from && sample.src_ts <= t_to)
-                    {
-                        samples.push_back(&sample);
-                    }
-                    else if (sample.src_ts > t_to)
-                    {
-                        break;
-                    }
-                }
+                select_samples_(locator->second, t_from, t_to, samples);
             }
             break;
         }
@@ -1748,17 +2076,7 @@ std::vector<const StatisticsSample*> Database::select(
             if (locator != participant->data.rtps_bytes_lost.end())
             {
                 /* Look for the samples between the given timestamps */
-                for (auto& sample : locator->second)
-                {
-                    if (sample.src_ts >= t_from && sample.src_ts <= t_to)
-                    {
-                        samples.push_back(&sample);
-                    }
-                    else if (sample.src_ts > t_to)
-                    {
-                        break;
-                    }
-                }
+                select_samples_(locator->second, t_from, t_to, samples);
             }
             break;
         }
@@ -1773,17 +2091,7 @@ std::vector<const StatisticsSample*> Database::select(
             if (dds_entity != participant->data.discovered_entity.end())
             {
                 /* Look for the samples between the given timestamps */
-                for (auto& sample : dds_entity->second)
-                {
-                    if (sample.src_ts >= t_from && sample.src_ts <= t_to)
-                    {
-                        samples.push_back(&sample);
-                    }
-                    else if (sample.src_ts > t_to)
-                    {
-                        break;
-                    }
-                }
+                select_samples_(dds_entity->second, t_from, t_to, samples);
             }
             break;
         }
@@ -1792,14 +2100,17 @@ std::vector<const StatisticsSample*> Database::select(
             throw BadParameter("Incorrect DataKind");
         }
     }
-    return samples;
+
+    keep_locked_(samples, source_entity, std::move(data_lock));
 }
 
-std::vector<const StatisticsSample*> Database::select(
+template<typename Samples>
+void Database::select_(
         DataKind data_type,
         EntityId entity_id,
         Timestamp t_from,
-        Timestamp t_to)
+        Timestamp t_to,
+        Samples& samples)
 {
     /* Check that the given timestamps are consistent */
     if (t_to <= t_from)
@@ -1809,8 +2120,9 @@ std::vector<const StatisticsSample*> Database::select(
 
     auto entity = get_entity(entity_id);
 
+    // Insertions on other entities may run concurrently, so only the data of the entity is locked
     std::shared_lock<std::shared_timed_mutex> lock(mutex_);
-    std::vector<const StatisticsSample*> samples;
+    auto data_lock = lock_entity_data_(entity);
     switch (data_type)
     {
         case DataKind::PUBLICATION_THROUGHPUT:
@@ -1818,21 +2130,7 @@ std::vector<const StatisticsSample*> Database::select(
             assert(EntityKind::DATAWRITER == entity->kind);
             auto writer = std::static_pointer_cast<const DataWriter>(entity);
             /* Look for the samples between the given timestamps */
-            // TODO(jlbueno) Knowing that the samples are ordered by timestamp it would be more efficient to
-            // implement a binary search (PR#58 Originally posted by @IkerLuengo in
-            // https://github.com/eProsima/Fast-DDS-statistics-backend/pull/58#discussion_r629383536)
-            for (auto& sample : writer->data.publication_throughput)
-            {
-                /* The data is assumed to be ordered by timestamp */
-                if (sample.src_ts >= t_from && sample.src_ts <= t_to)
-                {
-                    samples.push_back(&sample);
-                }
-                else if (sample.src_ts > t_to)
-                {
-                    break;
-                }
-            }
+            select_samples_(writer->data.publication_throughput, t_from, t_to, samples);
             break;
         }
         case DataKind::SUBSCRIPTION_THROUGHPUT:
@@ -1840,17 +2138,7 @@ std::vector<const StatisticsSample*> Database::select(
             assert(EntityKind::DATAREADER == entity->kind);
             auto reader = std::static_pointer_cast<const DataReader>(entity);
             /* Look for the samples between the given timestamps */
-            for (auto& sample : reader->data.subscription_throughput)
-            {
-                if (sample.src_ts >= t_from && sample.src_ts <= t_to)
-                {
-                    samples.push_back(&sample);
-                }
-                else if (sample.src_ts > t_to)
-                {
-                    break;
-                }
-            }
+            select_samples_(reader->data.subscription_throughput, t_from, t_to, samples);
             break;
         }
         case DataKind::RESENT_DATA:
@@ -1858,17 +2146,7 @@ std::vector<const StatisticsSample*> Database::select(
             assert(EntityKind::DATAWRITER == entity->kind);
             auto writer = std::static_pointer_cast<const DataWriter>(entity);
             /* Look for the samples between the given timestamps */
-            for (auto& sample : writer->data.resent_datas)
-            {
-                if (sample.src_ts >= t_from && sample.src_ts <= t_to)
-                {
-                    samples.push_back(&sample);
-                }
-                else if (sample.src_ts > t_to)
-                {
-                    break;
-                }
-            }
+            select_samples_(writer->data.resent_datas, t_from, t_to, samples);
             break;
         }
         case DataKind::HEARTBEAT_COUNT:
@@ -1876,17 +2154,7 @@ std::vector<const StatisticsSample*> Database::select(
             assert(EntityKind::DATAWRITER == entity->kind);
             auto writer = std::static_pointer_cast<const DataWriter>(entity);
             /* Look for the samples between the given timestamps */
-            for (auto& sample : writer->data.heartbeat_count)
-            {
-                if (sample.src_ts >= t_from && sample.src_ts <= t_to)
-                {
-                    samples.push_back(&sample);
-                }
-                else if (sample.src_ts > t_to)
-                {
-                    break;
-                }
-            }
+            select_samples_(writer->data.heartbeat_count, t_from, t_to, samples);
             break;
         }
         case DataKind::ACKNACK_COUNT:
@@ -1894,17 +2162,7 @@ std::vector<const StatisticsSample*> Database::select(
             assert(EntityKind::DATAREADER == entity->kind);
             auto reader = std::static_pointer_cast<const DataReader>(entity);
             /* Look for the samples between the given timestamps */
-            for (auto& sample : reader->data.acknack_count)
-            {
-                if (sample.src_ts >= t_from && sample.src_ts <= t_to)
-                {
-                    samples.push_back(&sample);
-                }
-                else if (sample.src_ts > t_to)
-                {
-                    break;
-                }
-            }
+            select_samples_(reader->data.acknack_count, t_from, t_to, samples);
             break;
         }
         case DataKind::NACKFRAG_COUNT:
@@ -1912,17 +2170,7 @@ std::vector<const StatisticsSample*> Database::select(
             assert(EntityKind::DATAREADER == entity->kind);
             auto reader = std::static_pointer_cast<const DataReader>(entity);
             /* Look for the samples between the given timestamps */
-            for (auto& sample : reader->data.nackfrag_count)
-            {
-                if (sample.src_ts >= t_from && sample.src_ts <= t_to)
-                {
-                    samples.push_back(&sample);
-                }
-                else if (sample.src_ts > t_to)
-                {
-                    break;
-                }
-            }
+            select_samples_(reader->data.nackfrag_count, t_from, t_to, samples);
             break;
         }
         case DataKind::GAP_COUNT:
@@ -1930,17 +2178,7 @@ std::vector<const StatisticsSample*> Database::select(
             assert(EntityKind::DATAWRITER == entity->kind);
             auto writer = std::static_pointer_cast<const DataWriter>(entity);
             /* Look for the samples between the given timestamps */
-            for (auto& sample : writer->data.gap_count)
-            {
-                if (sample.src_ts >= t_from && sample.src_ts <= t_to)
-                {
-                    samples.push_back(&sample);
-                }
-                else if (sample.src_ts > t_to)
-                {
-                    break;
-                }
-            }
+            select_samples_(writer->data.gap_count, t_from, t_to, samples);
             break;
         }
         case DataKind::DATA_COUNT:
@@ -1948,17 +2186,7 @@ std::vector<const StatisticsSample*> Database::select(
             assert(EntityKind::DATAWRITER == entity->kind);
             auto writer = std::static_pointer_cast<const DataWriter>(entity);
             /* Look for the samples between the given timestamps */
-            for (auto& sample : writer->data.data_count)
-            {
-                if (sample.src_ts >= t_from && sample.src_ts <= t_to)
-                {
-                    samples.push_back(&sample);
-                }
-                else if (sample.src_ts > t_to)
-                {
-                    break;
-                }
-            }
+            select_samples_(writer->data.data_count, t_from, t_to, samples);
             break;
         }
         case DataKind::PDP_PACKETS:
@@ -1966,17 +2194,7 @@ std::vector<const StatisticsSample*> Database::select(
             assert(EntityKind::PARTICIPANT == entity->kind);
             auto participant = std::static_pointer_cast<const DomainParticipant>(entity);
             /* Look for the samples between the given timestamps */
-            for (auto& sample : participant->data.pdp_packets)
-            {
-                if (sample.src_ts >= t_from && sample.src_ts <= t_to)
-                {
-                    samples.push_back(&sample);
-                }
-                else if (sample.src_ts > t_to)
-                {
-                    break;
-                }
-            }
+            select_samples_(participant->data.pdp_packets, t_from, t_to, samples);
             break;
         }
         case DataKind::EDP_PACKETS:
@@ -1984,17 +2202,7 @@ std::vector<const StatisticsSample*> Database::select(
             assert(EntityKind::PARTICIPANT == entity->kind);
             auto participant = std::static_pointer_cast<const DomainParticipant>(entity);
             /* Look for the samples between the given timestamps */
-            for (auto& sample : participant->data.edp_packets)
-            {
-                if (sample.src_ts >= t_from && sample.src_ts <= t_to)
-                {
-                    samples.push_back(&sample);
-                }
-                else if (sample.src_ts > t_to)
-                {
-                    break;
-                }
-            }
+            select_samples_(participant->data.edp_packets, t_from, t_to, samples);
             break;
         }
         case DataKind::SAMPLE_DATAS:
@@ -2005,18 +2213,10 @@ std::vector<const StatisticsSample*> Database::select(
                timestamps. The samples do not need to be ordered by source timestamp so they should be sorted */
             for (auto& sample : writer->data.sample_datas)
             {
-                // Vector only has one element
-                if (sample.second[0].src_ts >= t_from && sample.second[0].src_ts <= t_to)
-                {
-                    samples.push_back(&sample.second[0]);
-                }
+                // Container only has one element
+                select_samples_(sample.second, t_from, t_to, samples);
             }
-            std::sort(samples.begin(), samples.end(), [](
-                        const StatisticsSample* first,
-                        const StatisticsSample* second)
-                    {
-                        return first->src_ts < second->src_ts;
-                    });
+            sort_by_timestamp_(samples);
             break;
         }
         // Any other data_type corresponds to a sample which needs two entities or a DataKind::INVALID
@@ -2025,9 +2225,136 @@ std::vector<const StatisticsSample*> Database::select(
             throw BadParameter("Incorrect DataKind");
         }
     }
+
+    keep_locked_(samples, entity, std::move(data_lock));
+}
+
+std::vector<const StatisticsSample*> Database::select(
+        DataKind data_type,
+        EntityId entity_id_source,
+        EntityId entity_id_target,
+        Timestamp t_from,
+        Timestamp t_to)
+{
+    std::vector<const StatisticsSample*> samples;
+    select_(data_type, entity_id_source, entity_id_target, t_from, t_to, samples);
+    return samples;
+}
+
+std::vector<const StatisticsSample*> Database::select(
+        DataKind data_type,
+        EntityId entity_id,
+        Timestamp t_from,
+        Timestamp t_to)
+{
+    std::vector<const StatisticsSample*> samples;
+    select_(data_type, entity_id, t_from, t_to, samples);
+    return samples;
+}
+
+SampleSpans Database::select_spans(
+        DataKind data_type,
+        EntityId entity_id_source,
+        EntityId entity_id_target,
+        Timestamp t_from,
+        Timestamp t_to)
+{
+    SampleSpans samples;
+    select_(data_type, entity_id_source, entity_id_target, t_from, t_to, samples);
+    return samples;
+}
+
+SampleSpans Database::select_spans(
+        DataKind data_type,
+        EntityId entity_id,
+        Timestamp t_from,
+        Timestamp t_to)
+{
+    SampleSpans samples;
+    select_(data_type, entity_id, t_from, t_to, samples);
     return samples;
 }
 
+void Database::keep_locked_(
+        SampleSpans& samples,
+        const std::shared_ptr<const Entity>& entity,
+        std::shared_lock<std::shared_timed_mutex>&& data_lock)
+{
+    samples.entity_ = entity;
+    samples.data_lock_ = std::move(data_lock);
+}
+
+bool Database::select_summaries(
+        DataKind data_type,
+        EntityId entity_id_source,
+        EntityId entity_id_target,
+        details::RollupBins& bins)
+{
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+        if (rollup_resolutions_.empty() || DataKind::DISCOVERY_TIME == data_type ||
+                DataKind::SAMPLE_DATAS == data_type)
+        {
+            bins.complete = false;
+            return false;
+        }
+    }
+
+    select_(data_type, entity_id_source, entity_id_target, bins.t_from, bins.t_to - Timestamp::duration(1), bins);
+    return bins.complete;
+}
+
+bool Database::select_summaries(
+        DataKind data_type,
+        EntityId entity_id,
+        details::RollupBins& bins)
+{
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+        if (rollup_resolutions_.empty() || DataKind::DISCOVERY_TIME == data_type ||
+                DataKind::SAMPLE_DATAS == data_type)
+        {
+            bins.complete = false;
+            return false;
+        }
+    }
+
+    select_(data_type, entity_id, bins.t_from, bins.t_to - Timestamp::duration(1), bins);
+    return bins.complete;
+}
+
+void Database::set_rollup_resolutions(
+        const std::vector<Timestamp::duration>& resolutions)
+{
+    std::lock_guard<std::shared_timed_mutex> guard(mutex_);
+    rollup_resolutions_ = resolutions;
+
+    for (const auto& super_it : participants_)
+    {
+        for (const auto& it : super_it.second)
+        {
+            std::lock_guard<std::shared_timed_mutex> data_guard(it.second->data.mutex);
+            it.second->data.enable_rollups(resolutions);
+        }
+    }
+    for (const auto& super_it : datawriters_)
+    {
+        for (const auto& it : super_it.second)
+        {
+            std::lock_guard<std::shared_timed_mutex> data_guard(it.second->data.mutex);
+            it.second->data.enable_rollups(resolutions);
+        }
+    }
+    for (const auto& super_it : datareaders_)
+    {
+        for (const auto& it : super_it.second)
+        {
+            std::lock_guard<std::shared_timed_mutex> data_guard(it.second->data.mutex);
+            it.second->data.enable_rollups(resolutions);
+        }
+    }
+}
+
 bool Database::is_entity_present(
         const EntityId& entity_id) const noexcept
 {
@@ -2048,53 +2375,21 @@ std::pair<EntityId, EntityId> Database::get_entity_by_guid(
         EntityKind entity_kind,
         const std::string& guid) const
 {
-    switch (entity_kind)
+    if (EntityKind::PARTICIPANT != entity_kind &&
+            EntityKind::DATAREADER != entity_kind &&
+            EntityKind::DATAWRITER != entity_kind)
     {
-        case EntityKind::PARTICIPANT:
-        {
-            for (const auto& domain_it : participants_)
-            {
-                for (const auto& participant_it : domain_it.second)
-                {
-                    if (participant_it.second->guid == guid)
-                    {
-                        return std::pair<EntityId, EntityId>(domain_it.first, participant_it.first);
-                    }
-                }
-            }
-            break;
-        }
-        case EntityKind::DATAREADER:
-        {
-            for (const auto& domain_it : datareaders_)
-            {
-                for (const auto& datareader_it : domain_it.second)
-                {
-                    if (datareader_it.second->guid == guid)
-                    {
-                        return std::pair<EntityId, EntityId>(domain_it.first, datareader_it.first);
-                    }
-                }
-            }
-            break;
-        }
-        case EntityKind::DATAWRITER:
-        {
-            for (const auto& domain_it : datawriters_)
-            {
-                for (const auto& datawriter_it : domain_it.second)
-                {
-                    if (datawriter_it.second->guid == guid)
-                    {
-                        return std::pair<EntityId, EntityId>(domain_it.first, datawriter_it.first);
-                    }
-                }
-            }
-            break;
-        }
-        default:
+        throw BadParameter("Incorrect EntityKind");
+    }
+
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    auto kind_it = entities_by_guid_.find(entity_kind);
+    if (kind_it != entities_by_guid_.end())
+    {
+        auto guid_it = kind_it->second.find(guid);
+        if (guid_it != kind_it->second.end())
         {
-            throw BadParameter("Incorrect EntityKind");
+            return guid_it->second;
         }
     }
 
@@ -2102,6 +2397,35 @@ std::pair<EntityId, EntityId> Database::get_entity_by_guid(
                       static_cast<int>(entity_kind)) + " and GUID " + guid + " exists");
 }
 
+std::pair<EntityId, EntityId> Database::get_entity_by_guid(
+        EntityKind entity_kind,
+        const fastrtps::rtps::GUID_t& guid) const
+{
+    if (EntityKind::PARTICIPANT != entity_kind &&
+            EntityKind::DATAREADER != entity_kind &&
+            EntityKind::DATAWRITER != entity_kind)
+    {
+        throw BadParameter("Incorrect EntityKind");
+    }
+
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    auto kind_it = entities_by_binary_guid_.find(entity_kind);
+    if (kind_it != entities_by_binary_guid_.end())
+    {
+        auto guid_it = kind_it->second.find(guid);
+        if (guid_it != kind_it->second.end())
+        {
+            return guid_it->second;
+        }
+    }
+
+    // Every GUID string written by Fast DDS is in the binary index, so the entities that are only indexed by their
+    // string cannot match a binary GUID. This is the path of the statistics data of undiscovered entities, so the
+    // GUID is not converted to a string for the message.
+    throw BadParameter("No entity of type " + std::to_string(static_cast<int>(entity_kind)) +
+                  " with the given GUID exists");
+}
+
 EntityKind Database::get_entity_kind(
         EntityId entity_id) const
 {
@@ -2779,36 +3103,234 @@ DatabaseDump Database::dump_database(
     return dump;
 }
 
-DatabaseDump Database::dump_entity_(
-        const std::shared_ptr<Host>& entity)
+/**
+ * Write the members of a JSON object of a dump, without the surrounding braces.
+ */
+void write_dump_members(
+        std::ostream& stream,
+        const DatabaseDump& object)
 {
-    DatabaseDump entity_info = DatabaseDump::object();
-    entity_info[NAME_INFO_TAG] = entity->name;
-    entity_info[ALIAS_INFO_TAG] = entity->alias;
-
-    // metatraffic and active attributes are stored but ignored when loading
-    entity_info[METATRAFFIC_INFO_TAG] = entity->metatraffic;
-    entity_info[ALIVE_INFO_TAG] = entity->active;
-
-    // Populate subentity array
+    for (auto it = object.begin(); it != object.end(); ++it)
     {
-        DatabaseDump subentities = DatabaseDump::array();
-        for (const auto& sub_it : entity->users)
+        if (it != object.begin())
         {
-            subentities.push_back(id_to_string(sub_it.first));
+            stream << ',';
         }
-        entity_info[USER_CONTAINER_TAG] = subentities;
+        stream << DatabaseDump(it.key()) << ':' << it.value();
     }
-
-    return entity_info;
 }
 
-DatabaseDump Database::dump_entity_(
-        const std::shared_ptr<User>& entity)
+template<typename T, typename Functor>
+void write_dump_entities(
+        std::ostream& stream,
+        const std::map<EntityId, std::shared_ptr<T>>& entities,
+        Functor dump_entity,
+        bool& first)
 {
-    DatabaseDump entity_info = DatabaseDump::object();
-    entity_info[NAME_INFO_TAG] = entity->name;
-    entity_info[ALIAS_INFO_TAG] = entity->alias;
+    for (const auto& it : entities)
+    {
+        if (!first)
+        {
+            stream << ',';
+        }
+        first = false;
+        stream << '"' << it.first.value() << "\":";
+        dump_entity(it.second);
+    }
+}
+
+template<typename T, typename Functor>
+void write_dump_entities(
+        std::ostream& stream,
+        const std::map<EntityId, std::map<EntityId, std::shared_ptr<T>>>& entities_by_domain,
+        Functor dump_entity,
+        bool& first)
+{
+    for (const auto& it : entities_by_domain)
+    {
+        write_dump_entities(stream, it.second, dump_entity, first);
+    }
+}
+
+/**
+ * Write a container of a dump, calling \c dump_entity to write each of its entities.
+ */
+template<typename Entities, typename Functor>
+void write_dump_container(
+        std::ostream& stream,
+        const char* tag,
+        const Entities& entities,
+        Functor dump_entity)
+{
+    stream << ',' << DatabaseDump(tag) << ":{";
+    bool first = true;
+    write_dump_entities(stream, entities, dump_entity, first);
+    stream << '}';
+}
+
+void Database::dump_database(
+        std::ostream& stream,
+        const bool clear)
+{
+    // The dump only reads the database, so the statistics data can still be inserted meanwhile.
+    // Clearing the data afterwards needs the exclusive lock during the whole dump, so no sample is lost.
+    std::shared_lock<std::shared_timed_mutex> shared_lock(mutex_, std::defer_lock);
+    std::unique_lock<std::shared_timed_mutex> exclusive_lock(mutex_, std::defer_lock);
+    if (clear)
+    {
+        exclusive_lock.lock();
+    }
+    else
+    {
+        shared_lock.lock();
+    }
+
+    // Add version
+    stream << '{' << DatabaseDump(VERSION_TAG) << ':' << DatabaseDump(ACTUAL_DUMP_VERSION);
+
+    dump_entities_nts_(stream, DumpWatermark());
+
+    stream << '}';
+
+    if (clear)
+    {
+        // Clear all
+        clear_statistics_data_nts_(the_end_of_time());
+    }
+}
+
+/**
+ * Get the dump of a watermark of an incremental dump.
+ */
+DatabaseDump dump_watermark(
+        const DumpWatermark& watermark)
+{
+    DatabaseDump dump = DatabaseDump::object();
+    dump[WATERMARK_EPOCH_TAG] = std::to_string(watermark.epoch);
+    dump[WATERMARK_NEXT_ENTITY_TAG] = std::to_string(watermark.next_entity_id);
+    return dump;
+}
+
+/**
+ * Get a watermark of an incremental dump from its dump.
+ *
+ * @throws eprosima::statistics_backend::CorruptedFile if the dump is not a watermark.
+ */
+DumpWatermark load_watermark(
+        const DatabaseDump& dump)
+{
+    try
+    {
+        DumpWatermark watermark;
+        watermark.epoch = std::stoull(dump.at(WATERMARK_EPOCH_TAG).get<std::string>());
+        watermark.next_entity_id = std::stoll(dump.at(WATERMARK_NEXT_ENTITY_TAG).get<std::string>());
+        return watermark;
+    }
+    catch (const std::exception& e)
+    {
+        throw CorruptedFile(std::string("Wrong watermark in the incremental dump: ") + e.what());
+    }
+}
+
+DumpWatermark Database::dump_database_delta(
+        std::ostream& stream,
+        const DumpWatermark& since)
+{
+    // The exclusive lock keeps samples from being inserted during the dump, so the samples inserted in the epoch
+    // that ends here are all written, and the ones inserted after it belong to the next epoch
+    std::lock_guard<std::shared_timed_mutex> guard(mutex_);
+
+    DumpWatermark until;
+    until.next_entity_id = next_id_;
+    uint64_t epoch = insertion_epoch_++;
+
+    // The watermark of the previous dump goes before the entities, so they can be merged as they are read
+    stream << '{' << DatabaseDump(VERSION_TAG) << ':' << DatabaseDump(ACTUAL_DUMP_VERSION);
+    stream << ',' << DatabaseDump(DELTA_SINCE_TAG) << ':' << dump_watermark(since);
+
+    // Without new samples, the watermark does not need to move
+    until.epoch = dump_entities_nts_(stream, since) ? epoch : since.epoch;
+
+    stream << ',' << DatabaseDump(DELTA_UNTIL_TAG) << ':' << dump_watermark(until) << '}';
+
+    return until;
+}
+
+bool Database::dump_entities_nts_(
+        std::ostream& stream,
+        const DumpWatermark& since)
+{
+    bool written = false;
+
+    auto dump_entity = [&](const auto& entity)
+            {
+                stream << dump_entity_(entity);
+            };
+
+    // The statistics data is written one sample at a time, under the mutex of the data of the entity.
+    // The entities created after the previous dump have all their data written.
+    auto dump_entity_and_data = [&](const auto& entity)
+            {
+                SampleDumpRange range;
+                if (entity->id.value() < since.next_entity_id)
+                {
+                    range.since = since.epoch;
+                }
+
+                stream << '{';
+                write_dump_members(stream, dump_entity_(entity, false));
+                stream << ',' << DatabaseDump(DATA_CONTAINER_TAG) << ':';
+                std::shared_lock<std::shared_timed_mutex> data_lock(entity->data.mutex);
+                dump_data_(stream, entity->data, range);
+                stream << '}';
+
+                written = written || range.written;
+            };
+
+    // The containers are written in the order in which they are loaded, so they can be loaded as they are read
+    write_dump_container(stream, LOCATOR_CONTAINER_TAG, locators_, dump_entity);
+    write_dump_container(stream, HOST_CONTAINER_TAG, hosts_, dump_entity);
+    write_dump_container(stream, USER_CONTAINER_TAG, users_, dump_entity);
+    write_dump_container(stream, PROCESS_CONTAINER_TAG, processes_, dump_entity);
+    write_dump_container(stream, DOMAIN_CONTAINER_TAG, domains_, dump_entity);
+    write_dump_container(stream, TOPIC_CONTAINER_TAG, topics_, dump_entity);
+    write_dump_container(stream, PARTICIPANT_CONTAINER_TAG, participants_, dump_entity_and_data);
+    write_dump_container(stream, DATAWRITER_CONTAINER_TAG, datawriters_, dump_entity_and_data);
+    write_dump_container(stream, DATAREADER_CONTAINER_TAG, datareaders_, dump_entity_and_data);
+
+    return written;
+}
+
+DatabaseDump Database::dump_entity_(
+        const std::shared_ptr<Host>& entity)
+{
+    DatabaseDump entity_info = DatabaseDump::object();
+    entity_info[NAME_INFO_TAG] = entity->name;
+    entity_info[ALIAS_INFO_TAG] = entity->alias;
+
+    // metatraffic and active attributes are stored but ignored when loading
+    entity_info[METATRAFFIC_INFO_TAG] = entity->metatraffic;
+    entity_info[ALIVE_INFO_TAG] = entity->active;
+
+    // Populate subentity array
+    {
+        DatabaseDump subentities = DatabaseDump::array();
+        for (const auto& sub_it : entity->users)
+        {
+            subentities.push_back(id_to_string(sub_it.first));
+        }
+        entity_info[USER_CONTAINER_TAG] = subentities;
+    }
+
+    return entity_info;
+}
+
+DatabaseDump Database::dump_entity_(
+        const std::shared_ptr<User>& entity)
+{
+    DatabaseDump entity_info = DatabaseDump::object();
+    entity_info[NAME_INFO_TAG] = entity->name;
+    entity_info[ALIAS_INFO_TAG] = entity->alias;
 
     entity_info[HOST_ENTITY_TAG] = id_to_string(entity->host->id);
 
@@ -2928,7 +3450,8 @@ DatabaseDump Database::dump_entity_(
 }
 
 DatabaseDump Database::dump_entity_(
-        const std::shared_ptr<DomainParticipant>& entity)
+        const std::shared_ptr<DomainParticipant>& entity,
+        const bool include_data /* = true */)
 {
     DatabaseDump entity_info = DatabaseDump::object();
     entity_info[NAME_INFO_TAG] = entity->name;
@@ -2971,6 +3494,7 @@ DatabaseDump Database::dump_entity_(
     }
 
     // Store data from the entity
+    if (include_data)
     {
         DatabaseDump data = DatabaseDump::object();
 
@@ -3027,7 +3551,8 @@ DatabaseDump Database::dump_entity_(
 }
 
 DatabaseDump Database::dump_entity_(
-        const std::shared_ptr<DataWriter>& entity)
+        const std::shared_ptr<DataWriter>& entity,
+        const bool include_data /* = true */)
 {
     DatabaseDump entity_info = DatabaseDump::object();
     entity_info[NAME_INFO_TAG] = entity->name;
@@ -3054,6 +3579,7 @@ DatabaseDump Database::dump_entity_(
     }
 
     // Store data from the entity
+    if (include_data)
     {
         DatabaseDump data = DatabaseDump::object();
 
@@ -3097,7 +3623,8 @@ DatabaseDump Database::dump_entity_(
 }
 
 DatabaseDump Database::dump_entity_(
-        const std::shared_ptr<DataReader>& entity)
+        const std::shared_ptr<DataReader>& entity,
+        const bool include_data /* = true */)
 {
     DatabaseDump entity_info = DatabaseDump::object();
     entity_info[NAME_INFO_TAG] = entity->name;
@@ -3124,6 +3651,7 @@ DatabaseDump Database::dump_entity_(
     }
 
     // Store data from the entity
+    if (include_data)
     {
         DatabaseDump data = DatabaseDump::object();
 
@@ -3193,12 +3721,7 @@ DatabaseDump Database::dump_data_(
 
         for (const auto& sample : it.second)
         {
-            DatabaseDump value = DatabaseDump::object();
-            value[DATA_VALUE_SRC_TIME_TAG] = time_to_string(sample.src_ts);
-            value[DATA_VALUE_COUNT_TAG] = sample.count;
-            value[DATA_VALUE_MAGNITUDE_TAG] = sample.magnitude_order;
-
-            samples.push_back(value);
+            samples.push_back(dump_data_(sample));
         }
 
         data_dump[id_to_string(it.first.value())] = samples;
@@ -3218,11 +3741,7 @@ DatabaseDump Database::dump_data_(
 
         for (const auto& sample : it.second)
         {
-            DatabaseDump value = DatabaseDump::object();
-            value[DATA_VALUE_SRC_TIME_TAG] = time_to_string(sample.src_ts);
-            value[DATA_VALUE_COUNT_TAG] = sample.count;
-
-            samples.push_back(value);
+            samples.push_back(dump_data_(sample));
         }
 
         data_dump[id_to_string(it.first.value())] = samples;
@@ -3242,11 +3761,7 @@ DatabaseDump Database::dump_data_(
 
         for (const auto& sample : it.second)
         {
-            DatabaseDump value = DatabaseDump::object();
-            value[DATA_VALUE_SRC_TIME_TAG] = time_to_string(sample.src_ts);
-            value[DATA_VALUE_DATA_TAG] = sample.data;
-
-            samples.push_back(value);
+            samples.push_back(dump_data_(sample));
         }
 
         data_dump[id_to_string(it.first.value())] = samples;
@@ -3266,13 +3781,7 @@ DatabaseDump Database::dump_data_(
 
         for (const auto& sample : it.second)
         {
-            DatabaseDump value = DatabaseDump::object();
-            value[DATA_VALUE_SRC_TIME_TAG] = time_to_string(sample.src_ts);
-            value[DATA_VALUE_TIME_TAG] = time_to_string(sample.time);
-            value[DATA_VALUE_REMOTE_ENTITY_TAG] = id_to_string(sample.remote_entity.value());
-            value[DATA_VALUE_DISCOVERED_TAG] = sample.discovered;
-
-            samples.push_back(value);
+            samples.push_back(dump_data_(sample));
         }
 
         data_dump[id_to_string(it.first.value())] = samples;
@@ -3292,11 +3801,7 @@ DatabaseDump Database::dump_data_(
 
         for (const auto& sample : it.second)
         {
-            DatabaseDump value = DatabaseDump::object();
-            value[DATA_VALUE_SRC_TIME_TAG] = time_to_string(sample.src_ts);
-            value[DATA_VALUE_COUNT_TAG] = sample.count;
-
-            samples.push_back(value);
+            samples.push_back(dump_data_(sample));
         }
 
         data_dump[id_to_string(it.first)] = samples;
@@ -3312,11 +3817,7 @@ DatabaseDump Database::dump_data_(
 
     for (const auto& it : data)
     {
-        DatabaseDump value = DatabaseDump::object();
-        value[DATA_VALUE_SRC_TIME_TAG] = time_to_string(it.src_ts);
-        value[DATA_VALUE_COUNT_TAG] = it.count;
-
-        data_dump.push_back(value);
+        data_dump.push_back(dump_data_(it));
     }
 
     return data_dump;
@@ -3329,11 +3830,7 @@ DatabaseDump Database::dump_data_(
 
     for (const auto& it : data)
     {
-        DatabaseDump value = DatabaseDump::object();
-        value[DATA_VALUE_SRC_TIME_TAG] = time_to_string(it.src_ts);
-        value[DATA_VALUE_DATA_TAG] = it.data;
-
-        data_dump.push_back(value);
+        data_dump.push_back(dump_data_(it));
     }
 
     return data_dump;
@@ -3360,6 +3857,28 @@ DatabaseDump Database::dump_data_(
     return data_dump;
 }
 
+DatabaseDump Database::dump_data_(
+        const EntityDataSample& data)
+{
+    DatabaseDump data_dump = DatabaseDump::object();
+    data_dump[DATA_VALUE_SRC_TIME_TAG] = time_to_string(data.src_ts);
+    data_dump[DATA_VALUE_DATA_TAG] = data.data;
+
+    return data_dump;
+}
+
+DatabaseDump Database::dump_data_(
+        const DiscoveryTimeSample& data)
+{
+    DatabaseDump data_dump = DatabaseDump::object();
+    data_dump[DATA_VALUE_SRC_TIME_TAG] = time_to_string(data.src_ts);
+    data_dump[DATA_VALUE_TIME_TAG] = time_to_string(data.time);
+    data_dump[DATA_VALUE_REMOTE_ENTITY_TAG] = id_to_string(data.remote_entity.value());
+    data_dump[DATA_VALUE_DISCOVERED_TAG] = data.discovered;
+
+    return data_dump;
+}
+
 DatabaseDump Database::dump_data_(
         const std::map<EntityId, EntityCountSample>& data)
 {
@@ -3386,6 +3905,182 @@ DatabaseDump Database::dump_data_(
     return data_dump;
 }
 
+void Database::dump_data_(
+        std::ostream& stream,
+        const DomainParticipantData& data,
+        SampleDumpRange& range)
+{
+    stream << '{';
+
+    // discovered_entity
+    stream << DatabaseDump(DATA_KIND_DISCOVERY_TIME_TAG) << ':';
+    dump_data_(stream, data.discovered_entity, range);
+
+    // pdp_packets
+    stream << ',' << DatabaseDump(DATA_KIND_PDP_PACKETS_TAG) << ':';
+    dump_data_(stream, data.pdp_packets, range);
+
+    // edp_packets
+    stream << ',' << DatabaseDump(DATA_KIND_EDP_PACKETS_TAG) << ':';
+    dump_data_(stream, data.edp_packets, range);
+
+    // rtps_packets_sent
+    stream << ',' << DatabaseDump(DATA_KIND_RTPS_PACKETS_SENT_TAG) << ':';
+    dump_data_(stream, data.rtps_packets_sent, range);
+
+    // rtps_bytes_sent
+    stream << ',' << DatabaseDump(DATA_KIND_RTPS_BYTES_SENT_TAG) << ':';
+    dump_data_(stream, data.rtps_bytes_sent, range);
+
+    // rtps_packets_lost
+    stream << ',' << DatabaseDump(DATA_KIND_RTPS_PACKETS_LOST_TAG) << ':';
+    dump_data_(stream, data.rtps_packets_lost, range);
+
+    // rtps_bytes_lost
+    stream << ',' << DatabaseDump(DATA_KIND_RTPS_BYTES_LOST_TAG) << ':';
+    dump_data_(stream, data.rtps_bytes_lost, range);
+
+    // network_latency_per_locator
+    stream << ',' << DatabaseDump(DATA_KIND_NETWORK_LATENCY_TAG) << ':';
+    dump_data_(stream, data.network_latency_per_locator, range);
+
+    // The last reported samples hold a single sample per series
+    stream << ',' << DatabaseDump(DATA_KIND_PDP_PACKETS_LAST_REPORTED_TAG) << ':'
+           << dump_data_(data.last_reported_pdp_packets);
+    stream << ',' << DatabaseDump(DATA_KIND_EDP_PACKETS_LAST_REPORTED_TAG) << ':'
+           << dump_data_(data.last_reported_edp_packets);
+    stream << ',' << DatabaseDump(DATA_KIND_RTPS_PACKETS_SENT_LAST_REPORTED_TAG) << ':'
+           << dump_data_(data.last_reported_rtps_packets_sent_count);
+    stream << ',' << DatabaseDump(DATA_KIND_RTPS_BYTES_SENT_LAST_REPORTED_TAG) << ':'
+           << dump_data_(data.last_reported_rtps_bytes_sent_count);
+    stream << ',' << DatabaseDump(DATA_KIND_RTPS_PACKETS_LOST_LAST_REPORTED_TAG) << ':'
+           << dump_data_(data.last_reported_rtps_packets_lost_count);
+    stream << ',' << DatabaseDump(DATA_KIND_RTPS_BYTES_LOST_LAST_REPORTED_TAG) << ':'
+           << dump_data_(data.last_reported_rtps_bytes_lost_count);
+
+    stream << '}';
+}
+
+void Database::dump_data_(
+        std::ostream& stream,
+        const DataWriterData& data,
+        SampleDumpRange& range)
+{
+    stream << '{';
+
+    // publication_throughput
+    stream << DatabaseDump(DATA_KIND_PUBLICATION_THROUGHPUT_TAG) << ':';
+    dump_data_(stream, data.publication_throughput, range);
+
+    // resent_datas
+    stream << ',' << DatabaseDump(DATA_KIND_RESENT_DATA_TAG) << ':';
+    dump_data_(stream, data.resent_datas, range);
+
+    // heartbeat_count
+    stream << ',' << DatabaseDump(DATA_KIND_HEARTBEAT_COUNT_TAG) << ':';
+    dump_data_(stream, data.heartbeat_count, range);
+
+    // gap_count
+    stream << ',' << DatabaseDump(DATA_KIND_GAP_COUNT_TAG) << ':';
+    dump_data_(stream, data.gap_count, range);
+
+    // data_count
+    stream << ',' << DatabaseDump(DATA_KIND_DATA_COUNT_TAG) << ':';
+    dump_data_(stream, data.data_count, range);
+
+    // sample_datas
+    stream << ',' << DatabaseDump(DATA_KIND_SAMPLE_DATAS_TAG) << ':';
+    dump_data_(stream, data.sample_datas, range);
+
+    // history2history_latency
+    stream << ',' << DatabaseDump(DATA_KIND_FASTDDS_LATENCY_TAG) << ':';
+    dump_data_(stream, data.history2history_latency, range);
+
+    // The last reported samples hold a single sample per series
+    stream << ',' << DatabaseDump(DATA_KIND_RESENT_DATA_LAST_REPORTED_TAG) << ':'
+           << dump_data_(data.last_reported_resent_datas);
+    stream << ',' << DatabaseDump(DATA_KIND_HEARTBEAT_COUNT_LAST_REPORTED_TAG) << ':'
+           << dump_data_(data.last_reported_heartbeat_count);
+    stream << ',' << DatabaseDump(DATA_KIND_GAP_COUNT_LAST_REPORTED_TAG) << ':'
+           << dump_data_(data.last_reported_gap_count);
+    stream << ',' << DatabaseDump(DATA_KIND_DATA_COUNT_LAST_REPORTED_TAG) << ':'
+           << dump_data_(data.last_reported_data_count);
+
+    stream << '}';
+}
+
+void Database::dump_data_(
+        std::ostream& stream,
+        const DataReaderData& data,
+        SampleDumpRange& range)
+{
+    stream << '{';
+
+    // subscription_throughput
+    stream << DatabaseDump(DATA_KIND_SUBSCRIPTION_THROUGHPUT_TAG) << ':';
+    dump_data_(stream, data.subscription_throughput, range);
+
+    // acknack_count
+    stream << ',' << DatabaseDump(DATA_KIND_ACKNACK_COUNT_TAG) << ':';
+    dump_data_(stream, data.acknack_count, range);
+
+    // nackfrag_count
+    stream << ',' << DatabaseDump(DATA_KIND_NACKFRAG_COUNT_TAG) << ':';
+    dump_data_(stream, data.nackfrag_count, range);
+
+    // The last reported samples hold a single sample per series
+    stream << ',' << DatabaseDump(DATA_KIND_ACKNACK_COUNT_LAST_REPORTED_TAG) << ':'
+           << dump_data_(data.last_reported_acknack_count);
+    stream << ',' << DatabaseDump(DATA_KIND_NACKFRAG_COUNT_LAST_REPORTED_TAG) << ':'
+           << dump_data_(data.last_reported_nackfrag_count);
+
+    stream << '}';
+}
+
+template<typename T>
+void Database::dump_data_(
+        std::ostream& stream,
+        const details::DataContainer<T>& data,
+        SampleDumpRange& range)
+{
+    // The samples are inserted at the end, so the ones inserted after the epoch follow the first of them
+    auto first = data.inserted_after(range.since);
+
+    stream << '[';
+    for (auto it = first; it != data.end(); ++it)
+    {
+        if (it != first)
+        {
+            stream << ',';
+        }
+        stream << dump_data_(*it);
+    }
+    stream << ']';
+
+    range.written = range.written || first != data.end();
+}
+
+template<typename K, typename T>
+void Database::dump_data_(
+        std::ostream& stream,
+        const std::map<K, details::DataContainer<T>>& data,
+        SampleDumpRange& range)
+{
+    stream << '{';
+    bool first = true;
+    for (const auto& it : data)
+    {
+        if (!first)
+        {
+            stream << ',';
+        }
+        first = false;
+        stream << DatabaseDump(id_to_string(it.first)) << ':';
+        dump_data_(stream, it.second, range);
+    }
+    stream << '}';
+}
+
 void Database::clear_statistics_data(
         const Timestamp& t_to)
 {
@@ -3402,6 +4097,7 @@ void Database::clear_statistics_data_nts_(
         // For each entity of this kind in the domain
         for (const auto& it : super_it.second)
         {
+            std::lock_guard<std::shared_timed_mutex> data_guard(it.second->data.mutex);
             it.second->data.clear(t_to, false);
         }
     }
@@ -3411,6 +4107,7 @@ void Database::clear_statistics_data_nts_(
         // For each entity of this kind in the domain
         for (const auto& it : super_it.second)
         {
+            std::lock_guard<std::shared_timed_mutex> data_guard(it.second->data.mutex);
             it.second->data.clear(t_to, false);
         }
     }
@@ -3420,6 +4117,7 @@ void Database::clear_statistics_data_nts_(
         // For each entity of this kind in the domain
         for (const auto& it : super_it.second)
         {
+            std::lock_guard<std::shared_timed_mutex> data_guard(it.second->data.mutex);
             it.second->data.clear(t_to, false);
         }
     }
@@ -3433,18 +4131,24 @@ void Database::clear_inactive_entities()
 
 void Database::clear_inactive_entities_nts_()
 {
+    // Every removed entity must be removed from the lookup indexes as well
+    auto unindex = [this](const std::shared_ptr<Entity>& entity)
+            {
+                unindex_entity_nts_(entity);
+            };
+
     // Physical entities
-    clear_inactive_entities_from_map_(hosts_);
-    clear_inactive_entities_from_map_(users_);
-    clear_inactive_entities_from_map_(processes_);
+    clear_inactive_entities_from_map_(hosts_, unindex);
+    clear_inactive_entities_from_map_(users_, unindex);
+    clear_inactive_entities_from_map_(processes_, unindex);
 
     // DDS entities
-    clear_inactive_entities_from_map_(participants_);
-    clear_inactive_entities_from_map_(datawriters_);
-    clear_inactive_entities_from_map_(datareaders_);
+    clear_inactive_entities_from_map_(participants_, unindex);
+    clear_inactive_entities_from_map_(datawriters_, unindex);
+    clear_inactive_entities_from_map_(datareaders_, unindex);
 
     // Logic entities
-    clear_inactive_entities_from_map_(topics_);
+    clear_inactive_entities_from_map_(topics_, unindex);
 
     // Domain and Locators are not affected
 
@@ -3452,376 +4156,1269 @@ void Database::clear_inactive_entities_nts_()
     clear_internal_references_nts_();
 }
 
-/**
- * @brief Check that in the 'dump', the references of the entity iterator 'it' of type 'entity_tag'
- * to entities of type 'reference_tag' are consistent and mutual. For this, the referenced entities must
- * have reference to 'it' of type 'entity_tag'.
- *
- * Example -> Check that each user, reference host[0]:
- *
- * \code
- * {
- *      host["0"]
- *      {
- *          users: ["1","5","9"]
- *      }
- *      user["1"]
- *      {
- *          host: "0"
- *      }
- * }
- * \endcode
- *
- * @param dump reference to the database dump.
- * @param it iterator to the dump of the entity.
- * @param entity_tag Type of the entity to check.
- * @param reference_tag Type of the referenced entity to check.
- * @throws eprosima::statistics_backend::FileCorrupted if the references are not consistent and mutual.
- */
-void check_entity_contains_all_references(
-        DatabaseDump const& dump,
-        nlohmann::json::iterator const& it,
-        std::string const& entity_tag,
-        std::string const& reference_container_tag,
-        std::string const& reference_tag)
+void Database::set_retention_policy(
+        const RetentionPolicy& policy)
 {
-    std::string entity_id = it.key();
-    DatabaseDump references_id = (*it).at(reference_tag);
-    DatabaseDump reference_container = dump.at(reference_container_tag);
-
-    // Check all 'references_id' in the 'reference_container'
-    for (auto refIt = references_id.begin(); refIt != references_id.end(); ++refIt)
+    if (policy.slice_duration <= std::chrono::microseconds::zero())
     {
-        std::string referenced_id = *refIt;
-
-        // 1) Check that the 'referenced_id' entity exists.
-        if (!reference_container.contains(referenced_id))
-        {
-            throw CorruptedFile(
-                      "Entity container: " + reference_container.dump() + " do not have a Entity with ID: " +
-                      referenced_id);
-        }
-
-        // 2) Check that referenced entity contains a reference to an 'entity_id' of type 'entity_tag'.
-        std::vector<std::string> referenced_entities;
-        auto referenced_entities_json = reference_container.at(referenced_id).at(entity_tag);
-        if (referenced_entities_json.is_array())
-        {
-            referenced_entities.insert(referenced_entities.end(),
-                    referenced_entities_json.begin(),
-                    referenced_entities_json.end());
-        }
-        else
-        {
-            referenced_entities.push_back(referenced_entities_json.get<std::string>());
-        }
-
-        if (std::find(referenced_entities.begin(), referenced_entities.end(), entity_id) == referenced_entities.end())
+        throw BadParameter("The slice duration of a retention policy must be positive");
+    }
+    if (policy.enforcement_period <= std::chrono::milliseconds::zero())
+    {
+        throw BadParameter("The enforcement period of a retention policy must be positive");
+    }
+    for (const auto& max_age : policy.max_age)
+    {
+        if (max_age.second < Timestamp::duration::zero())
         {
-            throw CorruptedFile("Entity with ID (" + referenced_id + ") :" + reference_container.at(
-                              referenced_id).dump() +
-                          " has reference to " + entity_tag + ": " +
-                          reference_container.at(referenced_id).at(entity_tag).dump() +
-                          " instead of " + entity_tag + ": " + entity_id);
+            throw BadParameter("The maximum age of the data of a retention policy cannot be negative");
         }
     }
+
+    std::lock_guard<std::shared_timed_mutex> guard(mutex_);
+    retention_policy_ = policy;
+    retention_enabled_ = policy.enabled();
+    retention_period_ = policy.enforcement_period.count();
+
+    // Start a new visit with the new limits
+    retention_pending_.clear();
+    retention_visited_memory_ = 0;
+    retention_memory_ = 0;
+    retention_eviction_ratio_ = 0.0;
 }
 
-void Database::load_database(
-        const DatabaseDump& dump)
+bool Database::enforce_retention()
 {
-    std::lock_guard<std::shared_timed_mutex> guard (mutex_);
-
-    if (next_id_ != 0)
+    if (!retention_enabled_)
     {
-        throw PreconditionNotMet("Error: Database not empty");
+        return true;
     }
 
-    // Locators
+    std::lock_guard<std::shared_timed_mutex> guard(mutex_);
+    auto deadline = std::chrono::steady_clock::now() + retention_policy_.slice_duration;
+
+    if (retention_pending_.empty())
     {
-        DatabaseDump container = dump.at(LOCATOR_CONTAINER_TAG);
-        for (auto it = container.begin(); it != container.end(); ++it)
+        // Start a new visit, removing in it the proportion of the data that exceeds the budget on the last visit
+        retention_eviction_ratio_ = 0.0;
+        if (0 != retention_policy_.memory_budget && retention_memory_ > retention_policy_.memory_budget)
         {
-            // Check that entity has correct references to other entities
-            check_entity_contains_all_references(dump, it, LOCATOR_CONTAINER_TAG, DATAWRITER_CONTAINER_TAG,
-                    DATAWRITER_CONTAINER_TAG);
-            check_entity_contains_all_references(dump, it, LOCATOR_CONTAINER_TAG, DATAREADER_CONTAINER_TAG,
-                    DATAREADER_CONTAINER_TAG);
-
-            // Create entity
-            std::shared_ptr<Locator> entity = std::make_shared<Locator>((*it).at(NAME_INFO_TAG));
-            entity->alias = (*it).at(ALIAS_INFO_TAG);
-
-            // Insert into database
-            EntityId entity_id = EntityId(string_to_int(it.key()));
-            insert_nts(entity, entity_id);
+            retention_eviction_ratio_ = static_cast<double>(retention_memory_ - retention_policy_.memory_budget) /
+                    static_cast<double>(retention_memory_);
         }
-    }
+        retention_visited_memory_ = 0;
 
-    // Hosts
+        // The entities are visited from the back of the collection
+        for (const auto& super_it : datareaders_)
+        {
+            for (const auto& it : super_it.second)
+            {
+                retention_pending_.push_back(it.second);
+            }
+        }
+        for (const auto& super_it : datawriters_)
+        {
+            for (const auto& it : super_it.second)
+            {
+                retention_pending_.push_back(it.second);
+            }
+        }
+        for (const auto& super_it : participants_)
+        {
+            for (const auto& it : super_it.second)
+            {
+                retention_pending_.push_back(it.second);
+            }
+        }
+    }
+
+    Timestamp now = std::chrono::system_clock::now();
+    while (!retention_pending_.empty())
     {
-        DatabaseDump container = dump.at(HOST_CONTAINER_TAG);
+        std::shared_ptr<Entity> entity = retention_pending_.back().lock();
+        retention_pending_.pop_back();
 
-        // For each entity of this kind in the database
-        for (auto it = container.begin(); it != container.end(); ++it)
+        // Entities removed from the database since the visit started are skipped
+        Data* data = nullptr;
+        if (entity)
+        {
+            switch (entity->kind)
+            {
+                case EntityKind::PARTICIPANT:
+                    data = &std::static_pointer_cast<DomainParticipant>(entity)->data;
+                    break;
+                case EntityKind::DATAWRITER:
+                    data = &std::static_pointer_cast<DataWriter>(entity)->data;
+                    break;
+                case EntityKind::DATAREADER:
+                    data = &std::static_pointer_cast<DataReader>(entity)->data;
+                    break;
+                default:
+                    break;
+            }
+        }
+        if (nullptr != data)
+        {
+            std::lock_guard<std::shared_timed_mutex> data_guard(data->mutex);
+            data->enforce_retention(retention_policy_, now, retention_eviction_ratio_);
+            retention_visited_memory_ += data->memory_usage();
+        }
+
+        if (std::chrono::steady_clock::now() >= deadline)
         {
-            // Check that entity has correct references to other entities
-            check_entity_contains_all_references(dump, it, HOST_ENTITY_TAG, USER_CONTAINER_TAG, USER_CONTAINER_TAG);
+            break;
+        }
+    }
+
+    if (retention_pending_.empty())
+    {
+        retention_memory_ = retention_visited_memory_;
+        return true;
+    }
+    return false;
+}
+
+bool Database::retention_enabled() const
+{
+    return retention_enabled_.load();
+}
+
+std::chrono::milliseconds Database::retention_period() const
+{
+    return std::chrono::milliseconds(retention_period_.load());
+}
+
+std::size_t Database::retained_memory_usage() const
+{
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    return retention_memory_;
+}
+
+/**
+ * @brief Index of the references that the entities of a database dump hold to other entities.
+ *
+ * For each pair of referenced container and reference tag, the references of each referenced entity
+ * are gathered in a hash set. This way, each reference of the dump is copied once, instead of copying
+ * the whole referenced container for every entity checked.
+ *
+ * When the whole dump is available, the references of an entity are gathered the first time that entity
+ * is referenced. When the dump is read as a stream, the references of each entity are added as the entity is read,
+ * and the checks of references to entities that have not been read yet are kept until the end of the dump.
+ */
+class DumpReferences
+{
+public:
 
-            // Create entity
-            std::shared_ptr<Host> entity = std::make_shared<Host>((*it).at(NAME_INFO_TAG));
-            entity->alias = (*it).at(ALIAS_INFO_TAG);
+    //! Index the references of a whole database dump
+    DumpReferences(
+            DatabaseDump const& dump)
+        : dump_(&dump)
+    {
+    }
+
+    //! Index the references of a database dump whose entities are added as they are read
+    DumpReferences()
+        : dump_(nullptr)
+    {
+    }
 
-            // Insert into database
-            EntityId entity_id = EntityId(string_to_int(it.key()));
-            insert_nts(entity, entity_id);
+    /**
+     * @brief Add the references of an entity read from a streamed dump.
+     *
+     * @param container_tag Container of the entity.
+     * @param entity_id ID of the entity.
+     * @param entity Dump of the entity.
+     */
+    void add(
+            std::string const& container_tag,
+            std::string const& entity_id,
+            DatabaseDump const& entity)
+    {
+        for (const char* entity_tag : reference_tags(container_tag))
+        {
+            gather(references_[container_tag + "/" + entity_tag][entity_id], entity.at(entity_tag));
         }
     }
 
-    // Users
+    //! Mark that every entity of a container of a streamed dump has been added
+    void complete(
+            std::string const& container_tag)
     {
-        DatabaseDump container = dump.at(USER_CONTAINER_TAG);
+        completed_containers_.insert(container_tag);
+    }
 
-        // For each entity of this kind in the database
-        for (auto it = container.begin(); it != container.end(); ++it)
+    //! Whether every entity of a container has been added
+    bool is_complete(
+            std::string const& container_tag) const
+    {
+        return nullptr != dump_ || completed_containers_.count(container_tag) > 0;
+    }
+
+    /**
+     * @brief Check that the entity 'referenced_id' of 'reference_container_tag' exists,
+     * and that it references the entity 'entity_id' in its 'entity_tag'.
+     *
+     * If the referenced container has not been completely read yet, the check is delayed until check_pending().
+     *
+     * @throws eprosima::statistics_backend::CorruptedFile if the references are not consistent and mutual.
+     */
+    void check(
+            std::string const& reference_container_tag,
+            std::string const& entity_tag,
+            std::string const& referenced_id,
+            std::string const& entity_id)
+    {
+        // 1) Check that the 'referenced_id' entity exists.
+        const std::unordered_set<std::string>* referenced_entities =
+                find(reference_container_tag, entity_tag, referenced_id);
+        if (nullptr == referenced_entities)
         {
-            // Check that entity has correct references to other entities
-            check_entity_contains_all_references(dump, it, USER_CONTAINER_TAG, HOST_CONTAINER_TAG, HOST_ENTITY_TAG);
-            check_entity_contains_all_references(dump, it, USER_ENTITY_TAG, PROCESS_CONTAINER_TAG,
-                    PROCESS_CONTAINER_TAG);
+            if (!is_complete(reference_container_tag))
+            {
+                pending_.push_back({reference_container_tag, entity_tag, referenced_id, entity_id});
+                return;
+            }
 
-            // Create entity
-            std::shared_ptr<User> entity = std::make_shared<User>((*it).at(NAME_INFO_TAG),
-                            hosts_[string_to_int((*it).at(HOST_ENTITY_TAG))]);
-            entity->alias = (*it).at(ALIAS_INFO_TAG);
+            throw CorruptedFile(
+                      "Entity container: " + reference_container_tag + " do not have a Entity with ID: " +
+                      referenced_id);
+        }
+
+        // 2) Check that referenced entity contains a reference to an 'entity_id' of type 'entity_tag'.
+        if (referenced_entities->find(entity_id) == referenced_entities->end())
+        {
+            std::string references;
+            for (const auto& id : *referenced_entities)
+            {
+                references += (references.empty() ? "" : ", ") + id;
+            }
+            throw CorruptedFile("Entity with ID (" + referenced_id + ") of " + reference_container_tag +
+                          " has reference to " + entity_tag + ": [" + references + "]" +
+                          " instead of " + entity_tag + ": " + entity_id);
+        }
+    }
 
-            // Insert into database
-            EntityId entity_id = EntityId(string_to_int(it.key()));
-            insert_nts(entity, entity_id);
+    /**
+     * @brief Run the checks delayed until every container of the dump had been read.
+     *
+     * @throws eprosima::statistics_backend::CorruptedFile if the references are not consistent and mutual.
+     */
+    void check_pending()
+    {
+        std::vector<PendingCheck> pending;
+        pending.swap(pending_);
+        for (const auto& check_args : pending)
+        {
+            check(check_args.reference_container_tag, check_args.entity_tag, check_args.referenced_id,
+                    check_args.entity_id);
         }
     }
 
-    // Processes
+private:
+
+    //! Check delayed until the referenced container is complete
+    struct PendingCheck
     {
-        DatabaseDump container = dump.at(PROCESS_CONTAINER_TAG);
+        std::string reference_container_tag;
+        std::string entity_tag;
+        std::string referenced_id;
+        std::string entity_id;
+    };
 
-        // For each entity of this kind in the database
-        for (auto it = container.begin(); it != container.end(); ++it)
+    //! Tags of the references checked on the entities of each container
+    static const std::vector<const char*>& reference_tags(
+            std::string const& container_tag)
+    {
+        static const std::unordered_map<std::string, std::vector<const char*>> tags =
         {
-            // Check that entity has correct references to other entities
-            check_entity_contains_all_references(dump, it, PROCESS_CONTAINER_TAG, USER_CONTAINER_TAG, USER_ENTITY_TAG);
-            check_entity_contains_all_references(dump, it, PROCESS_ENTITY_TAG, PARTICIPANT_CONTAINER_TAG,
-                    PARTICIPANT_CONTAINER_TAG);
+            {HOST_CONTAINER_TAG, {USER_CONTAINER_TAG}},
+            {USER_CONTAINER_TAG, {HOST_ENTITY_TAG, PROCESS_CONTAINER_TAG}},
+            {PROCESS_CONTAINER_TAG, {USER_ENTITY_TAG, PARTICIPANT_CONTAINER_TAG}},
+            {DOMAIN_CONTAINER_TAG, {PARTICIPANT_CONTAINER_TAG, TOPIC_CONTAINER_TAG}},
+            {TOPIC_CONTAINER_TAG, {DOMAIN_ENTITY_TAG, DATAWRITER_CONTAINER_TAG, DATAREADER_CONTAINER_TAG}},
+            {PARTICIPANT_CONTAINER_TAG, {DOMAIN_ENTITY_TAG, PROCESS_ENTITY_TAG, DATAWRITER_CONTAINER_TAG,
+                                         DATAREADER_CONTAINER_TAG}},
+            {DATAWRITER_CONTAINER_TAG, {PARTICIPANT_ENTITY_TAG, TOPIC_ENTITY_TAG, LOCATOR_CONTAINER_TAG}},
+            {DATAREADER_CONTAINER_TAG, {PARTICIPANT_ENTITY_TAG, TOPIC_ENTITY_TAG, LOCATOR_CONTAINER_TAG}},
+            {LOCATOR_CONTAINER_TAG, {DATAWRITER_CONTAINER_TAG, DATAREADER_CONTAINER_TAG}},
+        };
+        static const std::vector<const char*> none;
 
-            // Create entity
-            std::shared_ptr<Process> entity =
-                    std::make_shared<Process>((*it).at(NAME_INFO_TAG), (*it).at(PID_INFO_TAG),
-                            users_[EntityId(string_to_int((*it).at(USER_ENTITY_TAG)))]);
-            entity->alias = (*it).at(ALIAS_INFO_TAG);
+        auto found = tags.find(container_tag);
+        return found == tags.end() ? none : found->second;
+    }
 
-            // Insert into database
-            EntityId entity_id = EntityId(string_to_int(it.key()));
-            insert_nts(entity, entity_id);
+    //! Add the IDs of a reference, which is either an array of IDs or a single ID, to a set
+    static void gather(
+            std::unordered_set<std::string>& referenced_entities,
+            DatabaseDump const& referenced_entities_json)
+    {
+        if (referenced_entities_json.is_array())
+        {
+            for (auto const& id : referenced_entities_json)
+            {
+                referenced_entities.insert(id.get<std::string>());
+            }
+        }
+        else
+        {
+            referenced_entities.insert(referenced_entities_json.get<std::string>());
         }
     }
 
-    // Domains
+    /**
+     * @brief Get the references to entities of type 'entity_tag' of the entity 'referenced_id',
+     * found in 'reference_container_tag'.
+     *
+     * @return The IDs referenced by the entity, or nullptr if the container does not have an entity with that ID.
+     */
+    const std::unordered_set<std::string>* find(
+            std::string const& reference_container_tag,
+            std::string const& entity_tag,
+            std::string const& referenced_id)
     {
-        DatabaseDump container = dump.at(DOMAIN_CONTAINER_TAG);
+        std::unordered_map<std::string, std::unordered_set<std::string>>& references =
+                references_[reference_container_tag + "/" + entity_tag];
 
-        // For each entity of this kind in the database
-        for (auto it = container.begin(); it != container.end(); ++it)
+        auto found = references.find(referenced_id);
+        if (found != references.end())
         {
-            // Check that entity has correct references to other entities
-            check_entity_contains_all_references(dump, it, DOMAIN_ENTITY_TAG, PARTICIPANT_CONTAINER_TAG,
-                    PARTICIPANT_CONTAINER_TAG);
-            check_entity_contains_all_references(dump, it, DOMAIN_ENTITY_TAG, TOPIC_CONTAINER_TAG, TOPIC_CONTAINER_TAG);
+            return &found->second;
+        }
 
-            // Create entity
-            std::shared_ptr<Domain> entity = std::make_shared<Domain>((*it).at(NAME_INFO_TAG));
-            entity->alias = (*it).at(ALIAS_INFO_TAG);
+        if (nullptr == dump_)
+        {
+            return nullptr;
+        }
 
-            // Insert into database
-            EntityId entity_id = EntityId(string_to_int(it.key()));
-            insert_nts(entity, entity_id);
+        DatabaseDump const& reference_container = dump_->at(reference_container_tag);
+        auto referenced_it = reference_container.find(referenced_id);
+        if (referenced_it == reference_container.end())
+        {
+            return nullptr;
         }
+
+        std::unordered_set<std::string>& referenced_entities = references[referenced_id];
+        gather(referenced_entities, referenced_it->at(entity_tag));
+        return &referenced_entities;
     }
 
-    // Topics
+    //! Whole dump, or nullptr if the dump is read as a stream
+    DatabaseDump const* dump_;
+
+    //! References of the already checked entities, by referenced container and reference tag
+    std::unordered_map<std::string, std::unordered_map<std::string, std::unordered_set<std::string>>> references_;
+
+    //! Containers of a streamed dump whose entities have all been added
+    std::unordered_set<std::string> completed_containers_;
+
+    //! Checks of references to entities not read yet
+    std::vector<PendingCheck> pending_;
+};
+
+/**
+ * @brief Check that in the 'dump', the references of the entity 'entity_id' of type 'entity_tag'
+ * to entities of type 'reference_tag' are consistent and mutual. For this, the referenced entities must
+ * have reference to 'entity_id' of type 'entity_tag'.
+ *
+ * Example -> Check that each user, reference host[0]:
+ *
+ * \code
+ * {
+ *      host["0"]
+ *      {
+ *          users: ["1","5","9"]
+ *      }
+ *      user["1"]
+ *      {
+ *          host: "0"
+ *      }
+ * }
+ * \endcode
+ *
+ * @param references index of the references of the database dump.
+ * @param entity_id ID of the entity to check.
+ * @param entity dump of the entity to check.
+ * @param entity_tag Type of the entity to check.
+ * @param reference_tag Type of the referenced entity to check.
+ * @throws eprosima::statistics_backend::FileCorrupted if the references are not consistent and mutual.
+ */
+void check_entity_contains_all_references(
+        DumpReferences& references,
+        std::string const& entity_id,
+        DatabaseDump const& entity,
+        std::string const& entity_tag,
+        std::string const& reference_container_tag,
+        std::string const& reference_tag)
+{
+    DatabaseDump const& references_id = entity.at(reference_tag);
+
+    // Check all 'references_id' in the 'reference_container'
+    for (auto refIt = references_id.begin(); refIt != references_id.end(); ++refIt)
     {
-        DatabaseDump container = dump.at(TOPIC_CONTAINER_TAG);
+        references.check(reference_container_tag, entity_tag, *refIt, entity_id);
+    }
+}
 
-        // For each entity of this kind in the database
-        for (auto it = container.begin(); it != container.end(); ++it)
+//! Containers of a database dump, in the order in which their entities are loaded
+static const std::vector<const char*>& dump_load_order()
+{
+    static const std::vector<const char*> containers =
+    {
+        LOCATOR_CONTAINER_TAG,
+        HOST_CONTAINER_TAG,
+        USER_CONTAINER_TAG,
+        PROCESS_CONTAINER_TAG,
+        DOMAIN_CONTAINER_TAG,
+        TOPIC_CONTAINER_TAG,
+        PARTICIPANT_CONTAINER_TAG,
+        DATAWRITER_CONTAINER_TAG,
+        DATAREADER_CONTAINER_TAG
+    };
+    return containers;
+}
+
+/**
+ * @brief SAX handler that splits a JSON database dump into its entities.
+ *
+ * Only the entity being read is held in memory: as soon as it is complete, it is passed to \c on_entity,
+ * together with its container and its ID. Once every entity of a container has been read,
+ * \c on_container is called with the container. The members of the dump that are not containers of entities,
+ * like its version, are passed whole to \c on_member.
+ */
+class DumpStreamReader
+{
+public:
+
+    using EntityCallback = std::function<void (const std::string&, std::string&, DatabaseDump&)>;
+    using ContainerCallback = std::function<void (const std::string&)>;
+    using MemberCallback = std::function<void (const std::string&, DatabaseDump&)>;
+
+    DumpStreamReader(
+            EntityCallback on_entity,
+            ContainerCallback on_container,
+            MemberCallback on_member)
+        : on_entity_(std::move(on_entity))
+        , on_container_(std::move(on_container))
+        , on_member_(std::move(on_member))
+    {
+    }
+
+    bool null()
+    {
+        return scalar_([&](ValueParser& parser)
+                       {
+                           return parser.null();
+                       });
+    }
+
+    bool boolean(
+            bool val)
+    {
+        return scalar_([&](ValueParser& parser)
+                       {
+                           return parser.boolean(val);
+                       });
+    }
+
+    bool number_integer(
+            DatabaseDump::number_integer_t val)
+    {
+        return scalar_([&](ValueParser& parser)
+                       {
+                           return parser.number_integer(val);
+                       });
+    }
+
+    bool number_unsigned(
+            DatabaseDump::number_unsigned_t val)
+    {
+        return scalar_([&](ValueParser& parser)
+                       {
+                           return parser.number_unsigned(val);
+                       });
+    }
+
+    bool number_float(
+            DatabaseDump::number_float_t val,
+            const DatabaseDump::string_t& s)
+    {
+        return scalar_([&](ValueParser& parser)
+                       {
+                           return parser.number_float(val, s);
+                       });
+    }
+
+    bool string(
+            DatabaseDump::string_t& val)
+    {
+        return scalar_([&](ValueParser& parser)
+                       {
+                           return parser.string(val);
+                       });
+    }
+
+    bool binary(
+            DatabaseDump::binary_t& val)
+    {
+        return scalar_([&](ValueParser& parser)
+                       {
+                           return parser.binary(val);
+                       });
+    }
+
+    bool start_object(
+            std::size_t elements)
+    {
+        ++depth_;
+        if (!parser_)
+        {
+            switch (depth_)
+            {
+                case ROOT_DEPTH:
+                    return true;
+                case CONTAINER_DEPTH:
+                    if (is_container_(member_))
+                    {
+                        return true;
+                    }
+                    break;
+                default:
+                    break;
+            }
+            start_value_();
+        }
+        return parser_->start_object(elements);
+    }
+
+    bool key(
+            DatabaseDump::string_t& val)
+    {
+        if (parser_)
+        {
+            return parser_->key(val);
+        }
+        switch (depth_)
         {
-            // Check that entity has correct references to other entities
-            check_entity_contains_all_references(dump, it, TOPIC_CONTAINER_TAG, DOMAIN_CONTAINER_TAG,
-                    DOMAIN_ENTITY_TAG);
-            check_entity_contains_all_references(dump, it, TOPIC_ENTITY_TAG, DATAWRITER_CONTAINER_TAG,
-                    DATAWRITER_CONTAINER_TAG);
-            check_entity_contains_all_references(dump, it, TOPIC_ENTITY_TAG, DATAREADER_CONTAINER_TAG,
-                    DATAREADER_CONTAINER_TAG);
+            case ROOT_DEPTH:
+                member_ = val;
+                return true;
+            default:
+                entity_id_ = val;
+                return true;
+        }
+    }
 
-            // Create entity
-            std::shared_ptr<Topic> entity =
-                    std::make_shared<Topic>((*it).at(NAME_INFO_TAG), (*it).at(DATA_TYPE_INFO_TAG),
-                            domains_[EntityId(string_to_int((*it).at(DOMAIN_ENTITY_TAG)))]);
-            entity->alias = (*it).at(ALIAS_INFO_TAG);
+    bool end_object()
+    {
+        if (parser_)
+        {
+            parser_->end_object();
+            end_value_();
+        }
+        else if (CONTAINER_DEPTH == depth_)
+        {
+            on_container_(member_);
+        }
+        --depth_;
+        return true;
+    }
 
-            // Insert into database
-            EntityId entity_id = EntityId(string_to_int(it.key()));
-            insert_nts(entity, entity_id);
+    bool start_array(
+            std::size_t elements)
+    {
+        ++depth_;
+        if (!parser_)
+        {
+            switch (depth_)
+            {
+                case ROOT_DEPTH:
+                    throw CorruptedFile("The database dump is not a JSON object");
+                case CONTAINER_DEPTH:
+                    if (is_container_(member_))
+                    {
+                        throw CorruptedFile("The container " + member_ + " is not a JSON object");
+                    }
+                    break;
+                default:
+                    throw CorruptedFile("Entity " + entity_id_ + " of " + member_ + " is not a JSON object");
+            }
+            start_value_();
         }
+        return parser_->start_array(elements);
     }
 
-    // Participants
+    bool end_array()
     {
-        DatabaseDump container = dump.at(PARTICIPANT_CONTAINER_TAG);
+        parser_->end_array();
+        end_value_();
+        --depth_;
+        return true;
+    }
+
+    template<class Exception>
+    bool parse_error(
+            std::size_t,
+            const std::string&,
+            const Exception& ex)
+    {
+        throw ex;
+    }
+
+private:
+
+    using ValueParser = nlohmann::detail::json_sax_dom_parser<DatabaseDump>;
+
+    //! Depth of the root object, whose members are the containers of entities
+    static constexpr int ROOT_DEPTH = 1;
+
+    //! Depth of the containers, whose members are their entities
+    static constexpr int CONTAINER_DEPTH = 2;
+
+    //! Depth of the entities
+    static constexpr int ENTITY_DEPTH = 3;
+
+    //! Whether a member of the root is a container of entities
+    static bool is_container_(
+            const std::string& member)
+    {
+        const auto& containers = dump_load_order();
+        return std::find(containers.begin(), containers.end(), member) != containers.end();
+    }
+
+    //! Pass a scalar to the value being read, or to \c on_member if it is a member of the root
+    template<typename Functor>
+    bool scalar_(
+            Functor forward)
+    {
+        if (parser_)
+        {
+            return forward(*parser_);
+        }
+        switch (depth_)
+        {
+            case ROOT_DEPTH:
+            {
+                DatabaseDump member;
+                ValueParser parser(member);
+                forward(parser);
+                on_member_(member_, member);
+                return true;
+            }
+            case CONTAINER_DEPTH:
+                throw CorruptedFile("Entity " + entity_id_ + " of " + member_ + " is not a JSON object");
+            default:
+                throw CorruptedFile("The database dump is not a JSON object");
+        }
+    }
+
+    //! Start reading an entity, or a member of the root that is not a container, opened at the current depth
+    void start_value_()
+    {
+        value_ = DatabaseDump();
+        value_depth_ = depth_;
+        parser_.reset(new ValueParser(value_));
+    }
+
+    //! Pass the value being read to its callback, if it is closed at the current depth
+    void end_value_()
+    {
+        if (depth_ != value_depth_)
+        {
+            return;
+        }
+        parser_.reset();
+        if (ENTITY_DEPTH == value_depth_)
+        {
+            on_entity_(member_, entity_id_, value_);
+        }
+        else
+        {
+            on_member_(member_, value_);
+        }
+    }
+
+    EntityCallback on_entity_;
+    ContainerCallback on_container_;
+    MemberCallback on_member_;
+
+    //! Number of objects and arrays opened and not closed yet
+    int depth_ = 0;
+
+    //! Member of the root being read
+    std::string member_;
+
+    //! ID of the entity being read
+    std::string entity_id_;
+
+    //! Entity, or member of the root, being read
+    DatabaseDump value_;
+
+    //! Depth of the value being read
+    int value_depth_ = 0;
+
+    //! Builder of the value being read, if any
+    std::unique_ptr<ValueParser> parser_;
+};
+
+/**
+ * @brief Check that the references of an entity of a dump to other entities of the dump are consistent and mutual.
+ *
+ * @param references index of the references of the database dump.
+ * @param container_tag Container of the entity in the dump.
+ * @param entity_id_str ID of the entity to check.
+ * @param entity_dump dump of the entity to check.
+ * @throws eprosima::statistics_backend::FileCorrupted if the references are not consistent and mutual.
+ */
+void check_dump_entity_references(
+        DumpReferences& references,
+        const std::string& container_tag,
+        const std::string& entity_id_str,
+        const DatabaseDump& entity_dump)
+{
+    if (LOCATOR_CONTAINER_TAG == container_tag)
+    {
+        check_entity_contains_all_references(references, entity_id_str, entity_dump, LOCATOR_CONTAINER_TAG,
+                DATAWRITER_CONTAINER_TAG, DATAWRITER_CONTAINER_TAG);
+        check_entity_contains_all_references(references, entity_id_str, entity_dump, LOCATOR_CONTAINER_TAG,
+                DATAREADER_CONTAINER_TAG, DATAREADER_CONTAINER_TAG);
+    }
+    else if (HOST_CONTAINER_TAG == container_tag)
+    {
+        check_entity_contains_all_references(references, entity_id_str, entity_dump, HOST_ENTITY_TAG,
+                USER_CONTAINER_TAG, USER_CONTAINER_TAG);
+    }
+    else if (USER_CONTAINER_TAG == container_tag)
+    {
+        check_entity_contains_all_references(references, entity_id_str, entity_dump, USER_CONTAINER_TAG,
+                HOST_CONTAINER_TAG, HOST_ENTITY_TAG);
+        check_entity_contains_all_references(references, entity_id_str, entity_dump, USER_ENTITY_TAG,
+                PROCESS_CONTAINER_TAG, PROCESS_CONTAINER_TAG);
+    }
+    else if (PROCESS_CONTAINER_TAG == container_tag)
+    {
+        check_entity_contains_all_references(references, entity_id_str, entity_dump, PROCESS_CONTAINER_TAG,
+                USER_CONTAINER_TAG, USER_ENTITY_TAG);
+        check_entity_contains_all_references(references, entity_id_str, entity_dump, PROCESS_ENTITY_TAG,
+                PARTICIPANT_CONTAINER_TAG, PARTICIPANT_CONTAINER_TAG);
+    }
+    else if (DOMAIN_CONTAINER_TAG == container_tag)
+    {
+        check_entity_contains_all_references(references, entity_id_str, entity_dump, DOMAIN_ENTITY_TAG,
+                PARTICIPANT_CONTAINER_TAG, PARTICIPANT_CONTAINER_TAG);
+        check_entity_contains_all_references(references, entity_id_str, entity_dump, DOMAIN_ENTITY_TAG,
+                TOPIC_CONTAINER_TAG, TOPIC_CONTAINER_TAG);
+    }
+    else if (TOPIC_CONTAINER_TAG == container_tag)
+    {
+        check_entity_contains_all_references(references, entity_id_str, entity_dump, TOPIC_CONTAINER_TAG,
+                DOMAIN_CONTAINER_TAG, DOMAIN_ENTITY_TAG);
+        check_entity_contains_all_references(references, entity_id_str, entity_dump, TOPIC_ENTITY_TAG,
+                DATAWRITER_CONTAINER_TAG, DATAWRITER_CONTAINER_TAG);
+        check_entity_contains_all_references(references, entity_id_str, entity_dump, TOPIC_ENTITY_TAG,
+                DATAREADER_CONTAINER_TAG, DATAREADER_CONTAINER_TAG);
+    }
+    else if (PARTICIPANT_CONTAINER_TAG == container_tag)
+    {
+        check_entity_contains_all_references(references, entity_id_str, entity_dump, PARTICIPANT_CONTAINER_TAG,
+                DOMAIN_CONTAINER_TAG, DOMAIN_ENTITY_TAG);
+        check_entity_contains_all_references(references, entity_id_str, entity_dump, PARTICIPANT_ENTITY_TAG,
+                DATAWRITER_CONTAINER_TAG, DATAWRITER_CONTAINER_TAG);
+        check_entity_contains_all_references(references, entity_id_str, entity_dump, PARTICIPANT_ENTITY_TAG,
+                DATAREADER_CONTAINER_TAG, DATAREADER_CONTAINER_TAG);
+
+        // The participant may not be linked with a process
+        if (EntityId(std::stoll(entity_dump.at(PROCESS_ENTITY_TAG).get<std::string>())) != EntityId::invalid())
+        {
+            check_entity_contains_all_references(references, entity_id_str, entity_dump, PARTICIPANT_CONTAINER_TAG,
+                    PROCESS_CONTAINER_TAG, PROCESS_ENTITY_TAG);
+        }
+    }
+    else if (DATAWRITER_CONTAINER_TAG == container_tag)
+    {
+        check_entity_contains_all_references(references, entity_id_str, entity_dump, DATAWRITER_CONTAINER_TAG,
+                PARTICIPANT_CONTAINER_TAG, PARTICIPANT_ENTITY_TAG);
+        check_entity_contains_all_references(references, entity_id_str, entity_dump, DATAWRITER_CONTAINER_TAG,
+                TOPIC_CONTAINER_TAG, TOPIC_ENTITY_TAG);
+        check_entity_contains_all_references(references, entity_id_str, entity_dump, DATAWRITER_CONTAINER_TAG,
+                LOCATOR_CONTAINER_TAG, LOCATOR_CONTAINER_TAG);
+    }
+    else if (DATAREADER_CONTAINER_TAG == container_tag)
+    {
+        check_entity_contains_all_references(references, entity_id_str, entity_dump, DATAREADER_CONTAINER_TAG,
+                PARTICIPANT_CONTAINER_TAG, PARTICIPANT_ENTITY_TAG);
+        check_entity_contains_all_references(references, entity_id_str, entity_dump, DATAREADER_CONTAINER_TAG,
+                TOPIC_CONTAINER_TAG, TOPIC_ENTITY_TAG);
+        check_entity_contains_all_references(references, entity_id_str, entity_dump, DATAREADER_CONTAINER_TAG,
+                LOCATOR_CONTAINER_TAG, LOCATOR_CONTAINER_TAG);
+    }
+}
+
+//! Kind of the entities of a container of a database dump
+static EntityKind dump_container_kind(
+        const std::string& container_tag)
+{
+    static const std::unordered_map<std::string, EntityKind> kinds =
+    {
+        {HOST_CONTAINER_TAG, EntityKind::HOST},
+        {USER_CONTAINER_TAG, EntityKind::USER},
+        {PROCESS_CONTAINER_TAG, EntityKind::PROCESS},
+        {DOMAIN_CONTAINER_TAG, EntityKind::DOMAIN},
+        {TOPIC_CONTAINER_TAG, EntityKind::TOPIC},
+        {PARTICIPANT_CONTAINER_TAG, EntityKind::PARTICIPANT},
+        {DATAWRITER_CONTAINER_TAG, EntityKind::DATAWRITER},
+        {DATAREADER_CONTAINER_TAG, EntityKind::DATAREADER},
+        {LOCATOR_CONTAINER_TAG, EntityKind::LOCATOR},
+    };
+
+    auto found = kinds.find(container_tag);
+    return found == kinds.end() ? EntityKind::INVALID : found->second;
+}
+
+void Database::load_database(
+        const DatabaseDump& dump)
+{
+    std::lock_guard<std::shared_timed_mutex> guard (mutex_);
+
+    if (next_id_ != 0)
+    {
+        throw PreconditionNotMet("Error: Database not empty");
+    }
+
+    // References of the entities in the dump, built as they are checked
+    DumpReferences references(dump);
+
+    // The samples of an incremental dump are skipped by the incremental dumps of this database,
+    // as in load_database_nts_
+    auto since = dump.find(DELTA_SINCE_TAG);
+    if (since != dump.end())
+    {
+        insertion_epoch_ = (std::max)(insertion_epoch_, load_watermark(*since).epoch + 1);
+    }
+
+    for (const char* container_tag : dump_load_order())
+    {
+        const DatabaseDump& container = dump.at(container_tag);
 
         // For each entity of this kind in the database
         for (auto it = container.begin(); it != container.end(); ++it)
         {
-            // Check that entity has correct references to other entities
-            check_entity_contains_all_references(dump, it, PARTICIPANT_CONTAINER_TAG, DOMAIN_CONTAINER_TAG,
-                    DOMAIN_ENTITY_TAG);
-            check_entity_contains_all_references(dump, it, PARTICIPANT_ENTITY_TAG, DATAWRITER_CONTAINER_TAG,
-                    DATAWRITER_CONTAINER_TAG);
-            check_entity_contains_all_references(dump, it, PARTICIPANT_ENTITY_TAG, DATAREADER_CONTAINER_TAG,
-                    DATAREADER_CONTAINER_TAG);
+            load_entity_(references, container_tag, it.key(), *it);
+        }
+    }
 
-            // Create entity
-            std::shared_ptr<DomainParticipant> entity = std::make_shared<DomainParticipant>(
-                (*it).at(NAME_INFO_TAG), (*it).at(QOS_INFO_TAG), (*it).at(GUID_INFO_TAG), nullptr,
-                domains_[EntityId(string_to_int((*it).at(DOMAIN_ENTITY_TAG)))]);
-            entity->alias = (*it).at(ALIAS_INFO_TAG);
+    auto until = dump.find(DELTA_UNTIL_TAG);
+    if (until != dump.end())
+    {
+        insertion_epoch_ = (std::max)(insertion_epoch_, load_watermark(*until).epoch + 1);
+    }
+}
+
+void Database::load_database(
+        std::istream& stream)
+{
+    std::lock_guard<std::shared_timed_mutex> guard (mutex_);
+
+    if (next_id_ != 0)
+    {
+        throw PreconditionNotMet("Error: Database not empty");
+    }
+
+    load_database_nts_(stream);
+}
+
+void Database::load_database_delta(
+        std::istream& stream)
+{
+    std::lock_guard<std::shared_timed_mutex> guard (mutex_);
+    load_database_nts_(stream);
+}
+
+void Database::load_database_nts_(
+        std::istream& stream)
+{
+    // References of the entities in the dump, added as they are read
+    DumpReferences references;
 
-            // Insert into database
-            EntityId entity_id = EntityId(string_to_int(it.key()));
-            insert_nts(entity, entity_id);
+    // Watermark of the previous dump, if the dump is incremental
+    DumpWatermark since;
 
-            // Link participant with process
-            EntityId process_id(string_to_int((*it).at(PROCESS_ENTITY_TAG)));
+    // Next container to load. The entities of the containers that come before in the load order must be loaded first
+    const std::vector<const char*>& load_order = dump_load_order();
+    std::size_t next_container = 0;
 
-            if (process_id != EntityId::invalid())
+    // Entities read before the containers they depend on, which are kept until those have been loaded.
+    // Dumps written by dump_database(std::ostream&, bool) have the containers in load order, so no entity is kept
+    std::unordered_map<std::string, std::vector<std::pair<std::string, DatabaseDump>>> pending_entities;
+
+    // When the dump is merged with the entities of the database, the entities that are not in the dump are removed
+    // before the new entities of the dump are inserted, as those may replace them. Until then, the new entities
+    // are kept, and the entities already in the database are merged as they are read
+    const bool merging = !entities_by_id_.empty();
+    std::unordered_set<EntityId> dumped_entities;
+    std::vector<std::pair<std::string, std::pair<std::string, DatabaseDump>>> new_entities;
+    std::vector<std::pair<EntityId, EntityId>> process_links;
+
+    auto load_entity = [&](const std::string& container_tag, std::string& entity_id_str, DatabaseDump& entity)
             {
-                check_entity_contains_all_references(dump, it, PARTICIPANT_CONTAINER_TAG, PROCESS_CONTAINER_TAG,
-                        PROCESS_ENTITY_TAG);
+                EntityId entity_id(string_to_int(entity_id_str));
+
+                if (merging)
+                {
+                    dumped_entities.insert(entity_id);
+
+                    auto existing = entities_by_id_.find(entity_id);
+                    if (existing != entities_by_id_.end())
+                    {
+                        if (entity_id.value() >= since.next_entity_id)
+                        {
+                            throw CorruptedFile("Entity " + entity_id_str + " of " + container_tag +
+                                          " is already in the database: the dump has already been loaded");
+                        }
+                        merge_entity_(references, container_tag, entity_id_str, entity, existing->second,
+                                process_links);
+                        return;
+                    }
+                }
 
-                link_participant_with_process_nts(entity->id, process_id);
+                // The entities created before the watermark of the dump must have been loaded from a previous dump
+                if (entity_id.value() < since.next_entity_id)
+                {
+                    throw CorruptedFile("Entity " + entity_id_str + " of " + container_tag +
+                                  " is not in the database: the previous incremental dump has not been loaded");
+                }
+
+                if (merging)
+                {
+                    new_entities.emplace_back(container_tag, std::make_pair(std::move(entity_id_str),
+                            std::move(entity)));
+                }
+                else
+                {
+                    load_entity_(references, container_tag, entity_id_str, entity);
+                }
+            };
+
+    DumpStreamReader reader(
+        [&](const std::string& container_tag, std::string& entity_id, DatabaseDump& entity)
+        {
+            references.add(container_tag, entity_id, entity);
+
+            if (next_container < load_order.size() && container_tag == load_order[next_container])
+            {
+                load_entity(container_tag, entity_id, entity);
+            }
+            else
+            {
+                pending_entities[container_tag].emplace_back(std::move(entity_id), std::move(entity));
+            }
+        },
+        [&](const std::string& container_tag)
+        {
+            references.complete(container_tag);
+
+            while (next_container < load_order.size() && references.is_complete(load_order[next_container]))
+            {
+                auto pending = pending_entities.find(load_order[next_container]);
+                if (pending != pending_entities.end())
+                {
+                    for (auto& entity : pending->second)
+                    {
+                        load_entity(pending->first, entity.first, entity.second);
+                        entity.second = DatabaseDump();
+                    }
+                    pending_entities.erase(pending);
+                }
+                ++next_container;
+            }
+        },
+        [&](const std::string& member, DatabaseDump& value)
+        {
+            // The watermark of the previous dump is written before the entities.
+            // The samples of the dump were inserted after it, so they are loaded in the epoch that follows it,
+            // and the database moves past the watermark of the dump, which is written after the entities.
+            // This way, the incremental dumps of this database skip the loaded samples
+            if (DELTA_SINCE_TAG == member)
+            {
+                since = load_watermark(value);
+                insertion_epoch_ = (std::max)(insertion_epoch_, since.epoch + 1);
             }
+            else if (DELTA_UNTIL_TAG == member)
+            {
+                insertion_epoch_ = (std::max)(insertion_epoch_, load_watermark(value).epoch + 1);
+            }
+        });
 
-            // Load data and insert into database
-            load_data((*it).at(DATA_CONTAINER_TAG), entity);
+    // A stream may hold several dumps one after the other, so only the first one is read
+    DatabaseDump::sax_parse(stream, &reader, DatabaseDump::input_format_t::json, false);
+
+    if (next_container < load_order.size())
+    {
+        throw CorruptedFile(std::string("The database dump does not contain the container ") +
+                      load_order[next_container]);
+    }
+    references.check_pending();
+
+    if (merging)
+    {
+        erase_entities_not_in_nts_(dumped_entities);
+
+        for (const auto& entity : new_entities)
+        {
+            load_entity_(references, entity.first, entity.second.first, entity.second.second);
+        }
+
+        for (const auto& link : process_links)
+        {
+            link_participant_with_process_nts(link.first, link.second);
         }
     }
+}
 
-    // DataWriters
+void Database::merge_entity_(
+        DumpReferences& references,
+        const std::string& container_tag,
+        const std::string& entity_id_str,
+        const DatabaseDump& entity_dump,
+        const std::shared_ptr<Entity>& entity,
+        std::vector<std::pair<EntityId, EntityId>>& process_links)
+{
+    if (dump_container_kind(container_tag) != entity->kind ||
+            entity_dump.at(NAME_INFO_TAG).get<std::string>() != entity->name)
     {
-        DatabaseDump container = dump.at(DATAWRITER_CONTAINER_TAG);
+        throw CorruptedFile("Entity " + entity_id_str + " of " + container_tag +
+                      " is not the entity with the same ID in the database");
+    }
 
-        // For each entity of this kind in the database
-        for (auto it = container.begin(); it != container.end(); ++it)
+    // Check that entity has correct references to other entities
+    check_dump_entity_references(references, container_tag, entity_id_str, entity_dump);
+
+    entity->alias = entity_dump.at(ALIAS_INFO_TAG);
+
+    if (PARTICIPANT_CONTAINER_TAG == container_tag)
+    {
+        std::shared_ptr<DomainParticipant> participant = std::static_pointer_cast<DomainParticipant>(entity);
+
+        // The participant may have been linked with its process after the previous dump
+        EntityId process_id(string_to_int(entity_dump.at(PROCESS_ENTITY_TAG)));
+        if (process_id != EntityId::invalid() && !participant->process)
         {
-            // Check that entity has correct references to other entities
-            check_entity_contains_all_references(dump, it, DATAWRITER_CONTAINER_TAG, PARTICIPANT_CONTAINER_TAG,
-                    PARTICIPANT_ENTITY_TAG);
-            check_entity_contains_all_references(dump, it, DATAWRITER_CONTAINER_TAG, TOPIC_CONTAINER_TAG,
-                    TOPIC_ENTITY_TAG);
-            check_entity_contains_all_references(dump, it, DATAWRITER_CONTAINER_TAG, LOCATOR_CONTAINER_TAG,
-                    LOCATOR_CONTAINER_TAG);
+            process_links.emplace_back(participant->id, process_id);
+        }
 
-            // Get keys
-            EntityId participant_id = EntityId(string_to_int((*it).at(PARTICIPANT_ENTITY_TAG)));
-            EntityId participant_domain_id =
-                    EntityId(string_to_int(dump.at(PARTICIPANT_CONTAINER_TAG)
-                                    .at(std::to_string(participant_id.value()))
-                                    .at(DOMAIN_ENTITY_TAG)));
+        // Append the new data
+        load_data(entity_dump.at(DATA_CONTAINER_TAG), participant);
+    }
+    else if (DATAWRITER_CONTAINER_TAG == container_tag)
+    {
+        load_data(entity_dump.at(DATA_CONTAINER_TAG), std::static_pointer_cast<DataWriter>(entity));
+    }
+    else if (DATAREADER_CONTAINER_TAG == container_tag)
+    {
+        load_data(entity_dump.at(DATA_CONTAINER_TAG), std::static_pointer_cast<DataReader>(entity));
+    }
+}
 
-            EntityId topic_id = EntityId(string_to_int((*it).at(TOPIC_ENTITY_TAG)));
-            EntityId topic_domain_id = EntityId(string_to_int(dump.at(TOPIC_CONTAINER_TAG)
-                                    .at(std::to_string(topic_id.value()))
-                                    .at(DOMAIN_ENTITY_TAG)));
+void Database::erase_entities_not_in_nts_(
+        const std::unordered_set<EntityId>& kept)
+{
+    // Erasing a domain erases all its entities as well
+    std::vector<EntityId> erased_domains;
+    for (const auto& domain : domains_)
+    {
+        if (kept.find(domain.first) == kept.end())
+        {
+            erased_domains.push_back(domain.first);
+        }
+    }
+    for (const auto& domain_id : erased_domains)
+    {
+        erase_nts_(domain_id);
+    }
+
+    auto erased = [&kept](const std::shared_ptr<Entity>& entity)
+            {
+                return kept.find(entity->id) == kept.end();
+            };
+
+    // Every removed entity must be removed from the lookup indexes as well
+    auto unindex = [this](const std::shared_ptr<Entity>& entity)
+            {
+                unindex_entity_nts_(entity);
+            };
+
+    // Physical entities
+    erase_entities_from_map_(hosts_, erased, unindex);
+    erase_entities_from_map_(users_, erased, unindex);
+    erase_entities_from_map_(processes_, erased, unindex);
+
+    // DDS entities
+    erase_entities_from_map_(participants_, erased, unindex);
+    erase_entities_from_map_(datawriters_, erased, unindex);
+    erase_entities_from_map_(datareaders_, erased, unindex);
+
+    // Logic entities
+    erase_entities_from_map_(topics_, erased, unindex);
 
-            // Create entity
-            std::shared_ptr<DataWriter> entity = std::make_shared<DataWriter>(
-                (*it).at(NAME_INFO_TAG),
-                (*it).at(QOS_INFO_TAG),
-                (*it).at(GUID_INFO_TAG),
-                participants_[participant_domain_id][participant_id],
-                topics_[topic_domain_id][topic_id]);
-            entity->alias = (*it).at(ALIAS_INFO_TAG);
-            entity->is_virtual_metatraffic = (*it).at(VIRTUAL_METATRAFFIC_TAG).get<bool>();
+    // Locators are never removed from the database
+
+    // Remove internal references of entities to those that have been removed
+    clear_internal_references_nts_();
+}
+
+void Database::load_entity_(
+        DumpReferences& references,
+        const std::string& container_tag,
+        const std::string& entity_id_str,
+        const DatabaseDump& entity_dump)
+{
+    EntityId entity_id = EntityId(string_to_int(entity_id_str));
+
+    // Check that entity has correct references to other entities
+    check_dump_entity_references(references, container_tag, entity_id_str, entity_dump);
+
+    if (LOCATOR_CONTAINER_TAG == container_tag)
+    {
+        // Create entity
+        std::shared_ptr<Locator> entity = std::make_shared<Locator>(entity_dump.at(NAME_INFO_TAG));
+        entity->alias = entity_dump.at(ALIAS_INFO_TAG);
+
+        // Insert into database
+        insert_nts(entity, entity_id);
+    }
+    else if (HOST_CONTAINER_TAG == container_tag)
+    {
+        // Create entity
+        std::shared_ptr<Host> entity = std::make_shared<Host>(entity_dump.at(NAME_INFO_TAG));
+        entity->alias = entity_dump.at(ALIAS_INFO_TAG);
+
+        // Insert into database
+        insert_nts(entity, entity_id);
+    }
+    else if (USER_CONTAINER_TAG == container_tag)
+    {
+        // Create entity
+        std::shared_ptr<User> entity = std::make_shared<User>(entity_dump.at(NAME_INFO_TAG),
+                        hosts_[string_to_int(entity_dump.at(HOST_ENTITY_TAG))]);
+        entity->alias = entity_dump.at(ALIAS_INFO_TAG);
+
+        // Insert into database
+        insert_nts(entity, entity_id);
+    }
+    else if (PROCESS_CONTAINER_TAG == container_tag)
+    {
+        // Create entity
+        std::shared_ptr<Process> entity =
+                std::make_shared<Process>(entity_dump.at(NAME_INFO_TAG), entity_dump.at(PID_INFO_TAG),
+                        users_[EntityId(string_to_int(entity_dump.at(USER_ENTITY_TAG)))]);
+        entity->alias = entity_dump.at(ALIAS_INFO_TAG);
+
+        // Insert into database
+        insert_nts(entity, entity_id);
+    }
+    else if (DOMAIN_CONTAINER_TAG == container_tag)
+    {
+        // Create entity
+        std::shared_ptr<Domain> entity = std::make_shared<Domain>(entity_dump.at(NAME_INFO_TAG));
+        entity->alias = entity_dump.at(ALIAS_INFO_TAG);
+
+        // Insert into database
+        insert_nts(entity, entity_id);
+    }
+    else if (TOPIC_CONTAINER_TAG == container_tag)
+    {
+        // Create entity
+        std::shared_ptr<Topic> entity =
+                std::make_shared<Topic>(entity_dump.at(NAME_INFO_TAG), entity_dump.at(DATA_TYPE_INFO_TAG),
+                        domains_[EntityId(string_to_int(entity_dump.at(DOMAIN_ENTITY_TAG)))]);
+        entity->alias = entity_dump.at(ALIAS_INFO_TAG);
+
+        // Insert into database
+        insert_nts(entity, entity_id);
+    }
+    else if (PARTICIPANT_CONTAINER_TAG == container_tag)
+    {
+        // Create entity
+        std::shared_ptr<DomainParticipant> entity = std::make_shared<DomainParticipant>(
+            entity_dump.at(NAME_INFO_TAG), entity_dump.at(QOS_INFO_TAG), entity_dump.at(GUID_INFO_TAG), nullptr,
+            domains_[EntityId(string_to_int(entity_dump.at(DOMAIN_ENTITY_TAG)))]);
+        entity->alias = entity_dump.at(ALIAS_INFO_TAG);
 
-            /* Add reference to locator to the endpoint */
-            for (auto it_loc = (*it).at(LOCATOR_CONTAINER_TAG).begin();
-                    it_loc != (*it).at(LOCATOR_CONTAINER_TAG).end();
-                    ++it_loc)
-            {
-                entity->locators[string_to_int(*it_loc)] =
-                        locators_[EntityId(string_to_int(*it_loc))];
-            }
+        // Insert into database
+        insert_nts(entity, entity_id);
 
-            // Insert into database
-            EntityId entity_id = EntityId(string_to_int(it.key()));
-            insert_nts(entity, entity_id);
+        // Link participant with process
+        EntityId process_id(string_to_int(entity_dump.at(PROCESS_ENTITY_TAG)));
 
-            // Load data and insert into database
-            load_data((*it).at(DATA_CONTAINER_TAG), entity);
+        if (process_id != EntityId::invalid())
+        {
+            link_participant_with_process_nts(entity->id, process_id);
         }
-    }
 
-    // DataReaders
+        // Load data and insert into database
+        load_data(entity_dump.at(DATA_CONTAINER_TAG), entity);
+    }
+    else if (DATAWRITER_CONTAINER_TAG == container_tag)
     {
-        DatabaseDump container = dump.at(DATAREADER_CONTAINER_TAG);
-        for (auto it = container.begin(); it != container.end(); ++it)
-        {
-            // Check that entity has correct references to other entities
-            check_entity_contains_all_references(dump, it, DATAREADER_CONTAINER_TAG, PARTICIPANT_CONTAINER_TAG,
-                    PARTICIPANT_ENTITY_TAG);
-            check_entity_contains_all_references(dump, it, DATAREADER_CONTAINER_TAG, TOPIC_CONTAINER_TAG,
-                    TOPIC_ENTITY_TAG);
-            check_entity_contains_all_references(dump, it, DATAREADER_CONTAINER_TAG, LOCATOR_CONTAINER_TAG,
-                    LOCATOR_CONTAINER_TAG);
+        // Get keys. The participant and the topic have already been loaded
+        EntityId participant_id = EntityId(string_to_int(entity_dump.at(PARTICIPANT_ENTITY_TAG)));
+        EntityId topic_id = EntityId(string_to_int(entity_dump.at(TOPIC_ENTITY_TAG)));
 
-            // Get keys
-            EntityId participant_id = EntityId(string_to_int((*it).at(
-                                PARTICIPANT_ENTITY_TAG)));
-            EntityId participant_domain_id =
-                    EntityId(string_to_int(dump.at(PARTICIPANT_CONTAINER_TAG)
-                                    .at(std::to_string(participant_id.value()))
-                                    .at(DOMAIN_ENTITY_TAG)));
+        // Create entity
+        std::shared_ptr<DataWriter> entity = std::make_shared<DataWriter>(
+            entity_dump.at(NAME_INFO_TAG),
+            entity_dump.at(QOS_INFO_TAG),
+            entity_dump.at(GUID_INFO_TAG),
+            std::static_pointer_cast<DomainParticipant>(entities_by_id_.at(participant_id)),
+            std::static_pointer_cast<Topic>(entities_by_id_.at(topic_id)));
+        entity->alias = entity_dump.at(ALIAS_INFO_TAG);
+        entity->is_virtual_metatraffic = entity_dump.at(VIRTUAL_METATRAFFIC_TAG).get<bool>();
 
-            EntityId topic_id = EntityId(string_to_int((*it).at(TOPIC_ENTITY_TAG)));
-            EntityId topic_domain_id = EntityId(string_to_int(dump.at(TOPIC_CONTAINER_TAG)
-                                    .at(std::to_string(topic_id.value()))
-                                    .at(DOMAIN_ENTITY_TAG)));
+        /* Add reference to locator to the endpoint */
+        for (auto it_loc = entity_dump.at(LOCATOR_CONTAINER_TAG).begin();
+                it_loc != entity_dump.at(LOCATOR_CONTAINER_TAG).end();
+                ++it_loc)
+        {
+            entity->locators[string_to_int(*it_loc)] =
+                    locators_[EntityId(string_to_int(*it_loc))];
+        }
 
-            // Create entity
-            std::shared_ptr<DataReader> entity = std::make_shared<DataReader>(
-                (*it).at(NAME_INFO_TAG),
-                (*it).at(QOS_INFO_TAG),
-                (*it).at(GUID_INFO_TAG),
-                participants_[participant_domain_id][participant_id],
-                topics_[topic_domain_id][topic_id]);
-            entity->alias = (*it).at(ALIAS_INFO_TAG);
-            entity->is_virtual_metatraffic = (*it).at(VIRTUAL_METATRAFFIC_TAG).get<bool>();
+        // Insert into database
+        insert_nts(entity, entity_id);
 
-            /* Add reference to locator to the endpoint */
-            for (auto it_loc = (*it).at(LOCATOR_CONTAINER_TAG).begin();
-                    it_loc != (*it).at(LOCATOR_CONTAINER_TAG).end();
-                    ++it_loc)
-            {
-                entity->locators[string_to_int(*it_loc)] =
-                        locators_[EntityId(string_to_int(*it_loc))];
-            }
+        // Load data and insert into database
+        load_data(entity_dump.at(DATA_CONTAINER_TAG), entity);
+    }
+    else if (DATAREADER_CONTAINER_TAG == container_tag)
+    {
+        // Get keys. The participant and the topic have already been loaded
+        EntityId participant_id = EntityId(string_to_int(entity_dump.at(PARTICIPANT_ENTITY_TAG)));
+        EntityId topic_id = EntityId(string_to_int(entity_dump.at(TOPIC_ENTITY_TAG)));
 
-            // Insert into database
-            EntityId entity_id = EntityId(string_to_int(it.key()));
-            insert_nts(entity, entity_id);
+        // Create entity
+        std::shared_ptr<DataReader> entity = std::make_shared<DataReader>(
+            entity_dump.at(NAME_INFO_TAG),
+            entity_dump.at(QOS_INFO_TAG),
+            entity_dump.at(GUID_INFO_TAG),
+            std::static_pointer_cast<DomainParticipant>(entities_by_id_.at(participant_id)),
+            std::static_pointer_cast<Topic>(entities_by_id_.at(topic_id)));
+        entity->alias = entity_dump.at(ALIAS_INFO_TAG);
+        entity->is_virtual_metatraffic = entity_dump.at(VIRTUAL_METATRAFFIC_TAG).get<bool>();
 
-            // Load data and insert into database
-            load_data((*it).at(DATA_CONTAINER_TAG), entity);
+        /* Add reference to locator to the endpoint */
+        for (auto it_loc = entity_dump.at(LOCATOR_CONTAINER_TAG).begin();
+                it_loc != entity_dump.at(LOCATOR_CONTAINER_TAG).end();
+                ++it_loc)
+        {
+            entity->locators[string_to_int(*it_loc)] =
+                    locators_[EntityId(string_to_int(*it_loc))];
         }
+
+        // Insert into database
+        insert_nts(entity, entity_id);
+
+        // Load data and insert into database
+        load_data(entity_dump.at(DATA_CONTAINER_TAG), entity);
     }
 }
 
@@ -3831,7 +5428,7 @@ void Database::load_data(
 {
     // discovery_time
     {
-        DatabaseDump container = dump.at(DATA_KIND_DISCOVERY_TIME_TAG);
+        const DatabaseDump& container = dump.at(DATA_KIND_DISCOVERY_TIME_TAG);
 
         // RemoteEntities iterator
         for (auto remote_it = container.begin(); remote_it != container.end(); ++remote_it)
@@ -3865,7 +5462,7 @@ void Database::load_data(
 
     // pdp_packets
     {
-        DatabaseDump container = dump.at(DATA_KIND_PDP_PACKETS_TAG);
+        const DatabaseDump& container = dump.at(DATA_KIND_PDP_PACKETS_TAG);
 
         // Data iterator
         for (auto it = container.begin(); it != container.end(); ++it)
@@ -3886,7 +5483,7 @@ void Database::load_data(
 
     // edp_packets
     {
-        DatabaseDump container = dump.at(DATA_KIND_EDP_PACKETS_TAG);
+        const DatabaseDump& container = dump.at(DATA_KIND_EDP_PACKETS_TAG);
 
         // Data iterator
         for (auto it = container.begin(); it != container.end(); ++it)
@@ -3907,7 +5504,7 @@ void Database::load_data(
 
     // rtps_packets_sent
     {
-        DatabaseDump container = dump.at(DATA_KIND_RTPS_PACKETS_SENT_TAG);
+        const DatabaseDump& container = dump.at(DATA_KIND_RTPS_PACKETS_SENT_TAG);
 
         // RemoteEntities iterator
         for (auto remote_it = container.begin(); remote_it != container.end(); ++remote_it)
@@ -3935,7 +5532,7 @@ void Database::load_data(
 
     // rtps_bytes_sent
     {
-        DatabaseDump container = dump.at(DATA_KIND_RTPS_BYTES_SENT_TAG);
+        const DatabaseDump& container = dump.at(DATA_KIND_RTPS_BYTES_SENT_TAG);
 
         // RemoteEntities iterator
         for (auto remote_it = container.begin(); remote_it != container.end(); ++remote_it)
@@ -3967,7 +5564,7 @@ void Database::load_data(
 
     // rtps_packets_lost
     {
-        DatabaseDump container = dump.at(DATA_KIND_RTPS_PACKETS_LOST_TAG);
+        const DatabaseDump& container = dump.at(DATA_KIND_RTPS_PACKETS_LOST_TAG);
 
         // RemoteEntities iterator
         for (auto remote_it = container.begin(); remote_it != container.end(); ++remote_it)
@@ -3995,7 +5592,7 @@ void Database::load_data(
 
     // rtps_bytes_lost
     {
-        DatabaseDump container = dump.at(DATA_KIND_RTPS_BYTES_LOST_TAG);
+        const DatabaseDump& container = dump.at(DATA_KIND_RTPS_BYTES_LOST_TAG);
 
         // RemoteEntities iterator
         for (auto remote_it = container.begin(); remote_it != container.end(); ++remote_it)
@@ -4027,7 +5624,7 @@ void Database::load_data(
 
     // network_latency
     {
-        DatabaseDump container = dump.at(DATA_KIND_NETWORK_LATENCY_TAG);
+        const DatabaseDump& container = dump.at(DATA_KIND_NETWORK_LATENCY_TAG);
 
         // RemoteEntities iterator
         for (auto remote_it = container.begin(); remote_it != container.end(); ++remote_it)
@@ -4055,13 +5652,13 @@ void Database::load_data(
 
     // last_reported_rtps_bytes_lost
     {
-        DatabaseDump container = dump.at(DATA_KIND_RTPS_BYTES_LOST_LAST_REPORTED_TAG);
+        const DatabaseDump& container = dump.at(DATA_KIND_RTPS_BYTES_LOST_LAST_REPORTED_TAG);
 
         // RemoteEntities iterator
         for (auto remote_it = container.begin(); remote_it != container.end(); ++remote_it)
         {
             RtpsBytesLostSample sample;
-            DatabaseDump sample_dump = container.at(remote_it.key());
+            const DatabaseDump& sample_dump = container.at(remote_it.key());
 
             // std::chrono::system_clock::time_point
             uint64_t time = string_to_uint(std::string(sample_dump.at(DATA_VALUE_SRC_TIME_TAG)));
@@ -4084,13 +5681,13 @@ void Database::load_data(
 
     // last_reported_rtps_bytes_sent
     {
-        DatabaseDump container = dump.at(DATA_KIND_RTPS_BYTES_SENT_LAST_REPORTED_TAG);
+        const DatabaseDump& container = dump.at(DATA_KIND_RTPS_BYTES_SENT_LAST_REPORTED_TAG);
 
         // RemoteEntities iterator
         for (auto remote_it = container.begin(); remote_it != container.end(); ++remote_it)
         {
             RtpsBytesSentSample sample;
-            DatabaseDump sample_dump = container.at(remote_it.key());
+            const DatabaseDump& sample_dump = container.at(remote_it.key());
 
             // std::chrono::system_clock::time_point
             uint64_t time = string_to_uint(std::string(sample_dump.at(DATA_VALUE_SRC_TIME_TAG)));
@@ -4113,13 +5710,13 @@ void Database::load_data(
 
     // last_reported_rtps_packets_lost
     {
-        DatabaseDump container = dump.at(DATA_KIND_RTPS_PACKETS_LOST_LAST_REPORTED_TAG);
+        const DatabaseDump& container = dump.at(DATA_KIND_RTPS_PACKETS_LOST_LAST_REPORTED_TAG);
 
         // RemoteEntities iterator
         for (auto remote_it = container.begin(); remote_it != container.end(); ++remote_it)
         {
             RtpsPacketsLostSample sample;
-            DatabaseDump sample_dump = container.at(remote_it.key());
+            const DatabaseDump& sample_dump = container.at(remote_it.key());
 
             // std::chrono::system_clock::time_point
             uint64_t time = string_to_uint(std::string(sample_dump.at(DATA_VALUE_SRC_TIME_TAG)));
@@ -4138,13 +5735,13 @@ void Database::load_data(
 
     // last_reported_rtps_packets_sent
     {
-        DatabaseDump container = dump.at(DATA_KIND_RTPS_PACKETS_SENT_LAST_REPORTED_TAG);
+        const DatabaseDump& container = dump.at(DATA_KIND_RTPS_PACKETS_SENT_LAST_REPORTED_TAG);
 
         // RemoteEntities iterator
         for (auto remote_it = container.begin(); remote_it != container.end(); ++remote_it)
         {
             RtpsPacketsSentSample sample;
-            DatabaseDump sample_dump = container.at(remote_it.key());
+            const DatabaseDump& sample_dump = container.at(remote_it.key());
 
             // std::chrono::system_clock::time_point
             uint64_t time = string_to_uint(std::string(sample_dump.at(DATA_VALUE_SRC_TIME_TAG)));
@@ -4166,7 +5763,7 @@ void Database::load_data(
         // Only insert last reported if there are at least one
         if (!dump.at(DATA_KIND_EDP_PACKETS_TAG).empty())
         {
-            DatabaseDump container = dump.at(DATA_KIND_EDP_PACKETS_LAST_REPORTED_TAG);
+            const DatabaseDump& container = dump.at(DATA_KIND_EDP_PACKETS_LAST_REPORTED_TAG);
 
             EdpCountSample sample;
 
@@ -4187,7 +5784,7 @@ void Database::load_data(
         // Only insert last reported if there are at least one
         if (!dump.at(DATA_KIND_PDP_PACKETS_TAG).empty())
         {
-            DatabaseDump container = dump.at(DATA_KIND_PDP_PACKETS_LAST_REPORTED_TAG);
+            const DatabaseDump& container = dump.at(DATA_KIND_PDP_PACKETS_LAST_REPORTED_TAG);
 
             PdpCountSample sample;
 
@@ -4199,23 +5796,273 @@ void Database::load_data(
             sample.count = string_to_uint(to_string(container.at(DATA_VALUE_COUNT_TAG)));
 
             // Insert data into database
-            insert_nts(entity->domain->id, entity->id, sample, true, true);
+            insert_nts(entity->domain->id, entity->id, sample, true, true);
+        }
+    }
+}
+
+void Database::load_data(
+        const DatabaseDump& dump,
+        const std::shared_ptr<DataWriter>& entity)
+{
+    // publication_throughput
+    {
+        const DatabaseDump& container = dump.at(DATA_KIND_PUBLICATION_THROUGHPUT_TAG);
+
+        // Data iterator
+        for (auto it = container.begin(); it != container.end(); ++it)
+        {
+            PublicationThroughputSample sample;
+
+            // std::chrono::system_clock::time_point
+            uint64_t time = string_to_uint((*it).at(DATA_VALUE_SRC_TIME_TAG));
+            sample.src_ts = nanoseconds_to_systemclock(time);
+
+            // double
+            sample.data = (*it).at(DATA_VALUE_DATA_TAG);
+
+            // Insert data into database
+            insert_nts(entity->participant->domain->id, entity->id, sample, true);
+        }
+    }
+
+    // resent_datas
+    {
+        const DatabaseDump& container = dump.at(DATA_KIND_RESENT_DATA_TAG);
+
+        // Data iterator
+        for (auto it = container.begin(); it != container.end(); ++it)
+        {
+            ResentDataSample sample;
+
+            // std::chrono::system_clock::time_point
+            uint64_t time = string_to_uint((*it).at(DATA_VALUE_SRC_TIME_TAG));
+            sample.src_ts = nanoseconds_to_systemclock(time);
+
+            // uint64_t
+            sample.count = string_to_uint(to_string((*it).at(DATA_VALUE_COUNT_TAG)));
+
+            // Insert data into database
+            insert_nts(entity->participant->domain->id, entity->id, sample, true);
+        }
+    }
+
+    // heartbeat_count
+    {
+        const DatabaseDump& container = dump.at(DATA_KIND_HEARTBEAT_COUNT_TAG);
+
+        // Data iterator
+        for (auto it = container.begin(); it != container.end(); ++it)
+        {
+            HeartbeatCountSample sample;
+
+            // std::chrono::system_clock::time_point
+            uint64_t time = string_to_uint((*it).at(DATA_VALUE_SRC_TIME_TAG));
+            sample.src_ts = nanoseconds_to_systemclock(time);
+
+            // uint64_t
+            sample.count = string_to_uint(to_string((*it).at(DATA_VALUE_COUNT_TAG)));
+
+            // Insert data into database
+            insert_nts(entity->participant->domain->id, entity->id, sample, true);
+        }
+    }
+
+    // gap_count
+    {
+        const DatabaseDump& container = dump.at(DATA_KIND_GAP_COUNT_TAG);
+
+        // Data iterator
+        for (auto it = container.begin(); it != container.end(); ++it)
+        {
+            GapCountSample sample;
+
+            // std::chrono::system_clock::time_point
+            uint64_t time = string_to_uint((*it).at(DATA_VALUE_SRC_TIME_TAG));
+            sample.src_ts = nanoseconds_to_systemclock(time);
+
+            // uint64_t
+            sample.count = string_to_uint(to_string((*it).at(DATA_VALUE_COUNT_TAG)));
+
+            // Insert data into database
+            insert_nts(entity->participant->domain->id, entity->id, sample, true);
+        }
+    }
+
+    // data_count
+    {
+        const DatabaseDump& container = dump.at(DATA_KIND_DATA_COUNT_TAG);
+
+        // Data iterator
+        for (auto it = container.begin(); it != container.end(); ++it)
+        {
+            DataCountSample sample;
+
+            // std::chrono::system_clock::time_point
+            uint64_t time = string_to_uint((*it).at(DATA_VALUE_SRC_TIME_TAG));
+            sample.src_ts = nanoseconds_to_systemclock(time);
+
+            // uint64_t
+            sample.count = string_to_uint(to_string((*it).at(DATA_VALUE_COUNT_TAG)));
+
+            // Insert data into database
+            insert_nts(entity->participant->domain->id, entity->id, sample, true);
+        }
+    }
+
+    // samples_datas
+    {
+        const DatabaseDump& container = dump.at(DATA_KIND_SAMPLE_DATAS_TAG);
+
+        // RemoteEntities iterator
+        for (auto remote_it = container.begin(); remote_it != container.end(); ++remote_it)
+        {
+            // Data iterator
+            for (auto it = container.at(remote_it.key()).begin(); it != container.at(remote_it.key()).end(); ++it)
+            {
+                SampleDatasCountSample sample;
+
+                // std::chrono::system_clock::time_point
+                uint64_t time = string_to_uint((*it).at(DATA_VALUE_SRC_TIME_TAG));
+                sample.src_ts = nanoseconds_to_systemclock(time);
+
+                // uint64_t
+                sample.count = string_to_uint(to_string((*it).at(DATA_VALUE_COUNT_TAG)));
+
+                // uint64_t
+                sample.sequence_number = string_to_int(remote_it.key());
+
+                // Insert data into database
+                insert_nts(entity->participant->domain->id, entity->id, sample, true);
+            }
+        }
+    }
+
+    // history2history_latency
+    {
+        const DatabaseDump& container = dump.at(DATA_KIND_FASTDDS_LATENCY_TAG);
+
+        // RemoteEntities iterator
+        for (auto remote_it = container.begin(); remote_it != container.end(); ++remote_it)
+        {
+            // Data iterator
+            for (auto it = container.at(remote_it.key()).begin(); it != container.at(remote_it.key()).end(); ++it)
+            {
+                HistoryLatencySample sample;
+
+                // std::chrono::system_clock::time_point
+                uint64_t time = string_to_uint((*it).at(DATA_VALUE_SRC_TIME_TAG));
+                sample.src_ts = nanoseconds_to_systemclock(time);
+
+                // double
+                sample.data = (*it).at(DATA_VALUE_DATA_TAG);
+
+                // EntityId
+                sample.reader = EntityId(string_to_int(remote_it.key()));
+
+                // Insert data into database
+                insert_nts(entity->participant->domain->id, entity->id, sample, true);
+            }
+        }
+    }
+
+    // last_reported_data_count
+    {
+        // Only insert last reported if there are at least one
+        if (!dump.at(DATA_KIND_DATA_COUNT_TAG).empty())
+        {
+            const DatabaseDump& container = dump.at(DATA_KIND_DATA_COUNT_LAST_REPORTED_TAG);
+
+            DataCountSample sample;
+
+            // std::chrono::system_clock::time_point
+            uint64_t time = string_to_uint(std::string(container.at(DATA_VALUE_SRC_TIME_TAG)));
+            sample.src_ts = nanoseconds_to_systemclock(time);
+
+            // uint64_t count;
+            sample.count = string_to_uint(to_string(container.at(DATA_VALUE_COUNT_TAG)));
+
+            // Insert data into database
+            insert_nts(entity->participant->domain->id, entity->id, sample, true, true);
+        }
+    }
+
+    // last_reported_gap_count
+    {
+        // Only insert last reported if there are at least one
+        if (!dump.at(DATA_KIND_GAP_COUNT_TAG).empty())
+        {
+            const DatabaseDump& container = dump.at(DATA_KIND_GAP_COUNT_LAST_REPORTED_TAG);
+
+            GapCountSample sample;
+
+            // std::chrono::system_clock::time_point
+            uint64_t time = string_to_uint(std::string(container.at(DATA_VALUE_SRC_TIME_TAG)));
+            sample.src_ts = nanoseconds_to_systemclock(time);
+
+            // uint64_t count;
+            sample.count = string_to_uint(to_string(container.at(DATA_VALUE_COUNT_TAG)));
+
+            // Insert data into database
+            insert_nts(entity->participant->domain->id, entity->id, sample, true, true);
+        }
+    }
+
+    // last_reported_heartbeat_count
+    {
+        // Only insert last reported if there are at least one
+        if (!dump.at(DATA_KIND_HEARTBEAT_COUNT_TAG).empty())
+        {
+            const DatabaseDump& container = dump.at(DATA_KIND_HEARTBEAT_COUNT_LAST_REPORTED_TAG);
+
+            HeartbeatCountSample sample;
+
+            // std::chrono::system_clock::time_point
+            uint64_t time = string_to_uint(std::string(container.at(DATA_VALUE_SRC_TIME_TAG)));
+            sample.src_ts = nanoseconds_to_systemclock(time);
+
+            // uint64_t count;
+            sample.count = string_to_uint(to_string(container.at(DATA_VALUE_COUNT_TAG)));
+
+            // Insert data into database
+            insert_nts(entity->participant->domain->id, entity->id, sample, true, true);
+        }
+    }
+
+    // last_reported_resent_datas
+    {
+        // Only insert last reported if there are at least one
+        if (!dump.at(DATA_KIND_RESENT_DATA_TAG).empty())
+        {
+            const DatabaseDump& container = dump.at(DATA_KIND_RESENT_DATA_LAST_REPORTED_TAG);
+
+            ResentDataSample sample;
+
+            // std::chrono::system_clock::time_point
+            uint64_t time = string_to_uint(std::string(container.at(DATA_VALUE_SRC_TIME_TAG)));
+            sample.src_ts = nanoseconds_to_systemclock(time);
+
+            // uint64_t count;
+            sample.count = string_to_uint(to_string(container.at(DATA_VALUE_COUNT_TAG)));
+
+            // Insert data into database
+            insert_nts(entity->participant->domain->id, entity->id, sample, true, true);
         }
     }
 }
 
 void Database::load_data(
         const DatabaseDump& dump,
-        const std::shared_ptr<DataWriter>& entity)
+        const std::shared_ptr<DataReader>& entity)
 {
-    // publication_throughput
+    // subscription_throughput
     {
-        DatabaseDump container = dump.at(DATA_KIND_PUBLICATION_THROUGHPUT_TAG);
+        const DatabaseDump& container = dump.at(DATA_KIND_SUBSCRIPTION_THROUGHPUT_TAG);
 
         // Data iterator
         for (auto it = container.begin(); it != container.end(); ++it)
         {
-            PublicationThroughputSample sample;
+            SubscriptionThroughputSample sample;
 
             // std::chrono::system_clock::time_point
             uint64_t time = string_to_uint((*it).at(DATA_VALUE_SRC_TIME_TAG));
@@ -4229,14 +6076,14 @@ void Database::load_data(
         }
     }
 
-    // resent_datas
+    // acknack_count
     {
-        DatabaseDump container = dump.at(DATA_KIND_RESENT_DATA_TAG);
+        const DatabaseDump& container = dump.at(DATA_KIND_ACKNACK_COUNT_TAG);
 
         // Data iterator
         for (auto it = container.begin(); it != container.end(); ++it)
         {
-            ResentDataSample sample;
+            AcknackCountSample sample;
 
             // std::chrono::system_clock::time_point
             uint64_t time = string_to_uint((*it).at(DATA_VALUE_SRC_TIME_TAG));
@@ -4250,14 +6097,14 @@ void Database::load_data(
         }
     }
 
-    // heartbeat_count
+    // nackfrag_count
     {
-        DatabaseDump container = dump.at(DATA_KIND_HEARTBEAT_COUNT_TAG);
+        const DatabaseDump& container = dump.at(DATA_KIND_NACKFRAG_COUNT_TAG);
 
         // Data iterator
         for (auto it = container.begin(); it != container.end(); ++it)
         {
-            HeartbeatCountSample sample;
+            NackfragCountSample sample;
 
             // std::chrono::system_clock::time_point
             uint64_t time = string_to_uint((*it).at(DATA_VALUE_SRC_TIME_TAG));
@@ -4271,295 +6118,875 @@ void Database::load_data(
         }
     }
 
-    // gap_count
+    // last_reported_acknack_count
     {
-        DatabaseDump container = dump.at(DATA_KIND_GAP_COUNT_TAG);
-
-        // Data iterator
-        for (auto it = container.begin(); it != container.end(); ++it)
+        // Only insert last reported if there are at least one
+        if (!dump.at(DATA_KIND_ACKNACK_COUNT_TAG).empty())
         {
-            GapCountSample sample;
+            const DatabaseDump& container = dump.at(DATA_KIND_ACKNACK_COUNT_LAST_REPORTED_TAG);
+
+            AcknackCountSample sample;
 
             // std::chrono::system_clock::time_point
-            uint64_t time = string_to_uint((*it).at(DATA_VALUE_SRC_TIME_TAG));
+            uint64_t time = string_to_uint(std::string(container.at(DATA_VALUE_SRC_TIME_TAG)));
             sample.src_ts = nanoseconds_to_systemclock(time);
 
-            // uint64_t
-            sample.count = string_to_uint(to_string((*it).at(DATA_VALUE_COUNT_TAG)));
+            // uint64_t count;
+            sample.count = string_to_uint(to_string(container.at(DATA_VALUE_COUNT_TAG)));
 
             // Insert data into database
-            insert_nts(entity->participant->domain->id, entity->id, sample, true);
+            insert_nts(entity->participant->domain->id, entity->id, sample, true, true);
         }
     }
 
-    // data_count
+    // last_reported_nackfrag_count
     {
-        DatabaseDump container = dump.at(DATA_KIND_DATA_COUNT_TAG);
-
-        // Data iterator
-        for (auto it = container.begin(); it != container.end(); ++it)
+        // Only insert last reported if there are at least one
+        if (!dump.at(DATA_KIND_NACKFRAG_COUNT_TAG).empty())
         {
-            DataCountSample sample;
+            const DatabaseDump& container = dump.at(DATA_KIND_NACKFRAG_COUNT_LAST_REPORTED_TAG);
+
+            NackfragCountSample sample;
 
             // std::chrono::system_clock::time_point
-            uint64_t time = string_to_uint((*it).at(DATA_VALUE_SRC_TIME_TAG));
+            uint64_t time = string_to_uint(std::string(container.at(DATA_VALUE_SRC_TIME_TAG)));
             sample.src_ts = nanoseconds_to_systemclock(time);
 
-            // uint64_t
-            sample.count = string_to_uint(to_string((*it).at(DATA_VALUE_COUNT_TAG)));
+            // uint64_t count;
+            sample.count = string_to_uint(to_string(container.at(DATA_VALUE_COUNT_TAG)));
 
             // Insert data into database
-            insert_nts(entity->participant->domain->id, entity->id, sample, true);
+            insert_nts(entity->participant->domain->id, entity->id, sample, true, true);
         }
     }
+}
 
-    // samples_datas
+//! Write the counts of a block of a binary snapshot
+template<typename Samples>
+void write_snapshot_columns(
+        SnapshotWriter& writer,
+        const Samples& samples,
+        const EntityCountSample*)
+{
+    for (const auto& sample : samples)
     {
-        DatabaseDump container = dump.at(DATA_KIND_SAMPLE_DATAS_TAG);
+        writer.write_uint64(sample.count);
+    }
+}
 
-        // RemoteEntities iterator
-        for (auto remote_it = container.begin(); remote_it != container.end(); ++remote_it)
-        {
-            // Data iterator
-            for (auto it = container.at(remote_it.key()).begin(); it != container.at(remote_it.key()).end(); ++it)
-            {
-                SampleDatasCountSample sample;
+//! Write the counts and magnitude orders of a block of a binary snapshot
+template<typename Samples>
+void write_snapshot_columns(
+        SnapshotWriter& writer,
+        const Samples& samples,
+        const ByteCountSample*)
+{
+    for (const auto& sample : samples)
+    {
+        writer.write_uint64(sample.count);
+    }
+    for (const auto& sample : samples)
+    {
+        writer.write_uint16(static_cast<uint16_t>(sample.magnitude_order));
+    }
+}
 
-                // std::chrono::system_clock::time_point
-                uint64_t time = string_to_uint((*it).at(DATA_VALUE_SRC_TIME_TAG));
-                sample.src_ts = nanoseconds_to_systemclock(time);
+//! Write the data values of a block of a binary snapshot
+template<typename Samples>
+void write_snapshot_columns(
+        SnapshotWriter& writer,
+        const Samples& samples,
+        const EntityDataSample*)
+{
+    for (const auto& sample : samples)
+    {
+        writer.write_double(sample.data);
+    }
+}
 
-                // uint64_t
-                sample.count = string_to_uint(to_string((*it).at(DATA_VALUE_COUNT_TAG)));
+//! Write the discovery times and statuses of a block of a binary snapshot. The remote entity is the key of the block
+template<typename Samples>
+void write_snapshot_columns(
+        SnapshotWriter& writer,
+        const Samples& samples,
+        const DiscoveryTimeSample*)
+{
+    for (const auto& sample : samples)
+    {
+        writer.write_timestamp(sample.time);
+    }
+    for (const auto& sample : samples)
+    {
+        writer.write_bool(sample.discovered);
+    }
+}
 
-                // uint64_t
-                sample.sequence_number = string_to_int(remote_it.key());
+template<typename Samples>
+void write_snapshot_block(
+        SnapshotWriter& writer,
+        const Samples& samples)
+{
+    writer.write_uint64(samples.size());
+    for (const auto& sample : samples)
+    {
+        writer.write_timestamp(sample.src_ts);
+    }
+    write_snapshot_columns(writer, samples, static_cast<const typename Samples::value_type*>(nullptr));
+}
 
-                // Insert data into database
-                insert_nts(entity->participant->domain->id, entity->id, sample, true);
-            }
-        }
+int64_t snapshot_key(
+        const EntityId& key)
+{
+    return key.value();
+}
+
+int64_t snapshot_key(
+        uint64_t key)
+{
+    return static_cast<int64_t>(key);
+}
+
+template<typename Sample>
+void write_snapshot_series(
+        SnapshotWriter& writer,
+        const char* tag,
+        const details::DataContainer<Sample>& series)
+{
+    writer.write_string(tag);
+    write_snapshot_block(writer, series);
+}
+
+template<typename Key, typename Sample>
+void write_snapshot_series(
+        SnapshotWriter& writer,
+        const char* tag,
+        const std::map<Key, details::DataContainer<Sample>>& series)
+{
+    writer.write_string(tag);
+    writer.write_uint64(series.size());
+    for (const auto& it : series)
+    {
+        writer.write_int64(snapshot_key(it.first));
+        write_snapshot_block(writer, it.second);
     }
+}
 
-    // history2history_latency
+/**
+ * Write a last reported sample as a block with a single sample.
+ * As in the JSON dumps, it is only meaningful if the series it belongs to has been reported.
+ */
+template<typename Sample>
+void write_snapshot_last_reported(
+        SnapshotWriter& writer,
+        const char* tag,
+        const Sample& last_reported,
+        bool reported)
+{
+    writer.write_string(tag);
+    write_snapshot_block(writer, reported ? std::vector<Sample>{last_reported} : std::vector<Sample>());
+}
+
+template<typename Sample>
+void write_snapshot_last_reported(
+        SnapshotWriter& writer,
+        const char* tag,
+        const std::map<EntityId, Sample>& last_reported)
+{
+    writer.write_string(tag);
+    writer.write_uint64(last_reported.size());
+    for (const auto& it : last_reported)
     {
-        DatabaseDump container = dump.at(DATA_KIND_FASTDDS_LATENCY_TAG);
+        writer.write_int64(it.first.value());
+        write_snapshot_block(writer, std::vector<Sample>{it.second});
+    }
+}
 
-        // RemoteEntities iterator
-        for (auto remote_it = container.begin(); remote_it != container.end(); ++remote_it)
-        {
-            // Data iterator
-            for (auto it = container.at(remote_it.key()).begin(); it != container.at(remote_it.key()).end(); ++it)
-            {
-                HistoryLatencySample sample;
+void write_snapshot_data(
+        SnapshotWriter& writer,
+        const DomainParticipantData& data)
+{
+    write_snapshot_series(writer, DATA_KIND_DISCOVERY_TIME_TAG, data.discovered_entity);
+    write_snapshot_series(writer, DATA_KIND_PDP_PACKETS_TAG, data.pdp_packets);
+    write_snapshot_series(writer, DATA_KIND_EDP_PACKETS_TAG, data.edp_packets);
+    write_snapshot_series(writer, DATA_KIND_RTPS_PACKETS_SENT_TAG, data.rtps_packets_sent);
+    write_snapshot_series(writer, DATA_KIND_RTPS_BYTES_SENT_TAG, data.rtps_bytes_sent);
+    write_snapshot_series(writer, DATA_KIND_RTPS_PACKETS_LOST_TAG, data.rtps_packets_lost);
+    write_snapshot_series(writer, DATA_KIND_RTPS_BYTES_LOST_TAG, data.rtps_bytes_lost);
+    write_snapshot_series(writer, DATA_KIND_NETWORK_LATENCY_TAG, data.network_latency_per_locator);
+    write_snapshot_last_reported(writer, DATA_KIND_PDP_PACKETS_LAST_REPORTED_TAG, data.last_reported_pdp_packets,
+            !data.pdp_packets.empty());
+    write_snapshot_last_reported(writer, DATA_KIND_EDP_PACKETS_LAST_REPORTED_TAG, data.last_reported_edp_packets,
+            !data.edp_packets.empty());
+    write_snapshot_last_reported(writer, DATA_KIND_RTPS_PACKETS_SENT_LAST_REPORTED_TAG,
+            data.last_reported_rtps_packets_sent_count);
+    write_snapshot_last_reported(writer, DATA_KIND_RTPS_BYTES_SENT_LAST_REPORTED_TAG,
+            data.last_reported_rtps_bytes_sent_count);
+    write_snapshot_last_reported(writer, DATA_KIND_RTPS_PACKETS_LOST_LAST_REPORTED_TAG,
+            data.last_reported_rtps_packets_lost_count);
+    write_snapshot_last_reported(writer, DATA_KIND_RTPS_BYTES_LOST_LAST_REPORTED_TAG,
+            data.last_reported_rtps_bytes_lost_count);
+    writer.write_string("");
+}
 
-                // std::chrono::system_clock::time_point
-                uint64_t time = string_to_uint((*it).at(DATA_VALUE_SRC_TIME_TAG));
-                sample.src_ts = nanoseconds_to_systemclock(time);
+void write_snapshot_data(
+        SnapshotWriter& writer,
+        const DataWriterData& data)
+{
+    write_snapshot_series(writer, DATA_KIND_PUBLICATION_THROUGHPUT_TAG, data.publication_throughput);
+    write_snapshot_series(writer, DATA_KIND_RESENT_DATA_TAG, data.resent_datas);
+    write_snapshot_series(writer, DATA_KIND_HEARTBEAT_COUNT_TAG, data.heartbeat_count);
+    write_snapshot_series(writer, DATA_KIND_GAP_COUNT_TAG, data.gap_count);
+    write_snapshot_series(writer, DATA_KIND_DATA_COUNT_TAG, data.data_count);
+    write_snapshot_series(writer, DATA_KIND_SAMPLE_DATAS_TAG, data.sample_datas);
+    write_snapshot_series(writer, DATA_KIND_FASTDDS_LATENCY_TAG, data.history2history_latency);
+    write_snapshot_last_reported(writer, DATA_KIND_RESENT_DATA_LAST_REPORTED_TAG, data.last_reported_resent_datas,
+            !data.resent_datas.empty());
+    write_snapshot_last_reported(writer, DATA_KIND_HEARTBEAT_COUNT_LAST_REPORTED_TAG,
+            data.last_reported_heartbeat_count, !data.heartbeat_count.empty());
+    write_snapshot_last_reported(writer, DATA_KIND_GAP_COUNT_LAST_REPORTED_TAG, data.last_reported_gap_count,
+            !data.gap_count.empty());
+    write_snapshot_last_reported(writer, DATA_KIND_DATA_COUNT_LAST_REPORTED_TAG, data.last_reported_data_count,
+            !data.data_count.empty());
+    writer.write_string("");
+}
 
-                // double
-                sample.data = (*it).at(DATA_VALUE_DATA_TAG);
+void write_snapshot_data(
+        SnapshotWriter& writer,
+        const DataReaderData& data)
+{
+    write_snapshot_series(writer, DATA_KIND_SUBSCRIPTION_THROUGHPUT_TAG, data.subscription_throughput);
+    write_snapshot_series(writer, DATA_KIND_ACKNACK_COUNT_TAG, data.acknack_count);
+    write_snapshot_series(writer, DATA_KIND_NACKFRAG_COUNT_TAG, data.nackfrag_count);
+    write_snapshot_last_reported(writer, DATA_KIND_ACKNACK_COUNT_LAST_REPORTED_TAG, data.last_reported_acknack_count,
+            !data.acknack_count.empty());
+    write_snapshot_last_reported(writer, DATA_KIND_NACKFRAG_COUNT_LAST_REPORTED_TAG,
+            data.last_reported_nackfrag_count, !data.nackfrag_count.empty());
+    writer.write_string("");
+}
 
-                // EntityId
-                sample.reader = EntityId(string_to_int(remote_it.key()));
+void write_snapshot_info(
+        SnapshotWriter& writer,
+        const Entity& entity)
+{
+    writer.write_int64(entity.id.value());
+    writer.write_string(entity.name);
+    writer.write_string(entity.alias);
+}
 
-                // Insert data into database
-                insert_nts(entity->participant->domain->id, entity->id, sample, true);
-            }
-        }
+template<typename T>
+void write_snapshot_table_size(
+        SnapshotWriter& writer,
+        const std::map<EntityId, std::map<EntityId, std::shared_ptr<T>>>& entities_by_domain)
+{
+    uint64_t size = 0;
+    for (const auto& it : entities_by_domain)
+    {
+        size += it.second.size();
     }
+    writer.write_uint64(size);
+}
 
-    // last_reported_data_count
+template<typename T>
+void write_snapshot_endpoint(
+        SnapshotWriter& writer,
+        const T& endpoint)
+{
+    write_snapshot_info(writer, endpoint);
+    writer.write_string(endpoint.guid);
+    writer.write_string(endpoint.qos.dump());
+    writer.write_int64(endpoint.participant->id.value());
+    writer.write_int64(endpoint.topic->id.value());
+    writer.write_bool(endpoint.is_virtual_metatraffic);
+    writer.write_uint64(endpoint.locators.size());
+    for (const auto& it : endpoint.locators)
+    {
+        writer.write_int64(it.first.value());
+    }
+    write_snapshot_data(writer, endpoint.data);
+}
+
+//! Read the counts of a block of a binary snapshot
+template<typename Samples>
+void read_snapshot_columns(
+        SnapshotReader& reader,
+        Samples& samples,
+        const EntityCountSample*)
+{
+    for (auto& sample : samples)
     {
-        // Only insert last reported if there are at least one
-        if (!dump.at(DATA_KIND_DATA_COUNT_TAG).empty())
-        {
-            DatabaseDump container = dump.at(DATA_KIND_DATA_COUNT_LAST_REPORTED_TAG);
+        sample.count = reader.read_uint64();
+    }
+}
 
-            DataCountSample sample;
+//! Read the counts and magnitude orders of a block of a binary snapshot
+template<typename Samples>
+void read_snapshot_columns(
+        SnapshotReader& reader,
+        Samples& samples,
+        const ByteCountSample*)
+{
+    for (auto& sample : samples)
+    {
+        sample.count = reader.read_uint64();
+    }
+    for (auto& sample : samples)
+    {
+        sample.magnitude_order = static_cast<int16_t>(reader.read_uint16());
+    }
+}
 
-            // std::chrono::system_clock::time_point
-            uint64_t time = string_to_uint(std::string(container.at(DATA_VALUE_SRC_TIME_TAG)));
-            sample.src_ts = nanoseconds_to_systemclock(time);
+//! Read the data values of a block of a binary snapshot
+template<typename Samples>
+void read_snapshot_columns(
+        SnapshotReader& reader,
+        Samples& samples,
+        const EntityDataSample*)
+{
+    for (auto& sample : samples)
+    {
+        sample.data = reader.read_double();
+    }
+}
 
-            // uint64_t count;
-            sample.count = string_to_uint(to_string(container.at(DATA_VALUE_COUNT_TAG)));
+//! Read the discovery times and statuses of a block of a binary snapshot
+template<typename Samples>
+void read_snapshot_columns(
+        SnapshotReader& reader,
+        Samples& samples,
+        const DiscoveryTimeSample*)
+{
+    for (auto& sample : samples)
+    {
+        sample.time = reader.read_timestamp();
+    }
+    for (auto& sample : samples)
+    {
+        sample.discovered = reader.read_bool();
+    }
+}
 
-            // Insert data into database
-            insert_nts(entity->participant->domain->id, entity->id, sample, true, true);
-        }
+/**
+ * Read a block of samples of a binary snapshot, and call \c functor with each of them.
+ */
+template<typename Sample, typename Functor>
+void read_snapshot_block(
+        SnapshotReader& reader,
+        Functor functor)
+{
+    uint64_t size = reader.read_uint64();
+
+    // The samples grow as they are read, so a corrupted size cannot allocate more memory than the stream holds
+    std::vector<Sample> samples;
+    samples.reserve(static_cast<std::size_t>(std::min<uint64_t>(size, 4096)));
+    for (uint64_t i = 0; i < size; ++i)
+    {
+        samples.emplace_back();
+        samples.back().src_ts = reader.read_timestamp();
     }
+    read_snapshot_columns(reader, samples, static_cast<const Sample*>(nullptr));
 
-    // last_reported_gap_count
+    for (auto& sample : samples)
     {
-        // Only insert last reported if there are at least one
-        if (!dump.at(DATA_KIND_GAP_COUNT_TAG).empty())
-        {
-            DatabaseDump container = dump.at(DATA_KIND_GAP_COUNT_LAST_REPORTED_TAG);
+        functor(sample);
+    }
+}
 
-            GapCountSample sample;
+/**
+ * Read the blocks of samples of a keyed series of a binary snapshot, and call \c functor with the key
+ * and each of the samples.
+ */
+template<typename Sample, typename Functor>
+void read_snapshot_keyed_blocks(
+        SnapshotReader& reader,
+        Functor functor)
+{
+    uint64_t keys = reader.read_uint64();
+    for (uint64_t i = 0; i < keys; ++i)
+    {
+        int64_t key = reader.read_int64();
+        read_snapshot_block<Sample>(reader, [&](Sample& sample)
+                {
+                    functor(key, sample);
+                });
+    }
+}
 
-            // std::chrono::system_clock::time_point
-            uint64_t time = string_to_uint(std::string(container.at(DATA_VALUE_SRC_TIME_TAG)));
-            sample.src_ts = nanoseconds_to_systemclock(time);
+/**
+ * Get an entity already loaded from a binary snapshot.
+ *
+ * @throws eprosima::statistics_backend::CorruptedFile if there is no entity of kind \c kind with id \c id.
+ */
+template<typename T>
+std::shared_ptr<T> find_snapshot_entity(
+        const std::unordered_map<EntityId, std::shared_ptr<Entity>>& entities,
+        const EntityId& id,
+        EntityKind kind)
+{
+    auto it = entities.find(id);
+    if (it == entities.end() || it->second->kind != kind)
+    {
+        throw CorruptedFile("The database snapshot references the entity " + std::to_string(id.value()) +
+                      ", which is not a loaded entity of the expected kind");
+    }
+    return std::static_pointer_cast<T>(it->second);
+}
 
-            // uint64_t count;
-            sample.count = string_to_uint(to_string(container.at(DATA_VALUE_COUNT_TAG)));
+Qos read_snapshot_qos(
+        SnapshotReader& reader)
+{
+    std::string qos = reader.read_string();
+    try
+    {
+        return Qos::parse(qos);
+    }
+    catch (const nlohmann::json::exception& e)
+    {
+        throw CorruptedFile(std::string("The database snapshot contains an invalid QoS: ") + e.what());
+    }
+}
 
-            // Insert data into database
-            insert_nts(entity->participant->domain->id, entity->id, sample, true, true);
-        }
+void Database::dump_snapshot(
+        std::ostream& stream,
+        const bool clear)
+{
+    std::lock_guard<std::shared_timed_mutex> guard(mutex_);
+
+    SnapshotWriter writer(stream);
+    writer.write_header();
+
+    // Locators, which are loaded first as the statistics data of the participants refer to them
+    writer.write_uint64(locators_.size());
+    for (const auto& it : locators_)
+    {
+        write_snapshot_info(writer, *it.second);
     }
 
-    // last_reported_heartbeat_count
+    // Hosts
+    writer.write_uint64(hosts_.size());
+    for (const auto& it : hosts_)
     {
-        // Only insert last reported if there are at least one
-        if (!dump.at(DATA_KIND_HEARTBEAT_COUNT_TAG).empty())
-        {
-            DatabaseDump container = dump.at(DATA_KIND_HEARTBEAT_COUNT_LAST_REPORTED_TAG);
+        write_snapshot_info(writer, *it.second);
+    }
 
-            HeartbeatCountSample sample;
+    // Users
+    writer.write_uint64(users_.size());
+    for (const auto& it : users_)
+    {
+        write_snapshot_info(writer, *it.second);
+        writer.write_int64(it.second->host->id.value());
+    }
 
-            // std::chrono::system_clock::time_point
-            uint64_t time = string_to_uint(std::string(container.at(DATA_VALUE_SRC_TIME_TAG)));
-            sample.src_ts = nanoseconds_to_systemclock(time);
+    // Processes
+    writer.write_uint64(processes_.size());
+    for (const auto& it : processes_)
+    {
+        write_snapshot_info(writer, *it.second);
+        writer.write_string(it.second->pid);
+        writer.write_int64(it.second->user->id.value());
+    }
 
-            // uint64_t count;
-            sample.count = string_to_uint(to_string(container.at(DATA_VALUE_COUNT_TAG)));
+    // Domains
+    writer.write_uint64(domains_.size());
+    for (const auto& it : domains_)
+    {
+        write_snapshot_info(writer, *it.second);
+    }
 
-            // Insert data into database
-            insert_nts(entity->participant->domain->id, entity->id, sample, true, true);
+    // Topics
+    write_snapshot_table_size(writer, topics_);
+    for (const auto& super_it : topics_)
+    {
+        for (const auto& it : super_it.second)
+        {
+            write_snapshot_info(writer, *it.second);
+            writer.write_string(it.second->data_type);
+            writer.write_int64(it.second->domain->id.value());
         }
     }
 
-    // last_reported_resent_datas
+    // Participants
+    write_snapshot_table_size(writer, participants_);
+    for (const auto& super_it : participants_)
     {
-        // Only insert last reported if there are at least one
-        if (!dump.at(DATA_KIND_RESENT_DATA_TAG).empty())
+        for (const auto& it : super_it.second)
         {
-            DatabaseDump container = dump.at(DATA_KIND_RESENT_DATA_LAST_REPORTED_TAG);
-
-            ResentDataSample sample;
-
-            // std::chrono::system_clock::time_point
-            uint64_t time = string_to_uint(std::string(container.at(DATA_VALUE_SRC_TIME_TAG)));
-            sample.src_ts = nanoseconds_to_systemclock(time);
-
-            // uint64_t count;
-            sample.count = string_to_uint(to_string(container.at(DATA_VALUE_COUNT_TAG)));
-
-            // Insert data into database
-            insert_nts(entity->participant->domain->id, entity->id, sample, true, true);
+            write_snapshot_info(writer, *it.second);
+            writer.write_string(it.second->guid);
+            writer.write_string(it.second->qos.dump());
+            writer.write_int64(it.second->domain->id.value());
+            writer.write_int64(it.second->process ? it.second->process->id.value() : EntityId::invalid().value());
+            write_snapshot_data(writer, it.second->data);
         }
     }
-}
 
-void Database::load_data(
-        const DatabaseDump& dump,
-        const std::shared_ptr<DataReader>& entity)
-{
-    // subscription_throughput
+    // DataWriters
+    write_snapshot_table_size(writer, datawriters_);
+    for (const auto& super_it : datawriters_)
     {
-        DatabaseDump container = dump.at(DATA_KIND_SUBSCRIPTION_THROUGHPUT_TAG);
-
-        // Data iterator
-        for (auto it = container.begin(); it != container.end(); ++it)
+        for (const auto& it : super_it.second)
         {
-            SubscriptionThroughputSample sample;
-
-            // std::chrono::system_clock::time_point
-            uint64_t time = string_to_uint((*it).at(DATA_VALUE_SRC_TIME_TAG));
-            sample.src_ts = nanoseconds_to_systemclock(time);
-
-            // double
-            sample.data = (*it).at(DATA_VALUE_DATA_TAG);
-
-            // Insert data into database
-            insert_nts(entity->participant->domain->id, entity->id, sample, true);
+            write_snapshot_endpoint(writer, *it.second);
         }
     }
 
-    // acknack_count
+    // DataReaders
+    write_snapshot_table_size(writer, datareaders_);
+    for (const auto& super_it : datareaders_)
     {
-        DatabaseDump container = dump.at(DATA_KIND_ACKNACK_COUNT_TAG);
-
-        // Data iterator
-        for (auto it = container.begin(); it != container.end(); ++it)
+        for (const auto& it : super_it.second)
         {
-            AcknackCountSample sample;
+            write_snapshot_endpoint(writer, *it.second);
+        }
+    }
 
-            // std::chrono::system_clock::time_point
-            uint64_t time = string_to_uint((*it).at(DATA_VALUE_SRC_TIME_TAG));
-            sample.src_ts = nanoseconds_to_systemclock(time);
+    if (clear)
+    {
+        // Clear all
+        clear_statistics_data_nts_(the_end_of_time());
+    }
+}
 
-            // uint64_t
-            sample.count = string_to_uint(to_string((*it).at(DATA_VALUE_COUNT_TAG)));
+template<typename T>
+void Database::load_snapshot_endpoints_(
+        SnapshotReader& reader)
+{
+    for (uint64_t i = 0, size = reader.read_uint64(); i < size; ++i)
+    {
+        EntityId entity_id(reader.read_int64());
+        std::string name = reader.read_string();
+        std::string alias = reader.read_string();
+        std::string guid = reader.read_string();
+        Qos qos = read_snapshot_qos(reader);
+        EntityId participant_id(reader.read_int64());
+        EntityId topic_id(reader.read_int64());
+        bool is_virtual_metatraffic = reader.read_bool();
 
-            // Insert data into database
-            insert_nts(entity->participant->domain->id, entity->id, sample, true);
+        std::shared_ptr<DomainParticipant> participant =
+                find_snapshot_entity<DomainParticipant>(entities_by_id_, participant_id, EntityKind::PARTICIPANT);
+        std::shared_ptr<T> entity = std::make_shared<T>(name, qos, guid, participant,
+                        find_snapshot_entity<Topic>(entities_by_id_, topic_id, EntityKind::TOPIC));
+        entity->alias = alias;
+        entity->is_virtual_metatraffic = is_virtual_metatraffic;
+
+        /* Add reference to locator to the endpoint */
+        for (uint64_t j = 0, locators = reader.read_uint64(); j < locators; ++j)
+        {
+            EntityId locator_id(reader.read_int64());
+            entity->locators[locator_id] =
+                    find_snapshot_entity<Locator>(entities_by_id_, locator_id, EntityKind::LOCATOR);
         }
+
+        insert_nts(entity, entity_id);
+
+        load_snapshot_data_(reader, participant->domain->id, entity->id);
     }
+}
 
-    // nackfrag_count
-    {
-        DatabaseDump container = dump.at(DATA_KIND_NACKFRAG_COUNT_TAG);
+void Database::load_snapshot(
+        std::istream& stream)
+{
+    std::lock_guard<std::shared_timed_mutex> guard (mutex_);
 
-        // Data iterator
-        for (auto it = container.begin(); it != container.end(); ++it)
-        {
-            NackfragCountSample sample;
+    if (next_id_ != 0)
+    {
+        throw PreconditionNotMet("Error: Database not empty");
+    }
 
-            // std::chrono::system_clock::time_point
-            uint64_t time = string_to_uint((*it).at(DATA_VALUE_SRC_TIME_TAG));
-            sample.src_ts = nanoseconds_to_systemclock(time);
+    SnapshotReader reader(stream);
+    reader.read_header();
 
-            // uint64_t
-            sample.count = string_to_uint(to_string((*it).at(DATA_VALUE_COUNT_TAG)));
+    // The fields are read into variables in the order in which they are written,
+    // as the evaluation order of the arguments of a call is unspecified
 
-            // Insert data into database
-            insert_nts(entity->participant->domain->id, entity->id, sample, true);
-        }
+    // Locators
+    for (uint64_t i = 0, size = reader.read_uint64(); i < size; ++i)
+    {
+        EntityId entity_id(reader.read_int64());
+        std::string name = reader.read_string();
+        std::shared_ptr<Locator> entity = std::make_shared<Locator>(name);
+        entity->alias = reader.read_string();
+        insert_nts(entity, entity_id);
     }
 
-    // last_reported_acknack_count
+    // Hosts
+    for (uint64_t i = 0, size = reader.read_uint64(); i < size; ++i)
     {
-        // Only insert last reported if there are at least one
-        if (!dump.at(DATA_KIND_ACKNACK_COUNT_TAG).empty())
-        {
-            DatabaseDump container = dump.at(DATA_KIND_ACKNACK_COUNT_LAST_REPORTED_TAG);
+        EntityId entity_id(reader.read_int64());
+        std::string name = reader.read_string();
+        std::shared_ptr<Host> entity = std::make_shared<Host>(name);
+        entity->alias = reader.read_string();
+        insert_nts(entity, entity_id);
+    }
 
-            AcknackCountSample sample;
+    // Users
+    for (uint64_t i = 0, size = reader.read_uint64(); i < size; ++i)
+    {
+        EntityId entity_id(reader.read_int64());
+        std::string name = reader.read_string();
+        std::string alias = reader.read_string();
+        EntityId host_id(reader.read_int64());
+        std::shared_ptr<User> entity = std::make_shared<User>(name,
+                        find_snapshot_entity<Host>(entities_by_id_, host_id, EntityKind::HOST));
+        entity->alias = alias;
+        insert_nts(entity, entity_id);
+    }
 
-            // std::chrono::system_clock::time_point
-            uint64_t time = string_to_uint(std::string(container.at(DATA_VALUE_SRC_TIME_TAG)));
-            sample.src_ts = nanoseconds_to_systemclock(time);
+    // Processes
+    for (uint64_t i = 0, size = reader.read_uint64(); i < size; ++i)
+    {
+        EntityId entity_id(reader.read_int64());
+        std::string name = reader.read_string();
+        std::string alias = reader.read_string();
+        std::string pid = reader.read_string();
+        EntityId user_id(reader.read_int64());
+        std::shared_ptr<Process> entity = std::make_shared<Process>(name, pid,
+                        find_snapshot_entity<User>(entities_by_id_, user_id, EntityKind::USER));
+        entity->alias = alias;
+        insert_nts(entity, entity_id);
+    }
 
-            // uint64_t count;
-            sample.count = string_to_uint(to_string(container.at(DATA_VALUE_COUNT_TAG)));
+    // Domains
+    for (uint64_t i = 0, size = reader.read_uint64(); i < size; ++i)
+    {
+        EntityId entity_id(reader.read_int64());
+        std::string name = reader.read_string();
+        std::shared_ptr<Domain> entity = std::make_shared<Domain>(name);
+        entity->alias = reader.read_string();
+        insert_nts(entity, entity_id);
+    }
 
-            // Insert data into database
-            insert_nts(entity->participant->domain->id, entity->id, sample, true, true);
-        }
+    // Topics
+    for (uint64_t i = 0, size = reader.read_uint64(); i < size; ++i)
+    {
+        EntityId entity_id(reader.read_int64());
+        std::string name = reader.read_string();
+        std::string alias = reader.read_string();
+        std::string data_type = reader.read_string();
+        EntityId domain_id(reader.read_int64());
+        std::shared_ptr<Topic> entity = std::make_shared<Topic>(name, data_type,
+                        find_snapshot_entity<Domain>(entities_by_id_, domain_id, EntityKind::DOMAIN));
+        entity->alias = alias;
+        insert_nts(entity, entity_id);
     }
 
-    // last_reported_nackfrag_count
+    // Participants
+    for (uint64_t i = 0, size = reader.read_uint64(); i < size; ++i)
     {
-        // Only insert last reported if there are at least one
-        if (!dump.at(DATA_KIND_NACKFRAG_COUNT_TAG).empty())
+        EntityId entity_id(reader.read_int64());
+        std::string name = reader.read_string();
+        std::string alias = reader.read_string();
+        std::string guid = reader.read_string();
+        Qos qos = read_snapshot_qos(reader);
+        EntityId domain_id(reader.read_int64());
+        EntityId process_id(reader.read_int64());
+        std::shared_ptr<DomainParticipant> entity = std::make_shared<DomainParticipant>(name, qos, guid, nullptr,
+                        find_snapshot_entity<Domain>(entities_by_id_, domain_id, EntityKind::DOMAIN));
+        entity->alias = alias;
+        insert_nts(entity, entity_id);
+
+        // Link participant with process
+        if (process_id != EntityId::invalid())
         {
-            DatabaseDump container = dump.at(DATA_KIND_NACKFRAG_COUNT_LAST_REPORTED_TAG);
+            find_snapshot_entity<Process>(entities_by_id_, process_id, EntityKind::PROCESS);
+            link_participant_with_process_nts(entity->id, process_id);
+        }
 
-            NackfragCountSample sample;
+        load_snapshot_data_(reader, domain_id, entity->id);
+    }
 
-            // std::chrono::system_clock::time_point
-            uint64_t time = string_to_uint(std::string(container.at(DATA_VALUE_SRC_TIME_TAG)));
-            sample.src_ts = nanoseconds_to_systemclock(time);
+    // DataWriters and DataReaders
+    load_snapshot_endpoints_<DataWriter>(reader);
+    load_snapshot_endpoints_<DataReader>(reader);
+}
 
-            // uint64_t count;
-            sample.count = string_to_uint(to_string(container.at(DATA_VALUE_COUNT_TAG)));
+void Database::load_snapshot_data_(
+        SnapshotReader& reader,
+        const EntityId& domain_id,
+        const EntityId& entity_id)
+{
+    auto insert = [&](const StatisticsSample& sample)
+            {
+                insert_nts(domain_id, entity_id, sample, true);
+            };
+    auto insert_last_reported = [&](const StatisticsSample& sample)
+            {
+                insert_nts(domain_id, entity_id, sample, true, true);
+            };
 
-            // Insert data into database
-            insert_nts(entity->participant->domain->id, entity->id, sample, true, true);
+    for (std::string tag = reader.read_string(); !tag.empty(); tag = reader.read_string())
+    {
+        if (DATA_KIND_DISCOVERY_TIME_TAG == tag)
+        {
+            read_snapshot_keyed_blocks<DiscoveryTimeSample>(reader, [&](int64_t key, DiscoveryTimeSample& sample)
+                    {
+                        sample.remote_entity = EntityId(key);
+                        insert(sample);
+                    });
+        }
+        else if (DATA_KIND_PDP_PACKETS_TAG == tag)
+        {
+            read_snapshot_block<PdpCountSample>(reader, insert);
+        }
+        else if (DATA_KIND_EDP_PACKETS_TAG == tag)
+        {
+            read_snapshot_block<EdpCountSample>(reader, insert);
+        }
+        else if (DATA_KIND_RTPS_PACKETS_SENT_TAG == tag)
+        {
+            read_snapshot_keyed_blocks<RtpsPacketsSentSample>(reader, [&](int64_t key, RtpsPacketsSentSample& sample)
+                    {
+                        sample.remote_locator = EntityId(key);
+                        insert(sample);
+                    });
+        }
+        else if (DATA_KIND_RTPS_BYTES_SENT_TAG == tag)
+        {
+            read_snapshot_keyed_blocks<RtpsBytesSentSample>(reader, [&](int64_t key, RtpsBytesSentSample& sample)
+                    {
+                        sample.remote_locator = EntityId(key);
+                        insert(sample);
+                    });
+        }
+        else if (DATA_KIND_RTPS_PACKETS_LOST_TAG == tag)
+        {
+            read_snapshot_keyed_blocks<RtpsPacketsLostSample>(reader, [&](int64_t key, RtpsPacketsLostSample& sample)
+                    {
+                        sample.remote_locator = EntityId(key);
+                        insert(sample);
+                    });
+        }
+        else if (DATA_KIND_RTPS_BYTES_LOST_TAG == tag)
+        {
+            read_snapshot_keyed_blocks<RtpsBytesLostSample>(reader, [&](int64_t key, RtpsBytesLostSample& sample)
+                    {
+                        sample.remote_locator = EntityId(key);
+                        insert(sample);
+                    });
+        }
+        else if (DATA_KIND_NETWORK_LATENCY_TAG == tag)
+        {
+            read_snapshot_keyed_blocks<NetworkLatencySample>(reader, [&](int64_t key, NetworkLatencySample& sample)
+                    {
+                        sample.remote_locator = EntityId(key);
+                        insert(sample);
+                    });
+        }
+        else if (DATA_KIND_PUBLICATION_THROUGHPUT_TAG == tag)
+        {
+            read_snapshot_block<PublicationThroughputSample>(reader, insert);
+        }
+        else if (DATA_KIND_SUBSCRIPTION_THROUGHPUT_TAG == tag)
+        {
+            read_snapshot_block<SubscriptionThroughputSample>(reader, insert);
+        }
+        else if (DATA_KIND_RESENT_DATA_TAG == tag)
+        {
+            read_snapshot_block<ResentDataSample>(reader, insert);
+        }
+        else if (DATA_KIND_HEARTBEAT_COUNT_TAG == tag)
+        {
+            read_snapshot_block<HeartbeatCountSample>(reader, insert);
+        }
+        else if (DATA_KIND_ACKNACK_COUNT_TAG == tag)
+        {
+            read_snapshot_block<AcknackCountSample>(reader, insert);
+        }
+        else if (DATA_KIND_NACKFRAG_COUNT_TAG == tag)
+        {
+            read_snapshot_block<NackfragCountSample>(reader, insert);
+        }
+        else if (DATA_KIND_GAP_COUNT_TAG == tag)
+        {
+            read_snapshot_block<GapCountSample>(reader, insert);
+        }
+        else if (DATA_KIND_DATA_COUNT_TAG == tag)
+        {
+            read_snapshot_block<DataCountSample>(reader, insert);
+        }
+        else if (DATA_KIND_SAMPLE_DATAS_TAG == tag)
+        {
+            read_snapshot_keyed_blocks<SampleDatasCountSample>(reader,
+                    [&](int64_t key, SampleDatasCountSample& sample)
+                    {
+                        sample.sequence_number = static_cast<uint64_t>(key);
+                        insert(sample);
+                    });
+        }
+        else if (DATA_KIND_FASTDDS_LATENCY_TAG == tag)
+        {
+            read_snapshot_keyed_blocks<HistoryLatencySample>(reader, [&](int64_t key, HistoryLatencySample& sample)
+                    {
+                        sample.reader = EntityId(key);
+                        insert(sample);
+                    });
+        }
+        else if (DATA_KIND_PDP_PACKETS_LAST_REPORTED_TAG == tag)
+        {
+            read_snapshot_block<PdpCountSample>(reader, insert_last_reported);
+        }
+        else if (DATA_KIND_EDP_PACKETS_LAST_REPORTED_TAG == tag)
+        {
+            read_snapshot_block<EdpCountSample>(reader, insert_last_reported);
+        }
+        else if (DATA_KIND_RTPS_PACKETS_SENT_LAST_REPORTED_TAG == tag)
+        {
+            read_snapshot_keyed_blocks<RtpsPacketsSentSample>(reader, [&](int64_t key, RtpsPacketsSentSample& sample)
+                    {
+                        sample.remote_locator = EntityId(key);
+                        insert_last_reported(sample);
+                    });
+        }
+        else if (DATA_KIND_RTPS_BYTES_SENT_LAST_REPORTED_TAG == tag)
+        {
+            read_snapshot_keyed_blocks<RtpsBytesSentSample>(reader, [&](int64_t key, RtpsBytesSentSample& sample)
+                    {
+                        sample.remote_locator = EntityId(key);
+                        insert_last_reported(sample);
+                    });
+        }
+        else if (DATA_KIND_RTPS_PACKETS_LOST_LAST_REPORTED_TAG == tag)
+        {
+            read_snapshot_keyed_blocks<RtpsPacketsLostSample>(reader, [&](int64_t key, RtpsPacketsLostSample& sample)
+                    {
+                        sample.remote_locator = EntityId(key);
+                        insert_last_reported(sample);
+                    });
+        }
+        else if (DATA_KIND_RTPS_BYTES_LOST_LAST_REPORTED_TAG == tag)
+        {
+            read_snapshot_keyed_blocks<RtpsBytesLostSample>(reader, [&](int64_t key, RtpsBytesLostSample& sample)
+                    {
+                        sample.remote_locator = EntityId(key);
+                        insert_last_reported(sample);
+                    });
+        }
+        else if (DATA_KIND_RESENT_DATA_LAST_REPORTED_TAG == tag)
+        {
+            read_snapshot_block<ResentDataSample>(reader, insert_last_reported);
+        }
+        else if (DATA_KIND_HEARTBEAT_COUNT_LAST_REPORTED_TAG == tag)
+        {
+            read_snapshot_block<HeartbeatCountSample>(reader, insert_last_reported);
+        }
+        else if (DATA_KIND_ACKNACK_COUNT_LAST_REPORTED_TAG == tag)
+        {
+            read_snapshot_block<AcknackCountSample>(reader, insert_last_reported);
+        }
+        else if (DATA_KIND_NACKFRAG_COUNT_LAST_REPORTED_TAG == tag)
+        {
+            read_snapshot_block<NackfragCountSample>(reader, insert_last_reported);
+        }
+        else if (DATA_KIND_GAP_COUNT_LAST_REPORTED_TAG == tag)
+        {
+            read_snapshot_block<GapCountSample>(reader, insert_last_reported);
+        }
+        else if (DATA_KIND_DATA_COUNT_LAST_REPORTED_TAG == tag)
+        {
+            read_snapshot_block<DataCountSample>(reader, insert_last_reported);
+        }
+        else
+        {
+            throw CorruptedFile("Unknown data kind in the database snapshot: " + tag);
         }
     }
 }
@@ -4590,13 +7017,10 @@ void Database::change_entity_status_of_kind(
         {
             std::shared_ptr<Host> host;
 
-            for (const auto& host_it : hosts_)
+            auto host_it = hosts_.find(entity_id);
+            if (host_it != hosts_.end())
             {
-                if (host_it.second->id == entity_id)
-                {
-                    host = host_it.second;
-                    break;
-                }
+                host = host_it->second;
             }
             if (host != nullptr && host->active != active)
             {
@@ -4617,13 +7041,10 @@ void Database::change_entity_status_of_kind(
         {
             std::shared_ptr<User> user;
 
-            for (const auto& user_it : users_)
+            auto user_it = users_.find(entity_id);
+            if (user_it != users_.end())
             {
-                if (user_it.second->id == entity_id)
-                {
-                    user = user_it.second;
-                    break;
-                }
+                user = user_it->second;
             }
             if (user != nullptr && user->active != active)
             {
@@ -4676,13 +7097,10 @@ void Database::change_entity_status_of_kind(
         {
             std::shared_ptr<Process> process;
 
-            for (const auto& process_it : processes_)
+            auto process_it = processes_.find(entity_id);
+            if (process_it != processes_.end())
             {
-                if (process_it.second->id == entity_id)
-                {
-                    process = process_it.second;
-                    break;
-                }
+                process = process_it->second;
             }
             if (process != nullptr && process->active != active)
             {
@@ -4735,13 +7153,10 @@ void Database::change_entity_status_of_kind(
         {
             std::shared_ptr<Domain> domain;
 
-            for (const auto& domain_it : domains_)
+            auto domain_it = domains_.find(entity_id);
+            if (domain_it != domains_.end())
             {
-                if (domain_it.second->id == entity_id)
-                {
-                    domain = domain_it.second;
-                    break;
-                }
+                domain = domain_it->second;
             }
             if (domain != nullptr && domain->active != active)
             {
@@ -4755,13 +7170,11 @@ void Database::change_entity_status_of_kind(
 
             for (const auto& domain_it : topics_)
             {
-                for (const auto& topic_it : domain_it.second)
+                auto topic_it = domain_it.second.find(entity_id);
+                if (topic_it != domain_it.second.end())
                 {
-                    if (topic_it.second->id == entity_id)
-                    {
-                        topic = topic_it.second;
-                        break;
-                    }
+                    topic = topic_it->second;
+                    break;
                 }
             }
             if (topic != nullptr && topic->active != active)
@@ -4785,13 +7198,11 @@ void Database::change_entity_status_of_kind(
 
             for (const auto& domain_it : participants_)
             {
-                for (const auto& participant_it : domain_it.second)
+                auto participant_it = domain_it.second.find(entity_id);
+                if (participant_it != domain_it.second.end())
                 {
-                    if (participant_it.second->id == entity_id)
-                    {
-                        participant = participant_it.second;
-                        break;
-                    }
+                    participant = participant_it->second;
+                    break;
                 }
             }
 
@@ -4865,13 +7276,11 @@ void Database::change_entity_status_of_kind(
 
             for (const auto& domain_it : datawriters_)
             {
-                for (const auto& datawriter_it : domain_it.second)
+                auto datawriter_it = domain_it.second.find(entity_id);
+                if (datawriter_it != domain_it.second.end())
                 {
-                    if (datawriter_it.second->id == entity_id)
-                    {
-                        datawriter = datawriter_it.second;
-                        break;
-                    }
+                    datawriter = datawriter_it->second;
+                    break;
                 }
             }
 
@@ -4930,13 +7339,11 @@ void Database::change_entity_status_of_kind(
 
             for (const auto& domain_it : datareaders_)
             {
-                for (const auto& datareader_it : domain_it.second)
+                auto datareader_it = domain_it.second.find(entity_id);
+                if (datareader_it != domain_it.second.end())
                 {
-                    if (datareader_it.second->id == entity_id)
-                    {
-                        datareader = datareader_it.second;
-                        break;
-                    }
+                    datareader = datareader_it->second;
+                    break;
                 }
             }
             if (datareader != nullptr && (datareader->active != active || datareader->topic->active != active))
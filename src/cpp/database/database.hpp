@@ -21,18 +21,29 @@
 #define _EPROSIMA_FASTDDS_STATISTICS_BACKEND_DATABASE_DATABASE_HPP_
 
 #include <atomic>
+#include <cstddef>
+#include <iosfwd>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <shared_mutex>
 #include <sstream>
+#include <string>
 #include <type_traits> // enable_if, is_integral
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <fastdds/rtps/common/Guid.h>
 
 #include <fastdds_statistics_backend/exception/Exception.hpp>
 #include <fastdds_statistics_backend/types/EntityId.hpp>
+#include <fastdds_statistics_backend/types/types.hpp>
 #include <fastdds_statistics_backend/exception/Exception.hpp>
 
 #include <database/entities.hpp>
 #include <types/DataContainer.hpp>
+#include <types/Rollup.hpp>
 
 namespace eprosima {
 namespace statistics_backend {
@@ -76,10 +87,113 @@ std::chrono::system_clock::time_point nanoseconds_to_systemclock(
 
 namespace database {
 
+class DumpReferences;
+class SnapshotReader;
+class SnapshotWriter;
+
+/**
+ * @brief Blocks of contiguous samples selected from the database by @ref Database::select_spans.
+ *
+ * The blocks reference the samples where the database stores them, so the object keeps locked, in shared mode, the
+ * statistics data of the entity from which they were selected, and keeps the entity alive even if it is erased.
+ * The database itself is not kept locked, so the other entities can be queried and modified meanwhile.
+ * While it is alive:
+ *   * the samples cannot be removed, neither by \c clear_statistics_data, \c enforce_retention, \c erase or
+ *     \c clear_inactive_entities, nor by the replacement of the samples of the same sequence number on the
+ *     insertion of SAMPLE_DATAS;
+ *   * no statistics data can be inserted in the entity from which the samples were selected.
+ *
+ * Hence, the blocks must be processed and the object destroyed as soon as possible, and the thread holding it
+ * must not select other blocks nor call any method of the database that modifies it, which would deadlock.
+ * Once the object is destroyed or moved from, the samples of the blocks must not be accessed anymore.
+ */
+class SampleSpans
+{
+public:
+
+    SampleSpans() = default;
+
+    SampleSpans(
+            SampleSpans&& other) = default;
+
+    SampleSpans& operator =(
+            SampleSpans&& other) noexcept
+    {
+        // The previous lock is released while its entity is alive
+        data_lock_ = std::move(other.data_lock_);
+        entity_ = std::move(other.entity_);
+        spans = std::move(other.spans);
+        return *this;
+    }
+
+    SampleSpans(
+            const SampleSpans&) = delete;
+
+    SampleSpans& operator =(
+            const SampleSpans&) = delete;
+
+    //! Blocks of samples, sorted by timestamp
+    std::vector<SampleSpan> spans;
+
+private:
+
+    friend class Database;
+
+    //! Entity whose statistics data is locked, which owns the mutex of its data
+    std::shared_ptr<const Entity> entity_;
+
+    //! Shared lock on the statistics data of the entity, which prevents the insertion and removal of samples
+    std::shared_lock<std::shared_timed_mutex> data_lock_;
+};
+
+/**
+ * @brief Hash functor for the binary representation of a GUID.
+ *
+ * It is used to index the entities of the database by their raw 16 bytes GUID (prefix + entity id),
+ * so they can be found without building the string representation of the GUID.
+ */
+struct GuidHash
+{
+    size_t operator ()(
+            const fastrtps::rtps::GUID_t& guid) const noexcept
+    {
+        // FNV-1a over the 16 bytes of the GUID
+        uint64_t hash = 14695981039346656037ULL;
+        for (uint8_t octet : guid.guidPrefix.value)
+        {
+            hash = (hash ^ octet) * 1099511628211ULL;
+        }
+        for (uint8_t octet : guid.entityId.value)
+        {
+            hash = (hash ^ octet) * 1099511628211ULL;
+        }
+        return static_cast<size_t>(hash);
+    }
+
+};
+
 class Database
 {
 public:
 
+    /**
+     * A statistics sample to be inserted together with others, and the result of its insertion.
+     */
+    struct SampleInsertion
+    {
+        //! The EntityId of the domain that contains the entity
+        EntityId domain_id;
+
+        //! The EntityId to which the sample relates
+        EntityId entity_id;
+
+        //! The sample to be inserted
+        std::unique_ptr<StatisticsSample> sample;
+
+        //! Reason why the sample could not be inserted. Empty if it was inserted
+        std::string error;
+    };
+
     /**
      * @brief Destructor of Database.
      *
@@ -107,6 +221,10 @@ public:
 
     /**
      * @brief Insert a new statistics sample into the database.
+     *
+     * The database mutex is only taken in shared mode, together with the mutex of the data of the entity, unless the
+     * sample creates new entities. Hence, insertions do not block queries on other entities.
+     *
      * @param domain_id The EntityId of the domain that contains the entity.
      * @param entity_id The EntityId to which the sample relates.
      * @param sample The sample to be inserted.
@@ -120,6 +238,20 @@ public:
             const EntityId& entity_id,
             const StatisticsSample& sample);
 
+    /**
+     * @brief Insert several statistics samples into the database, taking the database lock only once.
+     *
+     * Each sample is inserted as in \c insert(domain_id, entity_id, sample).
+     * A sample that cannot be inserted does not prevent the insertion of the rest:
+     * the reason is stored in its \c error field instead of throwing.
+     * The samples that create new entities are inserted last, under the database mutex taken exclusively, so the
+     * order of the samples of each series is kept.
+     *
+     * @param samples The samples to be inserted.
+     */
+    void insert(
+            std::vector<SampleInsertion>& samples);
+
     /**
      * @brief Create the link between a participant and a process.
      *
@@ -218,6 +350,106 @@ public:
             Timestamp t_from,
             Timestamp t_to);
 
+    /**
+     * @brief Select data from the database without copying it.
+     *
+     * Same as the \c select overload for data types that relate to two entities, but the samples are given as the
+     * blocks of contiguous samples where the database stores them, instead of as one pointer per sample.
+     * The type of the samples of every block is the one stored for \c data_type.
+     *
+     * @param data_type The type of the measurement being requested.
+     * @param entity_id_source Id of the source entity of the requested data.
+     * @param entity_id_target Id of the target entity of the requested data.
+     * @param t_from Starting time of the returned measures.
+     * @param t_to Ending time of the returned measures.
+     * @throws eprosima::statistics_backend::BadParameter when the parameters are not consistent:
+     *            * \c t_from must be less than \c t_to.
+     *            * \c data_type must be of a type that relates to two entities.
+     *            * Both EntityIds must be known in the database.
+     * @return The blocks of samples, sorted by timestamp, which keep the data of the entity locked while they are
+     *         alive.
+     *         See @ref SampleSpans for the operations that must not be done before destroying them.
+     */
+    SampleSpans select_spans(
+            DataKind data_type,
+            EntityId entity_id_source,
+            EntityId entity_id_target,
+            Timestamp t_from,
+            Timestamp t_to);
+
+    /**
+     * @brief Select data from the database without copying it.
+     *
+     * Same as the \c select overload for data types that relate to a single entity, but the samples are given as the
+     * blocks of contiguous samples where the database stores them, instead of as one pointer per sample.
+     * The type of the samples of every block is the one stored for \c data_type.
+     *
+     * @param data_type The type of the measurement being requested.
+     * @param entity_id Id of entity of the requested data.
+     * @param t_from Starting time of the returned measures.
+     * @param t_to Ending time of the returned measures.
+     * @throws eprosima::statistics_backend::BadParameter when the parameters are not consistent:
+     *            * \c t_from must be less than \c t_to.
+     *            * \c data_type must be of a type that relates to a single entity.
+     *            * Both EntityIds must be known in the database.
+     * @return The blocks of samples, sorted by timestamp, which keep the data of the entity locked while they are
+     *         alive.
+     *         See @ref SampleSpans for the operations that must not be done before destroying them.
+     */
+    SampleSpans select_spans(
+            DataKind data_type,
+            EntityId entity_id,
+            Timestamp t_from,
+            Timestamp t_to);
+
+    /**
+     * @brief Add to the summaries of some bins the data of two entities, computed from the rollups of the data.
+     *
+     * Only the samples in the bins are summarized: from \c bins.t_from included to \c bins.t_to not included.
+     * The rollups can be used when they are enabled for the data (see @ref set_rollup_resolutions) and one of their
+     * resolutions divides the duration of the bins. Otherwise \c bins.complete is set to false, and the samples
+     * must be selected to compute any statistic over them.
+     *
+     * @param data_type The type of the measurement being requested.
+     * @param entity_id_source Id of the source entity of the requested data.
+     * @param entity_id_target Id of the target entity of the requested data.
+     * @param bins The bins where the data is summarized.
+     * @throws eprosima::statistics_backend::BadParameter when the parameters are not consistent, as in \c select.
+     * @return Whether every summary of \c bins is complete, i.e. \c bins.complete.
+     */
+    bool select_summaries(
+            DataKind data_type,
+            EntityId entity_id_source,
+            EntityId entity_id_target,
+            details::RollupBins& bins);
+
+    /**
+     * @brief Add to the summaries of some bins the data of an entity, computed from the rollups of the data.
+     *
+     * Same as the \c select_summaries overload for data types that relate to two entities.
+     *
+     * @param data_type The type of the measurement being requested.
+     * @param entity_id Id of entity of the requested data.
+     * @param bins The bins where the data is summarized.
+     * @throws eprosima::statistics_backend::BadParameter when the parameters are not consistent, as in \c select.
+     * @return Whether every summary of \c bins is complete, i.e. \c bins.complete.
+     */
+    bool select_summaries(
+            DataKind data_type,
+            EntityId entity_id,
+            details::RollupBins& bins);
+
+    /**
+     * @brief Keep summaries (rollups) of the statistics data of every entity at the given resolutions.
+     *
+     * The summaries are updated as data is inserted or cleared, and they are used by \c select_summaries.
+     * Data that only holds events, i.e. DISCOVERY_TIME and SAMPLE_DATAS, is not summarized.
+     *
+     * @param resolutions Durations of the buckets of each tier of summaries. An empty collection disables them.
+     */
+    void set_rollup_resolutions(
+            const std::vector<Timestamp::duration>& resolutions);
+
     /**
      * @brief Whether an entity id is present/exists in the database.
      *
@@ -301,6 +533,19 @@ public:
             EntityKind entity_kind,
             const std::string& name) const;
 
+    /**
+     * @brief Get the topic of a Domain that matches with the requested name and data type.
+     *
+     * @param domain_id The EntityId of the Domain of the topic.
+     * @param name The name of the topic.
+     * @param data_type The name of the data type of the topic.
+     * @return The EntityId of the matching topic, or EntityId::invalid() if there is no such topic in the Domain.
+     */
+    EntityId get_topic_by_name_and_type(
+            const EntityId& domain_id,
+            const std::string& name,
+            const std::string& data_type) const;
+
     /**
      * @brief Get the entity of a given EntityKind that matches with the requested GUID.
      *
@@ -316,6 +561,26 @@ public:
             EntityKind entity_kind,
             const std::string& guid) const;
 
+    /**
+     * @brief Get the entity of a given EntityKind that matches with the requested binary GUID.
+     *
+     * Equivalent to the overload taking the string representation of the GUID, but it does not need to build that
+     * string, so it is the one to use in the hot paths (i.e. when processing statistics samples).
+     * Only the binary index is looked up, also when the entity is not found: the entities whose GUID string does not
+     * follow the Fast DDS format cannot be found by a binary GUID.
+     *
+     * @param entity_kind The EntityKind of the fetched entities.
+     * @param guid The GUID of the entities to search for.
+     * @throws eprosima::statistics_backend::BadParameter in the following cases:
+     *             * if the given EntityKind does not contain a GUID.
+     *             * if there is no entity with the given parameters.
+     * @return A pair, where the first field is the EntityId of the Domain of the matching entities,
+     *         and the second is the EntityId of the matching entity.
+     */
+    std::pair<EntityId, EntityId> get_entity_by_guid(
+            EntityKind entity_kind,
+            const fastrtps::rtps::GUID_t& guid) const;
+
     /**
      * @brief Get EntityKind given an EntityId.
      *
@@ -338,6 +603,20 @@ public:
     DatabaseDump dump_database(
             const bool clear = false);
 
+    /**
+     * @brief Write a dump of the database to a stream.
+     *
+     * The dump is the same JSON document returned by dump_database(const bool), but it is written as the database
+     * is visited, one sample at a time, so the whole DatabaseDump is never held in memory.
+     * Unless \c clear is set, the database is only locked in shared mode, so samples can still be inserted.
+     *
+     * @param stream Stream where the dump is written.
+     * @param clear If true, remove the statistics data of the database after writing it.
+     */
+    void dump_database(
+            std::ostream& stream,
+            const bool clear = false);
+
     /**
      * @brief Load Entities and their data from dump (json) object.
      *
@@ -347,6 +626,80 @@ public:
     void load_database(
             const DatabaseDump& dump);
 
+    /**
+     * @brief Load Entities and their data from a JSON dump read from a stream, inserting them as they are read.
+     *
+     * Only one entity of the dump is held in memory at a time, unless the containers of the dump are not in the
+     * order in which they are loaded, which is the order used by dump_database(std::ostream&, const bool).
+     * In that case, the entities of a container are kept until the containers they depend on have been loaded.
+     *
+     * @param stream Stream from which the dump is read.
+     * @throws eprosima::statistics_backend::PreconditionNotMet if there are already entities contained within
+     * the database.
+     * @throws eprosima::statistics_backend::CorruptedFile if the references of the entities are not consistent.
+     */
+    void load_database(
+            std::istream& stream);
+
+    /**
+     * @brief Write an incremental dump of the database to a stream.
+     *
+     * The incremental dump is a JSON dump, in the same format as dump_database(std::ostream&, const bool),
+     * with the whole topology of the database but only the statistics data newer than \c since:
+     * every sample of the entities created after \c since, and the samples inserted after \c since in the rest.
+     * It also holds \c since and the returned watermark, so it can be merged with load_database_delta
+     * after the dump from which \c since was returned. The statistics data is not removed from the database.
+     *
+     * @param stream Stream where the incremental dump is written.
+     * @param since Watermark returned by the previous dump. The default watermark dumps all the statistics data.
+     * @return The watermark to give to the next incremental dump.
+     */
+    DumpWatermark dump_database_delta(
+            std::ostream& stream,
+            const DumpWatermark& since = DumpWatermark());
+
+    /**
+     * @brief Merge an incremental dump read from a stream into the database.
+     *
+     * The entities of the dump already in the database get the alias and the process of the dump,
+     * and its statistics data appended. The rest of the entities are inserted, and the entities of the database
+     * that the dump does not contain, except the locators, are removed, as they were removed from the dumped one.
+     *
+     * @param stream Stream from which the incremental dump is read.
+     * @throws eprosima::statistics_backend::CorruptedFile in the following cases:
+     *            * if the references of the entities are not consistent.
+     *            * if an entity created before the watermark of the dump is not in the database,
+     *              which means that a previous dump has not been merged.
+     *            * if an entity created after the watermark of the dump is already in the database,
+     *              which means that the dump has already been merged.
+     */
+    void load_database_delta(
+            std::istream& stream);
+
+    /**
+     * @brief Write a binary snapshot of the database to a stream.
+     *
+     * The entities and their statistics data are written as the database is visited,
+     * so the snapshot is never held in memory. The format is described in database/snapshot.hpp.
+     *
+     * @param stream Stream where the snapshot is written.
+     * @param clear If true, remove the statistics data of the database after writing it.
+     */
+    void dump_snapshot(
+            std::ostream& stream,
+            const bool clear = false);
+
+    /**
+     * @brief Load Entities and their data from a binary snapshot, inserting them as they are read.
+     *
+     * @param stream Stream from which the snapshot is read.
+     * @throws eprosima::statistics_backend::PreconditionNotMet if there are already entities contained within
+     * the database.
+     * @throws eprosima::statistics_backend::CorruptedFile if the snapshot is not valid.
+     */
+    void load_snapshot(
+            std::istream& stream);
+
     /**
      * Change the status (active/inactive) of an entity given an EntityId.
      * Also check if the references of the entity must also be changed and change the status in that case.
@@ -372,6 +725,52 @@ public:
      */
     void clear_inactive_entities();
 
+    /**
+     * @brief Set the limits on the statistics data kept by the database.
+     *
+     * The limits are not enforced by this call, but incrementally by successive calls to \c enforce_retention.
+     *
+     * @param policy The retention policy. A policy without limits disables the enforcement.
+     * @throws eprosima::statistics_backend::BadParameter if the slice duration or the enforcement period is not
+     * positive, or any maximum age is negative.
+     */
+    void set_retention_policy(
+            const RetentionPolicy& policy);
+
+    /**
+     * @brief Enforce the retention policy on the statistics data of the next entities.
+     *
+     * The entities are visited in successive calls, each of them holding the database exclusively for at most
+     * the slice duration of the policy. The memory used is measured while visiting the entities, and it is reduced
+     * in the following visits if it exceeds the memory budget of the policy.
+     *
+     * @return true if every entity has been visited since the last call that returned true, or if there are no
+     * limits to enforce.
+     */
+    bool enforce_retention();
+
+    /**
+     * @brief Whether the retention policy has any limit to enforce.
+     *
+     * It does not take the database lock, so it can be checked while a query holds it.
+     */
+    bool retention_enabled() const;
+
+    /**
+     * @brief Maximum time between two calls to \c enforce_retention, set by the retention policy.
+     *
+     * It does not take the database lock, so it can be checked while a query holds it.
+     */
+    std::chrono::milliseconds retention_period() const;
+
+    /**
+     * @brief Approximate amount of memory used by the statistics data of all the entities, in bytes.
+     *
+     * @return The amount of memory measured on the last complete visit of \c enforce_retention, or 0 if there has
+     * been none.
+     */
+    std::size_t retained_memory_usage() const;
+
 protected:
 
     inline std::string id_to_string(
@@ -493,14 +892,9 @@ protected:
         auto domain_participants = participants_.find(endpoint->participant->domain->id);
         if (domain_participants != participants_.end())
         {
-            for (const auto& participant_it : domain_participants->second)
-            {
-                if (endpoint->participant.get() == participant_it.second.get())
-                {
-                    participant_exists = true;
-                    break;
-                }
-            }
+            auto participant_it = domain_participants->second.find(endpoint->participant->id);
+            participant_exists = participant_it != domain_participants->second.end() &&
+                    endpoint->participant.get() == participant_it->second.get();
         }
 
         if (!participant_exists)
@@ -513,14 +907,9 @@ protected:
         auto domain_topics = topics_.find(endpoint->topic->domain->id);
         if (domain_topics != topics_.end())
         {
-            for (const auto& topic_it : domain_topics->second)
-            {
-                if (endpoint->topic.get() == topic_it.second.get())
-                {
-                    topic_exists = true;
-                    break;
-                }
-            }
+            auto topic_it = domain_topics->second.find(endpoint->topic->id);
+            topic_exists = topic_it != domain_topics->second.end() &&
+                    endpoint->topic.get() == topic_it->second.get();
         }
 
         if (!topic_exists)
@@ -529,20 +918,16 @@ protected:
         }
 
         /* Check that this is indeed a new endpoint and that its GUID is unique */
-        for (const auto& endpoints_it: dds_endpoints<T>())
+        auto endpoint_it = entities_by_id_.find(endpoint->id);
+        if (endpoint_it != entities_by_id_.end() && endpoint.get() == endpoint_it->second.get())
         {
-            for (const auto& endpoint_it : endpoints_it.second)
-            {
-                if (endpoint.get() == endpoint_it.second.get())
-                {
-                    throw BadParameter("Endpoint already exists in the database");
-                }
-                if (endpoint->guid == endpoint_it.second->guid)
-                {
-                    throw BadParameter(
-                              "An endpoint with GUID '" + endpoint->guid + "' already exists in the database");
-                }
-            }
+            throw BadParameter("Endpoint already exists in the database");
+        }
+        auto& endpoints_by_guid = entities_by_guid_[endpoint->kind];
+        if (endpoints_by_guid.find(endpoint->guid) != endpoints_by_guid.end())
+        {
+            throw BadParameter(
+                      "An endpoint with GUID '" + endpoint->guid + "' already exists in the database");
         }
 
         // Add id to the entity
@@ -575,7 +960,7 @@ protected:
         for (auto& locator_it : endpoint->locators)
         {
             // See if we already know the locator
-            auto locators_with_same_name = get_entities_by_name(EntityKind::LOCATOR, locator_it.second->name);
+            auto locators_with_same_name = get_entities_by_name_nts(EntityKind::LOCATOR, locator_it.second->name);
             if (!locators_with_same_name.empty())
             {
                 // It could be only one in the database with the same name
@@ -630,8 +1015,15 @@ protected:
         /* Add endpoint to topics's collection */
         (*(endpoint->topic)).template ddsendpoints<T>()[endpoint->id] = endpoint;
 
+        /* Summarize the statistics data of the endpoint if required */
+        if (!rollup_resolutions_.empty())
+        {
+            endpoint->data.enable_rollups(rollup_resolutions_);
+        }
+
         /* Insert endpoint in the database */
         dds_endpoints<T>()[endpoint->participant->domain->id][endpoint->id] = endpoint;
+        index_entity_nts_(endpoint);
     }
 
     /**
@@ -646,6 +1038,7 @@ protected:
      * @brief Get a dump of an Entity stored in the database.
 
      * @param entity Pointer to Entity to dump.
+     * @param include_data Whether to dump the statistics data of the entity, for the entities that hold it.
      * @return \c DatabaseDump Object representing the entity.
      */
     DatabaseDump dump_entity_(
@@ -659,11 +1052,14 @@ protected:
     DatabaseDump dump_entity_(
             const std::shared_ptr<Topic>& entity);
     DatabaseDump dump_entity_(
-            const std::shared_ptr<DomainParticipant>& entity);
+            const std::shared_ptr<DomainParticipant>& entity,
+            const bool include_data = true);
     DatabaseDump dump_entity_(
-            const std::shared_ptr<DataWriter>& entity);
+            const std::shared_ptr<DataWriter>& entity,
+            const bool include_data = true);
     DatabaseDump dump_entity_(
-            const std::shared_ptr<DataReader>& entity);
+            const std::shared_ptr<DataReader>& entity,
+            const bool include_data = true);
     DatabaseDump dump_entity_(
             const std::shared_ptr<Locator>& entity);
 
@@ -691,11 +1087,66 @@ protected:
             const EntityCountSample& data);
     DatabaseDump dump_data_(
             const ByteCountSample& data);
+    DatabaseDump dump_data_(
+            const EntityDataSample& data);
+    DatabaseDump dump_data_(
+            const DiscoveryTimeSample& data);
     DatabaseDump dump_data_(
             const std::map<EntityId, EntityCountSample>& data);
     DatabaseDump dump_data_(
             const std::map<EntityId, ByteCountSample>& data);
 
+    //! Samples written by a dump to a stream
+    struct SampleDumpRange
+    {
+        //! Only the samples inserted after this epoch are written, see @ref insertion_epoch_
+        uint64_t since = 0;
+
+        //! Whether any sample has been written
+        bool written = false;
+    };
+
+    /**
+     * @brief Write the containers of entities of a dump to a stream, with their statistics data.
+     *
+     * @param stream Stream where the containers are written.
+     * @param since Watermark of the previous dump. Only the samples inserted after it are written.
+     * @return Whether any sample has been written.
+     */
+    bool dump_entities_nts_(
+            std::ostream& stream,
+            const DumpWatermark& since);
+
+    /**
+     * @brief Write a dump of data stored in the database to a stream, one sample at a time.
+
+     * @param stream Stream where the dump is written.
+     * @param data Reference to the data of an entity, or to one of its data containers.
+     * @param range Samples to write, updated with the newest sample written.
+     */
+    void dump_data_(
+            std::ostream& stream,
+            const DomainParticipantData& data,
+            SampleDumpRange& range);
+    void dump_data_(
+            std::ostream& stream,
+            const DataWriterData& data,
+            SampleDumpRange& range);
+    void dump_data_(
+            std::ostream& stream,
+            const DataReaderData& data,
+            SampleDumpRange& range);
+    template<typename T>
+    void dump_data_(
+            std::ostream& stream,
+            const details::DataContainer<T>& data,
+            SampleDumpRange& range);
+    template<typename K, typename T>
+    void dump_data_(
+            std::ostream& stream,
+            const std::map<K, details::DataContainer<T>>& data,
+            SampleDumpRange& range);
+
     /**
      * @brief Remove the statistics data of the database. This not include the info or discovery data.
      *
@@ -753,6 +1204,29 @@ protected:
     std::shared_ptr<Locator>  get_locator_nts(
             EntityId const& entity_id);
 
+    /**
+     * @brief Add an entity, already stored in its collection, to the lookup indexes of the database.
+     *
+     * Every entity is indexed by its EntityId. Participants, datareaders and datawriters are also indexed by their
+     * GUID, both as string and, if the string follows the Fast DDS GUID format, in binary form.
+     *
+     * @param entity The entity to index.
+     * @warning This method does not guard a mutex, as it is expected to be called with mutex already taken.
+     */
+    void index_entity_nts_(
+            const std::shared_ptr<Entity>& entity);
+
+    /**
+     * @brief Remove an entity from the lookup indexes of the database.
+     *
+     * It must be called whenever an entity is removed from its collection.
+     *
+     * @param entity The entity to remove from the indexes.
+     * @warning This method does not guard a mutex, as it is expected to be called with mutex already taken.
+     */
+    void unindex_entity_nts_(
+            const std::shared_ptr<Entity>& entity);
+
     /**
      * @brief Insert a new statistics sample into the database. This method is not thread safe.
      *
@@ -773,6 +1247,20 @@ protected:
             const bool loading = false,
             const bool last_reported = false);
 
+    /**
+     * @brief Whether inserting a statistics sample modifies the entities of the database, besides the data of the
+     * entity to which it relates. This method is not thread safe.
+     *
+     * That is the case of the samples that refer to a locator which is not in the database yet, as the locator is
+     * created on insertion. Those samples need the database mutex taken exclusively, while the rest can be inserted
+     * with the database mutex taken in shared mode.
+     *
+     * @param sample The sample to be inserted.
+     * @return true if the insertion of \c sample creates new entities.
+     */
+    bool sample_creates_entities_nts(
+            const StatisticsSample& sample) const;
+
     /**
      * Get an entity given its EntityId. This method is not thread safe.
      *
@@ -783,6 +1271,72 @@ protected:
     const std::shared_ptr<const Entity> get_entity_nts(
             const EntityId& entity_id) const;
 
+    /**
+     * Get all entities of a given EntityKind that match with the requested name. This method is not thread safe.
+     *
+     * @param entity_kind The EntityKind of the fetched entities.
+     * @param name The name of the entities for which to search.
+     * @throws eprosima::statistics_backend::BadParameter if \c entity_kind is not valid.
+     * @return A vector of pairs, where the first field is the EntityId of the Domain of the matching entities,
+     *         and the second is the EntityId of the matching entities.
+     */
+    std::vector<std::pair<EntityId, EntityId>> get_entities_by_name_nts(
+            EntityKind entity_kind,
+            const std::string& name) const;
+
+    /**
+     * @brief Keep the locks taken to select some samples as long as the samples are used.
+     *
+     * Only @ref SampleSpans reference the samples stored in the database once they are selected, so the lock is
+     * released on return for the other collections. The database lock is always released on return, as the
+     * methods that remove samples also take the lock of the statistics data of the entity.
+     */
+    template<typename Samples>
+    static void keep_locked_(
+            Samples& /*samples*/,
+            const std::shared_ptr<const Entity>& /*entity*/,
+            std::shared_lock<std::shared_timed_mutex>&& /*data_lock*/)
+    {
+    }
+
+    static void keep_locked_(
+            SampleSpans& samples,
+            const std::shared_ptr<const Entity>& entity,
+            std::shared_lock<std::shared_timed_mutex>&& data_lock);
+
+    /**
+     * @brief Select data that relates to two entities from the database.
+     *
+     * @tparam Samples Collection where the data is added, either \c std::vector<const StatisticsSample*>,
+     *                 \c SampleSpans or \c details::RollupBins.
+     * @param samples Collection where the data is added.
+     * @throws eprosima::statistics_backend::BadParameter as \c select.
+     */
+    template<typename Samples>
+    void select_(
+            DataKind data_type,
+            EntityId entity_id_source,
+            EntityId entity_id_target,
+            Timestamp t_from,
+            Timestamp t_to,
+            Samples& samples);
+
+    /**
+     * @brief Select data that relates to a single entity from the database.
+     *
+     * @tparam Samples Collection where the data is added, either \c std::vector<const StatisticsSample*>,
+     *                 \c SampleSpans or \c details::RollupBins.
+     * @param samples Collection where the data is added.
+     * @throws eprosima::statistics_backend::BadParameter as \c select.
+     */
+    template<typename Samples>
+    void select_(
+            DataKind data_type,
+            EntityId entity_id,
+            Timestamp t_from,
+            Timestamp t_to,
+            Samples& samples);
+
     /**
      * @brief Create the link between a participant and a process. This method is not thread safe.
      *
@@ -801,6 +1355,76 @@ protected:
             const EntityId& participant_id,
             const EntityId& process_id);
 
+    /**
+     * @brief Load the entities of a JSON dump read from a stream, merging them with the entities of the database.
+     *
+     * @param stream Stream from which the dump is read.
+     * @throws eprosima::statistics_backend::CorruptedFile if the dump is not consistent with itself
+     * or with the database.
+     */
+    void load_database_nts_(
+            std::istream& stream);
+
+    /**
+     * @brief Check the references of an entity of a dump, and insert it into the database with its data.
+     *
+     * @param references Index of the references of the entities of the dump.
+     * @param container_tag Container of the entity in the dump.
+     * @param entity_id_str ID of the entity in the dump.
+     * @param entity_dump Dump of the entity.
+     * @throws eprosima::statistics_backend::CorruptedFile if the references of the entity are not consistent.
+     */
+    void load_entity_(
+            DumpReferences& references,
+            const std::string& container_tag,
+            const std::string& entity_id_str,
+            const DatabaseDump& entity_dump);
+
+    /**
+     * @brief Merge an entity of an incremental dump with the same entity of the database.
+     *
+     * The alias of the entity is updated, and the data of the dump is appended to its data.
+     * A participant linked with a process in the dump, but not in the database, is not linked here,
+     * as the process may be a new entity of the dump, not inserted yet.
+     *
+     * @param references Index of the references of the entities of the dump.
+     * @param container_tag Container of the entity in the dump.
+     * @param entity_id_str ID of the entity in the dump.
+     * @param entity_dump Dump of the entity.
+     * @param entity The entity of the database.
+     * @param process_links Links between participants and processes to make, where the link of the participant
+     * is added.
+     * @throws eprosima::statistics_backend::CorruptedFile if the references of the entity are not consistent,
+     * or if the entity of the database is not the same entity.
+     */
+    void merge_entity_(
+            DumpReferences& references,
+            const std::string& container_tag,
+            const std::string& entity_id_str,
+            const DatabaseDump& entity_dump,
+            const std::shared_ptr<Entity>& entity,
+            std::vector<std::pair<EntityId, EntityId>>& process_links);
+
+    /**
+     * @brief Remove the entities of the database, except the locators, that are not in a set.
+     *
+     * @param kept IDs of the entities to keep.
+     *
+     * @warning This method does not guard a mutex, as it is expected to be called with mutex already taken.
+     */
+    void erase_entities_not_in_nts_(
+            const std::unordered_set<EntityId>& kept);
+
+    /**
+     * @brief Erase all the data related to a domain.
+     *
+     * @param domain_id The EntityId of the domain to be erased.
+     *
+     * @warning This method does not guard a mutex, as it is expected to be called with mutex already taken.
+     */
+    void erase_nts_(
+            const EntityId& domain_id);
+
     /**
      * @brief Load data from a dump.
 
@@ -821,6 +1445,30 @@ protected:
             const DatabaseDump& dump,
             const std::shared_ptr<DataReader>& entity);
 
+    /**
+     * @brief Read the series of statistics data of an entity from a snapshot, and insert them into the database.
+     *
+     * @param reader Reader of the snapshot, placed at the first series of the entity.
+     * @param domain_id The EntityId of the domain of the entity.
+     * @param entity_id The EntityId of the entity.
+     * @throws eprosima::statistics_backend::CorruptedFile if the series are not valid.
+     */
+    void load_snapshot_data_(
+            SnapshotReader& reader,
+            const EntityId& domain_id,
+            const EntityId& entity_id);
+
+    /**
+     * @brief Load the table of DataWriters or DataReaders of a binary snapshot, with their data.
+     *
+     * @tparam T The DDSEndpoint to load, DataWriter or DataReader.
+     * @param reader Reader positioned at the start of the table.
+     * @throws eprosima::statistics_backend::CorruptedFile if the table is not valid.
+     */
+    template<typename T>
+    void load_snapshot_endpoints_(
+            SnapshotReader& reader);
+
     /**
      * Change the status (active/inactive) of an entity given an EntityId.
      * Also check if the references of the entity must also be changed and change the status in that case.
@@ -911,12 +1559,82 @@ protected:
      */
     std::map<EntityId, std::map<EntityId, std::shared_ptr<Topic>>> topics_;
 
+    /**
+     * Index of every entity in the database by its EntityId, regardless of its kind
+     *
+     * It holds the same entities as the collections above, and allows retrieving any of them in constant time.
+     * It must be updated whenever an entity is inserted into or removed from those collections.
+     */
+    std::unordered_map<EntityId, std::shared_ptr<Entity>> entities_by_id_;
+
+    /**
+     * Index of the participants, datareaders and datawriters by their GUID string, for each of these EntityKinds
+     *
+     * Each value is the pair of the EntityId of the Domain of the entity and the EntityId of the entity.
+     */
+    std::map<EntityKind, std::unordered_map<std::string, std::pair<EntityId, EntityId>>> entities_by_guid_;
+
+    /**
+     * Index of the participants, datareaders and datawriters by their binary GUID, for each of these EntityKinds
+     *
+     * Same as \c entities_by_guid_, but only for the entities whose GUID string follows the Fast DDS format.
+     */
+    std::map<EntityKind, std::unordered_map<fastrtps::rtps::GUID_t, std::pair<EntityId, EntityId>, GuidHash>>
+    entities_by_binary_guid_;
+
+    /**
+     * Index of every entity in the database by its name, for each EntityKind
+     *
+     * Each value is the set of pairs of the EntityId of the Domain of the entity (EntityId::invalid() for physical
+     * entities) and the EntityId of the entity, sorted as they would be found traversing the collections above.
+     */
+    std::map<EntityKind, std::unordered_map<std::string, std::set<std::pair<EntityId, EntityId>>>> entities_by_name_;
+
+    /**
+     * Index of the topics sorted by EntityId of the domain to which they belong
+     *
+     * Each value in the collection is in turn a map of the EntityId of the topics sorted by their name and data type,
+     * as that combination is unique within a domain.
+     */
+    std::map<EntityId, std::map<std::pair<std::string, std::string>, EntityId>> topics_by_name_and_type_;
+
     /**
      * The ID that will be assigned to the next entity.
      * Used to guarantee a unique EntityId within the database instance
      */
     std::atomic<int64_t> next_id_{0};
 
+    /**
+     * Epoch in which the statistics data is being inserted, recorded in the containers of the entities.
+     * Each incremental dump starts a new one, and loading an incremental dump moves it past the dumped ones.
+     * Guarded by \c mutex_: it is only modified with the mutex taken in exclusive mode.
+     */
+    uint64_t insertion_epoch_ = 1;
+
+    //! Resolutions of the summaries of the statistics data of new entities. Empty if they are disabled.
+    std::vector<Timestamp::duration> rollup_resolutions_;
+
+    //! Limits on the statistics data kept by the database
+    RetentionPolicy retention_policy_;
+
+    //! Whether \c retention_policy_ has any limit, so that it can be checked without taking the mutex
+    std::atomic<bool> retention_enabled_{false};
+
+    //! Enforcement period of \c retention_policy_, in milliseconds, so that it can be read without taking the mutex
+    std::atomic<std::chrono::milliseconds::rep> retention_period_{RetentionPolicy().enforcement_period.count()};
+
+    //! Entities not visited yet in the current visit of \c enforce_retention
+    std::vector<std::weak_ptr<Entity>> retention_pending_;
+
+    //! Memory used by the entities visited in the current visit of \c enforce_retention
+    std::size_t retention_visited_memory_ = 0;
+
+    //! Memory used by all the entities, measured on the last complete visit of \c enforce_retention
+    std::size_t retention_memory_ = 0;
+
+    //! Proportion of the data of every series to remove in the current visit to meet the memory budget
+    double retention_eviction_ratio_ = 0.0;
+
     //! Read-write synchronization mutex
     mutable std::shared_timed_mutex mutex_;
 };
@@ -19,6 +19,13 @@
 
 #include "database_queue.hpp"
 
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <fastdds/dds/log/Log.hpp>
 
 namespace eprosima {
@@ -28,6 +35,13 @@ namespace database {
 using namespace eprosima::fastdds::dds;
 using namespace eprosima::fastrtps::rtps;
 
+constexpr std::size_t DatabaseEntityQueue::DEFAULT_ENTITY_CAPACITY;
+constexpr std::size_t DatabaseDataQueue::DEFAULT_BATCH_SIZE;
+constexpr std::size_t DatabaseDataQueue::DEFAULT_PARKING_CAPACITY;
+constexpr std::chrono::milliseconds DatabaseDataQueue::DEFAULT_PARKING_TIMEOUT;
+constexpr std::size_t ShardedDatabaseDataQueue::DEFAULT_SHARD_COUNT;
+constexpr std::size_t ShardedDatabaseDataQueue::DEFAULT_DATA_POOL_CAPACITY;
+
 template<typename T>
 std::string to_string(
         T data)
@@ -63,9 +77,7 @@ EntityId DatabaseEntityQueue::process_participant(
     {
         // See if the participant is already in the database
         // This will throw if the participant is unknown
-        participant_id = database_->get_entity_by_guid(
-            EntityKind::PARTICIPANT, to_string(info.guid))
-                        .second;
+        participant_id = database_->get_entity_by_guid(EntityKind::PARTICIPANT, info.guid).second;
 
         // Update the entity status and check if its references must also change it status
         database_->change_entity_status(participant_id,
@@ -121,9 +133,7 @@ EntityId DatabaseEntityQueue::process_datareader(
     {
         // See if the reader is already in the database
         // This will throw if the reader is unknown
-        datareader_id =
-                database_->get_entity_by_guid(
-            EntityKind::DATAREADER, to_string(info.guid)).second;
+        datareader_id = database_->get_entity_by_guid(EntityKind::DATAREADER, info.guid).second;
 
         // Update the entity status and check if its references must also change it status
         database_->change_entity_status(datareader_id,
@@ -157,9 +167,7 @@ EntityId DatabaseEntityQueue::process_datawriter(
     {
         // See if the writer is already in the database
         // This will throw if the writer is unknown
-        datawriter_id =
-                database_->get_entity_by_guid(
-            EntityKind::DATAWRITER, to_string(info.guid)).second;
+        datawriter_id = database_->get_entity_by_guid(EntityKind::DATAWRITER, info.guid).second;
 
         // Update the entity status and check if its references must also change it status
         database_->change_entity_status(datawriter_id,
@@ -200,7 +208,7 @@ EntityId DatabaseEntityQueue::process_endpoint_discovery(
     std::pair<EntityId, EntityId> participant_id;
     try
     {
-        participant_id = database_->get_entity_by_guid(EntityKind::PARTICIPANT, to_string(participant_guid));
+        participant_id = database_->get_entity_by_guid(EntityKind::PARTICIPANT, participant_guid);
         assert(participant_id.first == info.domain_id);
     }
     catch (const Exception&)
@@ -214,33 +222,17 @@ EntityId DatabaseEntityQueue::process_endpoint_discovery(
         std::static_pointer_cast<const database::DomainParticipant>(database_->get_entity(
             participant_id.second)));
 
-    // Check whether the topic is already in the database
+    // Check whether the topic is already in the database, that is, a topic in the current domain with the same
+    // name AND data type
     std::shared_ptr<database::Topic> topic;
-    auto topic_ids = database_->get_entities_by_name(EntityKind::TOPIC, info.topic_name);
-
-    // Check if any of these topics is in the current domain AND shares the data type
-    for (const auto& topic_id : topic_ids)
+    EntityId topic_id = database_->get_topic_by_name_and_type(info.domain_id, info.topic_name, info.type_name);
+    if (topic_id.is_valid())
     {
-        if (topic_id.first == info.domain_id)
-        {
-            topic = std::const_pointer_cast<database::Topic>(
-                std::static_pointer_cast<const database::Topic>(database_->get_entity(topic_id.second)));
-
-            if (topic->data_type == info.type_name)
-            {
-                //Found the correct topic
-                break;
-            }
-            else
-            {
-                // The data type is not the same, so it must be another topic
-                topic.reset();
-            }
-        }
+        topic = std::const_pointer_cast<database::Topic>(
+            std::static_pointer_cast<const database::Topic>(database_->get_entity(topic_id)));
     }
-
     // If no such topic exists, create a new one
-    if (!topic)
+    else
     {
         topic = std::make_shared<database::Topic>(
             info.topic_name,
@@ -252,7 +244,7 @@ EntityId DatabaseEntityQueue::process_endpoint_discovery(
             topic->alias = info.alias;
         }
 
-        EntityId topic_id = database_->insert(topic);
+        topic_id = database_->insert(topic);
         details::StatisticsBackendData::get_instance()->on_domain_entity_discovery(
             info.domain_id,
             topic_id,
@@ -363,6 +355,14 @@ EntityId DatabaseDataQueue::get_or_create_locator(
         const std::string& locator_name) const
 {
     auto found_remote_locators = database_->get_entities_by_name(EntityKind::LOCATOR, locator_name);
+    if (!found_remote_locators.empty())
+    {
+        return found_remote_locators.front().second;
+    }
+
+    // Another queue may be creating the same locator
+    std::lock_guard<std::mutex> guard(*entity_creation_mutex_);
+    found_remote_locators = database_->get_entities_by_name(EntityKind::LOCATOR, locator_name);
     // In case that the reported locator is not known, create it without being linked to an endpoint
     if (found_remote_locators.empty())
     {
@@ -386,7 +386,7 @@ void DatabaseDataQueue::process_sample_type(
         const DatabaseQueue::StatisticsWriterReaderData& item) const
 {
     sample.data = item.data();
-    std::string reader_guid = deserialize_guid(item.reader_guid());
+    GUID_t reader_guid = deserialize_binary_guid(item.reader_guid());
     try
     {
         auto found_reader = database_->get_entity_by_guid(EntityKind::DATAREADER, reader_guid);
@@ -394,10 +394,10 @@ void DatabaseDataQueue::process_sample_type(
     }
     catch (BadParameter&)
     {
-        throw Error("Reader " + reader_guid + " not found");
+        throw EntityNotFound(reader_guid, "Reader " + to_string(reader_guid) + " not found");
     }
 
-    std::string writer_guid = deserialize_guid(item.writer_guid());
+    GUID_t writer_guid = deserialize_binary_guid(item.writer_guid());
     try
     {
         auto found_entity = database_->get_entity_by_guid(entity_kind, writer_guid);
@@ -406,7 +406,7 @@ void DatabaseDataQueue::process_sample_type(
     }
     catch (BadParameter&)
     {
-        throw Error("Entity " + writer_guid + " not found");
+        throw EntityNotFound(writer_guid, "Entity " + to_string(writer_guid) + " not found");
     }
 }
 
@@ -422,12 +422,17 @@ void DatabaseDataQueue::process_sample_type(
     std::string remote_locator = deserialize_locator(item.dst_locator());
     sample.remote_locator = get_or_create_locator(remote_locator);
 
-    std::string source_locator = deserialize_guid(item.src_locator());
-    // This call will throw BadParameter if there is no such entity
-    // We let this exception through, as it meets expectations
-    auto found_entities = database_->get_entity_by_guid(entity_kind, source_locator);
-    domain = found_entities.first;
-    entity = found_entities.second;
+    GUID_t source_locator = deserialize_binary_guid(item.src_locator());
+    try
+    {
+        auto found_entities = database_->get_entity_by_guid(entity_kind, source_locator);
+        domain = found_entities.first;
+        entity = found_entities.second;
+    }
+    catch (BadParameter&)
+    {
+        throw EntityNotFound(source_locator, "Entity " + to_string(source_locator) + " not found");
+    }
 }
 
 template<>
@@ -440,7 +445,7 @@ void DatabaseDataQueue::process_sample_type(
 {
     sample.data =  item.data();
 
-    std::string guid = deserialize_guid(item.guid());
+    GUID_t guid = deserialize_binary_guid(item.guid());
     try
     {
         auto found_entity = database_->get_entity_by_guid(entity_kind, guid);
@@ -449,7 +454,7 @@ void DatabaseDataQueue::process_sample_type(
     }
     catch (BadParameter&)
     {
-        throw Error("Entity " + guid + " not found");
+        throw EntityNotFound(guid, "Entity " + to_string(guid) + " not found");
     }
 }
 
@@ -465,7 +470,7 @@ void DatabaseDataQueue::process_sample_type(
     std::string remote_locator = deserialize_locator(item.dst_locator());
     sample.remote_locator = get_or_create_locator(remote_locator);
 
-    std::string guid = deserialize_guid(item.src_guid());
+    GUID_t guid = deserialize_binary_guid(item.src_guid());
     try
     {
         auto found_entity = database_->get_entity_by_guid(entity_kind, guid);
@@ -474,7 +479,7 @@ void DatabaseDataQueue::process_sample_type(
     }
     catch (BadParameter&)
     {
-        throw Error("Entity " + guid + " not found");
+        throw EntityNotFound(guid, "Entity " + to_string(guid) + " not found");
     }
 }
 
@@ -491,7 +496,7 @@ void DatabaseDataQueue::process_sample_type(
     std::string remote_locator = deserialize_locator(item.dst_locator());
     sample.remote_locator = get_or_create_locator(remote_locator);
 
-    std::string guid = deserialize_guid(item.src_guid());
+    GUID_t guid = deserialize_binary_guid(item.src_guid());
     try
     {
         auto found_entity = database_->get_entity_by_guid(entity_kind, guid);
@@ -500,7 +505,7 @@ void DatabaseDataQueue::process_sample_type(
     }
     catch (BadParameter&)
     {
-        throw Error("Entity " + guid + " not found");
+        throw EntityNotFound(guid, "Entity " + to_string(guid) + " not found");
     }
 }
 
@@ -514,7 +519,7 @@ void DatabaseDataQueue::process_sample_type(
 {
     sample.count = item.count();
 
-    std::string guid = deserialize_guid(item.guid());
+    GUID_t guid = deserialize_binary_guid(item.guid());
     try
     {
         auto found_entity = database_->get_entity_by_guid(entity_kind, guid);
@@ -523,7 +528,7 @@ void DatabaseDataQueue::process_sample_type(
     }
     catch (BadParameter&)
     {
-        throw Error("Entity " + guid + " not found");
+        throw EntityNotFound(guid, "Entity " + to_string(guid) + " not found");
     }
 }
 
@@ -536,7 +541,7 @@ void DatabaseDataQueue::process_sample_type(
         const StatisticsDiscoveryTime& item) const
 {
     sample.time = nanoseconds_to_systemclock(item.time());
-    std::string remote_entity_guid = deserialize_guid(item.remote_entity_guid());
+    GUID_t remote_entity_guid = deserialize_binary_guid(item.remote_entity_guid());
     try
     {
         auto found_remote_entity = database_->get_entity_by_guid(entity_kind, remote_entity_guid);
@@ -544,10 +549,10 @@ void DatabaseDataQueue::process_sample_type(
     }
     catch (BadParameter&)
     {
-        throw Error("Remote entity " + remote_entity_guid + " not found");
+        throw EntityNotFound(remote_entity_guid, "Remote entity " + to_string(remote_entity_guid) + " not found");
     }
 
-    std::string guid = deserialize_guid(item.local_participant_guid());
+    GUID_t guid = deserialize_binary_guid(item.local_participant_guid());
     try
     {
         auto found_entity = database_->get_entity_by_guid(entity_kind, guid);
@@ -556,7 +561,7 @@ void DatabaseDataQueue::process_sample_type(
     }
     catch (BadParameter&)
     {
-        throw Error("Entity " + guid + " not found");
+        throw EntityNotFound(guid, "Entity " + to_string(guid) + " not found");
     }
 }
 
@@ -580,427 +585,454 @@ void DatabaseDataQueue::process_sample_type(
     }
     catch (BadParameter&)
     {
-        throw Error("Entity " + sample_identity.first + " not found");
+        throw EntityNotFound(sample_identity.first, "Entity " + to_string(sample_identity.first) + " not found");
+    }
+}
+
+template<typename T, typename B, typename Q>
+void DatabaseDataQueue::add_to_batch(
+        const char* event,
+        EntityKind entity_kind,
+        const std::chrono::system_clock::time_point& src_ts,
+        const Q& item,
+        SampleBatch& batch) const
+{
+    std::unique_ptr<T> sample(new T());
+    sample->src_ts = src_ts;
+    EntityId domain;
+    EntityId entity;
+    try
+    {
+        process_sample_type(domain, entity, entity_kind, static_cast<B&>(*sample), item);
+    }
+    catch (const EntityNotFound&)
+    {
+        // The data waits for the discovery of the entity, without holding back the rest of the data
+        throw;
+    }
+    catch (const eprosima::statistics_backend::Exception& e)
+    {
+        logWarning(BACKEND_DATABASE_QUEUE,
+                "Error processing " + std::string(event) +
+                " event. Data was not added to the statistics collection: " + std::string(e.what()));
+        return;
+    }
+
+    Database::SampleInsertion insertion;
+    insertion.domain_id = domain;
+    insertion.entity_id = entity;
+    insertion.sample = std::move(sample);
+    batch.insertions.push_back(std::move(insertion));
+    batch.events.push_back(event);
+}
+
+void DatabaseDataQueue::insert_batch(
+        SampleBatch& batch)
+{
+    if (batch.insertions.empty())
+    {
+        return;
+    }
+
+    // Every sample is inserted under the same database lock
+    database_->insert(batch.insertions);
+
+    // Users are notified once the lock is released
+    for (std::size_t i = 0; i < batch.insertions.size(); ++i)
+    {
+        const Database::SampleInsertion& insertion = batch.insertions[i];
+        if (insertion.error.empty())
+        {
+            details::StatisticsBackendData::get_instance()->on_data_available(insertion.domain_id,
+                    insertion.entity_id, insertion.sample->kind);
+        }
+        else
+        {
+            logWarning(BACKEND_DATABASE_QUEUE,
+                    "Error processing " + std::string(batch.events[i]) +
+                    " event. Data was not added to the statistics collection: " + insertion.error);
+        }
     }
 }
 
 void DatabaseDataQueue::process_sample()
 {
-    switch (front().second->_d())
+    // The data of the entities discovered by now go before the new ones
+    if (has_discovered_guids_.load())
+    {
+        replay_parked();
+    }
+
+    SampleBatch batch;
+    add_or_park(front(), batch, std::chrono::steady_clock::now() + parking_timeout_);
+    insert_batch(batch);
+    recycle(std::move(front().second));
+}
+
+std::size_t DatabaseDataQueue::process_batch()
+{
+    // The data of the entities discovered by now go before the new ones
+    if (has_discovered_guids_.load())
+    {
+        replay_parked();
+    }
+
+    std::size_t count = (std::min)(batch_size_, size());
+    SampleBatch batch;
+    batch.insertions.reserve(count);
+    batch.events.reserve(count);
+    std::chrono::steady_clock::time_point expiration = std::chrono::steady_clock::now() + parking_timeout_;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        add_or_park(peek(i), batch, expiration);
+    }
+    insert_batch(batch);
+
+    // The samples inserted are copies, so the data can be reused by the producers
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        recycle(std::move(peek(i).second));
+    }
+
+    // Data could wait for long in a busy queue otherwise
+    expire_parked();
+    return count;
+}
+
+void DatabaseDataQueue::add_or_park(
+        const queue_item_type& queue_item,
+        SampleBatch& batch,
+        const std::chrono::steady_clock::time_point& expiration)
+{
+    // Data of an entity with parked data wait behind them, even if the entity is already in the database,
+    // so the data of an entity are always inserted in order
+    GUID_t parked_guid;
+    if (find_parked_guid(*queue_item.second, parked_guid))
+    {
+        park(parked_guid, queue_item, expiration, "Entity has older data waiting for its discovery");
+        return;
+    }
+
+    try
+    {
+        add_to_batch(queue_item, batch);
+    }
+    catch (const EntityNotFound& e)
+    {
+        park(e.guid(), queue_item, expiration, e.what());
+    }
+}
+
+bool DatabaseDataQueue::find_parked_guid(
+        const StatisticsData& data,
+        GUID_t& guid) const
+{
+    if (parked_data_.empty())
+    {
+        return false;
+    }
+
+    // The GUIDs of the entities that are looked up to build the samples of the data
+    std::array<GUID_t, 2> guids;
+    std::size_t guid_count = 1;
+    switch (data._d())
     {
         case StatisticsEventKind::HISTORY2HISTORY_LATENCY:
-        {
-            HistoryLatencySample sample;
-            EntityId domain;
-            EntityId entity;
-            queue_item_type item = front();
-            sample.src_ts = item.first;
-            try
-            {
-                process_sample_type(domain, entity, EntityKind::DATAWRITER, sample, item.second->writer_reader_data());
-                database_->insert(domain, entity, sample);
-                details::StatisticsBackendData::get_instance()->on_data_available(domain, entity,
-                        DataKind::FASTDDS_LATENCY);
-            }
-            catch (const eprosima::statistics_backend::Exception& e)
-            {
-                logWarning(BACKEND_DATABASE_QUEUE,
-                        "Error processing HISTORY2HISTORY_LATENCY event. Data was not added to the statistics collection: "
-                        + std::string(
-                            e.what()));
-            }
+            guids[0] = deserialize_binary_guid(data.writer_reader_data().reader_guid());
+            guids[1] = deserialize_binary_guid(data.writer_reader_data().writer_guid());
+            guid_count = 2;
             break;
-        }
         case StatisticsEventKind::NETWORK_LATENCY:
-        {
-            NetworkLatencySample sample;
-            EntityId domain;
-            EntityId entity;
-            queue_item_type item = front();
-            sample.src_ts = item.first;
-            try
-            {
-                process_sample_type(domain, entity, EntityKind::PARTICIPANT, sample,
-                        item.second->locator2locator_data());
-                database_->insert(domain, entity, sample);
-                details::StatisticsBackendData::get_instance()->on_data_available(domain, entity,
-                        DataKind::NETWORK_LATENCY);
-            }
-            catch (const eprosima::statistics_backend::Exception& e)
+            if (data.locator2locator_data().src_locator().port() != 0)
             {
-                logWarning(BACKEND_DATABASE_QUEUE,
-                        "Error processing NETWORK_LATENCY event. Data was not added to the statistics collection: "
-                        + std::string(e.what()));
+                // Wrong format, reported when the data is processed
+                return false;
             }
+            guids[0] = deserialize_binary_guid(data.locator2locator_data().src_locator());
             break;
-        }
         case StatisticsEventKind::PUBLICATION_THROUGHPUT:
-        {
-            PublicationThroughputSample sample;
-            EntityId domain;
-            EntityId entity;
-            queue_item_type item = front();
-            sample.src_ts = item.first;
-            try
-            {
-                process_sample_type(domain, entity, EntityKind::DATAWRITER, static_cast<EntityDataSample&>(sample),
-                        item.second->entity_data());
-                database_->insert(domain, entity, sample);
-                details::StatisticsBackendData::get_instance()->on_data_available(domain, entity,
-                        DataKind::PUBLICATION_THROUGHPUT);
-            }
-            catch (const eprosima::statistics_backend::Exception& e)
-            {
-                logWarning(BACKEND_DATABASE_QUEUE,
-                        "Error processing PUBLICATION_THROUGHPUT event. Data was not added to the statistics collection: "
-                        + std::string(
-                            e.what()));
-            }
-            break;
-        }
         case StatisticsEventKind::SUBSCRIPTION_THROUGHPUT:
-        {
-            SubscriptionThroughputSample sample;
-            EntityId domain;
-            EntityId entity;
-            queue_item_type item = front();
-            sample.src_ts = item.first;
-            try
-            {
-                process_sample_type(domain, entity, EntityKind::DATAREADER, static_cast<EntityDataSample&>(sample),
-                        item.second->entity_data());
-                database_->insert(domain, entity, sample);
-                details::StatisticsBackendData::get_instance()->on_data_available(domain, entity,
-                        DataKind::SUBSCRIPTION_THROUGHPUT);
-            }
-            catch (const eprosima::statistics_backend::Exception& e)
-            {
-                logWarning(BACKEND_DATABASE_QUEUE,
-                        "Error processing SUBSCRIPTION_THROUGHPUT event. Data was not added to the statistics collection: "
-                        + std::string(
-                            e.what()));
-            }
+            guids[0] = deserialize_binary_guid(data.entity_data().guid());
             break;
-        }
         case StatisticsEventKind::RTPS_SENT:
+        case StatisticsEventKind::RTPS_LOST:
+            guids[0] = deserialize_binary_guid(data.entity2locator_traffic().src_guid());
+            break;
+        case StatisticsEventKind::RESENT_DATAS:
+        case StatisticsEventKind::HEARTBEAT_COUNT:
+        case StatisticsEventKind::ACKNACK_COUNT:
+        case StatisticsEventKind::NACKFRAG_COUNT:
+        case StatisticsEventKind::GAP_COUNT:
+        case StatisticsEventKind::DATA_COUNT:
+        case StatisticsEventKind::PDP_PACKETS:
+        case StatisticsEventKind::EDP_PACKETS:
+            guids[0] = deserialize_binary_guid(data.entity_count().guid());
+            break;
+        case StatisticsEventKind::DISCOVERED_ENTITY:
+            guids[0] = deserialize_binary_guid(data.discovery_time().remote_entity_guid());
+            guids[1] = deserialize_binary_guid(data.discovery_time().local_participant_guid());
+            guid_count = 2;
+            break;
+        case StatisticsEventKind::SAMPLE_DATAS:
+            guids[0] = deserialize_sample_identity(data.sample_identity_count().sample_id()).first;
+            break;
+        default:
+            return false;
+    }
+
+    for (std::size_t i = 0; i < guid_count; ++i)
+    {
+        if (parked_data_.find(guids[i]) != parked_data_.end())
         {
-            RtpsPacketsSentSample packet_sample;
-            RtpsBytesSentSample byte_sample;
-            EntityId domain;
-            EntityId entity;
-            queue_item_type item = front();
-            packet_sample.src_ts = item.first;
-            byte_sample.src_ts = item.first;
+            guid = guids[i];
+            return true;
+        }
+    }
+    return false;
+}
 
-            try
-            {
-                process_sample_type(domain, entity, EntityKind::DATAWRITER,
-                        static_cast<EntityToLocatorCountSample&>(packet_sample),
-                        item.second->entity2locator_traffic());
-                database_->insert(domain, entity, packet_sample);
-            }
-            catch (const eprosima::statistics_backend::Exception& e)
-            {
-                logWarning(BACKEND_DATABASE_QUEUE,
-                        "Error processing RTPS_SENT event. Data was not added to the statistics collection: "
-                        + std::string(e.what()));
-            }
-            try
-            {
-                process_sample_type(domain, entity, EntityKind::DATAWRITER,
-                        static_cast<ByteToLocatorCountSample&>(byte_sample),
-                        item.second->entity2locator_traffic());
-                database_->insert(domain, entity, byte_sample);
-                details::StatisticsBackendData::get_instance()->on_data_available(domain, entity,
-                        DataKind::RTPS_PACKETS_SENT);
-                details::StatisticsBackendData::get_instance()->on_data_available(domain, entity,
-                        DataKind::RTPS_BYTES_SENT);
-            }
-            catch (const eprosima::statistics_backend::Exception& e)
+void DatabaseDataQueue::park(
+        const GUID_t& guid,
+        const queue_item_type& queue_item,
+        const std::chrono::steady_clock::time_point& expiration,
+        const char* reason)
+{
+    if (parked_count_ >= parking_capacity_)
+    {
+        expired_samples_.fetch_add(1);
+        logWarning(BACKEND_DATABASE_QUEUE,
+                "Error processing statistics data. Data was not added to the statistics collection: " +
+                std::string(reason) + ", and there is no room to wait for its discovery");
+        return;
+    }
+
+    ParkedSample parked;
+    parked.expiration = expiration;
+    parked.item = queue_item;
+    parked_data_[guid].push_back(std::move(parked));
+    ++parked_count_;
+    next_expiration_ = (std::min)(next_expiration_, expiration);
+    parked_samples_.fetch_add(1);
+}
+
+void DatabaseDataQueue::entity_discovered(
+        const GUID_t& guid)
+{
+    {
+        std::lock_guard<std::mutex> guard(discovered_mutex_);
+        discovered_guids_.push_back(guid);
+    }
+
+    // Wake up the consumer with its mutex taken, so it does not miss the notification (see pending_work)
+    std::lock_guard<std::mutex> guard(cv_mutex_);
+    has_discovered_guids_.store(true);
+    cv_.notify_all();
+}
+
+void DatabaseDataQueue::report_dropped()
+{
+    uint64_t dropped_count = dropped();
+    if (dropped_count == reported_dropped_)
+    {
+        return;
+    }
+
+    logWarning(BACKEND_DATABASE_QUEUE,
+            "Error processing " + std::to_string(dropped_count - reported_dropped_) +
+            " statistics data. Data was not added to the statistics collection: the queue was full");
+    reported_dropped_ = dropped_count;
+}
+
+void DatabaseDataQueue::replay_parked()
+{
+    std::vector<GUID_t> discovered;
+    {
+        std::lock_guard<std::mutex> guard(discovered_mutex_);
+        discovered.swap(discovered_guids_);
+        has_discovered_guids_.store(false);
+    }
+
+    std::vector<ParkedSample> replayed;
+    for (const GUID_t& guid : discovered)
+    {
+        auto it = parked_data_.find(guid);
+        if (it == parked_data_.end())
+        {
+            continue;
+        }
+        std::move(it->second.begin(), it->second.end(), std::back_inserter(replayed));
+        parked_data_.erase(it);
+    }
+    if (replayed.empty())
+    {
+        return;
+    }
+    parked_count_ -= replayed.size();
+    replayed_samples_.fetch_add(replayed.size());
+
+    // The data are replayed in the order in which they were generated, not in the one in which they were parked
+    std::stable_sort(replayed.begin(), replayed.end(),
+            [](const ParkedSample& a, const ParkedSample& b)
             {
-                logWarning(BACKEND_DATABASE_QUEUE,
-                        "Error processing RTPS_SENT event. Data was not added to the statistics collection: "
-                        + std::string(e.what()));
-            }
-            break;
+                return a.item.first < b.item.first;
+            });
+
+    // Data that still refer to another unknown entity are parked again, keeping their expiration
+    SampleBatch batch;
+    for (const ParkedSample& parked : replayed)
+    {
+        add_or_park(parked.item, batch, parked.expiration);
+    }
+    insert_batch(batch);
+
+    for (ParkedSample& parked : replayed)
+    {
+        recycle(std::move(parked.item.second));
+    }
+}
+
+void DatabaseDataQueue::expire_parked()
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (parked_data_.empty() || now < next_expiration_)
+    {
+        return;
+    }
+
+    next_expiration_ = (std::chrono::steady_clock::time_point::max)();
+    for (auto it = parked_data_.begin(); it != parked_data_.end();)
+    {
+        std::vector<ParkedSample>& samples = it->second;
+        auto expired = std::partition(samples.begin(), samples.end(),
+                        [&now](const ParkedSample& parked)
+                        {
+                            return parked.expiration > now;
+                        });
+        std::size_t expired_count = std::distance(expired, samples.end());
+        if (expired_count > 0)
+        {
+            logWarning(BACKEND_DATABASE_QUEUE,
+                    "Error processing " + std::to_string(expired_count) + " statistics data of entity " +
+                    to_string(it->first) +
+                    ". Data was not added to the statistics collection: the entity was not discovered in time");
+            samples.erase(expired, samples.end());
+            parked_count_ -= expired_count;
+            expired_samples_.fetch_add(expired_count);
         }
-        case StatisticsEventKind::RTPS_LOST:
+
+        if (samples.empty())
         {
+            it = parked_data_.erase(it);
+            continue;
+        }
+        for (const ParkedSample& parked : samples)
+        {
+            next_expiration_ = (std::min)(next_expiration_, parked.expiration);
+        }
+        ++it;
+    }
+}
 
-            RtpsPacketsLostSample packet_sample;
-            RtpsBytesLostSample byte_sample;
-            EntityId domain;
-            EntityId entity;
-            queue_item_type item = front();
-            packet_sample.src_ts = item.first;
-            byte_sample.src_ts = item.first;
-            try
-            {
-                process_sample_type(domain, entity, EntityKind::DATAWRITER,
-                        static_cast<EntityToLocatorCountSample&>(packet_sample),
-                        item.second->entity2locator_traffic());
-                database_->insert(domain, entity, packet_sample);
-            }
-            catch (const eprosima::statistics_backend::Exception& e)
-            {
-                logWarning(BACKEND_DATABASE_QUEUE,
-                        "Error processing RTPS_LOST event. Data was not added to the statistics collection: "
-                        + std::string(e.what()));
-            }
-            try
-            {
-                process_sample_type(domain, entity, EntityKind::DATAWRITER,
-                        static_cast<ByteToLocatorCountSample&>(byte_sample),
-                        item.second->entity2locator_traffic());
-                database_->insert(domain, entity, byte_sample);
-                details::StatisticsBackendData::get_instance()->on_data_available(domain, entity,
-                        DataKind::RTPS_PACKETS_LOST);
-                details::StatisticsBackendData::get_instance()->on_data_available(domain, entity,
-                        DataKind::RTPS_BYTES_LOST);
-            }
-            catch (const eprosima::statistics_backend::Exception& e)
-            {
-                logWarning(BACKEND_DATABASE_QUEUE,
-                        "Error processing RTPS_LOST event. Data was not added to the statistics collection: "
-                        + std::string(e.what()));
-            }
+void DatabaseEntityQueue::notify_discovery(
+        const EntityDiscoveryInfo& info)
+{
+    ShardedDatabaseDataQueue* data_queue = data_queue_.load();
+    if (nullptr != data_queue &&
+            info.discovery_status == details::StatisticsBackendData::DiscoveryStatus::DISCOVERY)
+    {
+        data_queue->entity_discovered(info.guid);
+    }
+}
+
+void DatabaseDataQueue::add_to_batch(
+        const queue_item_type& queue_item,
+        SampleBatch& batch)
+{
+    const std::chrono::system_clock::time_point& src_ts = queue_item.first;
+    const StatisticsData& data = *queue_item.second;
+
+    switch (data._d())
+    {
+        case StatisticsEventKind::HISTORY2HISTORY_LATENCY:
+            add_to_batch<HistoryLatencySample, HistoryLatencySample>("HISTORY2HISTORY_LATENCY",
+                    EntityKind::DATAWRITER, src_ts, data.writer_reader_data(), batch);
+            break;
+        case StatisticsEventKind::NETWORK_LATENCY:
+            add_to_batch<NetworkLatencySample, NetworkLatencySample>("NETWORK_LATENCY",
+                    EntityKind::PARTICIPANT, src_ts, data.locator2locator_data(), batch);
+            break;
+        case StatisticsEventKind::PUBLICATION_THROUGHPUT:
+            add_to_batch<PublicationThroughputSample, EntityDataSample>("PUBLICATION_THROUGHPUT",
+                    EntityKind::DATAWRITER, src_ts, data.entity_data(), batch);
+            break;
+        case StatisticsEventKind::SUBSCRIPTION_THROUGHPUT:
+            add_to_batch<SubscriptionThroughputSample, EntityDataSample>("SUBSCRIPTION_THROUGHPUT",
+                    EntityKind::DATAREADER, src_ts, data.entity_data(), batch);
+            break;
+        case StatisticsEventKind::RTPS_SENT:
+            add_to_batch<RtpsPacketsSentSample, EntityToLocatorCountSample>("RTPS_SENT",
+                    EntityKind::DATAWRITER, src_ts, data.entity2locator_traffic(), batch);
+            add_to_batch<RtpsBytesSentSample, ByteToLocatorCountSample>("RTPS_SENT",
+                    EntityKind::DATAWRITER, src_ts, data.entity2locator_traffic(), batch);
+            break;
+        case StatisticsEventKind::RTPS_LOST:
+            add_to_batch<RtpsPacketsLostSample, EntityToLocatorCountSample>("RTPS_LOST",
+                    EntityKind::DATAWRITER, src_ts, data.entity2locator_traffic(), batch);
+            add_to_batch<RtpsBytesLostSample, ByteToLocatorCountSample>("RTPS_LOST",
+                    EntityKind::DATAWRITER, src_ts, data.entity2locator_traffic(), batch);
             break;
-        }
         case StatisticsEventKind::RESENT_DATAS:
-        {
-            ResentDataSample sample;
-            EntityId domain;
-            EntityId entity;
-            queue_item_type item = front();
-            sample.src_ts = item.first;
-            try
-            {
-                process_sample_type(domain, entity, EntityKind::DATAWRITER, static_cast<EntityCountSample&>(sample),
-                        item.second->entity_count());
-                database_->insert(domain, entity, sample);
-                details::StatisticsBackendData::get_instance()->on_data_available(domain, entity,
-                        DataKind::RESENT_DATA);
-            }
-            catch (const eprosima::statistics_backend::Exception& e)
-            {
-                logWarning(BACKEND_DATABASE_QUEUE,
-                        "Error processing RESENT_DATAS event. Data was not added to the statistics collection: "
-                        + std::string(e.what()));
-            }
+            add_to_batch<ResentDataSample, EntityCountSample>("RESENT_DATAS",
+                    EntityKind::DATAWRITER, src_ts, data.entity_count(), batch);
             break;
-        }
         case StatisticsEventKind::HEARTBEAT_COUNT:
-        {
-            HeartbeatCountSample sample;
-            EntityId domain;
-            EntityId entity;
-            queue_item_type item = front();
-            sample.src_ts = item.first;
-            try
-            {
-                process_sample_type(domain, entity, EntityKind::DATAWRITER, static_cast<EntityCountSample&>(sample),
-                        item.second->entity_count());
-                database_->insert(domain, entity, sample);
-                details::StatisticsBackendData::get_instance()->on_data_available(domain, entity,
-                        DataKind::HEARTBEAT_COUNT);
-            }
-            catch (const eprosima::statistics_backend::Exception& e)
-            {
-                logWarning(BACKEND_DATABASE_QUEUE,
-                        "Error processing HEARTBEAT_COUNT event. Data was not added to the statistics collection: "
-                        + std::string(e.what()));
-            }
+            add_to_batch<HeartbeatCountSample, EntityCountSample>("HEARTBEAT_COUNT",
+                    EntityKind::DATAWRITER, src_ts, data.entity_count(), batch);
             break;
-        }
         case StatisticsEventKind::ACKNACK_COUNT:
-        {
-            AcknackCountSample sample;
-            EntityId domain;
-            EntityId entity;
-            queue_item_type item = front();
-            sample.src_ts = item.first;
-            try
-            {
-                process_sample_type(domain, entity, EntityKind::DATAREADER, static_cast<EntityCountSample&>(sample),
-                        item.second->entity_count());
-                database_->insert(domain, entity, sample);
-                details::StatisticsBackendData::get_instance()->on_data_available(domain, entity,
-                        DataKind::ACKNACK_COUNT);
-            }
-            catch (const eprosima::statistics_backend::Exception& e)
-            {
-                logWarning(BACKEND_DATABASE_QUEUE,
-                        "Error processing ACKNACK_COUNT event. Data was not added to the statistics collection: "
-                        + std::string(e.what()));
-            }
+            add_to_batch<AcknackCountSample, EntityCountSample>("ACKNACK_COUNT",
+                    EntityKind::DATAREADER, src_ts, data.entity_count(), batch);
             break;
-        }
         case StatisticsEventKind::NACKFRAG_COUNT:
-        {
-            NackfragCountSample sample;
-            EntityId domain;
-            EntityId entity;
-            queue_item_type item = front();
-            sample.src_ts = item.first;
-            try
-            {
-                process_sample_type(domain, entity, EntityKind::DATAREADER, static_cast<EntityCountSample&>(sample),
-                        item.second->entity_count());
-                database_->insert(domain, entity, sample);
-                details::StatisticsBackendData::get_instance()->on_data_available(domain, entity,
-                        DataKind::NACKFRAG_COUNT);
-            }
-            catch (const eprosima::statistics_backend::Exception& e)
-            {
-                logWarning(BACKEND_DATABASE_QUEUE,
-                        "Error processing NACKFRAG_COUNT event. Data was not added to the statistics collection: "
-                        + std::string(e.what()));
-            }
+            add_to_batch<NackfragCountSample, EntityCountSample>("NACKFRAG_COUNT",
+                    EntityKind::DATAREADER, src_ts, data.entity_count(), batch);
             break;
-        }
         case StatisticsEventKind::GAP_COUNT:
-        {
-            GapCountSample sample;
-            EntityId domain;
-            EntityId entity;
-            queue_item_type item = front();
-            sample.src_ts = item.first;
-            try
-            {
-                process_sample_type(domain, entity, EntityKind::DATAWRITER, static_cast<EntityCountSample&>(sample),
-                        item.second->entity_count());
-                database_->insert(domain, entity, sample);
-                details::StatisticsBackendData::get_instance()->on_data_available(domain, entity, DataKind::GAP_COUNT);
-            }
-            catch (const eprosima::statistics_backend::Exception& e)
-            {
-                logWarning(BACKEND_DATABASE_QUEUE,
-                        "Error processing GAP_COUNT event. Data was not added to the statistics collection: "
-                        + std::string(e.what()));
-            }
+            add_to_batch<GapCountSample, EntityCountSample>("GAP_COUNT",
+                    EntityKind::DATAWRITER, src_ts, data.entity_count(), batch);
             break;
-        }
         case StatisticsEventKind::DATA_COUNT:
-        {
-            DataCountSample sample;
-            EntityId domain;
-            EntityId entity;
-            queue_item_type item = front();
-            sample.src_ts = item.first;
-            try
-            {
-                process_sample_type(domain, entity, EntityKind::DATAWRITER, static_cast<EntityCountSample&>(sample),
-                        item.second->entity_count());
-                database_->insert(domain, entity, sample);
-                details::StatisticsBackendData::get_instance()->on_data_available(domain, entity, DataKind::DATA_COUNT);
-            }
-            catch (const eprosima::statistics_backend::Exception& e)
-            {
-                logWarning(BACKEND_DATABASE_QUEUE,
-                        "Error processing DATA_COUNT event. Data was not added to the statistics collection: "
-                        + std::string(e.what()));
-            }
+            add_to_batch<DataCountSample, EntityCountSample>("DATA_COUNT",
+                    EntityKind::DATAWRITER, src_ts, data.entity_count(), batch);
             break;
-        }
         case StatisticsEventKind::PDP_PACKETS:
-        {
-            PdpCountSample sample;
-            EntityId domain;
-            EntityId entity;
-            queue_item_type item = front();
-            sample.src_ts = item.first;
-            try
-            {
-                process_sample_type(domain, entity, EntityKind::PARTICIPANT, static_cast<EntityCountSample&>(sample),
-                        item.second->entity_count());
-                database_->insert(domain, entity, sample);
-                details::StatisticsBackendData::get_instance()->on_data_available(domain, entity,
-                        DataKind::PDP_PACKETS);
-            }
-            catch (const eprosima::statistics_backend::Exception& e)
-            {
-                logWarning(BACKEND_DATABASE_QUEUE,
-                        "Error processing PDP_PACKETS event. Data was not added to the statistics collection: "
-                        + std::string(e.what()));
-            }
+            add_to_batch<PdpCountSample, EntityCountSample>("PDP_PACKETS",
+                    EntityKind::PARTICIPANT, src_ts, data.entity_count(), batch);
             break;
-        }
         case StatisticsEventKind::EDP_PACKETS:
-        {
-            EdpCountSample sample;
-            EntityId domain;
-            EntityId entity;
-            queue_item_type item = front();
-            sample.src_ts = item.first;
-            try
-            {
-                process_sample_type(domain, entity, EntityKind::PARTICIPANT, static_cast<EntityCountSample&>(sample),
-                        item.second->entity_count());
-                database_->insert(domain, entity, sample);
-                details::StatisticsBackendData::get_instance()->on_data_available(domain, entity,
-                        DataKind::EDP_PACKETS);
-            }
-            catch (const eprosima::statistics_backend::Exception& e)
-            {
-                logWarning(BACKEND_DATABASE_QUEUE,
-                        "Error processing EDP_PACKETS event. Data was not added to the statistics collection: "
-                        + std::string(e.what()));
-            }
+            add_to_batch<EdpCountSample, EntityCountSample>("EDP_PACKETS",
+                    EntityKind::PARTICIPANT, src_ts, data.entity_count(), batch);
             break;
-        }
         case StatisticsEventKind::DISCOVERED_ENTITY:
-        {
-            DiscoveryTimeSample sample;
-            EntityId domain;
-            EntityId entity;
-            queue_item_type item = front();
-            sample.src_ts = item.first;
-            try
-            {
-                process_sample_type(domain, entity, EntityKind::PARTICIPANT, sample, item.second->discovery_time());
-                database_->insert(domain, entity, sample);
-                details::StatisticsBackendData::get_instance()->on_data_available(domain, entity,
-                        DataKind::DISCOVERY_TIME);
-            }
-            catch (const eprosima::statistics_backend::Exception& e)
-            {
-                logWarning(BACKEND_DATABASE_QUEUE,
-                        "Error processing DISCOVERED_ENTITY event. Data was not added to the statistics collection: "
-                        + std::string(e.what()));
-            }
+            add_to_batch<DiscoveryTimeSample, DiscoveryTimeSample>("DISCOVERED_ENTITY",
+                    EntityKind::PARTICIPANT, src_ts, data.discovery_time(), batch);
             break;
-        }
         case StatisticsEventKind::SAMPLE_DATAS:
-        {
-            SampleDatasCountSample sample;
-            EntityId domain;
-            EntityId entity;
-            queue_item_type item = front();
-            sample.src_ts = item.first;
-            try
-            {
-                process_sample_type(domain, entity, EntityKind::DATAWRITER, sample,
-                        item.second->sample_identity_count());
-                database_->insert(domain, entity, sample);
-                details::StatisticsBackendData::get_instance()->on_data_available(domain, entity,
-                        DataKind::SAMPLE_DATAS);
-            }
-            catch (const eprosima::statistics_backend::Exception& e)
-            {
-                logWarning(BACKEND_DATABASE_QUEUE,
-                        "Error processing SAMPLE_DATAS event. Data was not added to the statistics collection: "
-                        + std::string(e.what()));
-            }
+            add_to_batch<SampleDatasCountSample, SampleDatasCountSample>("SAMPLE_DATAS",
+                    EntityKind::DATAWRITER, src_ts, data.sample_identity_count(), batch);
             break;
-        }
         case StatisticsEventKind::PHYSICAL_DATA:
         {
-            StatisticsPhysicalData item = front().second->physical_data();
+            // Physical data does not produce samples, so it is processed right away
+            StatisticsPhysicalData item = data.physical_data();
+
+            // Another queue may be creating the same physical entities
+            std::lock_guard<std::mutex> guard(*entity_creation_mutex_);
 
             try
             {
                 // Take the ID of the Participant from its GUID
-                std::string participant_guid = deserialize_guid(item.participant_guid());
+                GUID_t participant_guid = deserialize_binary_guid(item.participant_guid());
                 auto participants = database_->get_entity_by_guid(EntityKind::PARTICIPANT, participant_guid);
                 EntityId participant_id = participants.second;
 
@@ -1094,6 +1126,183 @@ void DatabaseDataQueue::process_sample()
     }
 }
 
+ShardedDatabaseDataQueue::ShardedDatabaseDataQueue(
+        database::Database* database,
+        std::size_t shard_count)
+    : database_(database)
+    , entity_creation_mutex_(std::make_shared<std::mutex>())
+    , data_pool_(std::make_shared<details::ObjectPool<eprosima::fastdds::statistics::Data>>(DEFAULT_DATA_POOL_CAPACITY))
+{
+    set_shard_count(shard_count);
+}
+
+void ShardedDatabaseDataQueue::flush()
+{
+    for (auto& shard : shards_)
+    {
+        shard->flush();
+    }
+}
+
+bool ShardedDatabaseDataQueue::stop_consumer()
+{
+    bool stopped = false;
+    for (auto& shard : shards_)
+    {
+        stopped = shard->stop_consumer() || stopped;
+    }
+    return stopped;
+}
+
+bool ShardedDatabaseDataQueue::start_consumer()
+{
+    bool started = false;
+    for (auto& shard : shards_)
+    {
+        started = shard->start_consumer() || started;
+    }
+    return started;
+}
+
+void ShardedDatabaseDataQueue::entity_discovered(
+        const GUID_t& guid)
+{
+    // The parked data are keyed by the GUID of the missing entity, which may belong to any shard
+    for (auto& shard : shards_)
+    {
+        shard->entity_discovered(guid);
+    }
+}
+
+void ShardedDatabaseDataQueue::set_shard_count(
+        std::size_t shard_count)
+{
+    shard_count = (std::max)(shard_count, std::size_t(1));
+
+    // The data of an entity may change its shard, so the ones already pushed are processed first
+    flush();
+
+    while (shards_.size() > shard_count)
+    {
+        shards_.pop_back();
+    }
+    while (shards_.size() < shard_count)
+    {
+        shards_.push_back(create_shard());
+    }
+}
+
+std::unique_ptr<DatabaseDataQueue> ShardedDatabaseDataQueue::create_shard() const
+{
+    std::unique_ptr<DatabaseDataQueue> shard(new DatabaseDataQueue(database_));
+    shard->set_entity_creation_mutex(entity_creation_mutex_);
+    shard->set_data_pool(data_pool_);
+
+    // The first shard enforces the retention policy of the database on behalf of all of them
+    shard->set_retention_enforcement(shards_.empty());
+    return shard;
+}
+
+uint64_t ShardedDatabaseDataQueue::dropped() const noexcept
+{
+    uint64_t count = 0;
+    for (const auto& shard : shards_)
+    {
+        count += shard->dropped();
+    }
+    return count;
+}
+
+uint64_t ShardedDatabaseDataQueue::parked_samples() const noexcept
+{
+    uint64_t count = 0;
+    for (const auto& shard : shards_)
+    {
+        count += shard->parked_samples();
+    }
+    return count;
+}
+
+uint64_t ShardedDatabaseDataQueue::replayed_samples() const noexcept
+{
+    uint64_t count = 0;
+    for (const auto& shard : shards_)
+    {
+        count += shard->replayed_samples();
+    }
+    return count;
+}
+
+uint64_t ShardedDatabaseDataQueue::expired_samples() const noexcept
+{
+    uint64_t count = 0;
+    for (const auto& shard : shards_)
+    {
+        count += shard->expired_samples();
+    }
+    return count;
+}
+
+std::size_t ShardedDatabaseDataQueue::shard_of(
+        const DatabaseDataQueue::StatisticsData& data) const
+{
+    if (shards_.size() == 1)
+    {
+        return 0;
+    }
+
+    // The GUID prefix of the entity to which the data refers.
+    // A source locator of the network latency holds the GUID prefix of its participant in its address.
+    const uint8_t* prefix = nullptr;
+    switch (data._d())
+    {
+        case DatabaseDataQueue::StatisticsEventKind::HISTORY2HISTORY_LATENCY:
+            prefix = data.writer_reader_data().writer_guid().guidPrefix().value().data();
+            break;
+        case DatabaseDataQueue::StatisticsEventKind::NETWORK_LATENCY:
+            prefix = data.locator2locator_data().src_locator().address().data();
+            break;
+        case DatabaseDataQueue::StatisticsEventKind::PUBLICATION_THROUGHPUT:
+        case DatabaseDataQueue::StatisticsEventKind::SUBSCRIPTION_THROUGHPUT:
+            prefix = data.entity_data().guid().guidPrefix().value().data();
+            break;
+        case DatabaseDataQueue::StatisticsEventKind::RTPS_SENT:
+        case DatabaseDataQueue::StatisticsEventKind::RTPS_LOST:
+            prefix = data.entity2locator_traffic().src_guid().guidPrefix().value().data();
+            break;
+        case DatabaseDataQueue::StatisticsEventKind::RESENT_DATAS:
+        case DatabaseDataQueue::StatisticsEventKind::HEARTBEAT_COUNT:
+        case DatabaseDataQueue::StatisticsEventKind::ACKNACK_COUNT:
+        case DatabaseDataQueue::StatisticsEventKind::NACKFRAG_COUNT:
+        case DatabaseDataQueue::StatisticsEventKind::GAP_COUNT:
+        case DatabaseDataQueue::StatisticsEventKind::DATA_COUNT:
+        case DatabaseDataQueue::StatisticsEventKind::PDP_PACKETS:
+        case DatabaseDataQueue::StatisticsEventKind::EDP_PACKETS:
+            prefix = data.entity_count().guid().guidPrefix().value().data();
+            break;
+        case DatabaseDataQueue::StatisticsEventKind::DISCOVERED_ENTITY:
+            prefix = data.discovery_time().local_participant_guid().guidPrefix().value().data();
+            break;
+        case DatabaseDataQueue::StatisticsEventKind::SAMPLE_DATAS:
+            prefix = data.sample_identity_count().sample_id().writer_guid().guidPrefix().value().data();
+            break;
+        case DatabaseDataQueue::StatisticsEventKind::PHYSICAL_DATA:
+            prefix = data.physical_data().participant_guid().guidPrefix().value().data();
+            break;
+        default:
+            return 0;
+    }
+
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    for (std::size_t i = 0; i < GuidPrefix_t::size; ++i)
+    {
+        hash ^= prefix[i];
+        hash *= 1099511628211ull;
+    }
+    return static_cast<std::size_t>(hash % shards_.size());
+}
+
 } //namespace database
 } //namespace statistics_backend
 } //namespace eprosima
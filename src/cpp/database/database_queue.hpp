@@ -20,12 +20,18 @@
 #ifndef _EPROSIMA_FASTDDS_STATISTICS_BACKEND_DATABASE_DATABASE_QUEUE_HPP_
 #define _EPROSIMA_FASTDDS_STATISTICS_BACKEND_DATABASE_DATABASE_QUEUE_HPP_
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstddef>
 #include <cstring>
+#include <deque>
+#include <map>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
+#include <vector>
 
 #include <fastdds/rtps/common/Guid.h>
 #include <fastdds/rtps/common/Locator.h>
@@ -39,6 +45,8 @@
 #include <exception/Exception.hpp>
 #include <StatisticsBackend.hpp>
 #include <StatisticsBackendData.hpp>
+#include <types/MPSCRingBuffer.hpp>
+#include <types/ObjectPool.hpp>
 
 
 namespace eprosima {
@@ -47,6 +55,10 @@ namespace database {
 
 /**
  * Double buffered, threadsafe queue for MPSC (multi-producer, single-consumer) comms.
+ *
+ * Producers push into a bounded lock-free ring buffer (the background queue), whose overflow policy decides what
+ * happens when it is full. The consumer drains it into the foreground queue, from which the samples are processed.
+ * Producers only take a lock to wake the consumer up when it is waiting for data.
  */
 template<typename T>
 class DatabaseQueue
@@ -74,11 +86,24 @@ public:
 
     using queue_item_type = std::pair<std::chrono::system_clock::time_point, T>;
 
-    DatabaseQueue()
-        : foreground_queue_(&queue_alpha_)
-        , background_queue_(&queue_beta_)
+    //! Default number of items the background queue can hold
+    static constexpr std::size_t DEFAULT_CAPACITY = 1u << 16;
+
+    /**
+     * @brief Construct the queue and start its consumer.
+     *
+     * @param capacity Number of items the background queue can hold. It is rounded up to a power of two.
+     * @param overflow_policy What a producer does when the background queue is full.
+     *        With @ref details::OverflowPolicy::BLOCK, producers wait for the consumer, so pushing into a full queue
+     *        whose consumer is stopped blocks until it is started again.
+     */
+    DatabaseQueue(
+            std::size_t capacity = DEFAULT_CAPACITY,
+            details::OverflowPolicy overflow_policy = details::OverflowPolicy::BLOCK)
+        : background_queue_(capacity, overflow_policy)
         , consuming_(false)
         , current_loop_(0)
+        , parked_(false)
     {
         start_consumer();
     }
@@ -90,16 +115,81 @@ public:
     /**
      * @brief Pushes to the background queue.
      *
+     * The consumer is only notified if it is waiting for data.
+     *
      * @param item Item to push into the queue
+     * @return false if the item was discarded by the overflow policy, true otherwise.
      */
-    void push(
+    bool push(
             std::chrono::system_clock::time_point ts,
             const T& item)
+    {
+        pushed_.fetch_add(1);
+        if (!background_queue_.push(std::make_pair(ts, item),
+                [this](queue_item_type&& dropped)
+                {
+                    on_dropped(std::move(dropped));
+                }))
+        {
+            return false;
+        }
+
+        // Pairs with the fence in run(): either the consumer sees the new item before waiting,
+        // or this producer sees it parked
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (parked_.load(std::memory_order_relaxed))
+        {
+            std::unique_lock<std::mutex> guard(cv_mutex_);
+            cv_.notify_all();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Number of items discarded by the overflow policy of the background queue
+     */
+    uint64_t dropped() const noexcept
+    {
+        return background_queue_.dropped();
+    }
+
+    /**
+     * @brief Number of items pushed so far, including the ones discarded by the overflow policy
+     */
+    uint64_t pushed() const noexcept
+    {
+        return pushed_.load();
+    }
+
+    /**
+     * @brief Number of items already processed or discarded by the overflow policy
+     */
+    uint64_t consumed() const noexcept
+    {
+        return consumed_.load() + background_queue_.dropped();
+    }
+
+    /**
+     * @brief Wait until the given number of items have been processed or discarded
+     *
+     * This is a sequence barrier: the value returned by @ref pushed after pushing an item can be used to wait
+     * for that item, and every item pushed before it, to be processed.
+     *
+     * @param count Number of items to wait for
+     * @param timeout Maximum time to wait
+     * @return true if the items were consumed. False if the timeout expired or the consumer is stopped.
+     */
+    bool wait_consumed(
+            uint64_t count,
+            std::chrono::milliseconds timeout)
     {
         std::unique_lock<std::mutex> guard(cv_mutex_);
-        std::unique_lock<std::mutex> bg_guard(background_mutex_);
-        background_queue_->push(std::make_pair(ts, item));
-        cv_.notify_all();
+        cv_.wait_for(guard, timeout,
+                [&]()
+                {
+                    return !consuming_ || consumed() >= count;
+                });
+        return consumed() >= count;
     }
 
     /**
@@ -199,19 +289,24 @@ public:
 protected:
 
     /**
-     * @brief Clears foreground queue and swaps queues.
+     * @brief Clears foreground queue and moves the items in the background queue to it.
+     *
+     * At most as many items as the capacity of the background queue are moved, so producers
+     * that keep pushing cannot starve the consumer.
      */
     void swap()
     {
         std::unique_lock<std::mutex> fg_guard(foreground_mutex_);
-        std::unique_lock<std::mutex> bg_guard(background_mutex_);
 
         // Clear the foreground queue.
-        std::queue<queue_item_type>().swap(*foreground_queue_);
+        foreground_queue_.clear();
 
-        auto* swap        = background_queue_;
-        background_queue_ = foreground_queue_;
-        foreground_queue_ = swap;
+        background_queue_.consume(
+            [this](queue_item_type&& item)
+            {
+                foreground_queue_.push_back(std::move(item));
+            },
+            background_queue_.capacity());
     }
 
     /**
@@ -224,7 +319,7 @@ protected:
     queue_item_type& front()
     {
         std::unique_lock<std::mutex> fg_guard(foreground_mutex_);
-        return foreground_queue_->front();
+        return foreground_queue_.front();
     }
 
     /**
@@ -237,7 +332,22 @@ protected:
     const queue_item_type& front() const
     {
         std::unique_lock<std::mutex> fg_guard(foreground_mutex_);
-        return foreground_queue_->front();
+        return foreground_queue_.front();
+    }
+
+    /**
+     * @brief Returns a reference to an element in the foreground queue
+     *
+     * \pre index is lower than size(). Otherwise, the resulting behavior is undefined.
+     *
+     * @param index Position of the element, starting from the front
+     * @return A reference to the element
+     */
+    queue_item_type& peek(
+            std::size_t index)
+    {
+        std::unique_lock<std::mutex> fg_guard(foreground_mutex_);
+        return foreground_queue_[index];
     }
 
     /**
@@ -248,7 +358,16 @@ protected:
     void pop()
     {
         std::unique_lock<std::mutex> fg_guard(foreground_mutex_);
-        foreground_queue_->pop();
+        foreground_queue_.pop_front();
+    }
+
+    /**
+     * @brief Number of elements in the foreground queue
+     */
+    std::size_t size() const
+    {
+        std::unique_lock<std::mutex> fg_guard(foreground_mutex_);
+        return foreground_queue_.size();
     }
 
     /**
@@ -259,7 +378,7 @@ protected:
     bool empty() const
     {
         std::unique_lock<std::mutex> fg_guard(foreground_mutex_);
-        return foreground_queue_->empty();
+        return foreground_queue_.empty();
     }
 
     /**
@@ -270,8 +389,7 @@ protected:
     bool both_empty() const
     {
         std::unique_lock<std::mutex> fg_guard(foreground_mutex_);
-        std::unique_lock<std::mutex> bg_guard(background_mutex_);
-        return foreground_queue_->empty() && background_queue_->empty();
+        return foreground_queue_.empty() && background_queue_.empty();
     }
 
     /**
@@ -286,11 +404,23 @@ protected:
 
         while (consuming_)
         {
-            cv_.wait(guard,
-                    [&]()
+            // Pairs with the fence in push(): announce that the consumer is about to wait before checking for data
+            parked_.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            auto ready = [&]()
                     {
-                        return !consuming_ || !both_empty();
-                    });
+                        return !consuming_ || !both_empty() || pending_work();
+                    };
+            auto wakeup = next_wakeup();
+            if (wakeup == (std::chrono::steady_clock::time_point::max)())
+            {
+                cv_.wait(guard, ready);
+            }
+            else
+            {
+                cv_.wait_until(guard, wakeup, ready);
+            }
+            parked_.store(false, std::memory_order_relaxed);
 
             if (!consuming_)
             {
@@ -298,6 +428,11 @@ protected:
             }
 
             consume_all(guard);
+
+            // Let the specializations use the consumer thread while there is nothing to consume
+            guard.unlock();
+            after_consume();
+            guard.lock();
         }
     }
 
@@ -312,9 +447,16 @@ protected:
         while (!empty())
         {
             guard.unlock();
-            process_sample();
+            std::size_t processed = process_batch();
             guard.lock();
-            pop();
+            for (std::size_t i = 0; i < processed; ++i)
+            {
+                pop();
+            }
+
+            // Wake up the threads waiting in wait_consumed
+            consumed_.fetch_add(processed);
+            cv_.notify_all();
         }
 
         // We don't care about the overflow
@@ -327,17 +469,66 @@ protected:
      */
     virtual void process_sample() = 0;
 
+    /**
+     * @brief Processes the next samples in the foreground queue
+     *
+     * The samples processed are popped afterwards. By default, only the front one is processed, with
+     * @ref process_sample. Specializations may process several of them at once.
+     *
+     * @return The number of samples processed, at least one
+     */
+    virtual std::size_t process_batch()
+    {
+        process_sample();
+        return 1;
+    }
+
+    /**
+     * @brief Called by the consumer thread each time it has consumed all the available data in the queue
+     */
+    virtual void after_consume()
+    {
+    }
 
-    // Underlying queues
-    std::queue<queue_item_type> queue_alpha_;
-    std::queue<queue_item_type> queue_beta_;
+    /**
+     * @brief Whether the consumer has to wake up to call @ref after_consume, even if there are no new items
+     *
+     * It is called with the consumer mutex taken. Specializations that return true must notify the consumer
+     * with that mutex taken too, so the notification is not lost.
+     */
+    virtual bool pending_work() const
+    {
+        return false;
+    }
 
-    // Front and background queue references (double buffering)
-    std::queue<queue_item_type>* foreground_queue_;
-    std::queue<queue_item_type>* background_queue_;
+    /**
+     * @brief Time at which the consumer has to wake up to call @ref after_consume, even if there are no new items
+     *
+     * It is called by the consumer thread before waiting. By default, it only wakes up for new items or
+     * @ref pending_work.
+     */
+    virtual std::chrono::steady_clock::time_point next_wakeup()
+    {
+        return (std::chrono::steady_clock::time_point::max)();
+    }
+
+    /**
+     * @brief Called by a producer with each item discarded by @ref details::OverflowPolicy::DROP_OLDEST
+     * to make room for the one it pushes
+     */
+    virtual void on_dropped(
+            queue_item_type&&)
+    {
+    }
+
+
+    // Queue of the items being processed by the consumer
+    std::deque<queue_item_type> foreground_queue_;
+
+    // Queue where producers push the items
+    details::MPSCRingBuffer<queue_item_type> background_queue_;
 
     mutable std::mutex foreground_mutex_;
-    mutable std::mutex background_mutex_;
 
     // Consumer
     std::unique_ptr<std::thread> consumer_thread_;
@@ -346,8 +537,20 @@ protected:
 
     bool consuming_;
     unsigned char current_loop_;
+
+    // Whether the consumer is waiting for data, so producers must notify it
+    std::atomic<bool> parked_;
+
+    // Number of items pushed
+    std::atomic<uint64_t> pushed_{0};
+
+    // Number of items processed by the consumer
+    std::atomic<uint64_t> consumed_{0};
 };
 
+template<typename T>
+constexpr std::size_t DatabaseQueue<T>::DEFAULT_CAPACITY;
+
 struct EntityDiscoveryInfo
 {
     details::StatisticsBackendData::DiscoveryStatus discovery_status;
@@ -386,15 +589,39 @@ protected:
 
 };
 
+class ShardedDatabaseDataQueue;
+
+/**
+ * @brief Queue of the discovery events, inserted into the database by its consumer.
+ *
+ * A lost discovery event leaves the database inconsistent, so by default a producer pushing into a full queue
+ * blocks until the consumer makes room. Discovery events are pushed from the listener threads of Fast DDS,
+ * which stop handling messages meanwhile.
+ */
 class DatabaseEntityQueue : public DatabaseQueue<EntityDiscoveryInfo>
 {
 
 public:
 
+    //! Default number of discovery events the queue can hold
+    static constexpr std::size_t DEFAULT_ENTITY_CAPACITY = 1u << 12;
+
+    /**
+     * @brief Construct the queue and start its consumer.
+     *
+     * @param database Database where the entities are inserted.
+     * @param capacity Number of discovery events the queue can hold.
+     * @param overflow_policy What a producer does when the queue is full. With the default
+     *        @ref details::OverflowPolicy::BLOCK, the listener thread pushing the event blocks until the consumer
+     *        makes room, since dropping an event would lose the entity it announces.
+     */
     DatabaseEntityQueue(
-            database::Database* database)
-        : DatabaseQueue<EntityDiscoveryInfo>()
+            database::Database* database,
+            std::size_t capacity = DEFAULT_ENTITY_CAPACITY,
+            details::OverflowPolicy overflow_policy = details::OverflowPolicy::BLOCK)
+        : DatabaseQueue<EntityDiscoveryInfo>(capacity, overflow_policy)
         , database_(database)
+        , data_queue_(nullptr)
     {
     }
 
@@ -403,8 +630,27 @@ public:
         stop_consumer();
     }
 
+    /**
+     * @brief Set the queue whose statistics data are notified of the discovered entities
+     *
+     * @param data_queue The queue of statistics data. nullptr to not notify any queue.
+     */
+    void set_data_queue(
+            ShardedDatabaseDataQueue* data_queue)
+    {
+        data_queue_.store(data_queue);
+    }
+
 protected:
 
+    /**
+     * @brief Notify the data queue, if any, that an entity has been discovered
+     *
+     * @param info The discovery event of the entity
+     */
+    void notify_discovery(
+            const EntityDiscoveryInfo& info);
+
     EntityId process_participant(
             const EntityDiscoveryInfo& info);
 
@@ -445,6 +691,8 @@ protected:
                 entity_id,
                 info.kind(),
                 info.discovery_status);
+
+            notify_discovery(info);
         }
         catch (const eprosima::statistics_backend::Exception& e)
         {
@@ -471,6 +719,9 @@ protected:
     // Database
     Database* database_;
 
+    // Queue of the statistics data that may refer to the discovered entities
+    std::atomic<ShardedDatabaseDataQueue*> data_queue_;
+
 };
 
 class DatabaseDataQueue : public DatabaseQueue<std::shared_ptr<eprosima::fastdds::statistics::Data>>
@@ -478,10 +729,46 @@ class DatabaseDataQueue : public DatabaseQueue<std::shared_ptr<eprosima::fastdds
 
 public:
 
+    //! Default maximum number of statistics data processed at once
+    static constexpr std::size_t DEFAULT_BATCH_SIZE = 256;
+
+    //! Default maximum number of statistics data of unknown entities waiting for their discovery
+    static constexpr std::size_t DEFAULT_PARKING_CAPACITY = 1u << 12;
+
+    //! Default time that a statistics data of an unknown entity waits for its discovery
+    static constexpr std::chrono::milliseconds DEFAULT_PARKING_TIMEOUT{5000};
+
+    /**
+     * @brief Construct the queue and start its consumer.
+     *
+     * @param database Database where the samples are inserted.
+     * @param capacity Number of items the background queue can hold.
+     * @param overflow_policy What a producer does when the background queue is full. The statistics data are pushed
+     *        from the listener threads of Fast DDS, which must never wait for the consumer, so by default the oldest
+     *        data is lost: it is counted by @ref dropped, and the consumer logs a warning with the data lost since
+     *        the previous one. @ref details::OverflowPolicy::BLOCK loses nothing, but stalls the reception of
+     *        every DDS message handled by those threads while the consumer does not keep up.
+     * @param batch_size Maximum number of statistics data whose samples are inserted under the same database lock.
+     * @param parking_capacity Maximum number of statistics data of unknown entities waiting for their discovery.
+     * @param parking_timeout Time that a statistics data of an unknown entity waits for its discovery.
+     */
     DatabaseDataQueue(
-            database::Database* database)
-        : DatabaseQueue<std::shared_ptr<eprosima::fastdds::statistics::Data>>()
+            database::Database* database,
+            std::size_t capacity = DEFAULT_CAPACITY,
+            details::OverflowPolicy overflow_policy = details::OverflowPolicy::DROP_OLDEST,
+            std::size_t batch_size = DEFAULT_BATCH_SIZE,
+            std::size_t parking_capacity = DEFAULT_PARKING_CAPACITY,
+            std::chrono::milliseconds parking_timeout = DEFAULT_PARKING_TIMEOUT)
+        : DatabaseQueue<std::shared_ptr<eprosima::fastdds::statistics::Data>>(capacity, overflow_policy)
         , database_(database)
+        , batch_size_((std::max)(batch_size, std::size_t(1)))
+        , parking_capacity_(parking_capacity)
+        , parking_timeout_(parking_timeout)
+        , parked_count_(0)
+        , next_expiration_((std::chrono::steady_clock::time_point::max)())
+        , has_discovered_guids_(false)
+        , entity_creation_mutex_(std::make_shared<std::mutex>())
+        , enforce_retention_(true)
     {
     }
 
@@ -492,6 +779,124 @@ public:
 
     virtual void process_sample() override;
 
+    /**
+     * @brief Processes up to the batch size of statistics data in the foreground queue
+     *
+     * The entities of every data are resolved first, then all the samples are inserted taking the database lock
+     * only once, and finally the users are notified of the new data, once the lock is released.
+     *
+     * @return The number of statistics data processed
+     */
+    virtual std::size_t process_batch() override;
+
+    /**
+     * @brief Notify that an entity has been inserted in the database
+     *
+     * The statistics data parked waiting for the entity are replayed by the consumer, in timestamp order,
+     * before any newer data. Until then, the newer data of the entity are parked as well.
+     *
+     * @param guid GUID of the entity
+     */
+    void entity_discovered(
+            const eprosima::fastrtps::rtps::GUID_t& guid);
+
+    /**
+     * @brief Number of times a statistics data has been parked waiting for the discovery of its entity
+     */
+    uint64_t parked_samples() const noexcept
+    {
+        return parked_samples_.load();
+    }
+
+    /**
+     * @brief Number of parked statistics data replayed after the discovery of their entity
+     */
+    uint64_t replayed_samples() const noexcept
+    {
+        return replayed_samples_.load();
+    }
+
+    /**
+     * @brief Number of statistics data discarded because their entity was not discovered in time,
+     * or because there was no room to park them
+     */
+    uint64_t expired_samples() const noexcept
+    {
+        return expired_samples_.load();
+    }
+
+    /**
+     * @brief Set the mutex that serializes the creation of the entities found in the statistics data
+     *
+     * Queues that insert in the same database concurrently must share it,
+     * so they do not create the same locator or physical entity twice.
+     *
+     * @param entity_creation_mutex The shared mutex
+     */
+    void set_entity_creation_mutex(
+            const std::shared_ptr<std::mutex>& entity_creation_mutex)
+    {
+        entity_creation_mutex_ = entity_creation_mutex;
+    }
+
+    /**
+     * @brief Set whether the consumer enforces the retention policy of the database
+     *
+     * Among the queues that insert in the same database, one is enough.
+     *
+     * @param enforce_retention Whether the retention policy is enforced. It is by default.
+     */
+    void set_retention_enforcement(
+            bool enforce_retention)
+    {
+        enforce_retention_.store(enforce_retention);
+    }
+
+    /**
+     * @brief Set the pool where the processed statistics data are given back for recycling
+     *
+     * Producers that acquire their statistics data from the same pool save their allocation.
+     *
+     * @param data_pool The pool. nullptr to let the processed data be destroyed, which is the default.
+     */
+    void set_data_pool(
+            const std::shared_ptr<details::ObjectPool<eprosima::fastdds::statistics::Data>>& data_pool)
+    {
+        data_pool_ = data_pool;
+    }
+
+    /**
+     * @brief Replays the parked data of the discovered entities, discards the expired ones,
+     * and enforces the retention policy of the database on a slice of its entities
+     */
+    virtual void after_consume() override
+    {
+        report_dropped();
+        replay_parked();
+        expire_parked();
+        if (enforce_retention_.load())
+        {
+            database_->enforce_retention();
+            last_retention_slice_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    /**
+     * @brief Wake up to enforce the retention policy of the database while no statistics data is received
+     *
+     * The consumer enforces the next slice of the retention policy, finishing a visit of the database or starting
+     * a new one, when the enforcement period of the policy has elapsed since the previous slice.
+     * It does not wake up while the policy has no limits, until it receives statistics data again.
+     */
+    virtual std::chrono::steady_clock::time_point next_wakeup() override
+    {
+        if (!enforce_retention_.load() || !database_->retention_enabled())
+        {
+            return (std::chrono::steady_clock::time_point::max)();
+        }
+        return last_retention_slice_ + database_->retention_period();
+    }
+
     /**
      * @brief subroutine to build a StatisticsSample from a StatisticsData
      *
@@ -526,19 +931,176 @@ public:
 
 protected:
 
-    std::string deserialize_guid(
-            StatisticsGuid data) const
+    //! Error building a sample because the entity to which it refers is not in the database
+    class EntityNotFound : public Error
+    {
+
+    public:
+
+        EntityNotFound(
+                const eprosima::fastrtps::rtps::GUID_t& guid,
+                const std::string& message)
+            : Error(message)
+            , guid_(guid)
+        {
+        }
+
+        //! GUID of the entity that is not in the database
+        const eprosima::fastrtps::rtps::GUID_t& guid() const
+        {
+            return guid_;
+        }
+
+    protected:
+
+        eprosima::fastrtps::rtps::GUID_t guid_;
+    };
+
+    //! Statistics data waiting for the discovery of its entity
+    struct ParkedSample
+    {
+        //! Time at which the data is discarded if the entity has not been discovered
+        std::chrono::steady_clock::time_point expiration;
+
+        //! The statistics data and its reception time
+        queue_item_type item;
+    };
+
+    //! Samples built from the statistics data, waiting to be inserted in the database
+    struct SampleBatch
+    {
+        //! Samples to insert
+        std::vector<Database::SampleInsertion> insertions;
+
+        //! Statistics event from which each sample was built
+        std::vector<const char*> events;
+    };
+
+    /**
+     * @brief Build the samples of a statistics data and add them to a batch
+     *
+     * Data that do not produce samples, like PHYSICAL_DATA, are processed right away.
+     *
+     * @param queue_item The statistics data and its reception time
+     * @param batch Batch where the samples are added
+     */
+    void add_to_batch(
+            const queue_item_type& queue_item,
+            SampleBatch& batch);
+
+    /**
+     * @brief Build the samples of a statistics data and add them to a batch, or park the data
+     * if it refers to an entity that is not in the database
+     *
+     * @param queue_item The statistics data and its reception time
+     * @param batch Batch where the samples are added
+     * @param expiration Time at which the data is discarded if it is parked
+     */
+    void add_or_park(
+            const queue_item_type& queue_item,
+            SampleBatch& batch,
+            const std::chrono::steady_clock::time_point& expiration);
+
+    /**
+     * @brief Find an entity to which a statistics data refers that has parked data
+     *
+     * @param data The statistics data
+     * @param guid [out] GUID of the entity with parked data, if any
+     * @return Whether the statistics data refers to an entity with parked data
+     */
+    bool find_parked_guid(
+            const StatisticsData& data,
+            eprosima::fastrtps::rtps::GUID_t& guid) const;
+
+    /**
+     * @brief Park a statistics data until the entity to which it refers is discovered
+     *
+     * If there is no room for it, it is discarded.
+     *
+     * @param guid GUID of the entity that is not in the database
+     * @param queue_item The statistics data and its reception time
+     * @param expiration Time at which the data is discarded
+     * @param reason Why the data could not be processed, for logging
+     */
+    void park(
+            const eprosima::fastrtps::rtps::GUID_t& guid,
+            const queue_item_type& queue_item,
+            const std::chrono::steady_clock::time_point& expiration,
+            const char* reason);
+
+    /**
+     * @brief Log the statistics data discarded by the overflow policy since the last call, if any
+     */
+    void report_dropped();
+
+    /**
+     * @brief Gives back a statistics data discarded by the overflow policy to the data pool, if any
+     */
+    virtual void on_dropped(
+            queue_item_type&& item) override
+    {
+        recycle(std::move(item.second));
+    }
+
+    /**
+     * @brief Process again the parked statistics data of the entities discovered since the last call
+     */
+    void replay_parked();
+
+    /**
+     * @brief Discard the parked statistics data that have expired
+     */
+    void expire_parked();
+
+    /**
+     * @brief Whether there are discovered entities whose parked data have not been replayed yet
+     */
+    virtual bool pending_work() const override
+    {
+        return has_discovered_guids_.load();
+    }
+
+    /**
+     * @brief Build a sample from the inner data of a statistics data and add it to a batch
+     *
+     * If the sample cannot be built, the error is logged and it is not added,
+     * unless its entity is not in the database, in which case @ref EntityNotFound is thrown.
+     *
+     * @tparam T The Sample type.
+     * @tparam B The base of \c T for which \ref process_sample_type is specialized for \c Q.
+     * @tparam Q The type of the inner data.
+     *
+     * @param event Name of the statistics event, for logging
+     * @param entity_kind The entity kind of the entity to which the sample refers
+     * @param src_ts Reception time of the statistics data
+     * @param item The inner data
+     * @param batch Batch where the sample is added
+     */
+    template<typename T, typename B, typename Q>
+    void add_to_batch(
+            const char* event,
+            EntityKind entity_kind,
+            const std::chrono::system_clock::time_point& src_ts,
+            const Q& item,
+            SampleBatch& batch) const;
+
+    /**
+     * @brief Insert the samples of a batch in the database and notify the users of the new data
+     */
+    void insert_batch(
+            SampleBatch& batch);
+
+    eprosima::fastrtps::rtps::GUID_t deserialize_binary_guid(
+            const StatisticsGuid& data) const
     {
         eprosima::fastrtps::rtps::GUID_t guid;
         memcpy(guid.guidPrefix.value, data.guidPrefix().value().data(), eprosima::fastrtps::rtps::GuidPrefix_t::size);
         memcpy(guid.entityId.value, data.entityId().value().data(), eprosima::fastrtps::rtps::EntityId_t::size);
-        std::stringstream ss;
-        ss << guid;
-        return ss.str();
+        return guid;
     }
 
-    std::string deserialize_guid(
-            StatisticsLocator data) const
+    eprosima::fastrtps::rtps::GUID_t deserialize_binary_guid(
+            const StatisticsLocator& data) const
     {
         if (data.port() != 0)
         {
@@ -548,8 +1110,22 @@ protected:
         memcpy(guid.guidPrefix.value, data.address().data(), eprosima::fastrtps::rtps::GuidPrefix_t::size);
         memcpy(guid.entityId.value, data.address().data() + eprosima::fastrtps::rtps::GuidPrefix_t::size,
                 eprosima::fastrtps::rtps::EntityId_t::size);
+        return guid;
+    }
+
+    std::string deserialize_guid(
+            StatisticsGuid data) const
+    {
         std::stringstream ss;
-        ss << guid;
+        ss << deserialize_binary_guid(data);
+        return ss.str();
+    }
+
+    std::string deserialize_guid(
+            StatisticsLocator data) const
+    {
+        std::stringstream ss;
+        ss << deserialize_binary_guid(data);
         return ss.str();
     }
 
@@ -576,10 +1152,10 @@ protected:
         return eprosima::fastrtps::rtps::SequenceNumber_t(high, low).to64long();
     }
 
-    std::pair<std::string, uint64_t> deserialize_sample_identity(
-            StatisticsSampleIdentity data) const
+    std::pair<eprosima::fastrtps::rtps::GUID_t, uint64_t> deserialize_sample_identity(
+            const StatisticsSampleIdentity& data) const
     {
-        std::string writer_guid = deserialize_guid(data.writer_guid());
+        eprosima::fastrtps::rtps::GUID_t writer_guid = deserialize_binary_guid(data.writer_guid());
         uint64_t sequence_number = deserialize_sequence_number(data.sequence_number());
 
         return std::make_pair(writer_guid, sequence_number);
@@ -591,6 +1167,68 @@ protected:
     // Database
     Database* database_;
 
+    // Maximum number of statistics data processed at once
+    std::size_t batch_size_;
+
+    // Maximum number of parked statistics data
+    std::size_t parking_capacity_;
+
+    // Time that a statistics data is parked before being discarded
+    std::chrono::milliseconds parking_timeout_;
+
+    // Statistics data waiting for the discovery of their entity, by the GUID of the entity.
+    // Only used by the consumer.
+    std::map<eprosima::fastrtps::rtps::GUID_t, std::vector<ParkedSample>> parked_data_;
+
+    // Number of statistics data in parked_data_
+    std::size_t parked_count_;
+
+    // Earliest expiration of the statistics data in parked_data_
+    std::chrono::steady_clock::time_point next_expiration_;
+
+    // GUIDs of the entities discovered since the last replay
+    std::vector<eprosima::fastrtps::rtps::GUID_t> discovered_guids_;
+
+    // Protects discovered_guids_
+    std::mutex discovered_mutex_;
+
+    // Whether discovered_guids_ is not empty
+    std::atomic<bool> has_discovered_guids_;
+
+    // Statistics data discarded by the overflow policy already reported by report_dropped
+    uint64_t reported_dropped_ = 0;
+
+    // Counters of the parked statistics data
+    std::atomic<uint64_t> parked_samples_{0};
+    std::atomic<uint64_t> replayed_samples_{0};
+    std::atomic<uint64_t> expired_samples_{0};
+
+    // Serializes the creation of locators and physical entities with other queues
+    std::shared_ptr<std::mutex> entity_creation_mutex_;
+
+    // Whether the consumer enforces the retention policy of the database
+    std::atomic<bool> enforce_retention_;
+
+    // When the retention policy was last enforced on a slice of the database. Only used by the consumer
+    std::chrono::steady_clock::time_point last_retention_slice_;
+
+    // Pool where the processed statistics data are recycled. nullptr if they are not
+    std::shared_ptr<details::ObjectPool<eprosima::fastdds::statistics::Data>> data_pool_;
+
+    /**
+     * @brief Gives back a processed statistics data to the data pool, if any
+     *
+     * Data still referenced elsewhere, like the parked ones, are not recycled.
+     */
+    void recycle(
+            std::shared_ptr<eprosima::fastdds::statistics::Data>&& data)
+    {
+        if (data_pool_)
+        {
+            data_pool_->release(std::move(data));
+        }
+    }
+
 };
 
 template<>
@@ -658,6 +1296,158 @@ void DatabaseDataQueue::process_sample_type(
         SampleDatasCountSample& sample,
         const StatisticsSampleIdentityCount& item) const;
 
+/**
+ * Statistics data queue processed by several consumer threads.
+ *
+ * The statistics data are distributed among several @ref DatabaseDataQueue, the shards, each with its own consumer.
+ * The shard of a data is chosen by the hash of the GUID prefix of the entity to which it refers, so all the data of
+ * a participant and its endpoints go to the same shard, and are processed in the order they are pushed.
+ */
+class ShardedDatabaseDataQueue
+{
+
+public:
+
+    //! Default number of shards
+    static constexpr std::size_t DEFAULT_SHARD_COUNT = 1;
+
+    //! Default maximum number of processed statistics data kept for recycling
+    static constexpr std::size_t DEFAULT_DATA_POOL_CAPACITY = 1u << 12;
+
+    /**
+     * @brief Construct the queue and start the consumers of its shards.
+     *
+     * @param database Database where the samples are inserted.
+     * @param shard_count Number of shards. At least one is created.
+     */
+    ShardedDatabaseDataQueue(
+            database::Database* database,
+            std::size_t shard_count = DEFAULT_SHARD_COUNT);
+
+    ShardedDatabaseDataQueue(
+            const ShardedDatabaseDataQueue&) = delete;
+
+    ShardedDatabaseDataQueue& operator =(
+            const ShardedDatabaseDataQueue&) = delete;
+
+    /**
+     * @brief Pushes a statistics data to its shard
+     *
+     * @param ts Reception time of the data
+     * @param data The statistics data
+     * @return false if the data was discarded by the overflow policy of the shard, true otherwise.
+     */
+    bool push(
+            std::chrono::system_clock::time_point ts,
+            const std::shared_ptr<eprosima::fastdds::statistics::Data>& data)
+    {
+        return shards_[shard_of(*data)]->push(ts, data);
+    }
+
+    //! Consume all the available data in every shard
+    void flush();
+
+    /**
+     * @brief Stops the consumers of every shard and wait for them to end
+     *
+     * @return true if any consumer has been stopped. False if all of them were already stopped
+     */
+    bool stop_consumer();
+
+    /**
+     * @brief Starts the consumers of every shard
+     *
+     * @return true if any consumer has been started. False if all of them were already started
+     */
+    bool start_consumer();
+
+    /**
+     * @brief Notify every shard that an entity has been inserted in the database
+     *
+     * @see DatabaseDataQueue::entity_discovered
+     */
+    void entity_discovered(
+            const eprosima::fastrtps::rtps::GUID_t& guid);
+
+    /**
+     * @brief Change the number of shards
+     *
+     * The data in the queue are processed before, so the data of each entity keep their order.
+     * Data parked in the removed shards, waiting for the discovery of their entity, are discarded.
+     *
+     * \pre No thread is pushing to the queue.
+     *
+     * @param shard_count Number of shards. At least one is kept.
+     */
+    void set_shard_count(
+            std::size_t shard_count);
+
+    //! Number of shards
+    std::size_t shard_count() const noexcept
+    {
+        return shards_.size();
+    }
+
+    /**
+     * @brief Access a shard
+     *
+     * \pre index is lower than shard_count()
+     */
+    DatabaseDataQueue& shard(
+            std::size_t index)
+    {
+        return *shards_[index];
+    }
+
+    /**
+     * @brief Pool of statistics data shared by every shard
+     *
+     * The shards give back the statistics data once processed.
+     * Producers should acquire the data they push from here, so their allocation is saved.
+     */
+    details::ObjectPool<eprosima::fastdds::statistics::Data>& data_pool() noexcept
+    {
+        return *data_pool_;
+    }
+
+    //! Number of statistics data discarded by the overflow policy of every shard
+    uint64_t dropped() const noexcept;
+
+    //! Sum of @ref DatabaseDataQueue::parked_samples of every shard
+    uint64_t parked_samples() const noexcept;
+
+    //! Sum of @ref DatabaseDataQueue::replayed_samples of every shard
+    uint64_t replayed_samples() const noexcept;
+
+    //! Sum of @ref DatabaseDataQueue::expired_samples of every shard
+    uint64_t expired_samples() const noexcept;
+
+protected:
+
+    /**
+     * @brief Index of the shard of a statistics data
+     *
+     * It depends on the GUID prefix of the entity to which the data refers.
+     */
+    std::size_t shard_of(
+            const eprosima::fastdds::statistics::Data& data) const;
+
+    //! Create a shard that cooperates with the existing ones
+    std::unique_ptr<DatabaseDataQueue> create_shard() const;
+
+    // Database
+    Database* database_;
+
+    // Serializes the creation of locators and physical entities among the shards
+    std::shared_ptr<std::mutex> entity_creation_mutex_;
+
+    // Statistics data recycled by the shards
+    std::shared_ptr<details::ObjectPool<eprosima::fastdds::statistics::Data>> data_pool_;
+
+    // The shards
+    std::vector<std::unique_ptr<DatabaseDataQueue>> shards_;
+};
+
 } //namespace database
 } //namespace statistics_backend
 } //namespace eprosima
@@ -20,7 +20,10 @@
 #ifndef _EPROSIMA_FASTDDS_STATISTICS_BACKEND_DATABASE_SAMPLES_HPP_
 #define _EPROSIMA_FASTDDS_STATISTICS_BACKEND_DATABASE_SAMPLES_HPP_
 
+#include <cassert>
 #include <chrono>
+#include <cstddef>
+#include <typeinfo>
 
 #include <fastdds_statistics_backend/exception/Exception.hpp>
 #include <fastdds_statistics_backend/types/types.hpp>
@@ -734,6 +737,39 @@ struct SampleDatasCountSample : EntityCountSample
 
 };
 
+/*
+ * Block of contiguous samples selected from the database
+ *
+ * All the samples of a block are of the same type, which is the one that the database stores for the DataKind
+ * selected. They remain valid while the SampleSpans object returned with them by the database is alive.
+ */
+struct SampleSpan
+{
+    SampleSpan(
+            const StatisticsSample* first_sample,
+            std::size_t samples)
+        : first(first_sample)
+        , size(samples)
+    {
+    }
+
+    /**
+     * @brief Get the samples of the block as an array of their actual type.
+     *
+     * @tparam T Type of the samples stored in the database for the DataKind selected.
+     * @return Pointer to the first sample of the block.
+     */
+    template<typename T>
+    const T* data() const noexcept
+    {
+        assert(typeid(*first) == typeid(T));
+        return static_cast<const T*>(first);
+    }
+
+    const StatisticsSample* first;
+    std::size_t size;
+};
+
 } //namespace database
 } //namespace statistics_backend
 } //namespace eprosima
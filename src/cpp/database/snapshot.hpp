@@ -0,0 +1,308 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file snapshot.hpp
+ *
+ * Encoding of the binary snapshots of the database.
+ *
+ * A snapshot is a header followed by one table per entity kind, in the order in which the entities are loaded:
+ * locators, hosts, users, processes, domains, topics, participants, datawriters and datareaders.
+ *
+ * \code
+ * snapshot    := magic("FDSBSNAP") uint32(version) table*
+ * table       := uint64(entity count) entity*
+ * entity      := int64(id) string(name) string(alias) <fields of the kind> [series* string("")]
+ * series      := string(data kind tag) (block | uint64(key count) (int64(key) block)*)
+ * block       := uint64(n) int64[n](source timestamps) <value columns of the sample type>
+ * \endcode
+ *
+ * Only participants, datawriters and datareaders have series, identified by the same data kind tags of the JSON
+ * dumps. The series split per remote entity, locator or sequence number are keyed, the rest are a single block.
+ * Each block stores its samples by columns: first every timestamp, then every value of each field.
+ *
+ * Integers are little endian, doubles are IEEE 754 doubles stored as their 64 bits integer representation,
+ * timestamps are nanoseconds since the epoch, and strings are prefixed by their uint32 length.
+ */
+
+#ifndef _EPROSIMA_FASTDDS_STATISTICS_BACKEND_DATABASE_SNAPSHOT_HPP_
+#define _EPROSIMA_FASTDDS_STATISTICS_BACKEND_DATABASE_SNAPSHOT_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <string>
+
+#include <fastdds_statistics_backend/exception/Exception.hpp>
+#include <fastdds_statistics_backend/types/types.hpp>
+
+namespace eprosima {
+namespace statistics_backend {
+namespace database {
+
+//! First bytes of every binary snapshot
+constexpr const char SNAPSHOT_MAGIC[] = "FDSBSNAP";
+
+//! Size of SNAPSHOT_MAGIC, without the null terminator
+constexpr std::size_t SNAPSHOT_MAGIC_SIZE = sizeof(SNAPSHOT_MAGIC) - 1;
+
+//! Version of the binary snapshots written by this version of the library
+constexpr uint32_t SNAPSHOT_VERSION = 1;
+
+/**
+ * @brief Write the primitive values of a binary snapshot to a stream.
+ */
+class SnapshotWriter
+{
+public:
+
+    explicit SnapshotWriter(
+            std::ostream& stream)
+        : stream_(stream)
+    {
+    }
+
+    //! Write the magic bytes and the version of the snapshot
+    void write_header()
+    {
+        stream_.write(SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE);
+        write_uint32(SNAPSHOT_VERSION);
+    }
+
+    void write_uint8(
+            uint8_t value)
+    {
+        stream_.put(static_cast<char>(value));
+    }
+
+    void write_uint16(
+            uint16_t value)
+    {
+        write_little_endian_(value, 2);
+    }
+
+    void write_uint32(
+            uint32_t value)
+    {
+        write_little_endian_(value, 4);
+    }
+
+    void write_uint64(
+            uint64_t value)
+    {
+        write_little_endian_(value, 8);
+    }
+
+    void write_int64(
+            int64_t value)
+    {
+        write_uint64(static_cast<uint64_t>(value));
+    }
+
+    void write_double(
+            double value)
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        write_uint64(bits);
+    }
+
+    void write_bool(
+            bool value)
+    {
+        write_uint8(value ? 1 : 0);
+    }
+
+    void write_timestamp(
+            const Timestamp& value)
+    {
+        write_int64(std::chrono::duration_cast<std::chrono::nanoseconds>(value.time_since_epoch()).count());
+    }
+
+    void write_string(
+            const std::string& value)
+    {
+        write_uint32(static_cast<uint32_t>(value.size()));
+        stream_.write(value.data(), static_cast<std::streamsize>(value.size()));
+    }
+
+private:
+
+    void write_little_endian_(
+            uint64_t value,
+            std::size_t size)
+    {
+        char bytes[8];
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            bytes[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+        }
+        stream_.write(bytes, static_cast<std::streamsize>(size));
+    }
+
+    std::ostream& stream_;
+};
+
+/**
+ * @brief Read the primitive values of a binary snapshot from a stream.
+ *
+ * Every read throws eprosima::statistics_backend::CorruptedFile if the stream ends before the value.
+ */
+class SnapshotReader
+{
+public:
+
+    explicit SnapshotReader(
+            std::istream& stream)
+        : stream_(stream)
+    {
+    }
+
+    /**
+     * @brief Check whether a stream starts with the magic bytes of a binary snapshot.
+     *
+     * The stream is left at the position it had before the check.
+     */
+    static bool is_snapshot(
+            std::istream& stream)
+    {
+        char magic[SNAPSHOT_MAGIC_SIZE];
+        auto position = stream.tellg();
+        stream.read(magic, SNAPSHOT_MAGIC_SIZE);
+        bool snapshot = stream.gcount() == static_cast<std::streamsize>(SNAPSHOT_MAGIC_SIZE) &&
+                std::memcmp(magic, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE) == 0;
+        stream.clear();
+        stream.seekg(position);
+        return snapshot;
+    }
+
+    /**
+     * @brief Read the magic bytes and the version of the snapshot.
+     *
+     * @throws eprosima::statistics_backend::CorruptedFile if the stream is not a snapshot,
+     * or its version is not supported.
+     */
+    void read_header()
+    {
+        char magic[SNAPSHOT_MAGIC_SIZE];
+        read_bytes_(magic, SNAPSHOT_MAGIC_SIZE);
+        if (std::memcmp(magic, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE) != 0)
+        {
+            throw CorruptedFile("The stream is not a database snapshot");
+        }
+        uint32_t version = read_uint32();
+        if (version != SNAPSHOT_VERSION)
+        {
+            throw CorruptedFile("Unsupported database snapshot version: " + std::to_string(version));
+        }
+    }
+
+    uint8_t read_uint8()
+    {
+        char byte;
+        read_bytes_(&byte, 1);
+        return static_cast<uint8_t>(byte);
+    }
+
+    uint16_t read_uint16()
+    {
+        return static_cast<uint16_t>(read_little_endian_(2));
+    }
+
+    uint32_t read_uint32()
+    {
+        return static_cast<uint32_t>(read_little_endian_(4));
+    }
+
+    uint64_t read_uint64()
+    {
+        return read_little_endian_(8);
+    }
+
+    int64_t read_int64()
+    {
+        return static_cast<int64_t>(read_uint64());
+    }
+
+    double read_double()
+    {
+        uint64_t bits = read_uint64();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    bool read_bool()
+    {
+        return read_uint8() != 0;
+    }
+
+    Timestamp read_timestamp()
+    {
+        return Timestamp(std::chrono::duration_cast<Timestamp::duration>(std::chrono::nanoseconds(read_int64())));
+    }
+
+    std::string read_string()
+    {
+        uint32_t size = read_uint32();
+
+        // The string grows as it is read, so a corrupted size cannot allocate more memory than the stream holds
+        std::string value;
+        char buffer[4096];
+        while (value.size() < size)
+        {
+            std::size_t chunk = std::min<std::size_t>(sizeof(buffer), size - value.size());
+            read_bytes_(buffer, chunk);
+            value.append(buffer, chunk);
+        }
+        return value;
+    }
+
+private:
+
+    void read_bytes_(
+            char* data,
+            std::size_t size)
+    {
+        stream_.read(data, static_cast<std::streamsize>(size));
+        if (stream_.gcount() != static_cast<std::streamsize>(size))
+        {
+            throw CorruptedFile("Unexpected end of the database snapshot");
+        }
+    }
+
+    uint64_t read_little_endian_(
+            std::size_t size)
+    {
+        unsigned char bytes[8];
+        read_bytes_(reinterpret_cast<char*>(bytes), size);
+        uint64_t value = 0;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            value |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+        }
+        return value;
+    }
+
+    std::istream& stream_;
+};
+
+} //namespace database
+} //namespace statistics_backend
+} //namespace eprosima
+
+#endif // _EPROSIMA_FASTDDS_STATISTICS_BACKEND_DATABASE_SNAPSHOT_HPP_
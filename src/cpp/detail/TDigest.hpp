@@ -0,0 +1,321 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file TDigest.hpp
+ */
+
+#ifndef _EPROSIMA_FASTDDS_STATISTICS_BACKEND_DETAIL_TDIGEST_HPP_
+#define _EPROSIMA_FASTDDS_STATISTICS_BACKEND_DETAIL_TDIGEST_HPP_
+
+#include <algorithm>  // std::sort, std::nth_element, std::min_element, std::min, std::max
+#include <cmath>      // std::asin, std::sin, std::isnan, std::floor
+#include <cstddef>    // std::size_t
+#include <limits>     // std::numeric_limits
+#include <vector>     // std::vector
+
+namespace eprosima {
+namespace statistics_backend {
+namespace detail {
+
+/**
+ * @brief Bounded-memory sketch that estimates the quantiles of a stream of values.
+ *
+ * This is a merging t-digest (Dunning & Ertl, "Computing extremely accurate quantiles using t-digests").
+ * Incoming values are kept in a buffer. As long as the buffer has never been full, quantiles are computed exactly
+ * from it, so small sets of values do not lose any precision.
+ * When the buffer fills up, it is merged into a sorted list of centroids whose size is limited by the
+ * compression factor using the \c k1 scale function, which keeps centroids small near the tails, where the
+ * interesting quantiles (P99, P99.9) live.
+ *
+ * The memory used is O(compression + buffer capacity), independently of the number of values added.
+ *
+ * NaN values are ignored.
+ */
+class TDigest
+{
+public:
+
+    /// Default compression factor. The number of centroids is bounded by it.
+    static constexpr double DEFAULT_COMPRESSION = 100.0;
+
+    /// Default number of values buffered before merging, and thus the maximum size of an exact set of values
+    static constexpr std::size_t DEFAULT_BUFFER_CAPACITY = 1024;
+
+    /**
+     * @brief Construct an empty TDigest.
+     *
+     * @param compression Compression factor. Higher values give more accurate quantiles using more memory.
+     * @param buffer_capacity Number of values buffered before they are merged into the centroids.
+     */
+    explicit TDigest(
+            double compression = DEFAULT_COMPRESSION,
+            std::size_t buffer_capacity = DEFAULT_BUFFER_CAPACITY)
+        : compression_(compression)
+        , buffer_capacity_((std::max)(buffer_capacity, std::size_t(1)))
+    {
+    }
+
+    /**
+     * @brief Add a value to the digest.
+     *
+     * @param value The value to add. NaN values are ignored.
+     */
+    void add(
+            double value)
+    {
+        if (std::isnan(value))
+        {
+            return;
+        }
+
+        if (buffer_.size() >= buffer_capacity_)
+        {
+            merge_buffer_();
+        }
+        buffer_.push_back(value);
+        min_ = (std::min)(min_, value);
+        max_ = (std::max)(max_, value);
+    }
+
+    /// Number of values added to the digest, excluding the ignored NaN values
+    std::size_t count() const noexcept
+    {
+        return static_cast<std::size_t>(centroids_weight_) + buffer_.size();
+    }
+
+    /// Whether no value has been added to the digest
+    bool empty() const noexcept
+    {
+        return 0 == count();
+    }
+
+    /// Whether the quantiles are computed exactly, i.e. the values have never been merged into centroids
+    bool is_exact() const noexcept
+    {
+        return centroids_.empty();
+    }
+
+    /// Number of centroids in which the values have been summarized, after merging any buffered value
+    std::size_t centroid_count()
+    {
+        if (!is_exact())
+        {
+            merge_buffer_();
+        }
+        return centroids_.size();
+    }
+
+    /**
+     * @brief Estimate a quantile of the values added to the digest.
+     *
+     * While the digest is exact, the quantile is linearly interpolated between the closest ranks,
+     * so the quantile 0.5 is the usual median.
+     *
+     * @param q The quantile to compute, in the range [0, 1].
+     * @return The estimated quantile, or NaN if the digest is empty.
+     */
+    double quantile(
+            double q)
+    {
+        if (empty())
+        {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+
+        q = (std::min)((std::max)(q, 0.0), 1.0);
+
+        if (is_exact())
+        {
+            return exact_quantile_(q);
+        }
+
+        merge_buffer_();
+        return centroid_quantile_(q);
+    }
+
+protected:
+
+    //! A cluster of values summarized by their mean and their amount
+    struct Centroid
+    {
+        double mean;
+        double weight;
+    };
+
+    //! \c k1 scale function, mapping a quantile to the index space in which centroids have unit size
+    double scale_(
+            double q) const
+    {
+        return compression_ / (2.0 * PI_) * std::asin(2.0 * q - 1.0);
+    }
+
+    //! Inverse of @ref scale_
+    double inverse_scale_(
+            double k) const
+    {
+        if (k >= compression_ / 4.0)
+        {
+            return 1.0;
+        }
+        return (std::sin(k * 2.0 * PI_ / compression_) + 1.0) / 2.0;
+    }
+
+    //! Interpolate the quantile between the ranks of the buffered values
+    double exact_quantile_(
+            double q)
+    {
+        double position = q * static_cast<double>(buffer_.size() - 1);
+        std::size_t index = static_cast<std::size_t>(std::floor(position));
+        double fraction = position - static_cast<double>(index);
+
+        auto lower = buffer_.begin() + index;
+        std::nth_element(buffer_.begin(), lower, buffer_.end());
+        double value = *lower;
+
+        if (fraction > 0.0)
+        {
+            // After nth_element, all the values after index are greater or equal
+            double upper = *std::min_element(lower + 1, buffer_.end());
+            value = value * (1.0 - fraction) + upper * fraction;
+        }
+        return value;
+    }
+
+    //! Interpolate the quantile between the centers of the centroids, using the exact extremes at the ends
+    double centroid_quantile_(
+            double q) const
+    {
+        const double total = centroids_weight_;
+        const double rank = q * total;
+
+        if (1 == centroids_.size())
+        {
+            return centroids_.front().mean;
+        }
+        if (rank <= 0.0)
+        {
+            return min_;
+        }
+        if (rank >= total)
+        {
+            return max_;
+        }
+
+        // Between the minimum and the center of the first centroid
+        const Centroid& first = centroids_.front();
+        if (rank < first.weight / 2.0)
+        {
+            return min_ + (first.mean - min_) * rank / (first.weight / 2.0);
+        }
+
+        // Between the centers of two consecutive centroids
+        double weight_so_far = first.weight / 2.0;
+        for (std::size_t i = 0; i + 1 < centroids_.size(); ++i)
+        {
+            double delta = (centroids_[i].weight + centroids_[i + 1].weight) / 2.0;
+            if (weight_so_far + delta > rank)
+            {
+                double fraction = (rank - weight_so_far) / delta;
+                return centroids_[i].mean + (centroids_[i + 1].mean - centroids_[i].mean) * fraction;
+            }
+            weight_so_far += delta;
+        }
+
+        // Between the center of the last centroid and the maximum
+        const Centroid& last = centroids_.back();
+        double fraction = (rank - weight_so_far) / (last.weight / 2.0);
+        return last.mean + (max_ - last.mean) * (std::min)(fraction, 1.0);
+    }
+
+    //! Merge the buffered values with the current centroids
+    void merge_buffer_()
+    {
+        if (buffer_.empty())
+        {
+            return;
+        }
+
+        // Centroids are already sorted, so only the buffer needs sorting before merging both lists
+        std::sort(buffer_.begin(), buffer_.end());
+        std::vector<Centroid> points;
+        points.reserve(centroids_.size() + buffer_.size());
+        auto centroid = centroids_.begin();
+        for (double value : buffer_)
+        {
+            for (; centroid != centroids_.end() && centroid->mean < value; ++centroid)
+            {
+                points.push_back(*centroid);
+            }
+            points.push_back({value, 1.0});
+        }
+        points.insert(points.end(), centroid, centroids_.end());
+
+        const double total = centroids_weight_ + static_cast<double>(buffer_.size());
+        buffer_.clear();
+        centroids_.clear();
+
+        // Greedily merge consecutive points as long as the merged centroid spans at most one unit of k
+        Centroid current = points.front();
+        double weight_so_far = 0.0;
+        double q_limit = inverse_scale_(scale_(0.0) + 1.0);
+        for (auto it = points.begin() + 1; it != points.end(); ++it)
+        {
+            double q = (weight_so_far + current.weight + it->weight) / total;
+            if (q <= q_limit)
+            {
+                current.weight += it->weight;
+                current.mean += (it->mean - current.mean) * it->weight / current.weight;
+            }
+            else
+            {
+                weight_so_far += current.weight;
+                centroids_.push_back(current);
+                q_limit = inverse_scale_(scale_(weight_so_far / total) + 1.0);
+                current = *it;
+            }
+        }
+        centroids_.push_back(current);
+        centroids_weight_ = total;
+    }
+
+    static constexpr double PI_ = 3.14159265358979323846;
+
+    /// Compression factor
+    double compression_;
+
+    /// Maximum number of values in the buffer
+    std::size_t buffer_capacity_;
+
+    /// Values added since the last merge
+    std::vector<double> buffer_;
+
+    /// Centroids, sorted by mean
+    std::vector<Centroid> centroids_;
+
+    /// Amount of values summarized in the centroids
+    double centroids_weight_ = 0.0;
+
+    /// Minimum value added
+    double min_ = std::numeric_limits<double>::infinity();
+
+    /// Maximum value added
+    double max_ = -std::numeric_limits<double>::infinity();
+};
+
+} // namespace detail
+} // namespace statistics_backend
+} // namespace eprosima
+
+#endif // _EPROSIMA_FASTDDS_STATISTICS_BACKEND_DETAIL_TDIGEST_HPP_
@@ -19,7 +19,7 @@
 #ifndef _EPROSIMA_FASTDDS_STATISTICS_BACKEND_DETAIL_DATA_AGGREGATION_HPP_
 #define _EPROSIMA_FASTDDS_STATISTICS_BACKEND_DETAIL_DATA_AGGREGATION_HPP_
 
-#include <algorithm>  // std::min, std::max, std::nth_element
+#include <algorithm>  // std::min, std::max, std::partition_point
 #include <cassert>    // assert
 #include <cmath>      // std::isnan, std::sqrt
 #include <memory>     // std::unique_ptr
@@ -29,6 +29,8 @@
 
 #include <database/samples.hpp>
 #include <detail/data_getters.hpp>
+#include <detail/TDigest.hpp>
+#include <types/Rollup.hpp>
 
 namespace eprosima {
 namespace statistics_backend {
@@ -40,7 +42,7 @@ namespace detail {
  * It is constructed with the bins configuration and a reference to the resulting
  * data collection.
  *
- * The data returned by the database select() method is processed by the @ref add_data
+ * The data returned by the database select_spans() method is processed by the @ref add_data
  * method.
  *
  * To perform final aggregation calculations, method @ref finish should be called.
@@ -71,22 +73,12 @@ struct IDataAggregator
 
     /**
      * @brief Process a collection of data returned by the database.
-     * @param iterators Reference to the iterator pair returned by @ref get_iterators
+     * @param data_type The type of measurement requested to the database select_spans() call.
+     * @param spans The blocks of samples returned by the database select_spans() call, which must still be alive.
      */
-    void add_data(
-            IteratorPair& iterators)
-    {
-        for (auto& it = *iterators.first; it != *iterators.second; ++it)
-        {
-            // Find and check the bin corresponding to the sample timestamp
-            Timestamp ts = it.get_timestamp() + interval_;
-            auto index = (ts - data_[0].first) / interval_;
-            assert((index >= 0) && static_cast<size_t>(index) < data_.size());
-
-            // Add sample value to the corresponding bin
-            add_sample(static_cast<size_t>(index), it.get_value());
-        }
-    }
+    virtual void add_data(
+            DataKind data_type,
+            const std::vector<database::SampleSpan>& spans) = 0;
 
     /**
      * @brief Performs final aggregation of data.
@@ -97,15 +89,6 @@ struct IDataAggregator
 
 protected:
 
-    /**
-     * @brief Add a sample to a specific bin.
-     * @param index Index of the bin where the sample should be added.
-     * @param value Statistical value to add.
-     */
-    virtual void add_sample(
-            size_t index,
-            double value) = 0;
-
     /**
      * @brief Assign a value to a bin if it was not given a previous value.
      *
@@ -131,6 +114,23 @@ protected:
         return false;
     }
 
+    /**
+     * @brief Get the bin corresponding to a sample timestamp.
+     *
+     * Timestamps after the end of the last bin, which the truncation of the duration of the bins may leave
+     * before the ending time of the measures, are given to the last bin.
+     *
+     * @param ts Timestamp of the sample. It must not be lower than the starting time of the measures.
+     * @return Index of the bin.
+     */
+    size_t bin_index(
+            const Timestamp& ts) const
+    {
+        auto index = (ts + interval_ - data_[0].first) / interval_;
+        assert(index >= 0);
+        return (std::min)(static_cast<size_t>(index), data_.size() - 1);
+    }
+
     //! Reference to the collection to be returned by @ref StatisticsBackend::get_data
     std::vector<StatisticsData>& data_;
 
@@ -162,12 +162,103 @@ private:
     Timestamp::duration interval_;
 };
 
+/**
+ * @brief Base of the aggregators, which splits the data returned by the database into runs of samples of the same bin.
+ *
+ * The type of the samples is resolved once per call to @ref add_data. As the samples are sorted by timestamp, the
+ * bin of each run is found advancing from the bin of the previous run, and the end of each run is found with an
+ * exponential search on the timestamps.
+ * Each run is then processed by the \c add_run method of the concrete aggregator, which is bound at compile time
+ * and receives the samples with their actual type, so it can be implemented as a tight loop.
+ *
+ * @tparam Aggregator The concrete aggregator. It must implement
+ *                    \c template<typename T> void add_run(size_t index, const T* first, const T* last).
+ */
+template<typename Aggregator>
+struct DataAggregator : public IDataAggregator
+{
+    using IDataAggregator::IDataAggregator;
+
+    void add_data(
+            DataKind data_type,
+            const std::vector<database::SampleSpan>& spans) final
+    {
+        visit_sample_type(data_type, [this, &spans](
+                    auto sample_type)
+                {
+                    using T = typename decltype(sample_type)::type;
+                    add_spans<T>(spans);
+                });
+    }
+
+private:
+
+    template<typename T>
+    void add_spans(
+            const std::vector<database::SampleSpan>& spans)
+    {
+        if (spans.empty())
+        {
+            return;
+        }
+
+        const size_t last_index = data_.size() - 1;
+        size_t index = bin_index(spans.front().first->src_ts);
+
+        for (const auto& span : spans)
+        {
+            const T* first = span.data<T>();
+            const T* end = first + span.size;
+
+            while (first != end)
+            {
+                // Advance to the bin of the first sample of the run. Bins never go back as the samples are sorted.
+                while (index < last_index && first->src_ts >= data_[index].first)
+                {
+                    ++index;
+                }
+
+                const T* last = (index == last_index) ? end : run_end(first, end, data_[index].first);
+                static_cast<Aggregator*>(this)->add_run(index, first, last);
+                first = last;
+            }
+        }
+    }
+
+    /**
+     * @brief Find the first sample of a sorted range with a timestamp not lower than a given limit.
+     *
+     * The search doubles the step from the beginning of the range before the binary search, so its cost depends
+     * on the length of the run and not on the length of the range.
+     */
+    template<typename T>
+    static const T* run_end(
+            const T* first,
+            const T* end,
+            const Timestamp& limit)
+    {
+        size_t length = static_cast<size_t>(end - first);
+        size_t step = 1;
+        while (step < length && first[step].src_ts < limit)
+        {
+            step *= 2;
+        }
+
+        return std::partition_point(first + step / 2, first + (std::min)(step, length), [&limit](
+                    const T& sample)
+                {
+                    return sample.src_ts < limit;
+                });
+    }
+
+};
+
 #include "data_aggregators/CountAggregator.ipp"
 #include "data_aggregators/MaximumAggregator.ipp"
 #include "data_aggregators/MeanAggregator.ipp"
-#include "data_aggregators/MedianAggregator.ipp"
 #include "data_aggregators/MinimumAggregator.ipp"
 #include "data_aggregators/NoneAggregator.ipp"
+#include "data_aggregators/QuantileAggregator.ipp"
 #include "data_aggregators/StdDevAggregator.ipp"
 #include "data_aggregators/SumAggregator.ipp"
 
@@ -206,7 +297,23 @@ std::unique_ptr<detail::IDataAggregator> get_data_aggregator(
             break;
 
         case StatisticKind::MEDIAN:
-            ret_val = new detail::MedianAggregator(bins, t_from, t_to, returned_data);
+            ret_val = new detail::QuantileAggregator(bins, t_from, t_to, returned_data, 0.5);
+            break;
+
+        case StatisticKind::PERCENTILE_50:
+            ret_val = new detail::QuantileAggregator(bins, t_from, t_to, returned_data, 0.5);
+            break;
+
+        case StatisticKind::PERCENTILE_90:
+            ret_val = new detail::QuantileAggregator(bins, t_from, t_to, returned_data, 0.9);
+            break;
+
+        case StatisticKind::PERCENTILE_99:
+            ret_val = new detail::QuantileAggregator(bins, t_from, t_to, returned_data, 0.99);
+            break;
+
+        case StatisticKind::PERCENTILE_99_9:
+            ret_val = new detail::QuantileAggregator(bins, t_from, t_to, returned_data, 0.999);
             break;
 
         case StatisticKind::MAX:
@@ -230,6 +337,93 @@ std::unique_ptr<detail::IDataAggregator> get_data_aggregator(
     return std::unique_ptr<detail::IDataAggregator>(ret_val);
 }
 
+/**
+ * @brief Whether a statistic can be computed from the summaries kept by the rollups of the database.
+ * @param statistic  Kind of aggregation to perform
+ */
+bool is_summary_statistic(
+        StatisticKind statistic)
+{
+    switch (statistic)
+    {
+        case StatisticKind::COUNT:
+        case StatisticKind::SUM:
+        case StatisticKind::MEAN:
+        case StatisticKind::MAX:
+        case StatisticKind::MIN:
+        case StatisticKind::STANDARD_DEVIATION:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Compute the result of a @ref StatisticsBackend::get_data call from the summaries of each bin.
+ *
+ * The result is the same as the one of the aggregator of the statistic, except for the rounding of the floating
+ * point operations, which are performed in a different order.
+ *
+ * @param statistic      Kind of aggregation to perform. It must be a summary statistic.
+ * @param bins           Summaries of each bin
+ * @param returned_data  Reference to the collection to be returned by @ref StatisticsBackend::get_data
+ */
+void get_data_from_summaries(
+        StatisticKind statistic,
+        const details::RollupBins& bins,
+        std::vector<StatisticsData>& returned_data)
+{
+    assert(is_summary_statistic(statistic));
+
+    returned_data.reserve(bins.summaries.size());
+    for (size_t n = 0; n < bins.summaries.size(); ++n)
+    {
+        const details::RollupSummary& summary = bins.summaries[n];
+        double value = std::numeric_limits<double>::quiet_NaN();
+
+        if (StatisticKind::COUNT == statistic)
+        {
+            value = static_cast<double>(summary.count);
+        }
+        else if (!summary.empty())
+        {
+            switch (statistic)
+            {
+                // A NaN value as the last one of the bin makes these statistics NaN, as in the aggregators
+                case StatisticKind::SUM:
+                    value = summary.nan_last ? value : summary.sum;
+                    break;
+
+                case StatisticKind::MEAN:
+                    value = summary.nan_last ? value : summary.sum / summary.count;
+                    break;
+
+                case StatisticKind::MAX:
+                    value = summary.nan_last ? value : summary.max;
+                    break;
+
+                case StatisticKind::MIN:
+                    value = summary.nan_last ? value : summary.min;
+                    break;
+
+                case StatisticKind::STANDARD_DEVIATION:
+                default:
+                {
+                    // The rounding errors may give a slightly negative variance when all the values are equal.
+                    // A NaN variance, given by any NaN value, is kept
+                    double variance = (summary.sum_sq - (summary.sum * summary.sum) / summary.count) / summary.count;
+                    value = std::sqrt(variance < 0.0 ? 0.0 : variance);
+                    break;
+                }
+            }
+        }
+
+        // Bins are identified by their ending time, as done by the aggregators
+        returned_data.emplace_back(bins.t_from + bins.interval * static_cast<Timestamp::rep>(n + 1), value);
+    }
+}
+
 } // namespace statistics_backend
 } // namespace eprosima
 
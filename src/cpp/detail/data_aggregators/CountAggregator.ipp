@@ -17,25 +17,29 @@
  */
 
 /// An @ref IDataAggregator that returns the number of samples added to each bin
-struct CountAggregator final : public IDataAggregator
+struct CountAggregator final : public DataAggregator<CountAggregator>
 {
     CountAggregator(
             uint16_t bins,
             Timestamp t_from,
             Timestamp t_to,
             std::vector<StatisticsData>& returned_data)
-        : IDataAggregator(bins, t_from, t_to, returned_data, 0)
+        : DataAggregator<CountAggregator>(bins, t_from, t_to, returned_data, 0)
     {
     }
 
 protected:
 
-    void add_sample(
+    friend struct DataAggregator<CountAggregator>;
+
+    template<typename T>
+    void add_run(
             size_t index,
-            double value) override
+            const T* first,
+            const T* last)
     {
-        static_cast<void>(value);
-        data_[index].second++;
+        // The values are not needed, only the number of samples in the run
+        data_[index].second += static_cast<double>(last - first);
     }
 
 };
@@ -22,14 +22,14 @@
  * It behaves as the @ref SumAggregator, but it also keeps track of the number of samples added to each bin.
  * It will then perform the final division inside @ref MeanAggregator::finish.
  */
-struct MeanAggregator final : public IDataAggregator
+struct MeanAggregator final : public DataAggregator<MeanAggregator>
 {
     MeanAggregator(
             uint16_t bins,
             Timestamp t_from,
             Timestamp t_to,
             std::vector<StatisticsData>& returned_data)
-        : IDataAggregator(bins, t_from, t_to, returned_data)
+        : DataAggregator<MeanAggregator>(bins, t_from, t_to, returned_data)
     {
         // Initialize all sample counts to 0
         num_samples_.assign(data_.size(), 0);
@@ -48,18 +48,25 @@ struct MeanAggregator final : public IDataAggregator
 
 protected:
 
-    void add_sample(
+    friend struct DataAggregator<MeanAggregator>;
+
+    template<typename T>
+    void add_run(
             size_t index,
-            double value) override
+            const T* first,
+            const T* last)
     {
-        // Accumulate value
-        if (!assign_if_nan(index, value))
+        // Increase number of samples
+        num_samples_[index] += static_cast<size_t>(last - first);
+
+        // Accumulate values
+        double sum = data_[index].second;
+        for (; first != last; ++first)
         {
-            data_[index].second += value;
+            double value = get_value(*first);
+            sum = std::isnan(sum) ? value : sum + value;
         }
-
-        // Increase number of samples
-        ++num_samples_[index];
+        data_[index].second = sum;
     }
 
 private:
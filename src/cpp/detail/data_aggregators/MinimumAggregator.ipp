@@ -17,27 +17,34 @@
  */
 
 /// An @ref IDataAggregator that returns the minimum of all the samples added to each bin
-struct MinimumAggregator final : public IDataAggregator
+struct MinimumAggregator final : public DataAggregator<MinimumAggregator>
 {
     MinimumAggregator(
             uint16_t bins,
             Timestamp t_from,
             Timestamp t_to,
             std::vector<StatisticsData>& returned_data)
-        : IDataAggregator(bins, t_from, t_to, returned_data)
+        : DataAggregator<MinimumAggregator>(bins, t_from, t_to, returned_data)
     {
     }
 
 protected:
 
-    void add_sample(
+    friend struct DataAggregator<MinimumAggregator>;
+
+    template<typename T>
+    void add_run(
             size_t index,
-            double value) override
+            const T* first,
+            const T* last)
     {
-        if (!assign_if_nan(index, value))
+        // The value of an empty bin is NaN, which std::min discards when it is the second argument
+        double result = data_[index].second;
+        for (; first != last; ++first)
         {
-            data_[index].second = (std::min)(value, data_[index].second);
+            result = (std::min)(get_value(*first), result);
         }
+        data_[index].second = result;
     }
 
 };
@@ -17,24 +17,32 @@
  */
 
 /// An @ref IDataAggregator that returns the first sample received for each bin
-struct NoneAggregator final : public IDataAggregator
+struct NoneAggregator final : public DataAggregator<NoneAggregator>
 {
     NoneAggregator(
             uint16_t bins,
             Timestamp t_from,
             Timestamp t_to,
             std::vector<StatisticsData>& returned_data)
-        : IDataAggregator(bins, t_from, t_to, returned_data)
+        : DataAggregator<NoneAggregator>(bins, t_from, t_to, returned_data)
     {
     }
 
 protected:
 
-    void add_sample(
+    friend struct DataAggregator<NoneAggregator>;
+
+    template<typename T>
+    void add_run(
             size_t index,
-            double value) override
+            const T* first,
+            const T* last)
     {
-        assign_if_nan(index, value);
+        // Only the first sample of the bin is kept
+        while (first != last && assign_if_nan(index, get_value(*first)))
+        {
+            ++first;
+        }
     }
 
 };
@@ -0,0 +1,75 @@
+// Copyright 2021 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file QuantileAggregator.ipp
+ */
+
+/**
+ * @brief An @ref IDataAggregator that returns a quantile of the values of the samples added to each bin
+ *
+ * It keeps a @ref TDigest on each bin, so the memory used does not grow with the number of samples.
+ * Bins with few samples are computed exactly, which is what @ref StatisticKind::MEDIAN relies on.
+ */
+struct QuantileAggregator final : public DataAggregator<QuantileAggregator>
+{
+    QuantileAggregator(
+            uint16_t bins,
+            Timestamp t_from,
+            Timestamp t_to,
+            std::vector<StatisticsData>& returned_data,
+            double quantile)
+        : DataAggregator<QuantileAggregator>(bins, t_from, t_to, returned_data)
+        , quantile_(quantile)
+    {
+        digests_.resize(data_.size());
+    }
+
+    void finish() override
+    {
+        for (size_t n = 0; n < data_.size(); ++n)
+        {
+            if (!digests_[n].empty())
+            {
+                data_[n].second = digests_[n].quantile(quantile_);
+            }
+        }
+    }
+
+protected:
+
+    friend struct DataAggregator<QuantileAggregator>;
+
+    template<typename T>
+    void add_run(
+            size_t index,
+            const T* first,
+            const T* last)
+    {
+        TDigest& digest = digests_[index];
+        for (; first != last; ++first)
+        {
+            digest.add(get_value(*first));
+        }
+    }
+
+private:
+
+    /// The quantile to compute, in the range [0, 1]
+    double quantile_;
+
+    /// Summarizes the values added to each bin
+    std::vector<TDigest> digests_;
+
+};
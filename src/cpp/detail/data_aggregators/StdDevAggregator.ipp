@@ -22,14 +22,14 @@
  * Implements the <a href="https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance#Na%C3%AFve_algorithm">naïve algorithm</a>
  * keeping the sum of the values, the sum of the squares, and the number of samples.
  */
-struct StdDevAggregator final : public IDataAggregator
+struct StdDevAggregator final : public DataAggregator<StdDevAggregator>
 {
     StdDevAggregator(
             uint16_t bins,
             Timestamp t_from,
             Timestamp t_to,
             std::vector<StatisticsData>& returned_data)
-        : IDataAggregator(bins, t_from, t_to, returned_data)
+        : DataAggregator<StdDevAggregator>(bins, t_from, t_to, returned_data)
     {
         bin_data_.resize(data_.size());
     }
@@ -42,22 +42,36 @@ struct StdDevAggregator final : public IDataAggregator
             auto n_samples = data.num_samples;
             if (n_samples > 0)
             {
+                // The rounding errors may give a slightly negative variance when all the values are equal.
+                // A NaN variance, given by any NaN value, is kept
                 double variance = (data.sum_sq - (data.sum * data.sum) / n_samples) / n_samples;
-                data_[n].second = std::sqrt(variance);
+                data_[n].second = std::sqrt(variance < 0.0 ? 0.0 : variance);
             }
         }
     }
 
 protected:
 
-    void add_sample(
+    friend struct DataAggregator<StdDevAggregator>;
+
+    template<typename T>
+    void add_run(
             size_t index,
-            double value) override
+            const T* first,
+            const T* last)
     {
         BinData& data = bin_data_[index];
-        data.sum += value;
-        data.sum_sq += (value * value);
-        data.num_samples += 1;
+        double sum = data.sum;
+        double sum_sq = data.sum_sq;
+        data.num_samples += static_cast<uint64_t>(last - first);
+        for (; first != last; ++first)
+        {
+            double value = get_value(*first);
+            sum += value;
+            sum_sq += (value * value);
+        }
+        data.sum = sum;
+        data.sum_sq = sum_sq;
     }
 
 private:
@@ -17,27 +17,35 @@
  */
 
 /// An @ref IDataAggregator that returns the addition of all the samples added to each bin
-struct SumAggregator final : public IDataAggregator
+struct SumAggregator final : public DataAggregator<SumAggregator>
 {
     SumAggregator(
             uint16_t bins,
             Timestamp t_from,
             Timestamp t_to,
             std::vector<StatisticsData>& returned_data)
-        : IDataAggregator(bins, t_from, t_to, returned_data)
+        : DataAggregator<SumAggregator>(bins, t_from, t_to, returned_data)
     {
     }
 
 protected:
 
-    void add_sample(
+    friend struct DataAggregator<SumAggregator>;
+
+    template<typename T>
+    void add_run(
             size_t index,
-            double value) override
+            const T* first,
+            const T* last)
     {
-        if (!assign_if_nan(index, value))
+        // Accumulate on the value of the bin, so the values are added in the same order as they were sampled
+        double sum = data_[index].second;
+        for (; first != last; ++first)
         {
-            data_[index].second += value;
+            double value = get_value(*first);
+            sum = std::isnan(sum) ? value : sum + value;
         }
+        data_[index].second = sum;
     }
 
 };
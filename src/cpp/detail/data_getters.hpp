@@ -20,9 +20,9 @@
 #define _EPROSIMA_FASTDDS_STATISTICS_BACKEND_DETAIL_DATA_GETTERS_HPP_
 
 #include <algorithm>  // std::max
-#include <memory>     // std::unique_ptr
+#include <cmath>      // pow
+#include <cstddef>    // std::size_t
 #include <vector>     // std::vector
-#include <utility>    // std::pair
 
 #include <database/samples.hpp>
 
@@ -30,190 +30,78 @@ namespace eprosima {
 namespace statistics_backend {
 namespace detail {
 
-using base_iterator_type = typename std::vector<const database::StatisticsSample*>::const_iterator;
-
-/**
- * @brief A const_iterator for statistics samples obtained from the database select operation.
- *
- * Provides adapter interfaces to get the timestamp and statistic (double) value of the specific database
- * sample.
- */
-struct GenericIterator : public base_iterator_type
-{
-    explicit GenericIterator(
-            const base_iterator_type& plain_iterator) noexcept
-        : base_iterator_type(plain_iterator)
-    {
-    }
-
-    virtual ~GenericIterator()
-    {
-    }
-
-    /**
-     * @brief Get the timestamp of the sample currently pointed to by this iterator.
-     * @return Timestamp of sample.
-     */
-    Timestamp get_timestamp() const noexcept
-    {
-        return (**this)->src_ts;
-    }
-
-    /**
-     * @brief Get the statistic value of the sample currently pointed to by this iterator.
-     * @return Statistic value of sample.
-     */
-    virtual double get_value() const noexcept = 0;
-
-protected:
-
-    /// An utility method to get a reference to a specific child of the sample
-    template<typename T>
-    const T& sample() const noexcept
-    {
-        const database::StatisticsSample* ptr = **this;
-        return *static_cast<const T*>(ptr);
-    }
-
-};
-
-/// Basic template which provides a concrete specialization of the reference getter.
-template<typename T>
-struct BasicStatisticsIterator : public GenericIterator
+/// Get the statistic value of an EntityDataSample
+inline double get_value(
+        const database::EntityDataSample& sample) noexcept
 {
-    explicit BasicStatisticsIterator(
-            const base_iterator_type& plain_iterator) noexcept
-        : GenericIterator(plain_iterator)
-    {
-    }
-
-protected:
-
-    const T& sample() const noexcept
-    {
-        return GenericIterator::sample<T>();
-    }
-
-};
-
-/// Final template that should be specialized for every kind of database sample
-template<typename T>
-struct StatisticsIterator final : public BasicStatisticsIterator<T>
-{
-    explicit StatisticsIterator(
-            const base_iterator_type& plain_iterator) noexcept
-        : BasicStatisticsIterator<T>(plain_iterator)
-    {
-    }
-
-};
+    return sample.data;
+}
 
-/// Iterator returned for EntityDataSample
-template<>
-struct StatisticsIterator<database::EntityDataSample> final
-    : public BasicStatisticsIterator<database::EntityDataSample>
+/// Get the statistic value of an EntityCountSample
+inline double get_value(
+        const database::EntityCountSample& sample) noexcept
 {
-    explicit StatisticsIterator(
-            const base_iterator_type& plain_iterator) noexcept
-        : BasicStatisticsIterator<database::EntityDataSample>(plain_iterator)
-    {
-    }
-
-    double get_value() const noexcept override
-    {
-        return sample().data;
-    }
-
-};
+    return static_cast<double>(sample.count);
+}
 
-/// Iterator returned for EntityCountSample
-template<>
-struct StatisticsIterator<database::EntityCountSample> final
-    : public BasicStatisticsIterator<database::EntityCountSample>
+/// Get the statistic value of a ByteCountSample
+inline double get_value(
+        const database::ByteCountSample& sample) noexcept
 {
-    explicit StatisticsIterator(
-            const base_iterator_type& plain_iterator) noexcept
-        : BasicStatisticsIterator<database::EntityCountSample>(plain_iterator)
-    {
-    }
-
-    double get_value() const noexcept override
-    {
-        return static_cast<double>(sample().count);
-    }
-
-};
+    double order = (std::max)(sample.magnitude_order, static_cast<int16_t>(0));
+    return static_cast<double>(sample.count) + pow(2, 64) * order;
+}
 
-/// Iterator returned for ByteCountSample
-template<>
-struct StatisticsIterator<database::ByteCountSample> final
-    : public BasicStatisticsIterator<database::ByteCountSample>
+/// Get the statistic value of a TimepointSample
+inline double get_value(
+        const database::TimepointSample& sample) noexcept
 {
-    explicit StatisticsIterator(
-            const base_iterator_type& plain_iterator) noexcept
-        : BasicStatisticsIterator<database::ByteCountSample>(plain_iterator)
-    {
-    }
-
-    double get_value() const noexcept override
-    {
-        double order = (std::max)(sample().magnitude_order, static_cast<int16_t>(0));
-        return static_cast<double>(sample().count) + pow(2, 64) * order;
-    }
-
-};
+    auto t_epoch = sample.time.time_since_epoch();
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t_epoch);
+    return static_cast<double>(ns.count());
+}
 
-/// Iterator returned for TimepointSample
-template<>
-struct StatisticsIterator<database::TimepointSample> final
-    : public BasicStatisticsIterator<database::TimepointSample>
+/// Tag to pass the type of the samples stored in the database for a DataKind
+template<typename T>
+struct SampleType
 {
-    explicit StatisticsIterator(
-            const base_iterator_type& plain_iterator) noexcept
-        : BasicStatisticsIterator<database::TimepointSample>(plain_iterator)
-    {
-    }
-
-    double get_value() const noexcept override
-    {
-        auto t_epoch = sample().time.time_since_epoch();
-        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t_epoch);
-        return static_cast<double>(ns.count());
-    }
-
+    using type = T;
 };
 
-using IteratorPtr = std::unique_ptr<GenericIterator>;
-using IteratorPair = std::pair<IteratorPtr, IteratorPtr>;
-
 /**
- * @brief Get the iterators delimiting the traversal of a database select() result.
- * @param data The collection returned by the database select() call.
- * @return A pair of unique pointers to GenericIterator, with the begin and end iterators.
+ * @brief Traverse the samples of a database select_spans() result, knowing their type.
+ * @tparam T The type of the samples stored in the database for the requested measurement.
+ * @param spans The blocks of samples returned by the database select_spans() call, which must still be alive.
+ * @param function Callable as \c function(Timestamp, double) with the timestamp and the statistic value of each sample.
  */
-template<typename T>
-IteratorPair get_iterators(
-        const std::vector<const database::StatisticsSample*>& data)
+template<typename T, typename Function>
+void for_each_typed_sample(
+        const std::vector<database::SampleSpan>& spans,
+        Function& function)
 {
-    return IteratorPair
-           {
-               new StatisticsIterator<T>(data.cbegin()),
-               new StatisticsIterator<T>(data.cend())
-           };
+    for (const auto& span : spans)
+    {
+        const T* samples = span.data<T>();
+        for (std::size_t i = 0; i < span.size; ++i)
+        {
+            function(samples[i].src_ts, get_value(samples[i]));
+        }
+    }
 }
 
 } // namespace detail
 
 /**
- * @brief Get the iterators delimiting the traversal of a database select() result.
- * @param data_type The type of measurement requested to the database select() call.
- * @param data The collection returned by the database select() call.
+ * @brief Call a function with the type of the samples that the database stores for a DataKind.
+ *
+ * @param data_type The type of measurement requested to the database.
+ * @param function Callable as \c function(detail::SampleType<T>()), where \c T is the type of the samples.
  * @throws eprosima::statistics_backend::BadParameter if \c data_type is DataKind::INVALID
- * @return A pair of unique pointers to GenericIterator, with the begin and end iterators.
  */
-detail::IteratorPair get_iterators(
+template<typename Function>
+void visit_sample_type(
         DataKind data_type,
-        const std::vector<const database::StatisticsSample*>& data)
+        Function&& function)
 {
     switch (data_type)
     {
@@ -221,7 +109,8 @@ detail::IteratorPair get_iterators(
         case DataKind::NETWORK_LATENCY:
         case DataKind::PUBLICATION_THROUGHPUT:
         case DataKind::SUBSCRIPTION_THROUGHPUT:
-            return detail::get_iterators<database::EntityDataSample>(data);
+            function(detail::SampleType<database::EntityDataSample>());
+            break;
 
         case DataKind::RTPS_PACKETS_SENT:
         case DataKind::RTPS_PACKETS_LOST:
@@ -234,20 +123,47 @@ detail::IteratorPair get_iterators(
         case DataKind::PDP_PACKETS:
         case DataKind::EDP_PACKETS:
         case DataKind::SAMPLE_DATAS:
-            return detail::get_iterators<database::EntityCountSample>(data);
+            function(detail::SampleType<database::EntityCountSample>());
+            break;
 
         case DataKind::RTPS_BYTES_SENT:
         case DataKind::RTPS_BYTES_LOST:
-            return detail::get_iterators<database::ByteCountSample>(data);
+            function(detail::SampleType<database::ByteCountSample>());
+            break;
 
         case DataKind::DISCOVERY_TIME:
-            return detail::get_iterators<database::TimepointSample>(data);
+            function(detail::SampleType<database::DiscoveryTimeSample>());
+            break;
 
         default:
             throw BadParameter("Unsupported data kind");
     }
 }
 
+/**
+ * @brief Traverse the samples of a database select_spans() result.
+ *
+ * The type of the samples is resolved once for the whole traversal, so the samples are read without any virtual call.
+ *
+ * @param data_type The type of measurement requested to the database select_spans() call.
+ * @param spans The blocks of samples returned by the database select_spans() call, which must still be alive.
+ * @param function Callable as \c function(Timestamp, double) with the timestamp and the statistic value of each sample.
+ * @throws eprosima::statistics_backend::BadParameter if \c data_type is DataKind::INVALID
+ */
+template<typename Function>
+void for_each_sample(
+        DataKind data_type,
+        const std::vector<database::SampleSpan>& spans,
+        Function&& function)
+{
+    visit_sample_type(data_type, [&spans, &function](
+                auto sample_type)
+            {
+                using T = typename decltype(sample_type)::type;
+                detail::for_each_typed_sample<T>(spans, function);
+            });
+}
+
 } // namespace statistics_backend
 } // namespace eprosima
 
@@ -60,7 +60,7 @@ StatisticsParticipantListener::StatisticsParticipantListener(
         EntityId domain_id,
         database::Database* database,
         database::DatabaseEntityQueue* entity_queue,
-        database::DatabaseDataQueue* data_queue) noexcept
+        database::ShardedDatabaseDataQueue* data_queue) noexcept
     : DomainParticipantListener()
     , domain_id_(domain_id)
     , database_(database)
@@ -127,9 +127,6 @@ void StatisticsParticipantListener::on_participant_discovery(
         DomainParticipant* /*participant*/,
         ParticipantDiscoveryInfo&& info)
 {
-    // First stop the data queue until the new entity is created
-    data_queue_->stop_consumer();
-
     std::chrono::system_clock::time_point timestamp = now();
 
     // Meaningful prefix for metatraffic entities
@@ -210,9 +207,9 @@ void StatisticsParticipantListener::on_participant_discovery(
         }
     }
 
-    // Wait until the entity queue is processed and restart the data queue
+    // Wait until the entity queue is processed.
+    // The data queue keeps running: data of the new entities wait for this queue to be processed
     entity_queue_->flush();
-    data_queue_->start_consumer();
 }
 
 void StatisticsParticipantListener::on_subscriber_discovery(
@@ -225,9 +222,6 @@ void StatisticsParticipantListener::on_subscriber_discovery(
         return;
     }
 
-    // First stop the data queue until the new entity is created
-    data_queue_->stop_consumer();
-
     std::chrono::system_clock::time_point timestamp = now();
 
     // Build the discovery info for the queue
@@ -263,9 +257,9 @@ void StatisticsParticipantListener::on_subscriber_discovery(
 
     entity_queue_->push(timestamp, discovery_info);
 
-    // Wait until the entity queue is processed and restart the data queue
+    // Wait until the entity queue is processed.
+    // The data queue keeps running: data of the new entities wait for this queue to be processed
     entity_queue_->flush();
-    data_queue_->start_consumer();
 }
 
 void StatisticsParticipantListener::on_publisher_discovery(
@@ -276,9 +270,6 @@ void StatisticsParticipantListener::on_publisher_discovery(
     // deactivation of fastdds statistics module is enforced for the statistics backend, and hence none is ever created
     static_cast<void>(participant);
 
-    // First stop the data queue until the new entity is created
-    data_queue_->stop_consumer();
-
     std::chrono::system_clock::time_point timestamp = now();
 
     // Build the discovery info for the queue
@@ -314,9 +305,9 @@ void StatisticsParticipantListener::on_publisher_discovery(
 
     entity_queue_->push(timestamp, discovery_info);
 
-    // Wait until the entity queue is processed and restart the data queue
+    // Wait until the entity queue is processed.
+    // The data queue keeps running: data of the new entities wait for this queue to be processed
     entity_queue_->flush();
-    data_queue_->start_consumer();
 }
 
 } //namespace database
@@ -33,7 +33,7 @@ namespace statistics_backend {
 namespace database {
 
 class Database;
-class DatabaseDataQueue;
+class ShardedDatabaseDataQueue;
 class DatabaseEntityQueue;
 
 } // namespace database
@@ -55,7 +55,7 @@ public:
             EntityId domain_id,
             database::Database* database,
             database::DatabaseEntityQueue* entity_queue,
-            database::DatabaseDataQueue* data_queue) noexcept;
+            database::ShardedDatabaseDataQueue* data_queue) noexcept;
 
     /*!
      * This method is called when a new Participant is discovered, or a previously discovered participant changes
@@ -89,10 +89,10 @@ public:
 
 protected:
 
-    EntityId domain_id_;                            ///< The DomainId this listener is monitoring
-    database::Database* database_;                  ///< Reference to the statistics database. Injected on construction
-    database::DatabaseEntityQueue* entity_queue_;   ///< Reference to the statistics entity queue. Injected on construction
-    database::DatabaseDataQueue* data_queue_;       ///< Reference to the statistics data queue. Injected on construction
+    EntityId domain_id_;                                ///< The DomainId this listener is monitoring
+    database::Database* database_;                      ///< Reference to the statistics database. Injected on construction
+    database::DatabaseEntityQueue* entity_queue_;       ///< Reference to the statistics entity queue. Injected on construction
+    database::ShardedDatabaseDataQueue* data_queue_;    ///< Reference to the statistics data queue. Injected on construction
 };
 
 
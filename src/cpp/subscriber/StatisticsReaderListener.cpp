@@ -19,12 +19,14 @@
 
 #include "StatisticsReaderListener.hpp"
 
+#include <fastdds/dds/core/LoanableSequence.hpp>
 #include <fastdds/dds/subscriber/DataReader.hpp>
 #include <fastdds/dds/subscriber/SampleInfo.hpp>
-#include <fastdds/dds/topic/TopicDescription.hpp>
 #include <fastdds/statistics/topic_names.hpp>
 #include <fastrtps/types/TypesBase.h>
 
+#include <fastdds_statistics_backend/exception/Exception.hpp>
+
 #include <database/database_queue.hpp>
 #include <topic_types/types.h>
 
@@ -58,125 +60,149 @@ static const std::map<std::string, EventKind> topics =
     {PHYSICAL_DATA_TOPIC,           PHYSICAL_DATA}
 };
 
+/*
+ * Set the inner data of a statistics Data union.
+ * The discriminator must be set afterwards, as the inner data of some kinds is shared by several topics.
+ */
+static void set_inner_data(
+        Data& data,
+        const WriterReaderData& inner_data)
+{
+    data.writer_reader_data(inner_data);
+}
+
+static void set_inner_data(
+        Data& data,
+        const Locator2LocatorData& inner_data)
+{
+    data.locator2locator_data(inner_data);
+}
+
+static void set_inner_data(
+        Data& data,
+        const EntityData& inner_data)
+{
+    data.entity_data(inner_data);
+}
+
+static void set_inner_data(
+        Data& data,
+        const Entity2LocatorTraffic& inner_data)
+{
+    data.entity2locator_traffic(inner_data);
+}
+
+static void set_inner_data(
+        Data& data,
+        const EntityCount& inner_data)
+{
+    data.entity_count(inner_data);
+}
+
+static void set_inner_data(
+        Data& data,
+        const DiscoveryTime& inner_data)
+{
+    data.discovery_time(inner_data);
+}
+
+static void set_inner_data(
+        Data& data,
+        const SampleIdentityCount& inner_data)
+{
+    data.sample_identity_count(inner_data);
+}
+
+static void set_inner_data(
+        Data& data,
+        const PhysicalData& inner_data)
+{
+    data.physical_data(inner_data);
+}
+
 StatisticsReaderListener::StatisticsReaderListener(
-        database::DatabaseDataQueue* data_queue) noexcept
+        database::ShardedDatabaseDataQueue* data_queue,
+        const std::string& topic_name)
     : DataReaderListener()
     , data_queue_(data_queue)
 {
+    auto topic = topics.find(topic_name);
+    if (topic == topics.end())
+    {
+        throw BadParameter(topic_name + " is not a statistics topic");
+    }
+    event_kind_ = topic->second;
 }
 
 template<typename T>
-bool StatisticsReaderListener::get_available_data(
-        eprosima::fastdds::dds::DataReader* reader,
-        T& inner_data,
-        std::chrono::system_clock::time_point& timestamp)
+void StatisticsReaderListener::take_available_data(
+        eprosima::fastdds::dds::DataReader* reader)
 {
-    SampleInfo info;
-    if (reader->take_next_sample(&inner_data, &info) == ReturnCode_t::RETCODE_OK)
+    // Empty sequences, so that the reader loans the samples instead of copying them
+    LoanableSequence<T> inner_data;
+    LoanableSequence<SampleInfo> infos;
+
+    while (reader->take(inner_data, infos, MAX_SAMPLES_PER_TAKE) == ReturnCode_t::RETCODE_OK)
     {
-        if (!info.valid_data)
+        for (LoanableCollection::size_type i = 0; i < infos.length(); ++i)
         {
-            // Received data not valid
-            return false;
+            if (!infos[i].valid_data)
+            {
+                // Received data not valid
+                continue;
+            }
+
+            // Recycled data keep the memory of their previous contents, which is reused when overwritten
+            std::shared_ptr<Data> data = data_queue_->data_pool().acquire();
+            set_inner_data(*data, inner_data[i]);
+            data->_d(event_kind_);
+            data_queue_->push(nanoseconds_to_systemclock(infos[i].source_timestamp.to_ns()), data);
         }
-        timestamp = nanoseconds_to_systemclock(info.source_timestamp.to_ns());
-        return true;
+        reader->return_loan(inner_data, infos);
     }
-    return false;
 }
 
 void StatisticsReaderListener::on_data_available(
         eprosima::fastdds::dds::DataReader* reader)
 {
-    std::shared_ptr<Data> data = std::make_shared<Data>();
-    std::chrono::system_clock::time_point timestamp;
-
-    const std::string& topic_name = reader->get_topicdescription()->get_name();
-
-    bool enqueue = false;
-    if (HISTORY_LATENCY_TOPIC == topic_name)
-    {
-        WriterReaderData inner_data;
-        if (get_available_data(reader, inner_data, timestamp))
-        {
-            data->writer_reader_data(inner_data);
-            enqueue = true;
-        }
-    }
-    else if (NETWORK_LATENCY_TOPIC == topic_name)
+    switch (event_kind_)
     {
-        Locator2LocatorData inner_data;
-        if (get_available_data(reader, inner_data, timestamp))
-        {
-            data->locator2locator_data(inner_data);
-            enqueue = true;
-        }
-    }
-    else if (PUBLICATION_THROUGHPUT_TOPIC == topic_name || SUBSCRIPTION_THROUGHPUT_TOPIC == topic_name)
-    {
-        EntityData inner_data;
-        if (get_available_data(reader, inner_data, timestamp))
-        {
-            data->entity_data(inner_data);
-            enqueue = true;
-        }
-    }
-    else if (RTPS_SENT_TOPIC == topic_name || RTPS_LOST_TOPIC == topic_name)
-    {
-        Entity2LocatorTraffic inner_data;
-        if (get_available_data(reader, inner_data, timestamp))
-        {
-            data->entity2locator_traffic(inner_data);
-            enqueue = true;
-        }
-    }
-    else if (RESENT_DATAS_TOPIC == topic_name || HEARTBEAT_COUNT_TOPIC == topic_name ||
-            ACKNACK_COUNT_TOPIC == topic_name || NACKFRAG_COUNT_TOPIC == topic_name || GAP_COUNT_TOPIC == topic_name ||
-            DATA_COUNT_TOPIC == topic_name || PDP_PACKETS_TOPIC == topic_name || EDP_PACKETS_TOPIC == topic_name)
-    {
-        EntityCount inner_data;
-        if (get_available_data(reader, inner_data, timestamp))
-        {
-            data->entity_count(inner_data);
-            enqueue = true;
-        }
+        case HISTORY2HISTORY_LATENCY:
+            take_available_data<WriterReaderData>(reader);
+            break;
+        case NETWORK_LATENCY:
+            take_available_data<Locator2LocatorData>(reader);
+            break;
+        case PUBLICATION_THROUGHPUT:
+        case SUBSCRIPTION_THROUGHPUT:
+            take_available_data<EntityData>(reader);
+            break;
+        case RTPS_SENT:
+        case RTPS_LOST:
+            take_available_data<Entity2LocatorTraffic>(reader);
+            break;
+        case RESENT_DATAS:
+        case HEARTBEAT_COUNT:
+        case ACKNACK_COUNT:
+        case NACKFRAG_COUNT:
+        case GAP_COUNT:
+        case DATA_COUNT:
+        case PDP_PACKETS:
+        case EDP_PACKETS:
+            take_available_data<EntityCount>(reader);
+            break;
+        case DISCOVERED_ENTITY:
+            take_available_data<DiscoveryTime>(reader);
+            break;
+        case SAMPLE_DATAS:
+            take_available_data<SampleIdentityCount>(reader);
+            break;
+        case PHYSICAL_DATA:
+            take_available_data<PhysicalData>(reader);
+            break;
+        default:
+            break;
     }
-    else if (DISCOVERY_TOPIC == topic_name)
-    {
-        DiscoveryTime inner_data;
-        if (get_available_data(reader, inner_data, timestamp))
-        {
-            data->discovery_time(inner_data);
-            enqueue = true;
-        }
-    }
-    else if (SAMPLE_DATAS_TOPIC == topic_name)
-    {
-        SampleIdentityCount inner_data;
-        if (get_available_data(reader, inner_data, timestamp))
-        {
-            data->sample_identity_count(inner_data);
-            enqueue = true;
-        }
-    }
-    else if (PHYSICAL_DATA_TOPIC == topic_name)
-    {
-        PhysicalData inner_data;
-        if (get_available_data(reader, inner_data, timestamp))
-        {
-            data->physical_data(inner_data);
-            enqueue = true;
-        }
-    }
-
-    if (!enqueue)
-    {
-        // Nothing to push to queue
-        return;
-    }
-
-    data->_d(topics.at(topic_name));
-    data_queue_->push(timestamp, data);
 }
 
 } //namespace database
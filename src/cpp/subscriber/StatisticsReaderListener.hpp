@@ -23,6 +23,10 @@
 #include "fastdds/dds/subscriber/DataReaderListener.hpp"
 #include "fastdds/dds/core/status/StatusMask.hpp"
 
+#include <cstdint>
+#include <string>
+
+#include <topic_types/types.h>
 #include <types/types.hpp>
 
 namespace eprosima {
@@ -30,7 +34,7 @@ namespace statistics_backend {
 
 namespace database {
 
-class DatabaseDataQueue;
+class ShardedDatabaseDataQueue;
 class DatabaseEntityQueue;
 
 } // namespace database
@@ -45,20 +49,33 @@ static const eprosima::fastdds::dds::StatusMask StatisticsDataMask =
 
 /**
  * @brief Listener of the internal backend subscribers that receive the statistics data updates.
+ *
+ * Each statistics reader has its own listener, which knows the kind of the data of the reader topic.
  */
 class StatisticsReaderListener : public eprosima::fastdds::dds::DataReaderListener
 {
 
 public:
 
+    //! Maximum number of samples taken from the reader at once
+    static constexpr int32_t MAX_SAMPLES_PER_TAKE = 64;
+
     /**
      * @brief Constructor
+     *
+     * @param data_queue The queue where the received data is pushed.
+     * @param topic_name The name of the statistics topic of the reader this listener is linked to.
+     * @throws eprosima::statistics_backend::BadParameter if \c topic_name is not a statistics topic.
      */
     StatisticsReaderListener(
-            database::DatabaseDataQueue* data_queue) noexcept;
+            database::ShardedDatabaseDataQueue* data_queue,
+            const std::string& topic_name);
 
     /**
      * @brief Actions to be performed when a new Data Message is received.
+     *
+     * All the data available in the reader is taken, in batches of at most \c MAX_SAMPLES_PER_TAKE samples.
+     *
      * @param reader DataReader that received the data
      */
     void on_data_available(
@@ -66,14 +83,21 @@ public:
 
 protected:
 
+    /**
+     * @brief Take all the data available in the reader and push it to the queue.
+     *
+     * @tparam T The type of the data of the reader topic.
+     * @param reader DataReader that received the data
+     */
     template<typename T>
-    bool get_available_data(
-            eprosima::fastdds::dds::DataReader* reader,
-            T& inner_data,
-            std::chrono::system_clock::time_point& timestamp);
+    void take_available_data(
+            eprosima::fastdds::dds::DataReader* reader);
 
     //! Reference to the database queues
-    database::DatabaseDataQueue* data_queue_;
+    database::ShardedDatabaseDataQueue* data_queue_;
+
+    //! Kind of the data of the reader topic, resolved on construction
+    eprosima::fastdds::statistics::EventKind event_kind_;
 
 };
 
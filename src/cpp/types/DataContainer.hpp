@@ -19,99 +19,433 @@
 #ifndef _EPROSIMA_FASTDDS_STATISTICS_BACKEND_TYPES_DATACONTAINER_HPP_
 #define _EPROSIMA_FASTDDS_STATISTICS_BACKEND_TYPES_DATACONTAINER_HPP_
 
-#include <list>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <fastdds_statistics_backend/exception/Exception.hpp>
 #include <fastdds_statistics_backend/types/utils.hpp>
 
 #include <database/samples.hpp>
+#include <detail/data_getters.hpp>
+#include <types/Rollup.hpp>
 
 namespace eprosima {
 namespace statistics_backend {
 namespace details {
 
 /**
- * Class that contains a list of elements (StatisticsSample) sorted by timestamp.
+ * Class that contains a series of elements (StatisticsSample) sorted by timestamp.
  *
- * This class helps to iterate efficiently over a sorted list of elements.
- * It also helps to efficiently remove elements in the front.
+ * The elements are stored in chunks of contiguous memory, and the timestamps of the elements of each chunk are
+ * stored apart in their own array, so the series can be searched by timestamp with a binary search that only touches
+ * the timestamps.
+ * The capacity of the chunks grows geometrically up to \c MAX_CHUNK_CAPACITY, so that short series do not waste
+ * memory, and elements are removed from the front by dropping whole chunks.
  *
- * @note list used instead of vector as \c clear method for front elements is much more efficient.
+ * Chunks never reallocate, so references and pointers to the elements remain valid until the elements are removed.
+ * Iterators are invalidated by any \c clear call.
  *
  * @attention the data must be inserted sorted. This class does not manage the sort of the data.
  *
- * @todo this functions could be implemented much more efficiency:
- *  - binary search
- *  - add find_from_back option to accelerate search
- *  - add a helper iterator to no start from the beginning
- * For now we want to reduce implementation time, so lineal search it is
+ * The container also records the epoch, given by its owner, in which its elements were inserted,
+ * see @ref inserted_after.
+ *
+ * Optionally, the container keeps a @ref RollupSeries with summaries of the values of its elements, which is
+ * updated as elements are added or removed. See @ref enable_rollups.
+ *
+ * @attention the timestamp of an element must not be modified once it has been inserted.
  */
 template <typename T>
-class DataContainer : public std::list<T>
+class DataContainer
 {
     // This class only could be used with T types derived from \c StatisticsSample
     static_assert(std::is_base_of<database::StatisticsSample, T>::value,
             "Type of DataContainer not derived from database::StatisticsSample");
 
+protected:
+
+    //! Block of contiguous elements with a fixed capacity
+    struct Chunk
+    {
+        Chunk(
+                std::size_t capacity,
+                std::size_t index)
+            : first_index(index)
+        {
+            timestamps.reserve(capacity);
+            samples.reserve(capacity);
+        }
+
+        //! Whether the chunk cannot hold more elements without reallocating
+        bool full() const noexcept
+        {
+            return samples.size() == samples.capacity();
+        }
+
+        //! Position of the first element of the chunk since the container was created or cleared
+        std::size_t first_index;
+
+        //! Timestamps of the elements in \c samples
+        std::vector<Timestamp> timestamps;
+
+        //! Elements of the chunk
+        std::vector<T> samples;
+    };
+
+    using ChunkList = std::deque<std::unique_ptr<Chunk>>;
+
+    //! Position of an element, as the index of its chunk and its offset inside the chunk
+    using Position = std::pair<std::size_t, std::size_t>;
+
+    //! Epoch in which elements were inserted, and the position since the container was created or cleared of the
+    //! first of them
+    using EpochMark = std::pair<uint64_t, std::size_t>;
+
+    /**
+     * Bidirectional iterator over the elements of the container.
+     *
+     * @tparam Const whether the iterator gives read-only access to the elements.
+     */
+    template <bool Const>
+    class Iterator
+    {
+        using ChunkListPtr = typename std::conditional<Const, const ChunkList*, ChunkList*>::type;
+
+    public:
+
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::conditional<Const, const T*, T*>::type;
+        using reference = typename std::conditional<Const, const T&, T&>::type;
+
+        Iterator() = default;
+
+        Iterator(
+                ChunkListPtr chunks,
+                std::size_t chunk,
+                std::size_t offset)
+            : chunks_(chunks)
+            , chunk_(chunk)
+            , offset_(offset)
+        {
+        }
+
+        //! Conversion from iterator to const_iterator
+        operator Iterator<true>() const
+        {
+            return Iterator<true>(chunks_, chunk_, offset_);
+        }
+
+        reference operator *() const
+        {
+            return (*chunks_)[chunk_]->samples[offset_];
+        }
+
+        pointer operator ->() const
+        {
+            return &(*chunks_)[chunk_]->samples[offset_];
+        }
+
+        Iterator& operator ++()
+        {
+            if (++offset_ == (*chunks_)[chunk_]->samples.size())
+            {
+                ++chunk_;
+                offset_ = 0;
+            }
+            return *this;
+        }
+
+        Iterator operator ++(
+                int)
+        {
+            Iterator it = *this;
+            ++(*this);
+            return it;
+        }
+
+        Iterator& operator --()
+        {
+            if (0 == offset_)
+            {
+                --chunk_;
+                offset_ = (*chunks_)[chunk_]->samples.size();
+            }
+            --offset_;
+            return *this;
+        }
+
+        Iterator operator --(
+                int)
+        {
+            Iterator it = *this;
+            --(*this);
+            return it;
+        }
+
+        bool operator ==(
+                const Iterator& other) const noexcept
+        {
+            return chunk_ == other.chunk_ && offset_ == other.offset_ && chunks_ == other.chunks_;
+        }
+
+        bool operator !=(
+                const Iterator& other) const noexcept
+        {
+            return !(*this == other);
+        }
+
+    protected:
+
+        //! Chunks of the container
+        ChunkListPtr chunks_ = nullptr;
+
+        //! Index of the chunk of the element. The past-the-end element is in the chunk after the last one.
+        std::size_t chunk_ = 0;
+
+        //! Position of the element inside its chunk. It is always lower than the size of the chunk.
+        std::size_t offset_ = 0;
+    };
+
 public:
 
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    //! Capacity of the first chunk of the container
+    static constexpr std::size_t MIN_CHUNK_CAPACITY = 8;
+
+    //! Maximum capacity of a chunk
+    static constexpr std::size_t MAX_CHUNK_CAPACITY = 1024;
+
+    DataContainer() = default;
+
+    DataContainer(
+            const DataContainer& other)
+    {
+        for (const auto& value : other)
+        {
+            push_back(value);
+        }
+
+        // The elements keep the epochs in which they were inserted in the other container
+        epoch_marks_.clear();
+        std::size_t other_front = other.front_index_();
+        for (const auto& mark : other.epoch_marks_)
+        {
+            epoch_marks_.emplace_back(mark.first, mark.second > other_front ? mark.second - other_front : 0);
+        }
+        if (other.rollups_)
+        {
+            rollups_.reset(new RollupSeries(*other.rollups_));
+        }
+    }
+
+    DataContainer(
+            DataContainer&& other) noexcept
+        : chunks_(std::move(other.chunks_))
+        , front_offset_(other.front_offset_)
+        , size_(other.size_)
+        , next_chunk_capacity_(other.next_chunk_capacity_)
+        , epoch_marks_(std::move(other.epoch_marks_))
+        , rollups_(std::move(other.rollups_))
+    {
+        other.clear();
+    }
+
+    DataContainer& operator =(
+            const DataContainer& other)
+    {
+        if (this != &other)
+        {
+            DataContainer copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    DataContainer& operator =(
+            DataContainer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            chunks_ = std::move(other.chunks_);
+            front_offset_ = other.front_offset_;
+            size_ = other.size_;
+            next_chunk_capacity_ = other.next_chunk_capacity_;
+            epoch_marks_ = std::move(other.epoch_marks_);
+            rollups_ = std::move(other.rollups_);
+            other.clear();
+        }
+        return *this;
+    }
+
+    //! Number of elements in the container
+    size_type size() const noexcept
+    {
+        return size_;
+    }
+
+    //! Whether the container has no elements
+    bool empty() const noexcept
+    {
+        return 0 == size_;
+    }
+
+    iterator begin() noexcept
+    {
+        return iterator(&chunks_, 0, front_offset_);
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return const_iterator(&chunks_, 0, front_offset_);
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    iterator end() noexcept
+    {
+        return iterator(&chunks_, chunks_.size(), 0);
+    }
+
+    const_iterator end() const noexcept
+    {
+        return const_iterator(&chunks_, chunks_.size(), 0);
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    //! First element of the container. The container must not be empty.
+    T& front()
+    {
+        return chunks_.front()->samples[front_offset_];
+    }
+
+    //! First element of the container. The container must not be empty.
+    const T& front() const
+    {
+        return chunks_.front()->samples[front_offset_];
+    }
+
+    //! Last element of the container. The container must not be empty.
+    T& back()
+    {
+        return chunks_.back()->samples.back();
+    }
+
+    //! Last element of the container. The container must not be empty.
+    const T& back() const
+    {
+        return chunks_.back()->samples.back();
+    }
+
+    /**
+     * @brief Add an element at the end of the container
+     *
+     * @param value element to add. Its timestamp must not be lower than the one of the last element.
+     * @param epoch epoch in which the element is inserted, see @ref inserted_after.
+     */
+    void push_back(
+            const T& value,
+            uint64_t epoch = 0)
+    {
+        Chunk& chunk = writable_chunk_();
+        mark_epoch_(chunk, epoch);
+        chunk.timestamps.push_back(value.src_ts);
+        chunk.samples.push_back(value);
+        ++size_;
+        if (rollups_)
+        {
+            rollups_->add(value.src_ts, detail::get_value(value));
+        }
+    }
+
+    /**
+     * @brief Add an element at the end of the container
+     *
+     * @param value element to add. Its timestamp must not be lower than the one of the last element.
+     * @param epoch epoch in which the element is inserted, see @ref inserted_after.
+     */
+    void push_back(
+            T&& value,
+            uint64_t epoch = 0)
+    {
+        Chunk& chunk = writable_chunk_();
+        mark_epoch_(chunk, epoch);
+        chunk.timestamps.push_back(value.src_ts);
+        chunk.samples.push_back(std::move(value));
+        ++size_;
+        if (rollups_)
+        {
+            const T& added = chunk.samples.back();
+            rollups_->add(added.src_ts, detail::get_value(added));
+        }
+    }
+
     /**
-     * @brief Access operator to the list
+     * @brief Access operator to the container
      *
      * @param index index of the element to look for
      * @return reference to the element
      *
-     * @throws \c out_of_range if index higher than list size.
-     *
-     * @note thanks to chat gpt
+     * @throws \c out_of_range if index higher than container size.
      */
     T& operator [](
             std::size_t index)
     {
-        // Check if the index is valid
-        if (index >= this->size())
-        {
-            throw std::out_of_range("Index out of range in DataContainer list.");
-        }
-
-        // Traverse the list to the desired index
-        auto it = this->begin();
-        std::advance(it, index);
-
-        // Return a reference to the element at the index
-        return *it;
+        auto position = locate_(index);
+        return chunks_[position.first]->samples[position.second];
     }
 
     /**
-     * @brief const access operator to the list
+     * @brief const access operator to the container
      *
      * @param index index of the element to look for
      * @return const reference to the element
      *
-     * @throws \c out_of_range if index higher than list size.
-     *
-     * @note thanks to chat gpt
+     * @throws \c out_of_range if index higher than container size.
      */
     const T& operator [](
             std::size_t index) const
     {
-        // Check if the index is valid
-        if (index >= this->size())
+        auto position = locate_(index);
+        return chunks_[position.first]->samples[position.second];
+    }
+
+    //! Remove every element of the container
+    void clear()
+    {
+        chunks_.clear();
+        front_offset_ = 0;
+        size_ = 0;
+        next_chunk_capacity_ = MIN_CHUNK_CAPACITY;
+        epoch_marks_.clear();
+        if (rollups_)
         {
-            throw std::out_of_range("Index out of range in DataContainer list.");
+            rollups_->clear();
         }
-
-        // Traverse the list to the desired index
-        auto it = this->begin();
-        std::advance(it, index);
-
-        // Return a reference to the element at the index
-        return *it;
     }
 
-    //! Use map clear function if no arguments given
-    using std::list<T>::clear;
-
     /**
      * @brief Clear internal data that are previous to the time given.
      *
@@ -127,13 +461,149 @@ public:
         if (t_to == the_end_of_time())
         {
             this->clear();
+            return;
         }
-        else
+
+        auto limit = find_position_(t_to);
+        if (limit.first == chunks_.size())
         {
-            this->erase(this->begin(), find_by_timestamp_(t_to));
+            // Every element is previous to the time given, but keep growing the chunks as for a long series
+            chunks_.clear();
+            front_offset_ = 0;
+            size_ = 0;
+            epoch_marks_.clear();
+            if (rollups_)
+            {
+                rollups_->clear();
+            }
+            return;
+        }
+
+        // Drop the chunks whose elements are all previous to the limit, and skip the previous ones in the first
+        // remaining chunk
+        for (std::size_t i = 0; i < limit.first; ++i)
+        {
+            size_ -= chunks_.front()->samples.size() - front_offset_;
+            front_offset_ = 0;
+            chunks_.pop_front();
+        }
+        size_ -= limit.second - front_offset_;
+        front_offset_ = limit.second;
+        prune_epoch_marks_();
+
+        if (rollups_)
+        {
+            clear_rollups_(t_to);
         }
     }
 
+    /**
+     * @brief Remove the oldest elements, so that the container keeps at most the given number of elements.
+     *
+     * @param max_size Maximum number of elements that will be kept.
+     */
+    void trim(
+            size_type max_size)
+    {
+        if (size_ <= max_size)
+        {
+            return;
+        }
+        if (0 == max_size)
+        {
+            chunks_.clear();
+            front_offset_ = 0;
+            size_ = 0;
+            epoch_marks_.clear();
+            if (rollups_)
+            {
+                rollups_->clear();
+            }
+            return;
+        }
+
+        auto limit = locate_(size_ - max_size);
+        for (std::size_t i = 0; i < limit.first; ++i)
+        {
+            chunks_.pop_front();
+        }
+        front_offset_ = limit.second;
+        size_ = max_size;
+        prune_epoch_marks_();
+
+        if (rollups_)
+        {
+            // Elements with the same timestamp as the new first one may have been removed, so the whole bucket of
+            // the first element is rebuilt from the elements that are kept
+            const Timestamp& first = front().src_ts;
+            for (auto& tier : rollups_->tiers())
+            {
+                Timestamp bucket_end = tier.bucket_start(first) + tier.resolution();
+                tier.clear(bucket_end);
+                for_each_block(first, bucket_end - Timestamp::duration(1), [&tier](
+                            const T* block,
+                            std::size_t size)
+                        {
+                            for (const T* last = block + size; block != last; ++block)
+                            {
+                                tier.add(block->src_ts, detail::get_value(*block));
+                            }
+                        });
+            }
+        }
+    }
+
+    /**
+     * @brief Approximate amount of memory used by the elements of the container, in bytes.
+     *
+     * It accounts for the whole capacity of the chunks, including the space of removed elements at the front of
+     * the first chunk, and for the summaries of the values, if enabled.
+     */
+    std::size_t memory_usage() const noexcept
+    {
+        std::size_t usage = sizeof(DataContainer);
+        for (const auto& chunk : chunks_)
+        {
+            usage += sizeof(Chunk) + chunk->samples.capacity() * (sizeof(T) + sizeof(Timestamp));
+        }
+        usage += epoch_marks_.capacity() * sizeof(EpochMark);
+        if (rollups_)
+        {
+            usage += rollups_->memory_usage();
+        }
+        return usage;
+    }
+
+    /**
+     * @brief Keep summaries of the values of the elements at the given resolutions.
+     *
+     * The summaries are built from the elements already in the container, and then kept up to date as elements
+     * are added and removed.
+     *
+     * @param resolutions Durations of the buckets of each tier of summaries. An empty collection disables them.
+     */
+    void enable_rollups(
+            const std::vector<Timestamp::duration>& resolutions)
+    {
+        if (resolutions.empty())
+        {
+            rollups_.reset();
+            return;
+        }
+
+        rollups_.reset(new RollupSeries(resolutions));
+        for (const auto& value : *this)
+        {
+            rollups_->add(value.src_ts, detail::get_value(value));
+        }
+    }
+
+    //! Summaries of the values of the elements, or nullptr if they are not enabled
+    const RollupSeries* rollups() const noexcept
+    {
+        return rollups_.get();
+    }
+
     /**
      * @brief Get the interval limits iterators pointing to the internal data that are between the time limits given.
      *
@@ -141,13 +611,105 @@ public:
      * @param t_to Minimum time NOT included in the interval
      * @return Pair with first data inside the limit first, and second the first data higher to the limit.
      */
-    std::pair<typename std::list<T>::iterator, typename std::list<T>::iterator> get_interval_limits(
+    std::pair<iterator, iterator> get_interval_limits(
             const Timestamp& t_from,
             const Timestamp& t_to)
     {
         return {find_by_timestamp_(t_from), find_by_timestamp_(t_to)};
     }
 
+    /**
+     * @brief Get the interval limits iterators pointing to the internal data that are between the time limits given.
+     *
+     * @param t_from Minimum time included in the interval
+     * @param t_to Minimum time NOT included in the interval
+     * @return Pair with first data inside the limit first, and second the first data higher to the limit.
+     */
+    std::pair<const_iterator, const_iterator> get_interval_limits(
+            const Timestamp& t_from,
+            const Timestamp& t_to) const
+    {
+        return {find_by_timestamp_(t_from), find_by_timestamp_(t_to)};
+    }
+
+    /**
+     * @brief Get the iterators pointing to the internal data that are between the time limits given, both included.
+     *
+     * @param t_from Minimum time included in the interval
+     * @param t_to Maximum time included in the interval
+     * @return Pair with first data inside the limit first, and second the first data higher than \c t_to.
+     */
+    std::pair<const_iterator, const_iterator> get_closed_interval_limits(
+            const Timestamp& t_from,
+            const Timestamp& t_to) const
+    {
+        auto limits = closed_interval_positions_(t_from, t_to);
+        return {
+            const_iterator(&chunks_, limits.first.first, limits.first.second),
+            const_iterator(&chunks_, limits.second.first, limits.second.second)};
+    }
+
+    /**
+     * @brief Get the first element inserted after the given epoch.
+     *
+     * The elements are inserted at the end, so every element after it was inserted after the epoch too,
+     * even if its timestamp is older than those of elements of other containers inserted before.
+     *
+     * @param epoch Last epoch whose elements are skipped.
+     * @return Iterator to the first element inserted in a later epoch, or the end if there is no such element.
+     */
+    const_iterator inserted_after(
+            uint64_t epoch) const
+    {
+        auto mark = std::partition_point(
+            epoch_marks_.begin(),
+            epoch_marks_.end(),
+            [epoch](const EpochMark& epoch_mark)
+            {
+                return epoch_mark.first <= epoch;
+            });
+
+        if (mark == epoch_marks_.end())
+        {
+            return end();
+        }
+
+        std::size_t front_index = front_index_();
+        if (mark->second <= front_index)
+        {
+            return begin();
+        }
+        auto position = locate_(mark->second - front_index);
+        return const_iterator(&chunks_, position.first, position.second);
+    }
+
+    /**
+     * @brief Call a function for each block of contiguous internal data between the time limits given, both included.
+     *
+     * The blocks are visited in order, and each of them is inside a single chunk, so the function is called at most
+     * once per chunk.
+     *
+     * @param t_from Minimum time included in the interval
+     * @param t_to Maximum time included in the interval
+     * @param function Callable as \c function(const T* first, std::size_t size) with each block.
+     */
+    template <typename Function>
+    void for_each_block(
+            const Timestamp& t_from,
+            const Timestamp& t_to,
+            Function function) const
+    {
+        auto limits = closed_interval_positions_(t_from, t_to);
+        auto position = limits.first;
+        while (position < limits.second)
+        {
+            const auto& samples = chunks_[position.first]->samples;
+            std::size_t end = position.first == limits.second.first ? limits.second.second : samples.size();
+            function(samples.data() + position.second, end - position.second);
+            position = {position.first + 1, 0};
+        }
+    }
+
 protected:
 
     /**
@@ -156,21 +718,268 @@ protected:
      * @param value_to_find timestamp to find
      * @return Iterator to the first data with timestamp equal or higher than \c value_to_find
      */
-    typename std::list<T>::iterator find_by_timestamp_(
+    iterator find_by_timestamp_(
             const Timestamp& value_to_find)
     {
-        return std::find_if(
-            this->begin(),
-            this->end(),
-            [&value_to_find](const T& value)
+        auto position = find_position_(value_to_find);
+        return iterator(&chunks_, position.first, position.second);
+    }
+
+    /**
+     * @brief Find the first internal data that is equal or higher than the time given.
+     *
+     * @param value_to_find timestamp to find
+     * @return Iterator to the first data with timestamp equal or higher than \c value_to_find
+     */
+    const_iterator find_by_timestamp_(
+            const Timestamp& value_to_find) const
+    {
+        auto position = find_position_(value_to_find);
+        return const_iterator(&chunks_, position.first, position.second);
+    }
+
+    /**
+     * @brief Binary search of the first element that is equal or higher than the time given.
+     *
+     * @param value_to_find timestamp to find
+     * @return Pair with the index of the chunk and the position inside the chunk of the element found,
+     *         or the position of the end of the container if there is no such element.
+     */
+    Position find_position_(
+            const Timestamp& value_to_find) const
+    {
+        return partition_position_(
+            [&value_to_find](const Timestamp& timestamp)
+            {
+                return timestamp < value_to_find;
+            });
+    }
+
+    /**
+     * @brief Binary search of the limits of the elements between two times, both included.
+     *
+     * @param t_from Minimum time included in the interval
+     * @param t_to Maximum time included in the interval
+     * @return Pair with the positions of the first element inside the interval and of the first element after it,
+     *         as given by \c find_position_.
+     */
+    std::pair<Position, Position> closed_interval_positions_(
+            const Timestamp& t_from,
+            const Timestamp& t_to) const
+    {
+        auto first = find_position_(t_from);
+        auto last = partition_position_(
+            [&t_to](const Timestamp& timestamp)
             {
-                return value.src_ts >= value_to_find;
+                return timestamp <= t_to;
+            });
+
+        // An empty interval, i.e. t_to lower than t_from, must not give a last element before the first one
+        if (last < first)
+        {
+            last = first;
+        }
+        return {first, last};
+    }
+
+    /**
+     * @brief Binary search of the first element that does not satisfy a predicate on its timestamp.
+     *
+     * @param predicate Function that returns true for the timestamps of the elements that are before the one to
+     *                  find. As the data is sorted, it must return true for a prefix of the elements.
+     * @return Pair with the index of the chunk and the position inside the chunk of the element found,
+     *         or the position of the end of the container if there is no such element.
+     */
+    template <typename Predicate>
+    Position partition_position_(
+            Predicate predicate) const
+    {
+        // First chunk whose last element does not satisfy the predicate
+        auto chunk_it = std::partition_point(
+            chunks_.begin(),
+            chunks_.end(),
+            [&predicate](const std::unique_ptr<Chunk>& chunk)
+            {
+                return predicate(chunk->timestamps.back());
+            });
+
+        if (chunk_it == chunks_.end())
+        {
+            return {chunks_.size(), 0};
+        }
+
+        const auto& timestamps = (*chunk_it)->timestamps;
+        auto first = timestamps.begin();
+        if (chunk_it == chunks_.begin())
+        {
+            first += front_offset_;
+        }
+
+        auto timestamp_it = std::partition_point(first, timestamps.end(), predicate);
+        return {
+            static_cast<std::size_t>(chunk_it - chunks_.begin()),
+            static_cast<std::size_t>(timestamp_it - timestamps.begin())};
+    }
+
+    /**
+     * @brief Get the position of the element with a given index.
+     *
+     * @param index index of the element to look for
+     * @return Pair with the index of the chunk and the position inside the chunk of the element.
+     *
+     * @throws \c out_of_range if index higher than container size.
+     */
+    Position locate_(
+            std::size_t index) const
+    {
+        // Check if the index is valid
+        if (index >= size_)
+        {
+            throw std::out_of_range("Index out of range in DataContainer.");
+        }
+
+        // Binary search of the last chunk starting at or before the element
+        std::size_t target = chunks_.front()->first_index + front_offset_ + index;
+        auto chunk_it = std::partition_point(
+            chunks_.begin(),
+            chunks_.end(),
+            [target](const std::unique_ptr<Chunk>& chunk)
+            {
+                return chunk->first_index <= target;
+            });
+        --chunk_it;
+
+        return {
+            static_cast<std::size_t>(chunk_it - chunks_.begin()),
+            target - (*chunk_it)->first_index};
+    }
+
+    //! Remove from the summaries the elements previous to the time given, which have already been removed
+    void clear_rollups_(
+            const Timestamp& t_to)
+    {
+        for (auto& tier : rollups_->tiers())
+        {
+            // The bucket that contained t_to is rebuilt from the elements that are kept
+            Timestamp rebuild_to = tier.clear(t_to);
+            if (rebuild_to > t_to)
+            {
+                for_each_block(t_to, rebuild_to - Timestamp::duration(1), [&tier](
+                            const T* first,
+                            std::size_t size)
+                        {
+                            for (const T* last = first + size; first != last; ++first)
+                            {
+                                tier.add(first->src_ts, detail::get_value(*first));
+                            }
+                        });
+            }
+        }
+    }
+
+    //! Position of the first element since the container was created or cleared
+    std::size_t front_index_() const noexcept
+    {
+        return chunks_.empty() ? 0 : chunks_.front()->first_index + front_offset_;
+    }
+
+    //! Record the epoch of the element about to be added at the end of the given chunk.
+    //! An element given an epoch older than the last one belongs to the last one, so it is not skipped with it
+    void mark_epoch_(
+            const Chunk& chunk,
+            uint64_t epoch)
+    {
+        if (epoch_marks_.empty() || epoch_marks_.back().first < epoch)
+        {
+            epoch_marks_.emplace_back(epoch, chunk.first_index + chunk.samples.size());
+        }
+    }
+
+    //! Remove the marks of the epochs whose elements have all been removed
+    void prune_epoch_marks_()
+    {
+        // The last mark at or before the first element is kept, as that element was inserted in its epoch
+        std::size_t front_index = front_index_();
+        auto mark = std::partition_point(
+            epoch_marks_.begin(),
+            epoch_marks_.end(),
+            [front_index](const EpochMark& epoch_mark)
+            {
+                return epoch_mark.second <= front_index;
+            });
+        if (mark != epoch_marks_.begin())
+        {
+            epoch_marks_.erase(epoch_marks_.begin(), mark - 1);
+        }
+    }
+
+    //! Get the chunk where the next element must be added, creating it if needed
+    Chunk& writable_chunk_()
+    {
+        if (chunks_.empty() || chunks_.back()->full())
+        {
+            std::size_t first_index = chunks_.empty() ? 0 :
+                    chunks_.back()->first_index + chunks_.back()->samples.size();
+            chunks_.emplace_back(new Chunk(next_chunk_capacity_, first_index));
+            if (next_chunk_capacity_ < MAX_CHUNK_CAPACITY)
+            {
+                next_chunk_capacity_ *= 2;
             }
-            );
+        }
+        return *chunks_.back();
     }
 
+    //! Chunks of elements, sorted by timestamp
+    ChunkList chunks_;
+
+    //! Number of elements at the front of the first chunk that have been removed
+    std::size_t front_offset_ = 0;
+
+    //! Number of elements in the container
+    size_type size_ = 0;
+
+    //! Capacity of the next chunk to create
+    std::size_t next_chunk_capacity_ = MIN_CHUNK_CAPACITY;
+
+    //! Marks of the epochs in which the elements were inserted, sorted by epoch
+    std::vector<EpochMark> epoch_marks_;
+
+    //! Summaries of the values of the elements, if enabled
+    std::unique_ptr<RollupSeries> rollups_;
 };
 
+template <typename T>
+constexpr std::size_t DataContainer<T>::MIN_CHUNK_CAPACITY;
+
+template <typename T>
+constexpr std::size_t DataContainer<T>::MAX_CHUNK_CAPACITY;
+
+/**
+ * @brief Check whether two DataContainer have the same elements in the same order
+ * @param lhs The left-side of the operation
+ * @param rhs The right-side of the operation
+ */
+template <typename T>
+bool operator ==(
+        const DataContainer<T>& lhs,
+        const DataContainer<T>& rhs)
+{
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+/**
+ * @brief Check whether two DataContainer differ in any of their elements
+ * @param lhs The left-side of the operation
+ * @param rhs The right-side of the operation
+ */
+template <typename T>
+bool operator !=(
+        const DataContainer<T>& lhs,
+        const DataContainer<T>& rhs)
+{
+    return !(lhs == rhs);
+}
+
 } // namespace details
 } // namespace statistics_backend
 } // namespace eprosima
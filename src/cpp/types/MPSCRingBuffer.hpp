@@ -0,0 +1,441 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file MPSCRingBuffer.hpp
+ */
+
+#ifndef _EPROSIMA_FASTDDS_STATISTICS_BACKEND_TYPES_MPSCRINGBUFFER_HPP_
+#define _EPROSIMA_FASTDDS_STATISTICS_BACKEND_TYPES_MPSCRINGBUFFER_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace eprosima {
+namespace statistics_backend {
+namespace details {
+
+/**
+ * What a producer does when it pushes into a full @ref MPSCRingBuffer.
+ */
+enum class OverflowPolicy
+{
+    /// Wait until the consumer makes room for the new element. The producer is blocked for as long as the consumer
+    /// does not keep up, so it must not be used when the producers cannot wait
+    BLOCK,
+
+    /// Discard the oldest element in the buffer to make room for the new one
+    DROP_OLDEST,
+
+    /// Discard the new element
+    DROP_NEWEST
+};
+
+/**
+ * Bounded, lock-free ring buffer for several producer threads and a single consumer thread.
+ *
+ * Each slot of the buffer has a sequence number that tells whether it is free or holds an element for a given
+ * position, so producers only contend on the atomic increment of the tail position, and never with the consumer
+ * (see D. Vyukov, "Bounded MPMC queue"). Only producers blocked by a full buffer use a mutex.
+ *
+ * The number of elements discarded by the overflow policy is counted.
+ *
+ * @tparam T Type of the elements. It must be move constructible, but it does not need to be default constructible.
+ */
+template <typename T>
+class MPSCRingBuffer
+{
+public:
+
+    /**
+     * @brief Construct an empty buffer.
+     *
+     * @param capacity Minimum number of elements the buffer can hold. It is rounded up to a power of two.
+     * @param policy What a producer does when the buffer is full.
+     */
+    explicit MPSCRingBuffer(
+            std::size_t capacity,
+            OverflowPolicy policy = OverflowPolicy::BLOCK)
+        : capacity_(round_up_capacity_(capacity))
+        , mask_(capacity_ - 1)
+        , policy_(policy)
+        , cells_(new Cell[capacity_])
+    {
+        for (std::size_t i = 0; i < capacity_; ++i)
+        {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MPSCRingBuffer(
+            const MPSCRingBuffer&) = delete;
+
+    MPSCRingBuffer& operator =(
+            const MPSCRingBuffer&) = delete;
+
+    ~MPSCRingBuffer()
+    {
+        while (try_pop_(Discard()))
+        {
+        }
+    }
+
+    /**
+     * @brief Add an element at the end of the buffer, applying the overflow policy if it is full.
+     *
+     * @param item Element to add.
+     * @return false if the element was discarded, true otherwise.
+     */
+    template <typename U>
+    bool push(
+            U&& item)
+    {
+        return push(std::forward<U>(item), Discard());
+    }
+
+    /**
+     * @brief Add an element at the end of the buffer, applying the overflow policy if it is full.
+     *
+     * @param item Element to add.
+     * @param on_drop Callable as \c on_drop(T&& item) with each element removed by
+     *        @ref OverflowPolicy::DROP_OLDEST to make room for \c item, which it may keep.
+     * @return false if the element was discarded, true otherwise.
+     */
+    template <typename U, typename DropFunction>
+    bool push(
+            U&& item,
+            DropFunction&& on_drop)
+    {
+        for (unsigned int attempt = 0; !try_push_(std::forward<U>(item)); ++attempt)
+        {
+            switch (policy_)
+            {
+                case OverflowPolicy::DROP_NEWEST:
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+
+                case OverflowPolicy::DROP_OLDEST:
+                    if (try_pop_(on_drop))
+                    {
+                        dropped_.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    else
+                    {
+                        // The oldest element is still being written by another producer
+                        backoff_(attempt);
+                    }
+                    break;
+
+                case OverflowPolicy::BLOCK:
+                default:
+                    if (!wait_for_room_())
+                    {
+                        // There is room, but the slot is still being released by the consumer
+                        backoff_(attempt);
+                    }
+                    break;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Remove elements from the front of the buffer, passing each of them to a function.
+     *
+     * Only the consumer thread may call this method.
+     *
+     * @param function Callable as \c function(T&& item) with each element removed.
+     * @param max_items Maximum number of elements to remove.
+     * @return The number of elements removed.
+     */
+    template <typename Function>
+    std::size_t consume(
+            Function&& function,
+            std::size_t max_items)
+    {
+        std::size_t consumed = 0;
+        while (consumed < max_items && try_pop_(function))
+        {
+            ++consumed;
+        }
+
+        // Pairs with the fence in wait_for_room_: either the blocked producer sees the removals,
+        // or the consumer sees it blocked
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (consumed > 0 && blocked_producers_.load() > 0)
+        {
+            std::lock_guard<std::mutex> guard(room_mutex_);
+            room_cv_.notify_all();
+        }
+        return consumed;
+    }
+
+    /**
+     * @brief Number of elements in the buffer.
+     *
+     * It is only exact if no thread is pushing or consuming at the same time.
+     */
+    std::size_t size() const noexcept
+    {
+        std::size_t head = dequeue_pos_.load(std::memory_order_acquire);
+        std::size_t tail = enqueue_pos_.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    //! Whether the buffer has no elements. Same considerations as @ref size apply.
+    bool empty() const noexcept
+    {
+        return 0 == size();
+    }
+
+    //! Maximum number of elements the buffer can hold
+    std::size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    //! What a producer does when the buffer is full
+    OverflowPolicy policy() const noexcept
+    {
+        return policy_;
+    }
+
+    //! Number of elements discarded by the overflow policy since the buffer was created
+    uint64_t dropped() const noexcept
+    {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+protected:
+
+    //! Slot of the buffer
+    struct Cell
+    {
+        /**
+         * Position for which the slot is ready: if it equals the position, a producer can write on it;
+         * if it equals the position plus one, the consumer can read it.
+         */
+        std::atomic<std::size_t> sequence;
+
+        //! Storage for an element, only constructed while the slot holds one
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+    //! Size of a cache line, used to keep the positions of producers and consumer apart
+    static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+    static std::size_t round_up_capacity_(
+            std::size_t capacity)
+    {
+        std::size_t rounded = 2;
+        while (rounded < capacity)
+        {
+            rounded <<= 1;
+        }
+        return rounded;
+    }
+
+    //! Add an element if there is room for it. The element is not moved from if there is not.
+    template <typename U>
+    bool try_push_(
+            U&& item)
+    {
+        Cell* cell;
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            cell = &cells_[pos & mask_];
+            std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+            if (0 == difference)
+            {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (difference < 0)
+            {
+                // The slot still holds the element of the previous lap: the buffer is full
+                return false;
+            }
+            else
+            {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        new (&cell->storage) T(std::forward<U>(item));
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    //! Function that discards the elements it receives
+    struct Discard
+    {
+        void operator ()(
+                T&&) const noexcept
+        {
+        }
+
+    };
+
+    /**
+     * @brief Remove the first element, if any.
+     *
+     * @param function Callable that receives the element.
+     * @return Whether an element was removed.
+     */
+    template <typename Function>
+    bool try_pop_(
+            Function&& function)
+    {
+        Cell* cell;
+        std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            cell = &cells_[pos & mask_];
+            std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t difference =
+                    static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (0 == difference)
+            {
+                // Producers dropping the oldest elements also remove them, so the position must be claimed
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        // The slot is released before the element is passed on, so the buffer keeps working if the function throws
+        T* element = reinterpret_cast<T*>(&cell->storage);
+        T item(std::move(*element));
+        element->~T();
+        cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        function(std::move(item));
+        return true;
+    }
+
+    /**
+     * @brief Wait until the consumer removes any element from a full buffer.
+     *
+     * @return Whether the buffer was full, so the producer had to wait.
+     */
+    bool wait_for_room_()
+    {
+        if (size() < capacity_)
+        {
+            return false;
+        }
+
+        // Registering as blocked before checking the buffer guarantees that the consumer notifies any removal
+        // that this producer does not see
+        blocked_producers_.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        {
+            std::unique_lock<std::mutex> guard(room_mutex_);
+            room_cv_.wait(guard, [this]()
+                    {
+                        return size() < capacity_;
+                    });
+        }
+        blocked_producers_.fetch_sub(1);
+        return true;
+    }
+
+    /**
+     * @brief Wait for another thread to finish with the slot that a producer needs.
+     *
+     * The other thread is in the middle of copying an element, so the first attempts retry right away,
+     * and the following ones yield the processor to let it finish.
+     *
+     * @param attempt Number of previous attempts.
+     */
+    static void backoff_(
+            unsigned int attempt)
+    {
+        if (attempt >= SPIN_ATTEMPTS)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    //! Number of attempts to get a slot before yielding the processor
+    static constexpr unsigned int SPIN_ATTEMPTS = 16;
+
+    //! Number of slots
+    const std::size_t capacity_;
+
+    //! Mask to get the slot of a position
+    const std::size_t mask_;
+
+    //! What a producer does when the buffer is full
+    const OverflowPolicy policy_;
+
+    //! Slots of the buffer
+    std::unique_ptr<Cell[]> cells_;
+
+    char padding_0_[CACHE_LINE_SIZE];
+
+    //! Position where the next element is added
+    std::atomic<std::size_t> enqueue_pos_{0};
+
+    char padding_1_[CACHE_LINE_SIZE];
+
+    //! Position of the first element
+    std::atomic<std::size_t> dequeue_pos_{0};
+
+    char padding_2_[CACHE_LINE_SIZE];
+
+    //! Number of elements discarded by the overflow policy
+    std::atomic<uint64_t> dropped_{0};
+
+    //! Number of producers waiting for room in the buffer
+    std::atomic<std::size_t> blocked_producers_{0};
+
+    //! Protects the waits of blocked producers
+    std::mutex room_mutex_;
+
+    //! Notifies blocked producers of removals
+    std::condition_variable room_cv_;
+};
+
+template <typename T>
+constexpr std::size_t MPSCRingBuffer<T>::CACHE_LINE_SIZE;
+
+template <typename T>
+constexpr unsigned int MPSCRingBuffer<T>::SPIN_ATTEMPTS;
+
+} // namespace details
+} // namespace statistics_backend
+} // namespace eprosima
+
+#endif //_EPROSIMA_FASTDDS_STATISTICS_BACKEND_TYPES_MPSCRINGBUFFER_HPP_
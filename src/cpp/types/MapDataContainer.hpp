@@ -19,7 +19,9 @@
 #ifndef _EPROSIMA_FASTDDS_STATISTICS_BACKEND_TYPES_MAPDATACONTAINER_HPP_
 #define _EPROSIMA_FASTDDS_STATISTICS_BACKEND_TYPES_MAPDATACONTAINER_HPP_
 
-#include <list>
+#include <cstddef>
+#include <map>
+#include <vector>
 
 #include <fastdds_statistics_backend/exception/Exception.hpp>
 
@@ -51,6 +53,44 @@ public:
     //! Use map clear function if no arguments given
     using std::map<K, DataContainer<T>>::clear;
 
+    /**
+     * @brief Access the container of a key, creating it if it does not exist.
+     *
+     * Containers created this way keep summaries at the resolutions given to @ref enable_rollups.
+     *
+     * @param key Key of the container.
+     * @return Reference to the container.
+     */
+    DataContainer<T>& operator [](
+            const K& key)
+    {
+        auto it = this->lower_bound(key);
+        if (it == this->end() || this->key_comp()(key, it->first))
+        {
+            it = this->emplace_hint(it, key, DataContainer<T>());
+            if (!rollup_resolutions_.empty())
+            {
+                it->second.enable_rollups(rollup_resolutions_);
+            }
+        }
+        return it->second;
+    }
+
+    /**
+     * @brief Keep summaries of the values of every internal container, current and future, at the given resolutions.
+     *
+     * @param resolutions Durations of the buckets of each tier of summaries. An empty collection disables them.
+     */
+    void enable_rollups(
+            const std::vector<Timestamp::duration>& resolutions)
+    {
+        rollup_resolutions_ = resolutions;
+        for (auto& container : *this)
+        {
+            container.second.enable_rollups(resolutions);
+        }
+    }
+
     /**
      * @brief Clear internal data that are previous to the time given.
      *
@@ -68,7 +108,7 @@ public:
         else
         {
             // Remove internal data and in same loop
-            // Remove those internals lists that become empty
+            // Remove those internal containers that become empty
             // NOTE: unable to use remove_if
             auto end = this->end();
             for (auto iter = this->begin(); iter != end;)
@@ -86,6 +126,46 @@ public:
         }
     }
 
+    /**
+     * @brief Remove the oldest elements of every internal container, so that each of them keeps at most the given
+     * number of elements.
+     *
+     * Internal containers that become empty are removed.
+     *
+     * @param max_size Maximum number of elements that will be kept in each internal container.
+     */
+    void trim(
+            std::size_t max_size)
+    {
+        for (auto iter = this->begin(); iter != this->end();)
+        {
+            iter->second.trim(max_size);
+            if (iter->second.empty())
+            {
+                iter = this->erase(iter);
+            }
+            else
+            {
+                ++iter;
+            }
+        }
+    }
+
+    //! Approximate amount of memory used by the elements of every internal container, in bytes
+    std::size_t memory_usage() const noexcept
+    {
+        std::size_t usage = sizeof(MapDataContainer);
+        for (const auto& container : *this)
+        {
+            usage += sizeof(K) + container.second.memory_usage();
+        }
+        return usage;
+    }
+
+private:
+
+    //! Resolutions of the summaries of the internal containers
+    std::vector<Timestamp::duration> rollup_resolutions_;
 };
 
 } // namespace details
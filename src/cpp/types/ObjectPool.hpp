@@ -0,0 +1,162 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ObjectPool.hpp
+ */
+
+#ifndef _EPROSIMA_FASTDDS_STATISTICS_BACKEND_TYPES_OBJECTPOOL_HPP_
+#define _EPROSIMA_FASTDDS_STATISTICS_BACKEND_TYPES_OBJECTPOOL_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace eprosima {
+namespace statistics_backend {
+namespace details {
+
+/**
+ * Pool of objects that are recycled instead of being destroyed, so that their memory is reused.
+ *
+ * The objects are handed out as shared pointers by @ref acquire. Once its user is done with an object, it gives it
+ * back with @ref release, and the pool keeps it for a later @ref acquire, unless the object is still shared or the
+ * pool is full. Neither operation calls the allocator once the pool holds enough objects.
+ *
+ * Recycled objects keep their previous value. Their users overwrite it, which reuses the memory of their strings
+ * and sequences too.
+ *
+ * @tparam T Type of the objects. It must be default constructible.
+ */
+template <typename T>
+class ObjectPool
+{
+public:
+
+    /**
+     * @brief Construct an empty pool.
+     *
+     * @param capacity Maximum number of objects kept for recycling. Objects released beyond it are destroyed.
+     */
+    explicit ObjectPool(
+            std::size_t capacity)
+        : capacity_(capacity)
+    {
+        free_.reserve(capacity_);
+    }
+
+    ObjectPool(
+            const ObjectPool&) = delete;
+
+    ObjectPool& operator =(
+            const ObjectPool&) = delete;
+
+    /**
+     * @brief Get an object, recycled if there is any available, or newly created otherwise.
+     *
+     * @return The object, not shared with anyone else.
+     */
+    std::shared_ptr<T> acquire()
+    {
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            if (!free_.empty())
+            {
+                std::shared_ptr<T> object = std::move(free_.back());
+                free_.pop_back();
+                recycled_.fetch_add(1, std::memory_order_relaxed);
+                return object;
+            }
+        }
+
+        created_.fetch_add(1, std::memory_order_relaxed);
+        return std::make_shared<T>();
+    }
+
+    /**
+     * @brief Give back an object, so that it can be recycled.
+     *
+     * The object is only kept if nobody else shares it, and the pool is not full.
+     * In any case, \c object is empty afterwards.
+     *
+     * @param object The object to give back. It may have not been acquired from this pool.
+     */
+    void release(
+            std::shared_ptr<T>&& object)
+    {
+        // Nobody else can get a new reference to an object that is only referenced here
+        if (object && 1 == object.use_count())
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            if (free_.size() < capacity_)
+            {
+                free_.push_back(std::move(object));
+                return;
+            }
+        }
+        object.reset();
+    }
+
+    //! Maximum number of objects kept for recycling
+    std::size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    //! Number of objects available for recycling
+    std::size_t size() const
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return free_.size();
+    }
+
+    //! Number of objects created by @ref acquire, as there was none to recycle
+    uint64_t created() const noexcept
+    {
+        return created_.load(std::memory_order_relaxed);
+    }
+
+    //! Number of objects recycled by @ref acquire
+    uint64_t recycled() const noexcept
+    {
+        return recycled_.load(std::memory_order_relaxed);
+    }
+
+private:
+
+    //! Maximum number of objects in free_
+    const std::size_t capacity_;
+
+    //! Objects available for recycling. Its capacity is reserved on construction
+    std::vector<std::shared_ptr<T>> free_;
+
+    //! Protects free_
+    mutable std::mutex mutex_;
+
+    //! Number of objects created by acquire
+    std::atomic<uint64_t> created_{0};
+
+    //! Number of objects recycled by acquire
+    std::atomic<uint64_t> recycled_{0};
+};
+
+} // namespace details
+} // namespace statistics_backend
+} // namespace eprosima
+
+#endif // _EPROSIMA_FASTDDS_STATISTICS_BACKEND_TYPES_OBJECTPOOL_HPP_
@@ -0,0 +1,442 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file Rollup.hpp
+ */
+
+#ifndef _EPROSIMA_FASTDDS_STATISTICS_BACKEND_TYPES_ROLLUP_HPP_
+#define _EPROSIMA_FASTDDS_STATISTICS_BACKEND_TYPES_ROLLUP_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <vector>
+
+#include <fastdds_statistics_backend/types/types.hpp>
+
+namespace eprosima {
+namespace statistics_backend {
+namespace details {
+
+/**
+ * Summary of a sequence of values, from which the count, sum, mean, minimum, maximum and standard deviation
+ * of the sequence can be computed.
+ *
+ * NaN values are handled as done by the aggregators of @ref StatisticsBackend::get_data, so both give the same
+ * results: NaN values are counted, and each of them restarts the sum, minimum and maximum, which are NaN if the
+ * last value is NaN. Any NaN value makes the standard deviation NaN.
+ */
+struct RollupSummary
+{
+    //! Add a value at the end of the sequence
+    void add(
+            double value) noexcept
+    {
+        ++count;
+        sum_sq += value * value;
+        nan_last = std::isnan(value);
+        if (nan_last)
+        {
+            restart_();
+            return;
+        }
+
+        sum += value;
+        min = (std::min)(min, value);
+        max = (std::max)(max, value);
+    }
+
+    //! Add the values of another sequence at the end of this one
+    void merge(
+            const RollupSummary& other) noexcept
+    {
+        if (other.empty())
+        {
+            return;
+        }
+
+        count += other.count;
+        if (std::isnan(other.sum_sq))
+        {
+            // The other sequence has a NaN value, which restarted its sum, minimum and maximum
+            sum = other.sum;
+            min = other.min;
+            max = other.max;
+        }
+        else
+        {
+            sum += other.sum;
+            min = (std::min)(min, other.min);
+            max = (std::max)(max, other.max);
+        }
+        sum_sq += other.sum_sq;
+        nan_last = other.nan_last;
+    }
+
+    //! Whether the sequence has no values
+    bool empty() const noexcept
+    {
+        return 0 == count;
+    }
+
+    //! Number of values in the sequence, including the NaN values
+    uint64_t count = 0;
+
+    //! Summation of the values after the last NaN value
+    double sum = 0.0;
+
+    //! Summation of the squares of the values in the sequence. NaN if any value is NaN
+    double sum_sq = 0.0;
+
+    //! Minimum value after the last NaN value
+    double min = std::numeric_limits<double>::infinity();
+
+    //! Maximum value after the last NaN value
+    double max = -std::numeric_limits<double>::infinity();
+
+    //! Whether the last value of the sequence is NaN
+    bool nan_last = false;
+
+protected:
+
+    //! Forget the values added so far for the sum, minimum and maximum
+    void restart_() noexcept
+    {
+        sum = 0.0;
+        min = std::numeric_limits<double>::infinity();
+        max = -std::numeric_limits<double>::infinity();
+    }
+};
+
+/**
+ * Summaries of a series of values in consecutive buckets of a fixed duration.
+ *
+ * Buckets are aligned to multiples of their duration since the epoch, so the buckets of every series of a tier
+ * share the same limits. Only the buckets that received any value are kept.
+ */
+class RollupTier
+{
+public:
+
+    //! Values received during a bucket
+    struct Bucket
+    {
+        //! Starting time of the bucket
+        Timestamp start;
+
+        //! Summary of the values of the bucket
+        RollupSummary summary;
+    };
+
+    /**
+     * @brief Construct an empty tier.
+     *
+     * @param resolution Duration of the buckets. Must be positive.
+     */
+    explicit RollupTier(
+            Timestamp::duration resolution)
+        : resolution_(resolution)
+    {
+    }
+
+    //! Duration of the buckets
+    Timestamp::duration resolution() const noexcept
+    {
+        return resolution_;
+    }
+
+    //! Buckets of the tier, sorted by time
+    const std::deque<Bucket>& buckets() const noexcept
+    {
+        return buckets_;
+    }
+
+    //! Starting time of the bucket that contains a given time
+    Timestamp bucket_start(
+            const Timestamp& ts) const noexcept
+    {
+        auto remainder = ts.time_since_epoch() % resolution_;
+        if (remainder < Timestamp::duration::zero())
+        {
+            remainder += resolution_;
+        }
+        return ts - remainder;
+    }
+
+    /**
+     * @brief Add a value to the bucket that contains its timestamp.
+     *
+     * Values are expected to arrive sorted by time, which only touches the last bucket.
+     */
+    void add(
+            const Timestamp& ts,
+            double value)
+    {
+        Timestamp start = bucket_start(ts);
+        if (buckets_.empty() || buckets_.back().start < start)
+        {
+            buckets_.push_back({start, RollupSummary()});
+            buckets_.back().summary.add(value);
+            return;
+        }
+
+        auto it = lower_bound_(start);
+        if (it == buckets_.end() || it->start != start)
+        {
+            it = buckets_.insert(it, {start, RollupSummary()});
+        }
+        it->summary.add(value);
+    }
+
+    /**
+     * @brief Merge the summaries of the buckets that start in a time interval.
+     *
+     * @param t_from Minimum starting time of the merged buckets.
+     * @param t_to Starting time of the first bucket NOT merged.
+     * @param summary Summary where the buckets are merged.
+     */
+    void summarize(
+            const Timestamp& t_from,
+            const Timestamp& t_to,
+            RollupSummary& summary) const
+    {
+        for (auto it = lower_bound_(t_from); it != buckets_.end() && it->start < t_to; ++it)
+        {
+            summary.merge(it->summary);
+        }
+    }
+
+    //! Remove every bucket
+    void clear() noexcept
+    {
+        buckets_.clear();
+    }
+
+    /**
+     * @brief Remove the buckets that start before the time given.
+     *
+     * The bucket that contains \c t_to is removed too, as it holds values previous to \c t_to that cannot be
+     * subtracted from its summary.
+     *
+     * @param t_to Minimum time that will be kept.
+     * @return The ending time of the removed bucket that contained \c t_to, whose values since \c t_to must be
+     *         added again. \c t_to if there was no such bucket.
+     */
+    Timestamp clear(
+            const Timestamp& t_to)
+    {
+        Timestamp rebuild_to = t_to;
+        while (!buckets_.empty() && buckets_.front().start < t_to)
+        {
+            rebuild_to = (std::max)(rebuild_to, buckets_.front().start + resolution_);
+            buckets_.pop_front();
+        }
+        return rebuild_to;
+    }
+
+private:
+
+    //! First bucket that does not start before the time given
+    std::deque<Bucket>::const_iterator lower_bound_(
+            const Timestamp& start) const
+    {
+        return std::lower_bound(buckets_.begin(), buckets_.end(), start, [](
+                    const Bucket& bucket,
+                    const Timestamp& ts)
+                {
+                    return bucket.start < ts;
+                });
+    }
+
+    //! First bucket that does not start before the time given
+    std::deque<Bucket>::iterator lower_bound_(
+            const Timestamp& start)
+    {
+        return std::lower_bound(buckets_.begin(), buckets_.end(), start, [](
+                    const Bucket& bucket,
+                    const Timestamp& ts)
+                {
+                    return bucket.start < ts;
+                });
+    }
+
+    //! Duration of the buckets
+    Timestamp::duration resolution_;
+
+    //! Buckets that received any value, sorted by time
+    std::deque<Bucket> buckets_;
+};
+
+/**
+ * Pre-aggregated summaries of a series of values at several resolutions (tiers), updated as values are added.
+ *
+ * Statistics over wide time intervals can be computed from the buckets of the coarsest suitable tier,
+ * instead of from every value.
+ */
+class RollupSeries
+{
+public:
+
+    /**
+     * @brief Construct a series with a tier for each of the given resolutions.
+     *
+     * @param resolutions Durations of the buckets of each tier. Non-positive and repeated durations are ignored.
+     */
+    explicit RollupSeries(
+            std::vector<Timestamp::duration> resolutions)
+    {
+        std::sort(resolutions.begin(), resolutions.end());
+        resolutions.erase(std::unique(resolutions.begin(), resolutions.end()), resolutions.end());
+        for (const auto& resolution : resolutions)
+        {
+            if (resolution > Timestamp::duration::zero())
+            {
+                tiers_.emplace_back(resolution);
+            }
+        }
+    }
+
+    //! Tiers of the series, from the finest to the coarsest
+    std::vector<RollupTier>& tiers() noexcept
+    {
+        return tiers_;
+    }
+
+    //! Tiers of the series, from the finest to the coarsest
+    const std::vector<RollupTier>& tiers() const noexcept
+    {
+        return tiers_;
+    }
+
+    //! Add a value to every tier
+    void add(
+            const Timestamp& ts,
+            double value)
+    {
+        for (auto& tier : tiers_)
+        {
+            tier.add(ts, value);
+        }
+    }
+
+    //! Remove every bucket of every tier
+    void clear() noexcept
+    {
+        for (auto& tier : tiers_)
+        {
+            tier.clear();
+        }
+    }
+
+    //! Approximate amount of memory used by the buckets of every tier, in bytes
+    std::size_t memory_usage() const noexcept
+    {
+        std::size_t usage = sizeof(RollupSeries);
+        for (const auto& tier : tiers_)
+        {
+            usage += sizeof(RollupTier) + tier.buckets().size() * sizeof(RollupTier::Bucket);
+        }
+        return usage;
+    }
+
+    /**
+     * @brief Get the coarsest tier whose buckets fit a whole number of times in a bin.
+     *
+     * @param bin_duration Duration of the bins to compute.
+     * @return The tier, or nullptr if no tier is suitable.
+     */
+    const RollupTier* tier_for(
+            Timestamp::duration bin_duration) const noexcept
+    {
+        for (auto it = tiers_.rbegin(); it != tiers_.rend(); ++it)
+        {
+            if (bin_duration % it->resolution() == Timestamp::duration::zero())
+            {
+                return &(*it);
+            }
+        }
+        return nullptr;
+    }
+
+private:
+
+    //! Tiers of the series, sorted by resolution
+    std::vector<RollupTier> tiers_;
+};
+
+/**
+ * Summaries of the values of one or several series in each of the bins in which a time interval is divided.
+ *
+ * The bins are the same as the ones of @ref StatisticsBackend::get_data: all of them have the same duration, except
+ * the last one, which also takes the remainder of the interval.
+ */
+struct RollupBins
+{
+    /**
+     * @brief Construct the empty summaries of the bins of a time interval.
+     *
+     * @param bins Number of bins in which the interval is divided. Must be positive.
+     * @param t_from Starting time of the interval.
+     * @param t_to Ending time of the interval, not included.
+     */
+    RollupBins(
+            uint16_t bins,
+            Timestamp t_from,
+            Timestamp t_to)
+        : t_from(t_from)
+        , t_to(t_to)
+        , interval((t_to - t_from) / bins)
+        , summaries(bins)
+    {
+    }
+
+    //! Starting time of a bin
+    Timestamp bin_start(
+            std::size_t index) const noexcept
+    {
+        return t_from + interval * static_cast<Timestamp::rep>(index);
+    }
+
+    //! Ending time of a bin, not included
+    Timestamp bin_end(
+            std::size_t index) const noexcept
+    {
+        return index + 1 == summaries.size() ? t_to : bin_start(index + 1);
+    }
+
+    //! Starting time of the interval
+    Timestamp t_from;
+
+    //! Ending time of the interval, not included
+    Timestamp t_to;
+
+    //! Duration of each bin
+    Timestamp::duration interval;
+
+    //! Summary of each bin
+    std::vector<RollupSummary> summaries;
+
+    //! Whether every series could be summarized from its rollups
+    bool complete = true;
+};
+
+} // namespace details
+} // namespace statistics_backend
+} // namespace eprosima
+
+#endif //_EPROSIMA_FASTDDS_STATISTICS_BACKEND_TYPES_ROLLUP_HPP_
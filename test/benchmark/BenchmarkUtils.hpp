@@ -0,0 +1,183 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file BenchmarkUtils.hpp
+ */
+
+#ifndef _EPROSIMA_FASTDDS_STATISTICS_BACKEND_TEST_BENCHMARK_BENCHMARKUTILS_HPP_
+#define _EPROSIMA_FASTDDS_STATISTICS_BACKEND_TEST_BENCHMARK_BENCHMARKUTILS_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <fastdds_statistics_backend/nlohmann-json/json.hpp>
+
+namespace eprosima {
+namespace statistics_backend {
+namespace benchmark {
+
+using Json = nlohmann::json;
+using BenchmarkClock = std::chrono::steady_clock;
+
+/**
+ * @brief Options common to every benchmark executable.
+ *
+ * They are parsed from the command line arguments:
+ *   * \c --output \c <file> writes the JSON report into \c file instead of the standard output.
+ *   * \c --quick reduces the size of the scenarios so the benchmark can be used as a smoke test.
+ */
+struct BenchmarkOptions
+{
+    //! File where the report is written. Empty means standard output
+    std::string output;
+
+    //! Whether to run the reduced version of the scenarios
+    bool quick = false;
+};
+
+/**
+ * @brief Parse the command line arguments common to every benchmark.
+ *
+ * Unknown arguments are ignored so each benchmark can add its own ones.
+ */
+inline BenchmarkOptions parse_options(
+        int argc,
+        char** argv)
+{
+    BenchmarkOptions options;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg(argv[i]);
+        if (arg == "--output" && i + 1 < argc)
+        {
+            options.output = argv[++i];
+        }
+        else if (arg == "--quick")
+        {
+            options.quick = true;
+        }
+    }
+    return options;
+}
+
+/**
+ * @brief Elapsed time between two time points, in nanoseconds.
+ */
+inline double elapsed_ns(
+        const BenchmarkClock::time_point& start,
+        const BenchmarkClock::time_point& end)
+{
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+/**
+ * @brief Get the value at percentile \c p (in the range [0, 100]) of a collection of measures.
+ *
+ * @param values The measures. They are sorted in place.
+ * @return The value at the percentile, or 0 if there are no measures.
+ */
+inline double percentile(
+        std::vector<double>& values,
+        double p)
+{
+    if (values.empty())
+    {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    size_t index = static_cast<size_t>((p / 100.0) * static_cast<double>(values.size() - 1) + 0.5);
+    return values[std::min(index, values.size() - 1)];
+}
+
+/**
+ * @brief Prevent the compiler from optimizing away a value computed inside a benchmark loop.
+ */
+template<typename T>
+inline void do_not_optimize(
+        const T& value)
+{
+    static volatile const void* sink;
+    sink = &value;
+    (void)sink;
+}
+
+/**
+ * @brief Resident set size of the benchmark process, in kilobytes.
+ *
+ * It is read from \c /proc/self/status, so it is only available on Linux.
+ *
+ * @param peak Whether to get the highest resident set size so far, instead of the current one.
+ * @return The resident set size, or 0 if it is not available.
+ */
+inline uint64_t resident_set_kb(
+        bool peak = false)
+{
+    const std::string field = peak ? "VmHWM:" : "VmRSS:";
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (0 == line.compare(0, field.size(), field))
+        {
+            return std::strtoull(line.c_str() + field.size(), nullptr, 10);
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Write the JSON report of a benchmark.
+ *
+ * @param benchmark Name of the benchmark.
+ * @param results Array with one object per measured scenario.
+ * @param options Options of the benchmark run.
+ * @return EXIT_SUCCESS if the report could be written, EXIT_FAILURE otherwise.
+ */
+inline int write_report(
+        const std::string& benchmark,
+        const Json& results,
+        const BenchmarkOptions& options)
+{
+    Json report;
+    report["benchmark"] = benchmark;
+    report["results"] = results;
+
+    if (options.output.empty())
+    {
+        std::cout << report.dump(4) << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    std::ofstream file(options.output);
+    if (!file.good())
+    {
+        std::cerr << "Cannot open output file " << options.output << std::endl;
+        return EXIT_FAILURE;
+    }
+    file << report.dump(4) << std::endl;
+    return EXIT_SUCCESS;
+}
+
+} // namespace benchmark
+} // namespace statistics_backend
+} // namespace eprosima
+
+#endif // _EPROSIMA_FASTDDS_STATISTICS_BACKEND_TEST_BENCHMARK_BENCHMARKUTILS_HPP_
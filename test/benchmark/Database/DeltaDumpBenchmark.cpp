@@ -0,0 +1,222 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file DeltaDumpBenchmark.cpp
+ *
+ * Compare the bytes written and the time taken by periodic checkpoints of a growing database,
+ * when each checkpoint is a whole JSON dump and when it is an incremental dump of the previous one.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include <database/database.hpp>
+#include <database/entities.hpp>
+#include <database/samples.hpp>
+
+#include <BenchmarkUtils.hpp>
+
+using namespace eprosima::statistics_backend;
+using namespace eprosima::statistics_backend::database;
+using namespace eprosima::statistics_backend::benchmark;
+
+namespace {
+
+//! DataWriters created in each participant
+constexpr size_t WRITERS_PER_PARTICIPANT = 8;
+
+//! Stream buffer that only counts the characters written to it, so the output does not take memory
+class CountingBuffer : public std::streambuf
+{
+public:
+
+    uint64_t count = 0;
+
+protected:
+
+    int_type overflow(
+            int_type c) override
+    {
+        ++count;
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(
+            const char*,
+            std::streamsize n) override
+    {
+        count += static_cast<uint64_t>(n);
+        return n;
+    }
+
+};
+
+std::string make_guid(
+        size_t prefix,
+        size_t entity)
+{
+    char guid[64];
+    std::snprintf(guid, sizeof(guid), "01.0f.%02zx.%02zx.%02zx.%02zx.00.00.00.00.00.00|0.%zx.%zx.%zx",
+            (prefix >> 24) & 0xff, (prefix >> 16) & 0xff, (prefix >> 8) & 0xff, prefix & 0xff,
+            (entity >> 16) & 0xff, (entity >> 8) & 0xff, entity & 0xff);
+    return guid;
+}
+
+/**
+ * @brief Fill the database with \c writer_count datawriters, without statistics data.
+ *
+ * @return The datawriters created.
+ */
+std::vector<std::shared_ptr<DataWriter>> populate(
+        Database& db,
+        const std::shared_ptr<Domain>& domain,
+        size_t writer_count)
+{
+    db.insert(domain);
+    auto topic = std::make_shared<Topic>("topic", "type", domain);
+    db.insert(topic);
+    auto locator = std::make_shared<Locator>("UDPv4:[127.0.0.1]:7400");
+    locator->id = db.insert(locator);
+
+    std::vector<std::shared_ptr<DataWriter>> writers;
+    std::shared_ptr<DomainParticipant> participant;
+
+    for (size_t i = 0; i < writer_count; ++i)
+    {
+        if (0 == i % WRITERS_PER_PARTICIPANT)
+        {
+            participant = std::make_shared<DomainParticipant>(
+                "participant_" + std::to_string(i), "qos", make_guid(i, 0x1c1), nullptr, domain);
+            db.insert(participant);
+        }
+
+        auto writer = std::make_shared<DataWriter>(
+            "writer_" + std::to_string(i), "qos", make_guid(i, 0x103), participant, topic);
+        writer->locators[locator->id] = locator;
+        db.insert(writer);
+        writers.push_back(writer);
+    }
+    return writers;
+}
+
+/**
+ * @brief Insert the samples \c first to \c first + \c samples of throughput and heartbeats in every datawriter.
+ *
+ * The source timestamp of the sample \c i is \c timestamp plus \c i milliseconds.
+ */
+void insert_samples(
+        Database& db,
+        const std::shared_ptr<Domain>& domain,
+        const std::vector<std::shared_ptr<DataWriter>>& writers,
+        size_t first,
+        size_t samples,
+        const Timestamp& timestamp)
+{
+    for (const auto& writer : writers)
+    {
+        for (size_t s = first; s < first + samples; ++s)
+        {
+            PublicationThroughputSample throughput;
+            throughput.src_ts = timestamp + std::chrono::milliseconds(s);
+            throughput.data = static_cast<double>(s) * 1.5;
+            db.insert(domain->id, writer->id, throughput);
+
+            HeartbeatCountSample heartbeats;
+            heartbeats.src_ts = timestamp + std::chrono::milliseconds(s);
+            heartbeats.count = s;
+            db.insert(domain->id, writer->id, heartbeats);
+        }
+    }
+}
+
+} // namespace
+
+int main(
+        int argc,
+        char** argv)
+{
+    BenchmarkOptions options = parse_options(argc, argv);
+
+    std::vector<size_t> writer_counts = {1000, 5000};
+    size_t checkpoints = 20;
+    size_t samples = 10;
+    if (options.quick)
+    {
+        writer_counts = {100};
+        checkpoints = 5;
+        samples = 2;
+    }
+
+    Json results = Json::array();
+
+    for (size_t writer_count : writer_counts)
+    {
+        Database db;
+        auto domain = std::make_shared<Domain>("0");
+        auto writers = populate(db, domain, writer_count);
+        auto timestamp = std::chrono::system_clock::now();
+
+        uint64_t full_bytes = 0;
+        uint64_t delta_bytes = 0;
+        double full_ms = 0;
+        double delta_ms = 0;
+        DumpWatermark watermark;
+
+        for (size_t c = 0; c < checkpoints; ++c)
+        {
+            insert_samples(db, domain, writers, c * samples, samples, timestamp);
+
+            // A whole dump in each checkpoint
+            {
+                CountingBuffer buffer;
+                std::ostream stream(&buffer);
+                auto start = BenchmarkClock::now();
+                db.dump_database(stream);
+                auto end = BenchmarkClock::now();
+                full_bytes += buffer.count;
+                full_ms += elapsed_ns(start, end) * 1e-6;
+            }
+
+            // An incremental dump of the previous checkpoint
+            {
+                CountingBuffer buffer;
+                std::ostream stream(&buffer);
+                auto start = BenchmarkClock::now();
+                watermark = db.dump_database_delta(stream, watermark);
+                auto end = BenchmarkClock::now();
+                delta_bytes += buffer.count;
+                delta_ms += elapsed_ns(start, end) * 1e-6;
+            }
+        }
+
+        Json result;
+        result["writers"] = writer_count;
+        result["checkpoints"] = checkpoints;
+        result["samples_per_checkpoint"] = samples;
+        result["full_total_bytes"] = full_bytes;
+        result["delta_total_bytes"] = delta_bytes;
+        result["full_total_ms"] = full_ms;
+        result["delta_total_ms"] = delta_ms;
+        results.push_back(result);
+    }
+
+    return write_report("delta_dump", results, options);
+}
@@ -0,0 +1,194 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file DumpBenchmark.cpp
+ *
+ * Measure the time and the memory taken to write the JSON dump of the database to a stream,
+ * when the whole DatabaseDump is built first and when the dump is streamed as the database is visited.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include <database/database.hpp>
+#include <database/entities.hpp>
+#include <database/samples.hpp>
+
+#include <BenchmarkUtils.hpp>
+
+using namespace eprosima::statistics_backend;
+using namespace eprosima::statistics_backend::database;
+using namespace eprosima::statistics_backend::benchmark;
+
+namespace {
+
+//! DataWriters created in each participant
+constexpr size_t WRITERS_PER_PARTICIPANT = 8;
+
+//! Stream buffer that only counts the characters written to it, so the output does not take memory
+class CountingBuffer : public std::streambuf
+{
+public:
+
+    uint64_t count = 0;
+
+protected:
+
+    int_type overflow(
+            int_type c) override
+    {
+        ++count;
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(
+            const char*,
+            std::streamsize n) override
+    {
+        count += static_cast<uint64_t>(n);
+        return n;
+    }
+
+};
+
+std::string make_guid(
+        size_t prefix,
+        size_t entity)
+{
+    char guid[64];
+    std::snprintf(guid, sizeof(guid), "01.0f.%02zx.%02zx.%02zx.%02zx.00.00.00.00.00.00|0.%zx.%zx.%zx",
+            (prefix >> 24) & 0xff, (prefix >> 16) & 0xff, (prefix >> 8) & 0xff, prefix & 0xff,
+            (entity >> 16) & 0xff, (entity >> 8) & 0xff, entity & 0xff);
+    return guid;
+}
+
+/**
+ * @brief Fill the database with \c writer_count datawriters, each of them with \c samples samples
+ * of throughput and heartbeats.
+ */
+void populate(
+        Database& db,
+        size_t writer_count,
+        size_t samples)
+{
+    auto domain = std::make_shared<Domain>("0");
+    db.insert(domain);
+    auto topic = std::make_shared<Topic>("topic", "type", domain);
+    db.insert(topic);
+    auto locator = std::make_shared<Locator>("UDPv4:[127.0.0.1]:7400");
+    locator->id = db.insert(locator);
+
+    std::shared_ptr<DomainParticipant> participant;
+    auto timestamp = std::chrono::system_clock::now();
+
+    for (size_t i = 0; i < writer_count; ++i)
+    {
+        if (0 == i % WRITERS_PER_PARTICIPANT)
+        {
+            participant = std::make_shared<DomainParticipant>(
+                "participant_" + std::to_string(i), "qos", make_guid(i, 0x1c1), nullptr, domain);
+            db.insert(participant);
+        }
+
+        auto writer = std::make_shared<DataWriter>(
+            "writer_" + std::to_string(i), "qos", make_guid(i, 0x103), participant, topic);
+        writer->locators[locator->id] = locator;
+        db.insert(writer);
+
+        for (size_t s = 0; s < samples; ++s)
+        {
+            PublicationThroughputSample throughput;
+            throughput.src_ts = timestamp + std::chrono::milliseconds(s);
+            throughput.data = static_cast<double>(s) * 1.5;
+            db.insert(domain->id, writer->id, throughput);
+
+            HeartbeatCountSample heartbeats;
+            heartbeats.src_ts = timestamp + std::chrono::milliseconds(s);
+            heartbeats.count = s;
+            db.insert(domain->id, writer->id, heartbeats);
+        }
+    }
+}
+
+//! Reset the highest resident set size of the process to the current one. Only available on Linux.
+void reset_peak_resident_set()
+{
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    clear_refs << "5";
+}
+
+} // namespace
+
+int main(
+        int argc,
+        char** argv)
+{
+    BenchmarkOptions options = parse_options(argc, argv);
+
+    std::vector<size_t> writer_counts = {1000, 5000, 20000};
+    size_t samples = 100;
+    if (options.quick)
+    {
+        writer_counts = {100};
+        samples = 10;
+    }
+
+    Json results = Json::array();
+
+    for (size_t writer_count : writer_counts)
+    {
+        Database db;
+        populate(db, writer_count, samples);
+
+        for (bool streamed : {true, false})
+        {
+            CountingBuffer buffer;
+            std::ostream stream(&buffer);
+
+            reset_peak_resident_set();
+            uint64_t rss_before = resident_set_kb();
+            auto start = BenchmarkClock::now();
+            if (streamed)
+            {
+                db.dump_database(stream);
+            }
+            else
+            {
+                stream << db.dump_database();
+            }
+            auto end = BenchmarkClock::now();
+            uint64_t rss_peak = resident_set_kb(true);
+
+            Json result;
+            result["writers"] = writer_count;
+            result["samples_per_series"] = samples;
+            result["mode"] = streamed ? "stream" : "tree";
+            result["dump_bytes"] = buffer.count;
+            result["dump_ms"] = elapsed_ns(start, end) * 1e-6;
+            result["rss_before_kb"] = rss_before;
+            result["rss_growth_kb"] = rss_peak > rss_before ? rss_peak - rss_before : 0;
+            results.push_back(result);
+        }
+    }
+
+    return write_report("dump", results, options);
+}
@@ -0,0 +1,157 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file EntityLookupBenchmark.cpp
+ *
+ * Measure the latency of Database::get_entity as the number of entities in the database grows.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <database/database.hpp>
+#include <database/entities.hpp>
+
+#include <BenchmarkUtils.hpp>
+
+using namespace eprosima::statistics_backend;
+using namespace eprosima::statistics_backend::database;
+using namespace eprosima::statistics_backend::benchmark;
+
+namespace {
+
+std::string make_guid(
+        size_t prefix,
+        size_t entity)
+{
+    char guid[64];
+    std::snprintf(guid, sizeof(guid), "01.0f.%02zx.%02zx.%02zx.%02zx.00.00.00.00.00.00|0.%zx.%zx.%zx",
+            (prefix >> 24) & 0xff, (prefix >> 16) & 0xff, (prefix >> 8) & 0xff, prefix & 0xff,
+            (entity >> 16) & 0xff, (entity >> 8) & 0xff, entity & 0xff);
+    return guid;
+}
+
+/**
+ * @brief Fill the database with \c entity_count entities.
+ *
+ * Most of them are participants, datawriters and datareaders, as those are the collections that grow
+ * in a real deployment.
+ *
+ * @return The IDs of every entity inserted.
+ */
+std::vector<EntityId> populate(
+        Database& db,
+        size_t entity_count)
+{
+    std::vector<EntityId> ids;
+    ids.reserve(entity_count);
+
+    auto host = std::make_shared<Host>("host");
+    ids.push_back(db.insert(host));
+    auto user = std::make_shared<User>("user", host);
+    ids.push_back(db.insert(user));
+    auto process = std::make_shared<Process>("process", "1234", user);
+    ids.push_back(db.insert(process));
+    auto domain = std::make_shared<Domain>("0");
+    ids.push_back(db.insert(domain));
+    auto topic = std::make_shared<Topic>("topic", "type", domain);
+    ids.push_back(db.insert(topic));
+    auto locator = std::make_shared<Locator>("UDPv4:[127.0.0.1]:7400");
+    locator->id = db.insert(locator);
+    ids.push_back(locator->id);
+
+    for (size_t i = 0; ids.size() < entity_count; ++i)
+    {
+        auto participant = std::make_shared<DomainParticipant>(
+            "participant_" + std::to_string(i), "qos", make_guid(i, 0x1c1), nullptr, domain);
+        ids.push_back(db.insert(participant));
+
+        auto writer = std::make_shared<DataWriter>(
+            "writer_" + std::to_string(i), "qos", make_guid(i, 0x103), participant, topic);
+        writer->locators[locator->id] = locator;
+        ids.push_back(db.insert(writer));
+
+        auto reader = std::make_shared<DataReader>(
+            "reader_" + std::to_string(i), "qos", make_guid(i, 0x104), participant, topic);
+        reader->locators[locator->id] = locator;
+        ids.push_back(db.insert(reader));
+    }
+
+    return ids;
+}
+
+} // namespace
+
+int main(
+        int argc,
+        char** argv)
+{
+    BenchmarkOptions options = parse_options(argc, argv);
+
+    std::vector<size_t> entity_counts = {1000, 5000, 10000, 20000, 40000};
+    size_t lookups = 1000000;
+    if (options.quick)
+    {
+        entity_counts = {100, 1000};
+        lookups = 10000;
+    }
+
+    Json results = Json::array();
+    std::mt19937_64 generator(42);
+
+    for (size_t entity_count : entity_counts)
+    {
+        Database db;
+        std::vector<EntityId> ids = populate(db, entity_count);
+
+        // Look the entities up in a random order, so the cost does not depend on the insertion order
+        std::vector<EntityId> order(lookups);
+        std::uniform_int_distribution<size_t> distribution(0, ids.size() - 1);
+        for (auto& id : order)
+        {
+            id = ids[distribution(generator)];
+        }
+
+        auto start = BenchmarkClock::now();
+        for (const auto& id : order)
+        {
+            do_not_optimize(db.get_entity(id));
+        }
+        auto end = BenchmarkClock::now();
+
+        // The last inserted entity used to be the worst case of the lookup
+        const EntityId last_id = ids.back();
+        size_t last_lookups = std::max<size_t>(lookups / 10, 1);
+        auto last_start = BenchmarkClock::now();
+        for (size_t i = 0; i < last_lookups; ++i)
+        {
+            do_not_optimize(db.get_entity(last_id));
+        }
+        auto last_end = BenchmarkClock::now();
+
+        Json result;
+        result["entities"] = ids.size();
+        result["lookups"] = lookups;
+        result["mean_ns_per_lookup"] = elapsed_ns(start, end) / static_cast<double>(lookups);
+        result["last_entity_ns_per_lookup"] = elapsed_ns(last_start, last_end) / static_cast<double>(last_lookups);
+        results.push_back(result);
+    }
+
+    return write_report("entity_lookup", results, options);
+}
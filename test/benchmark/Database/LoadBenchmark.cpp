@@ -0,0 +1,162 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file LoadBenchmark.cpp
+ *
+ * Measure the time and memory taken by Database::load_database as the number of endpoints in the dump grows.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <database/database.hpp>
+#include <database/entities.hpp>
+#include <database/samples.hpp>
+
+#include <BenchmarkUtils.hpp>
+
+using namespace eprosima::statistics_backend;
+using namespace eprosima::statistics_backend::database;
+using namespace eprosima::statistics_backend::benchmark;
+
+namespace {
+
+//! Participants sharing a host, a user and a locator
+constexpr size_t PARTICIPANTS_PER_HOST = 16;
+
+std::string make_guid(
+        size_t prefix,
+        size_t entity)
+{
+    char guid[64];
+    std::snprintf(guid, sizeof(guid), "01.0f.%02zx.%02zx.%02zx.%02zx.00.00.00.00.00.00|0.%zx.%zx.%zx",
+            (prefix >> 24) & 0xff, (prefix >> 16) & 0xff, (prefix >> 8) & 0xff, prefix & 0xff,
+            (entity >> 16) & 0xff, (entity >> 8) & 0xff, entity & 0xff);
+    return guid;
+}
+
+/**
+ * @brief Fill the database with one datawriter and one datareader per participant, until there are
+ * \c endpoint_count endpoints, each of them with \c samples throughput samples.
+ */
+void populate(
+        Database& db,
+        size_t endpoint_count,
+        size_t samples)
+{
+    auto domain = std::make_shared<Domain>("0");
+    db.insert(domain);
+    auto topic = std::make_shared<Topic>("topic", "type", domain);
+    db.insert(topic);
+
+    std::shared_ptr<Host> host;
+    std::shared_ptr<User> user;
+    std::shared_ptr<Locator> locator;
+    auto timestamp = std::chrono::system_clock::now();
+
+    for (size_t i = 0; 2 * i < endpoint_count; ++i)
+    {
+        if (0 == i % PARTICIPANTS_PER_HOST)
+        {
+            host = std::make_shared<Host>("host_" + std::to_string(i));
+            db.insert(host);
+            user = std::make_shared<User>("user", host);
+            db.insert(user);
+            locator = std::make_shared<Locator>("UDPv4:[10.0.0." + std::to_string(i / PARTICIPANTS_PER_HOST) +
+                            "]:7400");
+            locator->id = db.insert(locator);
+        }
+
+        auto process = std::make_shared<Process>("process_" + std::to_string(i), std::to_string(i), user);
+        db.insert(process);
+        auto participant = std::make_shared<DomainParticipant>(
+            "participant_" + std::to_string(i), "qos", make_guid(i, 0x1c1), nullptr, domain);
+        db.insert(participant);
+        db.link_participant_with_process(participant->id, process->id);
+
+        auto writer = std::make_shared<DataWriter>(
+            "writer_" + std::to_string(i), "qos", make_guid(i, 0x103), participant, topic);
+        writer->locators[locator->id] = locator;
+        db.insert(writer);
+
+        auto reader = std::make_shared<DataReader>(
+            "reader_" + std::to_string(i), "qos", make_guid(i, 0x104), participant, topic);
+        reader->locators[locator->id] = locator;
+        db.insert(reader);
+
+        for (size_t s = 0; s < samples; ++s)
+        {
+            PublicationThroughputSample sample;
+            sample.src_ts = timestamp + std::chrono::milliseconds(s);
+            sample.data = static_cast<double>(s);
+            db.insert(domain->id, writer->id, sample);
+        }
+    }
+}
+
+} // namespace
+
+int main(
+        int argc,
+        char** argv)
+{
+    BenchmarkOptions options = parse_options(argc, argv);
+
+    std::vector<size_t> endpoint_counts = {1000, 5000, 10000, 25000, 50000};
+    size_t samples = 10;
+    size_t repetitions = 3;
+    if (options.quick)
+    {
+        endpoint_counts = {100, 1000};
+        samples = 2;
+        repetitions = 1;
+    }
+
+    Json results = Json::array();
+
+    for (size_t endpoint_count : endpoint_counts)
+    {
+        DatabaseDump dump;
+        {
+            Database db;
+            populate(db, endpoint_count, samples);
+            dump = db.dump_database();
+        }
+
+        std::vector<double> load_ms;
+        for (size_t r = 0; r < repetitions; ++r)
+        {
+            Database db;
+            auto start = BenchmarkClock::now();
+            db.load_database(dump);
+            auto end = BenchmarkClock::now();
+            load_ms.push_back(elapsed_ns(start, end) * 1e-6);
+        }
+
+        Json result;
+        result["endpoints"] = endpoint_count;
+        result["samples_per_writer"] = samples;
+        result["dump_bytes"] = dump.dump().size();
+        result["load_ms"] = percentile(load_ms, 50);
+        result["load_ms_max"] = percentile(load_ms, 100);
+        result["peak_rss_kb"] = resident_set_kb(true);
+        results.push_back(result);
+    }
+
+    return write_report("load", results, options);
+}
@@ -0,0 +1,151 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file SelectBenchmark.cpp
+ *
+ * Measure the latency of Database::select as the history of an entity grows, for several window sizes.
+ */
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <database/database.hpp>
+#include <database/entities.hpp>
+#include <database/samples.hpp>
+
+#include <BenchmarkUtils.hpp>
+
+using namespace eprosima::statistics_backend;
+using namespace eprosima::statistics_backend::database;
+using namespace eprosima::statistics_backend::benchmark;
+
+namespace {
+
+//! Timestamp of the sample at a given position of the history, one sample per millisecond
+Timestamp sample_timestamp(
+        size_t index)
+{
+    return Timestamp() + std::chrono::milliseconds(index);
+}
+
+/**
+ * @brief Create a datawriter with \c history_length publication throughput samples.
+ *
+ * @return The ID of the datawriter.
+ */
+EntityId populate(
+        Database& db,
+        size_t history_length)
+{
+    auto domain = std::make_shared<Domain>("0");
+    db.insert(domain);
+    auto topic = std::make_shared<Topic>("topic", "type", domain);
+    db.insert(topic);
+    auto participant = std::make_shared<DomainParticipant>(
+        "participant", "qos", "01.0f.00.00.00.00.00.00.00.00.00.00|0.0.1.c1", nullptr, domain);
+    db.insert(participant);
+    auto locator = std::make_shared<Locator>("UDPv4:[127.0.0.1]:7400");
+    locator->id = db.insert(locator);
+    auto writer = std::make_shared<DataWriter>(
+        "writer", "qos", "01.0f.00.00.00.00.00.00.00.00.00.00|0.0.0.103", participant, topic);
+    writer->locators[locator->id] = locator;
+    EntityId writer_id = db.insert(writer);
+
+    PublicationThroughputSample sample;
+    for (size_t i = 0; i < history_length; ++i)
+    {
+        sample.src_ts = sample_timestamp(i);
+        sample.data = static_cast<double>(i);
+        db.insert(domain->id, writer_id, sample);
+    }
+
+    return writer_id;
+}
+
+} // namespace
+
+int main(
+        int argc,
+        char** argv)
+{
+    BenchmarkOptions options = parse_options(argc, argv);
+
+    std::vector<size_t> history_lengths = {1000, 10000, 100000, 1000000};
+    std::vector<size_t> window_sizes = {1, 10, 100, 1000, 10000};
+    size_t queries = 2000;
+    if (options.quick)
+    {
+        history_lengths = {1000, 10000};
+        window_sizes = {1, 100};
+        queries = 100;
+    }
+
+    Json results = Json::array();
+
+    for (size_t history_length : history_lengths)
+    {
+        Database db;
+        EntityId writer_id = populate(db, history_length);
+
+        for (size_t window_size : window_sizes)
+        {
+            if (window_size > history_length)
+            {
+                continue;
+            }
+
+            // Recent window queries, the usual case for a monitor, and windows in the middle of the history
+            struct Window
+            {
+                const char* position;
+                size_t first;
+            };
+            std::vector<Window> windows = {
+                {"tail", history_length - window_size},
+                {"middle", (history_length - window_size) / 2}};
+
+            for (const auto& window : windows)
+            {
+                const Timestamp t_from = sample_timestamp(window.first);
+                // The interval must not be empty, so the window ends right before the next sample
+                const Timestamp t_to = sample_timestamp(window.first + window_size) - std::chrono::nanoseconds(1);
+
+                std::vector<double> measures;
+                measures.reserve(queries);
+                for (size_t i = 0; i < queries; ++i)
+                {
+                    auto start = BenchmarkClock::now();
+                    auto samples = db.select(DataKind::PUBLICATION_THROUGHPUT, writer_id, t_from, t_to);
+                    auto end = BenchmarkClock::now();
+                    do_not_optimize(samples);
+                    measures.push_back(elapsed_ns(start, end));
+                }
+
+                Json result;
+                result["history_length"] = history_length;
+                result["window_size"] = window_size;
+                result["window_position"] = window.position;
+                result["queries"] = queries;
+                result["p50_ns_per_select"] = percentile(measures, 50);
+                result["p99_ns_per_select"] = percentile(measures, 99);
+                results.push_back(result);
+            }
+        }
+    }
+
+    return write_report("select", results, options);
+}
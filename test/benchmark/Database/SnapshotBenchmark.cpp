@@ -0,0 +1,195 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file SnapshotBenchmark.cpp
+ *
+ * Compare the size of the JSON dumps and the binary snapshots of the same database,
+ * and the time taken to write and load each of them.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <database/database.hpp>
+#include <database/entities.hpp>
+#include <database/samples.hpp>
+
+#include <BenchmarkUtils.hpp>
+
+using namespace eprosima::statistics_backend;
+using namespace eprosima::statistics_backend::database;
+using namespace eprosima::statistics_backend::benchmark;
+
+namespace {
+
+//! DataWriters created in each participant
+constexpr size_t WRITERS_PER_PARTICIPANT = 8;
+
+std::string make_guid(
+        size_t prefix,
+        size_t entity)
+{
+    char guid[64];
+    std::snprintf(guid, sizeof(guid), "01.0f.%02zx.%02zx.%02zx.%02zx.00.00.00.00.00.00|0.%zx.%zx.%zx",
+            (prefix >> 24) & 0xff, (prefix >> 16) & 0xff, (prefix >> 8) & 0xff, prefix & 0xff,
+            (entity >> 16) & 0xff, (entity >> 8) & 0xff, entity & 0xff);
+    return guid;
+}
+
+/**
+ * @brief Fill the database with \c writer_count datawriters, each of them with \c samples samples
+ * of throughput, heartbeats and datas, and with \c samples packets sent by each participant.
+ */
+void populate(
+        Database& db,
+        size_t writer_count,
+        size_t samples)
+{
+    auto domain = std::make_shared<Domain>("0");
+    db.insert(domain);
+    auto topic = std::make_shared<Topic>("topic", "type", domain);
+    db.insert(topic);
+    auto locator = std::make_shared<Locator>("UDPv4:[127.0.0.1]:7400");
+    locator->id = db.insert(locator);
+
+    std::shared_ptr<DomainParticipant> participant;
+    auto timestamp = std::chrono::system_clock::now();
+
+    for (size_t i = 0; i < writer_count; ++i)
+    {
+        if (0 == i % WRITERS_PER_PARTICIPANT)
+        {
+            participant = std::make_shared<DomainParticipant>(
+                "participant_" + std::to_string(i), "qos", make_guid(i, 0x1c1), nullptr, domain);
+            db.insert(participant);
+
+            for (size_t s = 0; s < samples; ++s)
+            {
+                RtpsPacketsSentSample sample;
+                sample.src_ts = timestamp + std::chrono::milliseconds(s);
+                sample.count = s;
+                sample.remote_locator = locator->id;
+                db.insert(domain->id, participant->id, sample);
+            }
+        }
+
+        auto writer = std::make_shared<DataWriter>(
+            "writer_" + std::to_string(i), "qos", make_guid(i, 0x103), participant, topic);
+        writer->locators[locator->id] = locator;
+        db.insert(writer);
+
+        for (size_t s = 0; s < samples; ++s)
+        {
+            PublicationThroughputSample throughput;
+            throughput.src_ts = timestamp + std::chrono::milliseconds(s);
+            throughput.data = static_cast<double>(s) * 1.5;
+            db.insert(domain->id, writer->id, throughput);
+
+            HeartbeatCountSample heartbeats;
+            heartbeats.src_ts = timestamp + std::chrono::milliseconds(s);
+            heartbeats.count = s;
+            db.insert(domain->id, writer->id, heartbeats);
+
+            DataCountSample datas;
+            datas.src_ts = timestamp + std::chrono::milliseconds(s);
+            datas.count = 10 * s;
+            db.insert(domain->id, writer->id, datas);
+        }
+    }
+}
+
+} // namespace
+
+int main(
+        int argc,
+        char** argv)
+{
+    BenchmarkOptions options = parse_options(argc, argv);
+
+    std::vector<size_t> writer_counts = {100, 1000, 5000};
+    size_t samples = 100;
+    size_t repetitions = 3;
+    if (options.quick)
+    {
+        writer_counts = {100};
+        samples = 10;
+        repetitions = 1;
+    }
+
+    Json results = Json::array();
+
+    for (size_t writer_count : writer_counts)
+    {
+        Database db;
+        populate(db, writer_count, samples);
+
+        std::vector<double> json_dump_ms;
+        std::vector<double> json_load_ms;
+        std::vector<double> binary_dump_ms;
+        std::vector<double> binary_load_ms;
+        std::string json;
+        std::string binary;
+
+        for (size_t r = 0; r < repetitions; ++r)
+        {
+            // JSON, as written to and read from a file
+            {
+                auto start = BenchmarkClock::now();
+                json = db.dump_database().dump();
+                auto end = BenchmarkClock::now();
+                json_dump_ms.push_back(elapsed_ns(start, end) * 1e-6);
+
+                Database loaded_db;
+                start = BenchmarkClock::now();
+                loaded_db.load_database(DatabaseDump::parse(json));
+                end = BenchmarkClock::now();
+                json_load_ms.push_back(elapsed_ns(start, end) * 1e-6);
+            }
+
+            // Binary snapshot
+            {
+                std::stringstream stream;
+                auto start = BenchmarkClock::now();
+                db.dump_snapshot(stream);
+                auto end = BenchmarkClock::now();
+                binary_dump_ms.push_back(elapsed_ns(start, end) * 1e-6);
+                binary = stream.str();
+
+                Database loaded_db;
+                start = BenchmarkClock::now();
+                loaded_db.load_snapshot(stream);
+                end = BenchmarkClock::now();
+                binary_load_ms.push_back(elapsed_ns(start, end) * 1e-6);
+            }
+        }
+
+        Json result;
+        result["writers"] = writer_count;
+        result["samples_per_series"] = samples;
+        result["json_bytes"] = json.size();
+        result["binary_bytes"] = binary.size();
+        result["json_dump_ms"] = percentile(json_dump_ms, 50);
+        result["json_load_ms"] = percentile(json_load_ms, 50);
+        result["binary_dump_ms"] = percentile(binary_dump_ms, 50);
+        result["binary_load_ms"] = percentile(binary_load_ms, 50);
+        results.push_back(result);
+    }
+
+    return write_report("snapshot", results, options);
+}
@@ -0,0 +1,241 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file DataPoolBenchmark.cpp
+ *
+ * Measure the heap allocations per statistics data pushed through ShardedDatabaseDataQueue,
+ * when the producer creates a new data for every sample and when it acquires them from the data pool of the queue.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <database/database.hpp>
+#include <database/database_queue.hpp>
+#include <Monitor.hpp>
+#include <StatisticsBackendData.hpp>
+#include <topic_types/types.h>
+
+#include <BenchmarkUtils.hpp>
+
+namespace {
+
+//! Heap allocations of every thread
+std::atomic<uint64_t> total_allocations{0};
+
+//! Heap allocations of the current thread
+thread_local uint64_t thread_allocations = 0;
+
+void* counted_allocation(
+        std::size_t size)
+{
+    total_allocations.fetch_add(1, std::memory_order_relaxed);
+    ++thread_allocations;
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (nullptr == ptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+} // namespace
+
+void* operator new (
+        std::size_t size)
+{
+    return counted_allocation(size);
+}
+
+void* operator new[](
+        std::size_t size)
+{
+    return counted_allocation(size);
+}
+
+void operator delete (
+        void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](
+        void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete (
+        void* ptr,
+        std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](
+        void* ptr,
+        std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+using namespace eprosima::statistics_backend;
+using namespace eprosima::statistics_backend::database;
+using namespace eprosima::statistics_backend::benchmark;
+
+namespace {
+
+//! Ways in which the producer gets the statistics data it pushes
+enum class DataSource
+{
+    //! A new data for every sample, like the reader listeners did before the data pool
+    MAKE_SHARED,
+    //! Data recycled from the data pool of the queue
+    POOL
+};
+
+/**
+ * @brief Create the datawriter to which the statistics data refer.
+ *
+ * @return The GUID of the datawriter, as found in the statistics data.
+ */
+DatabaseDataQueue::StatisticsGuid populate(
+        Database& db)
+{
+    auto domain = std::make_shared<Domain>("0");
+    db.insert(domain);
+    auto topic = std::make_shared<Topic>("topic", "type", domain);
+    db.insert(topic);
+    auto participant = std::make_shared<DomainParticipant>(
+        "participant", "qos", "01.0f.00.00.00.00.00.00.00.00.00.00|0.0.1.c1", nullptr, domain);
+    db.insert(participant);
+    auto locator = std::make_shared<Locator>("UDPv4:[127.0.0.1]:7400");
+    locator->id = db.insert(locator);
+    auto writer = std::make_shared<DataWriter>(
+        "writer", "qos", "01.0f.00.00.00.00.00.00.00.00.00.00|0.0.1.3", participant, topic);
+    writer->locators[locator->id] = locator;
+    db.insert(writer);
+
+    // The backend notifies the samples inserted in a domain to its monitor
+    std::unique_ptr<details::Monitor> monitor = std::make_unique<details::Monitor>();
+    monitor->id = domain->id;
+    details::StatisticsBackendData::get_instance()->monitors_by_entity_[domain->id] = std::move(monitor);
+
+    DatabaseDataQueue::StatisticsGuidPrefix prefix;
+    prefix.value({1, 0x0f, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0});
+    DatabaseDataQueue::StatisticsEntityId entity_id;
+    entity_id.value({0, 0, 1, 3});
+    DatabaseDataQueue::StatisticsGuid guid;
+    guid.guidPrefix(prefix);
+    guid.entityId(entity_id);
+    return guid;
+}
+
+/**
+ * @brief Push heartbeat count data from \c first to \c last, and wait for them to be processed
+ *
+ * @param burst Number of data pushed before waiting for the queue to be processed. 0 to push all of them at once.
+ */
+void push_data(
+        ShardedDatabaseDataQueue& queue,
+        const DatabaseDataQueue::StatisticsGuid& writer_guid,
+        DataSource source,
+        size_t burst,
+        size_t first,
+        size_t last)
+{
+    DatabaseDataQueue::StatisticsEntityCount inner_data;
+    inner_data.guid(writer_guid);
+    auto timestamp = std::chrono::system_clock::now();
+    for (size_t i = first; i < last; ++i)
+    {
+        std::shared_ptr<eprosima::fastdds::statistics::Data> data = DataSource::POOL == source ?
+                queue.data_pool().acquire() : std::make_shared<eprosima::fastdds::statistics::Data>();
+        inner_data.count(i);
+        data->entity_count(inner_data);
+        data->_d(eprosima::fastdds::statistics::EventKind::HEARTBEAT_COUNT);
+        queue.push(timestamp + std::chrono::nanoseconds(i), data);
+        if (burst > 0 && 0 == (i + 1 - first) % burst)
+        {
+            queue.flush();
+        }
+    }
+    queue.flush();
+}
+
+} // namespace
+
+int main(
+        int argc,
+        char** argv)
+{
+    BenchmarkOptions options = parse_options(argc, argv);
+
+    size_t samples = 1000000;
+    size_t warmup_samples = 100000;
+    if (options.quick)
+    {
+        samples = 10000;
+        warmup_samples = 1000;
+    }
+
+    // Bursts of one take of a reader listener, and a producer that never waits for the consumer,
+    // which keeps more data in flight than the data pool can recycle
+    const std::vector<size_t> bursts = {64, 0};
+
+    Json results = Json::array();
+
+    for (size_t burst : bursts)
+    {
+        for (DataSource source : {DataSource::MAKE_SHARED, DataSource::POOL})
+        {
+            Database db;
+            DatabaseDataQueue::StatisticsGuid writer_guid = populate(db);
+            ShardedDatabaseDataQueue queue(&db);
+
+            // The pool and the buffers of the queue and the database reach their steady size
+            push_data(queue, writer_guid, source, burst, 0, warmup_samples);
+
+            uint64_t created_before = queue.data_pool().created();
+            uint64_t thread_before = thread_allocations;
+            uint64_t total_before = total_allocations.load();
+            auto start = BenchmarkClock::now();
+            push_data(queue, writer_guid, source, burst, warmup_samples, warmup_samples + samples);
+            auto end = BenchmarkClock::now();
+            uint64_t producer = thread_allocations - thread_before;
+            uint64_t total = total_allocations.load() - total_before;
+
+            Json result;
+            result["source"] = DataSource::POOL == source ? "pool" : "make_shared";
+            result["burst"] = burst;
+            result["samples"] = samples;
+            result["samples_per_second"] = static_cast<double>(samples) / (elapsed_ns(start, end) * 1e-9);
+            result["producer_allocations_per_sample"] = static_cast<double>(producer) / static_cast<double>(samples);
+            result["total_allocations_per_sample"] = static_cast<double>(total) / static_cast<double>(samples);
+            result["pool_data_created"] = queue.data_pool().created() - created_before;
+            results.push_back(result);
+
+            queue.stop_consumer();
+            details::StatisticsBackendData::get_instance()->monitors_by_entity_.clear();
+        }
+    }
+
+    return write_report("data_pool", results, options);
+}
@@ -0,0 +1,506 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file IngestionBenchmark.cpp
+ *
+ * Measure the ingestion of statistics data into the database, without DDS.
+ *
+ * The entities are discovered through DatabaseEntityQueue, and then a synthetic stream of statistics data is pushed
+ * to ShardedDatabaseDataQueue, as the reader listeners would do. Each scenario is defined by:
+ *   * The number of participants, each with one datawriter and one datareader (\c --participants).
+ *   * The mix of statistics data kinds (\c --mix): counts, throughput, latency or mixed.
+ *   * The rate at which the data are pushed, in samples per second, 0 meaning as fast as possible (\c --rate).
+ *   * The number of data pushed (\c --samples) and the number of shards of the queue (\c --shards).
+ * Giving any of them runs only that scenario. Otherwise a predefined set of scenarios is run.
+ *
+ * It reports the sustained ingestion rate, the depth of the queue, the latency from the push of a data to the
+ * notification of its sample, and the resident set size of the process.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fastdds/rtps/common/Guid.h>
+#include <fastdds/rtps/common/Locator.h>
+
+#include <fastdds_statistics_backend/listener/DomainListener.hpp>
+
+#include <database/database.hpp>
+#include <database/database_queue.hpp>
+#include <Monitor.hpp>
+#include <StatisticsBackendData.hpp>
+#include <topic_types/types.h>
+
+#include <BenchmarkUtils.hpp>
+
+using namespace eprosima::statistics_backend;
+using namespace eprosima::statistics_backend::database;
+using namespace eprosima::statistics_backend::benchmark;
+using eprosima::fastrtps::rtps::GUID_t;
+using StatisticsEventKind = DatabaseDataQueue::StatisticsEventKind;
+
+namespace {
+
+//! Parameters of an ingestion scenario
+struct Scenario
+{
+    //! Number of participants, each with one datawriter and one datareader
+    size_t participants;
+
+    //! Name of the mix of statistics data kinds (see mixes)
+    std::string mix;
+
+    //! Samples pushed per second. 0 to push them as fast as possible
+    double rate;
+
+    //! Number of statistics data pushed
+    size_t samples;
+
+    //! Number of shards of the data queue
+    size_t shards;
+};
+
+//! Statistics data kinds of each mix. The data of every participant cycle through the kinds of the mix
+const std::map<std::string, std::vector<StatisticsEventKind>> mixes = {
+    {"counts", {
+         StatisticsEventKind::HEARTBEAT_COUNT,
+         StatisticsEventKind::ACKNACK_COUNT,
+         StatisticsEventKind::DATA_COUNT,
+         StatisticsEventKind::PDP_PACKETS}},
+    {"throughput", {
+         StatisticsEventKind::PUBLICATION_THROUGHPUT,
+         StatisticsEventKind::SUBSCRIPTION_THROUGHPUT}},
+    {"latency", {
+         StatisticsEventKind::HISTORY2HISTORY_LATENCY}},
+    {"mixed", {
+         StatisticsEventKind::HISTORY2HISTORY_LATENCY,
+         StatisticsEventKind::PUBLICATION_THROUGHPUT,
+         StatisticsEventKind::SUBSCRIPTION_THROUGHPUT,
+         StatisticsEventKind::HEARTBEAT_COUNT,
+         StatisticsEventKind::ACKNACK_COUNT,
+         StatisticsEventKind::DATA_COUNT,
+         StatisticsEventKind::PDP_PACKETS}},
+};
+
+//! GUIDs of the entities of a participant
+struct ParticipantGuids
+{
+    GUID_t participant;
+    GUID_t writer;
+    GUID_t reader;
+};
+
+ParticipantGuids participant_guids(
+        size_t index)
+{
+    ParticipantGuids guids;
+    guids.participant.guidPrefix.value[0] = 0x01;
+    guids.participant.guidPrefix.value[1] = 0x0f;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        guids.participant.guidPrefix.value[8 + i] = static_cast<uint8_t>(index >> (8 * (3 - i)));
+    }
+    guids.participant.entityId = eprosima::fastrtps::rtps::c_EntityId_RTPSParticipant;
+
+    guids.writer.guidPrefix = guids.participant.guidPrefix;
+    guids.writer.entityId.value[2] = 0x01;
+    guids.writer.entityId.value[3] = 0x03;
+
+    guids.reader.guidPrefix = guids.participant.guidPrefix;
+    guids.reader.entityId.value[2] = 0x01;
+    guids.reader.entityId.value[3] = 0x04;
+    return guids;
+}
+
+DatabaseDataQueue::StatisticsGuid to_statistics_guid(
+        const GUID_t& guid)
+{
+    DatabaseDataQueue::StatisticsGuidPrefix prefix;
+    DatabaseDataQueue::StatisticsEntityId entity_id;
+    std::copy(std::begin(guid.guidPrefix.value), std::end(guid.guidPrefix.value), prefix.value().begin());
+    std::copy(std::begin(guid.entityId.value), std::end(guid.entityId.value), entity_id.value().begin());
+
+    DatabaseDataQueue::StatisticsGuid statistics_guid;
+    statistics_guid.guidPrefix(prefix);
+    statistics_guid.entityId(entity_id);
+    return statistics_guid;
+}
+
+/**
+ * Push and insertion times of the data of a participant.
+ *
+ * The data of a participant and its endpoints are processed by a single shard, in the order they are pushed,
+ * so the n-th notification of a participant corresponds to its n-th data.
+ */
+struct ParticipantTimes
+{
+    std::vector<BenchmarkClock::time_point> pushed;
+    std::vector<BenchmarkClock::time_point> inserted;
+    std::atomic<size_t> inserted_count{0};
+};
+
+/**
+ * Listener that records the time at which each sample is notified, which is right after its insertion.
+ */
+class InsertionListener : public DomainListener
+{
+public:
+
+    InsertionListener(
+            const std::map<EntityId, size_t>& participant_of,
+            std::vector<ParticipantTimes>& times)
+        : participant_of_(participant_of)
+        , times_(times)
+    {
+    }
+
+    void on_data_available(
+            EntityId,
+            EntityId entity_id,
+            DataKind) override
+    {
+        BenchmarkClock::time_point now = BenchmarkClock::now();
+        auto it = participant_of_.find(entity_id);
+        if (it == participant_of_.end())
+        {
+            return;
+        }
+        ParticipantTimes& times = times_[it->second];
+        size_t index = times.inserted_count.fetch_add(1, std::memory_order_relaxed);
+        if (index < times.inserted.size())
+        {
+            times.inserted[index] = now;
+        }
+    }
+
+private:
+
+    const std::map<EntityId, size_t>& participant_of_;
+    std::vector<ParticipantTimes>& times_;
+};
+
+//! Push the discovery of the entities of every participant, and wait for them to be processed
+void discover_entities(
+        DatabaseEntityQueue& entity_queue,
+        EntityId domain_id,
+        size_t participants)
+{
+    auto timestamp = std::chrono::system_clock::now();
+    for (size_t p = 0; p < participants; ++p)
+    {
+        ParticipantGuids guids = participant_guids(p);
+
+        EntityDiscoveryInfo participant_info(EntityKind::PARTICIPANT);
+        participant_info.domain_id = domain_id;
+        participant_info.guid = guids.participant;
+        participant_info.qos = {{"available_builtin_endpoints", 3135}};
+        participant_info.address = "127.0.0.1";
+        participant_info.participant_name = "participant_" + std::to_string(p);
+        participant_info.discovery_status = details::StatisticsBackendData::DiscoveryStatus::DISCOVERY;
+        entity_queue.push(timestamp, participant_info);
+
+        eprosima::fastrtps::rtps::Locator_t locator(LOCATOR_KIND_UDPv4, static_cast<uint32_t>(7411 + p));
+        locator.address[12] = 127;
+        locator.address[15] = 1;
+
+        EntityKind endpoint_kinds[] = {EntityKind::DATAWRITER, EntityKind::DATAREADER};
+        for (EntityKind kind : endpoint_kinds)
+        {
+            EntityDiscoveryInfo endpoint_info(kind);
+            endpoint_info.domain_id = domain_id;
+            endpoint_info.guid = EntityKind::DATAWRITER == kind ? guids.writer : guids.reader;
+            endpoint_info.qos = {{"reliability", {{"kind", "RELIABLE_RELIABILITY_QOS"}}}};
+            endpoint_info.topic_name = "ingestion_topic";
+            endpoint_info.type_name = "ingestion_type";
+            endpoint_info.locators.add_unicast_locator(locator);
+            endpoint_info.discovery_status = details::StatisticsBackendData::DiscoveryStatus::DISCOVERY;
+            entity_queue.push(timestamp, endpoint_info);
+        }
+    }
+    entity_queue.flush();
+}
+
+//! Fill a statistics data of the given kind, referring to the entities of a participant
+void fill_data(
+        DatabaseDataQueue::StatisticsData& data,
+        StatisticsEventKind kind,
+        const DatabaseDataQueue::StatisticsGuid& participant,
+        const DatabaseDataQueue::StatisticsGuid& writer,
+        const DatabaseDataQueue::StatisticsGuid& reader,
+        uint64_t sequence)
+{
+    switch (kind)
+    {
+        case StatisticsEventKind::HISTORY2HISTORY_LATENCY:
+        {
+            DatabaseDataQueue::StatisticsWriterReaderData inner_data;
+            inner_data.writer_guid(writer);
+            inner_data.reader_guid(reader);
+            inner_data.data(static_cast<float>(sequence % 1000));
+            data.writer_reader_data(inner_data);
+            break;
+        }
+        case StatisticsEventKind::PUBLICATION_THROUGHPUT:
+        case StatisticsEventKind::SUBSCRIPTION_THROUGHPUT:
+        {
+            DatabaseDataQueue::StatisticsEntityData inner_data;
+            inner_data.guid(StatisticsEventKind::PUBLICATION_THROUGHPUT == kind ? writer : reader);
+            inner_data.data(static_cast<float>(sequence % 1000));
+            data.entity_data(inner_data);
+            break;
+        }
+        default:
+        {
+            // Counts must not decrease, so the sequence of the data is used
+            DatabaseDataQueue::StatisticsEntityCount inner_data;
+            inner_data.guid(StatisticsEventKind::ACKNACK_COUNT == kind ? reader :
+                    (StatisticsEventKind::PDP_PACKETS == kind ? participant : writer));
+            inner_data.count(sequence);
+            data.entity_count(inner_data);
+            break;
+        }
+    }
+    data._d(kind);
+}
+
+Json run(
+        const Scenario& scenario)
+{
+    const std::vector<StatisticsEventKind>& kinds = mixes.at(scenario.mix);
+
+    Database db;
+    auto domain = std::make_shared<Domain>("0");
+    db.insert(domain);
+
+    // Each participant receives the data i, i + participants, i + 2 * participants...
+    const size_t samples_per_participant = (scenario.samples + scenario.participants - 1) / scenario.participants;
+    std::vector<ParticipantTimes> times(scenario.participants);
+    for (auto& participant_times : times)
+    {
+        participant_times.pushed.resize(samples_per_participant);
+        participant_times.inserted.resize(samples_per_participant);
+    }
+    std::map<EntityId, size_t> participant_of;
+    InsertionListener listener(participant_of, times);
+
+    // The backend notifies the entities and samples inserted in a domain to the listener of its monitor
+    std::unique_ptr<details::Monitor> monitor = std::make_unique<details::Monitor>();
+    monitor->id = domain->id;
+    monitor->domain_listener = &listener;
+    monitor->domain_callback_mask = CallbackKind::ON_DATA_AVAILABLE;
+    monitor->data_mask = DataKindMask::all();
+    details::StatisticsBackendData::get_instance()->monitors_by_entity_[domain->id] = std::move(monitor);
+
+    ShardedDatabaseDataQueue data_queue(&db, scenario.shards);
+    DatabaseEntityQueue entity_queue(&db);
+    entity_queue.set_data_queue(&data_queue);
+
+    // Discovery
+    auto discovery_start = BenchmarkClock::now();
+    discover_entities(entity_queue, domain->id, scenario.participants);
+    auto discovery_end = BenchmarkClock::now();
+
+    std::vector<DatabaseDataQueue::StatisticsGuid> guids;
+    for (size_t p = 0; p < scenario.participants; ++p)
+    {
+        ParticipantGuids participant = participant_guids(p);
+        participant_of[db.get_entity_by_guid(EntityKind::PARTICIPANT, participant.participant).second] = p;
+        participant_of[db.get_entity_by_guid(EntityKind::DATAWRITER, participant.writer).second] = p;
+        participant_of[db.get_entity_by_guid(EntityKind::DATAREADER, participant.reader).second] = p;
+        guids.push_back(to_statistics_guid(participant.participant));
+        guids.push_back(to_statistics_guid(participant.writer));
+        guids.push_back(to_statistics_guid(participant.reader));
+    }
+
+    // Sample the depth of the queue while the data are ingested
+    std::atomic<bool> ingesting(true);
+    std::vector<double> depths;
+    std::thread depth_sampler([&]()
+            {
+                while (ingesting.load())
+                {
+                    uint64_t depth = 0;
+                    for (size_t s = 0; s < data_queue.shard_count(); ++s)
+                    {
+                        DatabaseDataQueue& shard = data_queue.shard(s);
+                        uint64_t consumed = shard.consumed();
+                        uint64_t pushed = shard.pushed();
+                        depth += pushed > consumed ? pushed - consumed : 0;
+                    }
+                    depths.push_back(static_cast<double>(depth));
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            });
+
+    // Ingestion
+    const std::chrono::nanoseconds period(scenario.rate > 0 ? static_cast<int64_t>(1e9 / scenario.rate) : 0);
+    auto timestamp = std::chrono::system_clock::now();
+    auto start = BenchmarkClock::now();
+    for (size_t i = 0; i < scenario.samples; ++i)
+    {
+        if (period.count() > 0)
+        {
+            BenchmarkClock::time_point scheduled = start + period * i;
+            if (BenchmarkClock::now() < scheduled)
+            {
+                std::this_thread::sleep_until(scheduled);
+            }
+        }
+
+        size_t p = i % scenario.participants;
+        size_t sequence = i / scenario.participants;
+        std::shared_ptr<DatabaseDataQueue::StatisticsData> data = data_queue.data_pool().acquire();
+        fill_data(*data, kinds[sequence % kinds.size()], guids[3 * p], guids[3 * p + 1], guids[3 * p + 2],
+                sequence);
+
+        times[p].pushed[sequence] = BenchmarkClock::now();
+        data_queue.push(timestamp + std::chrono::microseconds(i), data);
+    }
+    auto pushed = BenchmarkClock::now();
+    data_queue.flush();
+    auto end = BenchmarkClock::now();
+    ingesting.store(false);
+    depth_sampler.join();
+
+    uint64_t inserted = 0;
+    std::vector<double> latencies;
+    latencies.reserve(scenario.samples);
+    for (const auto& participant_times : times)
+    {
+        size_t count = (std::min)(participant_times.inserted_count.load(), participant_times.inserted.size());
+        inserted += participant_times.inserted_count.load();
+        for (size_t n = 0; n < count; ++n)
+        {
+            latencies.push_back(elapsed_ns(participant_times.pushed[n], participant_times.inserted[n]));
+        }
+    }
+
+    Json result;
+    result["participants"] = scenario.participants;
+    result["mix"] = scenario.mix;
+    result["rate"] = scenario.rate;
+    result["shards"] = scenario.shards;
+    result["samples"] = scenario.samples;
+    result["inserted"] = inserted;
+    result["discovery_ms"] = elapsed_ns(discovery_start, discovery_end) * 1e-6;
+    result["pushed_per_second"] = static_cast<double>(scenario.samples) / (elapsed_ns(start, pushed) * 1e-9);
+    result["inserted_per_second"] = static_cast<double>(inserted) / (elapsed_ns(start, end) * 1e-9);
+    double depth_sum = 0;
+    for (double depth : depths)
+    {
+        depth_sum += depth;
+    }
+    result["mean_queue_depth"] = depths.empty() ? 0.0 : depth_sum / static_cast<double>(depths.size());
+    result["max_queue_depth"] = depths.empty() ? 0.0 : *std::max_element(depths.begin(), depths.end());
+    result["p50_push_to_insert_ns"] = percentile(latencies, 50);
+    result["p99_push_to_insert_ns"] = percentile(latencies, 99);
+    result["max_push_to_insert_ns"] = latencies.empty() ? 0.0 : latencies.back();
+    result["rss_kb"] = resident_set_kb();
+    result["peak_rss_kb"] = resident_set_kb(true);
+
+    entity_queue.stop_consumer();
+    data_queue.stop_consumer();
+    details::StatisticsBackendData::get_instance()->monitors_by_entity_.clear();
+    return result;
+}
+
+} // namespace
+
+int main(
+        int argc,
+        char** argv)
+{
+    BenchmarkOptions options = parse_options(argc, argv);
+
+    // Scenario given in the command line
+    Scenario custom {100, "mixed", 0, 1000000, ShardedDatabaseDataQueue::DEFAULT_SHARD_COUNT};
+    bool has_custom = false;
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        std::string arg(argv[i]);
+        if (arg == "--participants")
+        {
+            custom.participants = (std::max)(std::strtoull(argv[++i], nullptr, 10), 1ull);
+            has_custom = true;
+        }
+        else if (arg == "--mix")
+        {
+            custom.mix = argv[++i];
+            has_custom = true;
+        }
+        else if (arg == "--rate")
+        {
+            custom.rate = std::strtod(argv[++i], nullptr);
+            has_custom = true;
+        }
+        else if (arg == "--samples")
+        {
+            custom.samples = std::strtoull(argv[++i], nullptr, 10);
+            has_custom = true;
+        }
+        else if (arg == "--shards")
+        {
+            custom.shards = std::strtoull(argv[++i], nullptr, 10);
+            has_custom = true;
+        }
+    }
+    if (mixes.find(custom.mix) == mixes.end())
+    {
+        std::cerr << "Unknown mix " << custom.mix << ". Use counts, throughput, latency or mixed" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<Scenario> scenarios;
+    if (has_custom)
+    {
+        scenarios.push_back(custom);
+    }
+    else if (options.quick)
+    {
+        scenarios = {
+            {10, "mixed", 0, 10000, 1},
+            {10, "mixed", 20000, 2000, 2},
+        };
+    }
+    else
+    {
+        for (size_t participants : {10, 1000})
+        {
+            for (const auto& mix : mixes)
+            {
+                scenarios.push_back({participants, mix.first, 0, 1000000, 1});
+            }
+            scenarios.push_back({participants, "mixed", 0, 1000000, 4});
+            scenarios.push_back({participants, "mixed", 100000, 500000, 1});
+        }
+    }
+
+    Json results = Json::array();
+    for (const Scenario& scenario : scenarios)
+    {
+        results.push_back(run(scenario));
+    }
+
+    return write_report("ingestion", results, options);
+}
@@ -0,0 +1,178 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file QueueBenchmark.cpp
+ *
+ * Measure the throughput and the enqueue latency of DatabaseQueue with several producer threads,
+ * for each overflow policy of its background queue.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <database/database_queue.hpp>
+
+#include <BenchmarkUtils.hpp>
+
+using namespace eprosima::statistics_backend;
+using namespace eprosima::statistics_backend::database;
+using namespace eprosima::statistics_backend::benchmark;
+
+namespace {
+
+/**
+ * Queue whose consumer only counts the items, so the benchmark measures the queue itself.
+ */
+class CountingQueue : public DatabaseQueue<uint64_t>
+{
+public:
+
+    CountingQueue(
+            std::size_t capacity,
+            details::OverflowPolicy policy)
+        : DatabaseQueue<uint64_t>(capacity, policy)
+    {
+    }
+
+    virtual ~CountingQueue()
+    {
+        stop_consumer();
+    }
+
+    //! Number of items processed by the consumer, without the dropped ones
+    uint64_t processed() const
+    {
+        return consumed() - dropped();
+    }
+
+protected:
+
+    void process_sample() override
+    {
+        do_not_optimize(front().second);
+    }
+
+};
+
+std::string policy_name(
+        details::OverflowPolicy policy)
+{
+    switch (policy)
+    {
+        case details::OverflowPolicy::BLOCK:
+            return "block";
+        case details::OverflowPolicy::DROP_OLDEST:
+            return "drop_oldest";
+        case details::OverflowPolicy::DROP_NEWEST:
+            return "drop_newest";
+        default:
+            return "unknown";
+    }
+}
+
+} // namespace
+
+int main(
+        int argc,
+        char** argv)
+{
+    BenchmarkOptions options = parse_options(argc, argv);
+
+    std::vector<size_t> producer_counts = {1, 2, 4, 8};
+    size_t pushes_per_producer = 1000000;
+    size_t capacity = DatabaseQueue<uint64_t>::DEFAULT_CAPACITY;
+    if (options.quick)
+    {
+        producer_counts = {1, 2};
+        pushes_per_producer = 10000;
+        capacity = 1024;
+    }
+
+    const std::vector<details::OverflowPolicy> policies = {
+        details::OverflowPolicy::BLOCK,
+        details::OverflowPolicy::DROP_OLDEST,
+        details::OverflowPolicy::DROP_NEWEST};
+
+    Json results = Json::array();
+
+    for (auto policy : policies)
+    {
+        for (size_t producers : producer_counts)
+        {
+            CountingQueue queue(capacity, policy);
+            std::vector<std::vector<double>> latencies(producers);
+            std::atomic<bool> go(false);
+
+            std::vector<std::thread> threads;
+            for (size_t p = 0; p < producers; ++p)
+            {
+                threads.emplace_back([&, p]()
+                        {
+                            std::vector<double>& thread_latencies = latencies[p];
+                            thread_latencies.reserve(pushes_per_producer);
+                            auto timestamp = std::chrono::system_clock::now();
+                            while (!go)
+                            {
+                                std::this_thread::yield();
+                            }
+                            for (size_t i = 0; i < pushes_per_producer; ++i)
+                            {
+                                auto push_start = BenchmarkClock::now();
+                                queue.push(timestamp, i);
+                                thread_latencies.push_back(elapsed_ns(push_start, BenchmarkClock::now()));
+                            }
+                        });
+            }
+
+            auto start = BenchmarkClock::now();
+            go = true;
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+            auto pushed = BenchmarkClock::now();
+            queue.flush();
+            auto end = BenchmarkClock::now();
+
+            std::vector<double> all_latencies;
+            all_latencies.reserve(producers * pushes_per_producer);
+            for (const auto& thread_latencies : latencies)
+            {
+                all_latencies.insert(all_latencies.end(), thread_latencies.begin(), thread_latencies.end());
+            }
+
+            const size_t total_pushes = producers * pushes_per_producer;
+            Json result;
+            result["policy"] = policy_name(policy);
+            result["producers"] = producers;
+            result["capacity"] = capacity;
+            result["pushes"] = total_pushes;
+            result["pushes_per_second"] = static_cast<double>(total_pushes) / (elapsed_ns(start, pushed) * 1e-9);
+            result["consumed_per_second"] = static_cast<double>(queue.processed()) / (elapsed_ns(start, end) * 1e-9);
+            result["dropped"] = queue.dropped();
+            result["consumed"] = queue.processed();
+            result["p50_enqueue_ns"] = percentile(all_latencies, 50);
+            result["p99_enqueue_ns"] = percentile(all_latencies, 99);
+            result["p999_enqueue_ns"] = percentile(all_latencies, 99.9);
+            result["max_enqueue_ns"] = all_latencies.empty() ? 0.0 : all_latencies.back();
+            results.push_back(result);
+        }
+    }
+
+    return write_report("database_queue", results, options);
+}
@@ -0,0 +1,478 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file QueryBenchmark.cpp
+ *
+ * Measure the latency of the queries of StatisticsBackend on a synthetic database:
+ *   * Every overload of get_data, for several numbers of bins, statistics, time windows and number of entities.
+ *   * get_entities, for several relations of the entity hierarchy.
+ *   * get_info, for every entity kind.
+ *
+ * The size of the database is set with \c --participants, \c --endpoints (datawriters and datareaders per
+ * participant) and \c --history (samples of each series, one per millisecond).
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fastdds_statistics_backend/StatisticsBackend.hpp>
+#include <fastdds_statistics_backend/types/JSONTags.h>
+
+#include <database/database.hpp>
+#include <database/entities.hpp>
+#include <StatisticsBackendData.hpp>
+
+#include <BenchmarkUtils.hpp>
+
+using namespace eprosima::statistics_backend;
+using namespace eprosima::statistics_backend::database;
+using namespace eprosima::statistics_backend::benchmark;
+
+namespace {
+
+//! Size of the synthetic database
+struct DatabaseSize
+{
+    //! Number of participants
+    size_t participants;
+
+    //! Number of datawriters, and of datareaders, of each participant
+    size_t endpoints;
+
+    //! Number of samples of each series
+    size_t history;
+};
+
+//! Entities of the synthetic database
+struct Entities
+{
+    EntityId host;
+    EntityId user;
+    EntityId process;
+    EntityId domain;
+    EntityId topic;
+    EntityId participant;
+    EntityId locator;
+    std::vector<EntityId> writers;
+    std::vector<EntityId> readers;
+};
+
+//! Timestamp of the sample at a given position of the history, one sample per millisecond
+Timestamp sample_timestamp(
+        size_t index)
+{
+    return Timestamp() + std::chrono::milliseconds(index);
+}
+
+std::string make_guid(
+        size_t prefix,
+        size_t entity)
+{
+    char guid[64];
+    std::snprintf(guid, sizeof(guid), "01.0f.%02zx.%02zx.%02zx.%02zx.00.00.00.00.00.00|0.%zx.%zx.%zx",
+            (prefix >> 24) & 0xff, (prefix >> 16) & 0xff, (prefix >> 8) & 0xff, prefix & 0xff,
+            (entity >> 16) & 0xff, (entity >> 8) & 0xff, entity & 0xff);
+    return guid;
+}
+
+/**
+ * @brief Fill the database with the entities and samples of the given size.
+ *
+ * Every participant runs in its own process, sixteen of them per host, and has its own locator.
+ * Every datawriter has a publication throughput series and a latency series towards the datareader
+ * with its same index.
+ */
+Entities populate(
+        Database& db,
+        const DatabaseSize& size)
+{
+    Entities entities;
+
+    auto domain = std::make_shared<Domain>("0");
+    entities.domain = db.insert(domain);
+    auto topic = std::make_shared<Topic>("topic", "type", domain);
+    entities.topic = db.insert(topic);
+
+    std::shared_ptr<Host> host;
+    std::shared_ptr<User> user;
+    for (size_t p = 0; p < size.participants; ++p)
+    {
+        if (0 == p % 16)
+        {
+            host = std::make_shared<Host>("host_" + std::to_string(p / 16));
+            db.insert(host);
+            user = std::make_shared<User>("user", host);
+            db.insert(user);
+        }
+        auto process = std::make_shared<Process>("process_" + std::to_string(p), std::to_string(p), user);
+        EntityId process_id = db.insert(process);
+
+        auto participant = std::make_shared<DomainParticipant>(
+            "participant_" + std::to_string(p), "qos", make_guid(p, 0x1c1), nullptr, domain);
+        EntityId participant_id = db.insert(participant);
+        db.link_participant_with_process(participant_id, process_id);
+
+        auto locator = std::make_shared<Locator>("UDPv4:[127.0.0.1]:" + std::to_string(7400 + p));
+        locator->id = db.insert(locator);
+
+        for (size_t e = 0; e < size.endpoints; ++e)
+        {
+            auto writer = std::make_shared<DataWriter>(
+                "writer_" + std::to_string(p) + "_" + std::to_string(e), "qos", make_guid(p, 0x100 + 2 * e),
+                participant, topic);
+            writer->locators[locator->id] = locator;
+            entities.writers.push_back(db.insert(writer));
+
+            auto reader = std::make_shared<DataReader>(
+                "reader_" + std::to_string(p) + "_" + std::to_string(e), "qos", make_guid(p, 0x101 + 2 * e),
+                participant, topic);
+            reader->locators[locator->id] = locator;
+            entities.readers.push_back(db.insert(reader));
+        }
+
+        if (0 == p)
+        {
+            entities.host = host->id;
+            entities.user = user->id;
+            entities.process = process_id;
+            entities.participant = participant_id;
+            entities.locator = locator->id;
+        }
+    }
+
+    PublicationThroughputSample throughput;
+    HistoryLatencySample latency;
+    for (size_t w = 0; w < entities.writers.size(); ++w)
+    {
+        latency.reader = entities.readers[w];
+        for (size_t i = 0; i < size.history; ++i)
+        {
+            throughput.src_ts = sample_timestamp(i);
+            throughput.data = static_cast<double>(i % 1000);
+            db.insert(entities.domain, entities.writers[w], throughput);
+
+            latency.src_ts = sample_timestamp(i);
+            latency.data = static_cast<double>(i % 100);
+            db.insert(entities.domain, entities.writers[w], latency);
+        }
+    }
+
+    return entities;
+}
+
+//! Run a query several times and get the latency of each run, in nanoseconds
+std::vector<double> time_query(
+        size_t runs,
+        const std::function<size_t()>& query,
+        size_t& result_size)
+{
+    std::vector<double> latencies;
+    latencies.reserve(runs);
+    for (size_t i = 0; i < runs; ++i)
+    {
+        auto start = BenchmarkClock::now();
+        result_size = query();
+        latencies.push_back(elapsed_ns(start, BenchmarkClock::now()));
+    }
+    return latencies;
+}
+
+//! Report of the latencies of a query
+Json latency_report(
+        std::vector<double>& latencies,
+        size_t result_size)
+{
+    double total = 0;
+    for (double latency : latencies)
+    {
+        total += latency;
+    }
+
+    Json result;
+    result["runs"] = latencies.size();
+    result["result_size"] = result_size;
+    result["mean_ns"] = latencies.empty() ? 0.0 : total / static_cast<double>(latencies.size());
+    result["p50_ns"] = percentile(latencies, 50);
+    result["p99_ns"] = percentile(latencies, 99);
+    return result;
+}
+
+const std::vector<std::pair<StatisticKind, std::string>> statistics = {
+    {StatisticKind::NONE, "none"},
+    {StatisticKind::MEAN, "mean"},
+    {StatisticKind::STANDARD_DEVIATION, "standard_deviation"},
+    {StatisticKind::MAX, "max"},
+    {StatisticKind::MIN, "min"},
+    {StatisticKind::MEDIAN, "median"},
+    {StatisticKind::COUNT, "count"},
+    {StatisticKind::SUM, "sum"},
+    {StatisticKind::PERCENTILE_50, "percentile_50"},
+    {StatisticKind::PERCENTILE_90, "percentile_90"},
+    {StatisticKind::PERCENTILE_99, "percentile_99"},
+    {StatisticKind::PERCENTILE_99_9, "percentile_99_9"},
+};
+
+/**
+ * @brief Time every overload of get_data.
+ *
+ * The single entity overloads query the publication throughput of the first \c fan_out datawriters.
+ * The source-target overloads query the latency from the first \c fan_out datawriters to the first
+ * \c fan_out datareaders.
+ */
+void benchmark_get_data(
+        const Entities& entities,
+        const DatabaseSize& size,
+        const std::vector<size_t>& fan_outs,
+        const std::vector<size_t>& windows,
+        size_t runs,
+        Json& results)
+{
+    const std::vector<uint16_t> bins_list = {0, 1, 100, 10000};
+
+    for (size_t fan_out : fan_outs)
+    {
+        fan_out = (std::min)(fan_out, entities.writers.size());
+        std::vector<EntityId> writers(entities.writers.begin(), entities.writers.begin() + fan_out);
+        std::vector<EntityId> readers(entities.readers.begin(), entities.readers.begin() + fan_out);
+
+        for (uint16_t bins : bins_list)
+        {
+            for (const auto& statistic : statistics)
+            {
+                // The statistic is not used without bins
+                if (0 == bins && StatisticKind::NONE != statistic.first)
+                {
+                    continue;
+                }
+
+                for (size_t window : windows)
+                {
+                    window = (std::min)(window, size.history);
+                    Timestamp t_from = sample_timestamp(size.history - window);
+                    Timestamp t_to = sample_timestamp(size.history);
+
+                    for (bool source_target : {false, true})
+                    {
+                        size_t result_size = 0;
+                        std::vector<double> latencies = time_query(runs, [&]()
+                                        {
+                                            auto data = source_target ?
+                                            StatisticsBackend::get_data(DataKind::FASTDDS_LATENCY, writers, readers,
+                                            bins, t_from, t_to, statistic.first) :
+                                            StatisticsBackend::get_data(DataKind::PUBLICATION_THROUGHPUT, writers,
+                                            bins, t_from, t_to, statistic.first);
+                                            do_not_optimize(data);
+                                            return data.size();
+                                        }, result_size);
+
+                        Json result = latency_report(latencies, result_size);
+                        result["query"] = "get_data";
+                        result["overload"] = source_target ? "source_target" : "single";
+                        result["fan_out"] = fan_out;
+                        result["bins"] = bins;
+                        result["statistic"] = statistic.second;
+                        result["window"] = window;
+                        results.push_back(result);
+                    }
+                }
+
+                // Overloads without time arguments, which query the whole history
+                for (bool source_target : {false, true})
+                {
+                    size_t result_size = 0;
+                    std::vector<double> latencies = time_query(runs, [&]()
+                                    {
+                                        auto data = source_target ?
+                                        StatisticsBackend::get_data(DataKind::FASTDDS_LATENCY, writers, readers,
+                                        bins, statistic.first) :
+                                        StatisticsBackend::get_data(DataKind::PUBLICATION_THROUGHPUT, writers,
+                                        bins, statistic.first);
+                                        do_not_optimize(data);
+                                        return data.size();
+                                    }, result_size);
+
+                    Json result = latency_report(latencies, result_size);
+                    result["query"] = "get_data";
+                    result["overload"] = source_target ? "source_target_all_time" : "single_all_time";
+                    result["fan_out"] = fan_out;
+                    result["bins"] = bins;
+                    result["statistic"] = statistic.second;
+                    result["window"] = size.history;
+                    results.push_back(result);
+                }
+            }
+        }
+    }
+}
+
+//! Time get_entities along several relations of the entity hierarchy
+void benchmark_get_entities(
+        const Entities& entities,
+        size_t runs,
+        Json& results)
+{
+    struct Relation
+    {
+        EntityKind kind;
+        std::string origin;
+        EntityId origin_id;
+    };
+
+    const std::vector<Relation> relations = {
+        {EntityKind::HOST, "all", EntityId::all()},
+        {EntityKind::PARTICIPANT, "all", EntityId::all()},
+        {EntityKind::DATAWRITER, "all", EntityId::all()},
+        {EntityKind::DATAWRITER, "domain", entities.domain},
+        {EntityKind::DATAWRITER, "topic", entities.topic},
+        {EntityKind::DATAWRITER, "host", entities.host},
+        {EntityKind::DATAWRITER, "participant", entities.participant},
+        {EntityKind::DATAREADER, "locator", entities.locator},
+        {EntityKind::LOCATOR, "participant", entities.participant},
+        {EntityKind::LOCATOR, "domain", entities.domain},
+        {EntityKind::PARTICIPANT, "user", entities.user},
+        {EntityKind::HOST, "domain", entities.domain},
+        {EntityKind::HOST, "datawriter", entities.writers.front()},
+        {EntityKind::TOPIC, "process", entities.process},
+    };
+
+    for (const Relation& relation : relations)
+    {
+        size_t result_size = 0;
+        std::vector<double> latencies = time_query(runs, [&]()
+                        {
+                            auto ids = StatisticsBackend::get_entities(relation.kind, relation.origin_id);
+                            do_not_optimize(ids);
+                            return ids.size();
+                        }, result_size);
+
+        Json result = latency_report(latencies, result_size);
+        result["query"] = "get_entities";
+        result["kind"] = entity_kind_str[static_cast<int>(relation.kind)];
+        result["origin"] = relation.origin;
+        results.push_back(result);
+    }
+}
+
+//! Time get_info for an entity of every kind
+void benchmark_get_info(
+        const Entities& entities,
+        size_t runs,
+        Json& results)
+{
+    const std::vector<EntityId> ids = {
+        entities.host,
+        entities.user,
+        entities.process,
+        entities.domain,
+        entities.topic,
+        entities.participant,
+        entities.writers.front(),
+        entities.readers.front(),
+        entities.locator,
+    };
+
+    for (EntityId id : ids)
+    {
+        size_t result_size = 0;
+        std::vector<double> latencies = time_query(runs, [&]()
+                        {
+                            Info info = StatisticsBackend::get_info(id);
+                            do_not_optimize(info);
+                            return info.size();
+                        }, result_size);
+
+        Json result = latency_report(latencies, result_size);
+        result["query"] = "get_info";
+        result["kind"] = entity_kind_str[static_cast<int>(StatisticsBackend::get_type(id))];
+        results.push_back(result);
+    }
+}
+
+} // namespace
+
+int main(
+        int argc,
+        char** argv)
+{
+    BenchmarkOptions options = parse_options(argc, argv);
+
+    DatabaseSize size {100, 2, 10000};
+    std::vector<size_t> fan_outs = {1, 10, 1000};
+    std::vector<size_t> windows = {10, 1000, 10000};
+    size_t data_runs = 20;
+    size_t runs = 1000;
+    if (options.quick)
+    {
+        size = {4, 2, 1000};
+        fan_outs = {1, 8};
+        windows = {10, 1000};
+        data_runs = 2;
+        runs = 10;
+    }
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        std::string arg(argv[i]);
+        if (arg == "--participants")
+        {
+            size.participants = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--endpoints")
+        {
+            size.endpoints = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--history")
+        {
+            size.history = std::strtoull(argv[++i], nullptr, 10);
+        }
+    }
+    if (0 == size.participants || 0 == size.endpoints || 0 == size.history)
+    {
+        std::cerr << "The number of participants, endpoints and history samples must be positive" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // The queries of the backend use the database of its singleton
+    details::StatisticsBackendData::get_instance()->database_.reset(new Database());
+    Database& db = *details::StatisticsBackendData::get_instance()->database_;
+
+    auto populate_start = BenchmarkClock::now();
+    Entities entities = populate(db, size);
+    auto populate_end = BenchmarkClock::now();
+
+    Json results = Json::array();
+
+    Json population;
+    population["query"] = "populate";
+    population["participants"] = size.participants;
+    population["endpoints"] = size.endpoints;
+    population["history"] = size.history;
+    population["samples"] = 2 * entities.writers.size() * size.history;
+    population["elapsed_ms"] = elapsed_ns(populate_start, populate_end) * 1e-6;
+    population["rss_kb"] = resident_set_kb();
+    results.push_back(population);
+
+    benchmark_get_data(entities, size, fan_outs, windows, data_runs, results);
+    benchmark_get_entities(entities, runs, results);
+    benchmark_get_info(entities, runs, results);
+
+    return write_report("query", results, options);
+}
@@ -15,6 +15,13 @@
 #ifndef _EPROSIMA_FASTDDS_STATISTICS_BACKEND_DATABASE_DATABASE_HPP_
 #define _EPROSIMA_FASTDDS_STATISTICS_BACKEND_DATABASE_DATABASE_HPP_
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
 #include <gtest_aux.hpp>
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
@@ -24,6 +31,7 @@
 
 #include "database/entities.hpp"
 
+#include <fastdds_statistics_backend/exception/Exception.hpp>
 #include <fastdds_statistics_backend/types/EntityId.hpp>
 
 namespace eprosima {
@@ -56,6 +64,14 @@ class Database
 {
 public:
 
+    struct SampleInsertion
+    {
+        EntityId domain_id;
+        EntityId entity_id;
+        std::unique_ptr<StatisticsSample> sample;
+        std::string error;
+    };
+
     MOCK_METHOD1(insert, EntityId(
                 std::shared_ptr<Entity> entity));
 
@@ -64,6 +80,23 @@ public:
                 const EntityId& entity_id,
                 const StatisticsSample& sample));
 
+    // Rely the batched insertion on the mock of the single one
+    void insert(
+            std::vector<SampleInsertion>& samples)
+    {
+        for (auto& insertion : samples)
+        {
+            try
+            {
+                insert(insertion.domain_id, insertion.entity_id, *insertion.sample);
+            }
+            catch (const Exception& e)
+            {
+                insertion.error = e.what();
+            }
+        }
+    }
+
     MOCK_METHOD1(erase, void(
                 EntityId & domain_id));
 
@@ -95,10 +128,37 @@ public:
                 EntityKind entity_kind,
                 const std::string& guid));
 
+    // Rely this method to the mock of get_entity_by_guid with the string representation of the GUID
+    std::pair<EntityId, EntityId> get_entity_by_guid(
+            EntityKind entity_kind,
+            const fastrtps::rtps::GUID_t& guid) const
+    {
+        std::stringstream ss;
+        ss << guid;
+        return get_entity_by_guid(entity_kind, ss.str());
+    }
+
     MOCK_CONST_METHOD2(get_entities_by_name, std::vector<std::pair<EntityId, EntityId>>(
                 EntityKind entity_kind,
                 const std::string& name));
 
+    // Rely this method to the mocks of get_entities_by_name and get_entity
+    EntityId get_topic_by_name_and_type(
+            const EntityId& domain_id,
+            const std::string& name,
+            const std::string& data_type) const
+    {
+        for (const auto& topic_id : get_entities_by_name(EntityKind::TOPIC, name))
+        {
+            if (topic_id.first == domain_id &&
+                    std::static_pointer_cast<const Topic>(get_entity(topic_id.second))->data_type == data_type)
+            {
+                return topic_id.second;
+            }
+        }
+        return EntityId::invalid();
+    }
+
     MOCK_METHOD2(change_entity_status, void(
                 const EntityId& entity_id,
                 bool active));
@@ -130,6 +190,26 @@ public:
     {
     }
 
+    bool enforce_retention()
+    {
+        ++enforce_retention_calls_;
+        return true;
+    }
+
+    bool retention_enabled() const
+    {
+        return retention_enabled_;
+    }
+
+    std::chrono::milliseconds retention_period() const
+    {
+        return retention_period_;
+    }
+
+    std::atomic<uint64_t> enforce_retention_calls_{0};
+    std::atomic<bool> retention_enabled_{true};
+    std::chrono::milliseconds retention_period_{1000};
+
     int64_t next_id_{0};
 };
 
@@ -20,8 +20,10 @@
 #ifndef _FASTDDS_DDS_SUBSCRIBER_DATAREADER_HPP_
 #define _FASTDDS_DDS_SUBSCRIBER_DATAREADER_HPP_
 
+#include <algorithm>
 #include <queue>
 
+#include <fastdds/dds/core/LoanableSequence.hpp>
 #include <fastdds/dds/subscriber/SampleInfo.hpp>
 #include <fastdds/rtps/common/Guid.h>
 #include <fastrtps/types/TypesBase.h>
@@ -125,6 +127,37 @@ public:
         return ReturnCode_t::RETCODE_OK;
     }
 
+    template<typename T>
+    ReturnCode_t take(
+            LoanableSequence<T>& data_values,
+            LoanableSequence<SampleInfo>& sample_infos,
+            int32_t max_samples)
+    {
+        if (history_.empty())
+        {
+            return ReturnCode_t::RETCODE_NO_DATA;
+        }
+
+        int32_t count = std::min(max_samples, static_cast<int32_t>(history_.size()));
+        data_values.length(count);
+        sample_infos.length(count);
+        for (int32_t i = 0; i < count; ++i)
+        {
+            take_next_sample(&data_values[i], &sample_infos[i]);
+        }
+        return ReturnCode_t::RETCODE_OK;
+    }
+
+    template<typename T>
+    ReturnCode_t return_loan(
+            LoanableSequence<T>& data_values,
+            LoanableSequence<SampleInfo>& sample_infos)
+    {
+        data_values.length(0);
+        sample_infos.length(0);
+        return ReturnCode_t::RETCODE_OK;
+    }
+
     const fastrtps::rtps::GUID_t& guid()
     {
         return guid_;
@@ -12,8 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <string>
+#include <algorithm>
 #include <chrono>
+#include <iterator>
+#include <string>
 
 #include <gtest_aux.hpp>
 #include <gtest/gtest.h>
@@ -411,6 +413,395 @@ TYPED_TEST_P(DataContainer_tests, get_interval_limits)
     }
 }
 
+/**
+ * Test DataContainer::get_closed_interval_limits method
+ *
+ * CASES:
+ * - empty vector
+ * - N values vector
+ *   - empty interval
+ *   - exact value interval
+ *   - limits equal to values
+ *   - reversed interval
+ *   - all values interval
+ * - several chunks vector
+ *   - interval across chunks
+ *   - interval at the end
+ *   - interval before the first value kept
+ */
+TYPED_TEST_P(DataContainer_tests, get_closed_interval_limits)
+{
+    // empty vector
+    {
+        details::DataContainer<TypeParam> container;
+        auto res = container.get_closed_interval_limits(test::arbitrary_timestamp(0), test::arbitrary_timestamp(10));
+        ASSERT_EQ(res.first, container.end());
+        ASSERT_EQ(res.second, container.end());
+    }
+
+    // N values vector
+    {
+        details::DataContainer<TypeParam> container;
+        container.push_back(test::arbitrary_value<TypeParam>(1));
+        container.push_back(test::arbitrary_value<TypeParam>(3));
+        container.push_back(test::arbitrary_value<TypeParam>(5));
+        container.push_back(test::arbitrary_value<TypeParam>(7));
+        container.push_back(test::arbitrary_value<TypeParam>(9));
+        const auto& const_container = container;
+
+        auto element_3 = const_container.begin();
+        element_3++;
+        auto element_5 = element_3;
+        element_5++;
+        auto element_7 = element_5;
+        element_7++;
+
+        // empty interval
+        {
+            auto res = const_container.get_closed_interval_limits(
+                test::arbitrary_timestamp(10), test::arbitrary_timestamp(20));
+            ASSERT_EQ(res.first, const_container.end());
+            ASSERT_EQ(res.second, const_container.end());
+        }
+
+        // exact value interval
+        {
+            auto res = const_container.get_closed_interval_limits(
+                test::arbitrary_timestamp(3), test::arbitrary_timestamp(3));
+            ASSERT_EQ(res.first, element_3);
+            ASSERT_EQ(res.second, element_5);
+        }
+
+        // limits equal to values
+        {
+            auto res = const_container.get_closed_interval_limits(
+                test::arbitrary_timestamp(3), test::arbitrary_timestamp(5));
+            ASSERT_EQ(res.first, element_3);
+            ASSERT_EQ(res.second, element_7);
+        }
+
+        // reversed interval
+        {
+            auto res = const_container.get_closed_interval_limits(
+                test::arbitrary_timestamp(6), test::arbitrary_timestamp(2));
+            ASSERT_EQ(res.first, element_7);
+            ASSERT_EQ(res.second, element_7);
+        }
+
+        // all values interval
+        {
+            auto res = const_container.get_closed_interval_limits(
+                test::arbitrary_timestamp(1), test::arbitrary_timestamp(9));
+            ASSERT_EQ(res.first, const_container.begin());
+            ASSERT_EQ(res.second, const_container.end());
+        }
+    }
+
+    // several chunks vector
+    {
+        const unsigned int n = 3 * details::DataContainer<TypeParam>::MAX_CHUNK_CAPACITY + 5;
+
+        details::DataContainer<TypeParam> container;
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            container.push_back(test::arbitrary_value<TypeParam>(2 * i));
+        }
+        // Skip some values of the first chunk
+        container.clear(test::arbitrary_timestamp(4));
+        const auto& const_container = container;
+
+        // interval across chunks
+        {
+            auto res = const_container.get_closed_interval_limits(
+                test::arbitrary_timestamp(1000), test::arbitrary_timestamp(3000));
+            ASSERT_EQ(*res.first, test::arbitrary_value<TypeParam>(1000));
+            ASSERT_EQ(*res.second, test::arbitrary_value<TypeParam>(3002));
+            ASSERT_EQ(static_cast<unsigned int>(std::distance(res.first, res.second)), 1001u);
+        }
+
+        // interval at the end
+        {
+            auto res = const_container.get_closed_interval_limits(
+                test::arbitrary_timestamp(2 * (n - 3)), test::arbitrary_timestamp(2 * n));
+            ASSERT_EQ(*res.first, test::arbitrary_value<TypeParam>(2 * (n - 3)));
+            ASSERT_EQ(res.second, const_container.end());
+            ASSERT_EQ(static_cast<unsigned int>(std::distance(res.first, res.second)), 3u);
+        }
+
+        // interval before the first value kept
+        {
+            auto res = const_container.get_closed_interval_limits(
+                test::arbitrary_timestamp(0), test::arbitrary_timestamp(3));
+            ASSERT_EQ(res.first, const_container.begin());
+            ASSERT_EQ(res.second, const_container.begin());
+        }
+    }
+}
+
+/**
+ * Test DataContainer::for_each_block method
+ *
+ * CASES:
+ * - empty vector
+ * - interval inside a chunk
+ * - interval across chunks
+ * - empty interval
+ */
+TYPED_TEST_P(DataContainer_tests, for_each_block)
+{
+    using Block = std::pair<const TypeParam*, std::size_t>;
+
+    // empty vector
+    {
+        details::DataContainer<TypeParam> container;
+        std::vector<Block> blocks;
+        container.for_each_block(test::arbitrary_timestamp(0), test::arbitrary_timestamp(10), [&blocks](
+                    const TypeParam* first,
+                    std::size_t size)
+                {
+                    blocks.emplace_back(first, size);
+                });
+        ASSERT_TRUE(blocks.empty());
+    }
+
+    const unsigned int n = 3 * details::DataContainer<TypeParam>::MAX_CHUNK_CAPACITY + 5;
+    details::DataContainer<TypeParam> container;
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        container.push_back(test::arbitrary_value<TypeParam>(i));
+    }
+
+    // interval inside a chunk
+    {
+        std::vector<Block> blocks;
+        container.for_each_block(test::arbitrary_timestamp(2), test::arbitrary_timestamp(4), [&blocks](
+                    const TypeParam* first,
+                    std::size_t size)
+                {
+                    blocks.emplace_back(first, size);
+                });
+        ASSERT_EQ(blocks.size(), 1u);
+        ASSERT_EQ(blocks[0].second, 3u);
+        ASSERT_EQ(blocks[0].first, &container[2]);
+    }
+
+    // interval across chunks
+    {
+        std::vector<Block> blocks;
+        container.for_each_block(test::arbitrary_timestamp(1000), test::arbitrary_timestamp(3000), [&blocks](
+                    const TypeParam* first,
+                    std::size_t size)
+                {
+                    blocks.emplace_back(first, size);
+                });
+        ASSERT_GT(blocks.size(), 1u);
+
+        // The blocks hold every value of the interval in order
+        unsigned int index = 1000;
+        for (const auto& block : blocks)
+        {
+            for (std::size_t i = 0; i < block.second; ++i)
+            {
+                ASSERT_EQ(block.first[i], test::arbitrary_value<TypeParam>(index));
+                ASSERT_EQ(&block.first[i], &container[index]);
+                ++index;
+            }
+        }
+        ASSERT_EQ(index, 3001u);
+    }
+
+    // empty interval
+    {
+        std::vector<Block> blocks;
+        container.for_each_block(test::arbitrary_timestamp(2 * n), test::arbitrary_timestamp(3 * n), [&blocks](
+                    const TypeParam* first,
+                    std::size_t size)
+                {
+                    blocks.emplace_back(first, size);
+                });
+        ASSERT_TRUE(blocks.empty());
+    }
+}
+
+/**
+ * Test DataContainer::trim and DataContainer::memory_usage methods
+ *
+ * CASES:
+ * - trim an empty container
+ * - trim to a size higher than the container
+ * - trim inside the first chunk
+ * - trim across several chunks, keeping the rollups
+ * - trim to 0
+ */
+TYPED_TEST_P(DataContainer_tests, trim)
+{
+    details::DataContainer<TypeParam> container;
+
+    // trim an empty container
+    container.trim(10);
+    ASSERT_TRUE(container.empty());
+    std::size_t empty_usage = container.memory_usage();
+
+    for (unsigned int i = 0; i < 5000; ++i)
+    {
+        container.push_back(test::arbitrary_value<TypeParam>(i));
+    }
+    container.enable_rollups({std::chrono::seconds(10)});
+    std::size_t full_usage = container.memory_usage();
+    ASSERT_GT(full_usage, empty_usage);
+
+    // trim to a size higher than the container
+    container.trim(6000);
+    ASSERT_EQ(container.size(), 5000u);
+
+    // trim inside the first chunk
+    container.trim(4997);
+    ASSERT_EQ(container.size(), 4997u);
+    ASSERT_EQ(container.front(), test::arbitrary_value<TypeParam>(3));
+
+    // trim across several chunks, keeping the rollups
+    container.trim(1234);
+    ASSERT_EQ(container.size(), 1234u);
+    ASSERT_EQ(container.front(), test::arbitrary_value<TypeParam>(3766));
+    ASSERT_EQ(container.back(), test::arbitrary_value<TypeParam>(4999));
+    ASSERT_EQ(container[0], test::arbitrary_value<TypeParam>(3766));
+    ASSERT_LT(container.memory_usage(), full_usage);
+
+    details::DataContainer<TypeParam> expected;
+    for (unsigned int i = 3766; i < 5000; ++i)
+    {
+        expected.push_back(test::arbitrary_value<TypeParam>(i));
+    }
+    ASSERT_EQ(container, expected);
+    expected.enable_rollups({std::chrono::seconds(10)});
+    const auto& buckets = container.rollups()->tiers()[0].buckets();
+    const auto& expected_buckets = expected.rollups()->tiers()[0].buckets();
+    ASSERT_EQ(buckets.size(), expected_buckets.size());
+    for (std::size_t i = 0; i < buckets.size(); ++i)
+    {
+        ASSERT_EQ(buckets[i].start, expected_buckets[i].start);
+        ASSERT_EQ(buckets[i].summary.count, expected_buckets[i].summary.count);
+        ASSERT_EQ(buckets[i].summary.sum, expected_buckets[i].summary.sum);
+        ASSERT_EQ(buckets[i].summary.min, expected_buckets[i].summary.min);
+    }
+
+    // trim to 0
+    container.trim(0);
+    ASSERT_TRUE(container.empty());
+    ASSERT_TRUE(container.rollups()->tiers()[0].buckets().empty());
+}
+
+/**
+ * Test DataContainer rollups
+ *
+ * CASES:
+ * - disabled by default
+ * - enabled on a container with values
+ * - updated when adding values
+ * - clear with a time inside a bucket
+ * - coarsest tier for a bin duration
+ * - copy
+ * - clear everything
+ * - disable
+ */
+TYPED_TEST_P(DataContainer_tests, rollups)
+{
+    // Check a bucket against the summary of the values in [first, last]
+    auto check_bucket = [](
+        const details::RollupTier::Bucket& bucket,
+        unsigned int first,
+        unsigned int last)
+            {
+                double sum = 0;
+                double sum_sq = 0;
+                for (unsigned int i = first; i <= last; ++i)
+                {
+                    sum += i;
+                    sum_sq += static_cast<double>(i) * i;
+                }
+                ASSERT_EQ(bucket.summary.count, last - first + 1);
+                ASSERT_EQ(bucket.summary.sum, sum);
+                ASSERT_EQ(bucket.summary.sum_sq, sum_sq);
+                ASSERT_EQ(bucket.summary.min, first);
+                ASSERT_EQ(bucket.summary.max, last);
+            };
+
+    details::DataContainer<TypeParam> container;
+    for (unsigned int i = 0; i < 100; ++i)
+    {
+        container.push_back(test::arbitrary_value<TypeParam>(i));
+    }
+
+    // disabled by default
+    ASSERT_EQ(container.rollups(), nullptr);
+
+    // enabled on a container with values
+    container.enable_rollups({std::chrono::seconds(10), std::chrono::seconds(1), std::chrono::minutes(1)});
+    ASSERT_NE(container.rollups(), nullptr);
+    const auto& tiers = container.rollups()->tiers();
+    ASSERT_EQ(tiers.size(), 3u);
+    ASSERT_EQ(tiers[0].resolution(), std::chrono::seconds(1));
+    ASSERT_EQ(tiers[1].resolution(), std::chrono::seconds(10));
+    ASSERT_EQ(tiers[2].resolution(), std::chrono::minutes(1));
+    ASSERT_EQ(tiers[0].buckets().size(), 100u);
+    ASSERT_EQ(tiers[1].buckets().size(), 10u);
+    for (unsigned int i = 0; i < 10; ++i)
+    {
+        ASSERT_EQ(tiers[1].buckets()[i].start, test::arbitrary_timestamp(10 * i));
+        check_bucket(tiers[1].buckets()[i], 10 * i, 10 * i + 9);
+    }
+
+    // updated when adding values
+    for (unsigned int i = 100; i < 150; ++i)
+    {
+        container.push_back(test::arbitrary_value<TypeParam>(i));
+    }
+    ASSERT_EQ(tiers[2].buckets().size(), 3u);
+    check_bucket(tiers[2].buckets()[0], 0, 59);
+    check_bucket(tiers[2].buckets()[1], 60, 119);
+    check_bucket(tiers[2].buckets()[2], 120, 149);
+
+    // clear with a time inside a bucket: the bucket only keeps the values not removed
+    container.clear(test::arbitrary_timestamp(65));
+    ASSERT_EQ(container.size(), 85u);
+    ASSERT_EQ(tiers[0].buckets().size(), 85u);
+    ASSERT_EQ(tiers[1].buckets().size(), 9u);
+    ASSERT_EQ(tiers[1].buckets()[0].start, test::arbitrary_timestamp(60));
+    check_bucket(tiers[1].buckets()[0], 65, 69);
+    check_bucket(tiers[1].buckets()[1], 70, 79);
+    ASSERT_EQ(tiers[2].buckets().size(), 2u);
+    ASSERT_EQ(tiers[2].buckets()[0].start, test::arbitrary_timestamp(60));
+    check_bucket(tiers[2].buckets()[0], 65, 119);
+    check_bucket(tiers[2].buckets()[1], 120, 149);
+
+    // coarsest tier for a bin duration
+    ASSERT_EQ(container.rollups()->tier_for(std::chrono::seconds(7)), &tiers[0]);
+    ASSERT_EQ(container.rollups()->tier_for(std::chrono::seconds(20)), &tiers[1]);
+    ASSERT_EQ(container.rollups()->tier_for(std::chrono::minutes(2)), &tiers[2]);
+    ASSERT_EQ(container.rollups()->tier_for(std::chrono::milliseconds(1500)), nullptr);
+
+    // copy
+    {
+        details::DataContainer<TypeParam> copy(container);
+        ASSERT_NE(copy.rollups(), nullptr);
+        ASSERT_EQ(copy.rollups()->tiers().size(), 3u);
+        ASSERT_EQ(copy.rollups()->tiers()[1].buckets().size(), 9u);
+        check_bucket(copy.rollups()->tiers()[1].buckets()[0], 65, 69);
+    }
+
+    // clear everything
+    container.clear();
+    ASSERT_NE(container.rollups(), nullptr);
+    for (const auto& tier : tiers)
+    {
+        ASSERT_TRUE(tier.buckets().empty());
+    }
+
+    // disable
+    container.enable_rollups({});
+    ASSERT_EQ(container.rollups(), nullptr);
+}
+
 /**
  * Test DataContainer::get_interval_limits method
  *
@@ -486,13 +877,196 @@ TYPED_TEST_P(DataContainer_tests, find_by_timestamp_)
     }
 }
 
+/**
+ * Test DataContainer methods with data spread over several internal chunks
+ *
+ * CASES:
+ * - access operator and iteration
+ * - get_interval_limits
+ * - get_interval_limits across the boundary of two chunks
+ * - clear with time in the middle of a chunk
+ * - clear with time in the last value of a chunk
+ * - clear with time in the first value of a chunk
+ * - copy
+ * - add after clear
+ */
+TYPED_TEST_P(DataContainer_tests, chunks)
+{
+    // Enough values to fill several chunks
+    const unsigned int n = 3 * details::DataContainer<TypeParam>::MAX_CHUNK_CAPACITY + 5;
+
+    details::DataContainer<TypeParam> container;
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        container.push_back(test::arbitrary_value<TypeParam>(2 * i));
+    }
+    ASSERT_EQ(container.size(), n);
+
+    // Index of the first value of the second chunk of maximum capacity, as the capacity of the chunks doubles
+    // from the minimum one
+    unsigned int boundary = 0;
+    for (std::size_t capacity = details::DataContainer<TypeParam>::MIN_CHUNK_CAPACITY;
+            capacity < details::DataContainer<TypeParam>::MAX_CHUNK_CAPACITY; capacity *= 2)
+    {
+        boundary += static_cast<unsigned int>(capacity);
+    }
+    boundary += details::DataContainer<TypeParam>::MAX_CHUNK_CAPACITY;
+    ASSERT_LT(boundary, n);
+
+    // access operator and iteration
+    {
+        unsigned int index = 0;
+        for (const auto& value : container)
+        {
+            ASSERT_EQ(value, test::arbitrary_value<TypeParam>(2 * index));
+            ASSERT_EQ(container[index], value);
+            ++index;
+        }
+        ASSERT_EQ(index, n);
+        ASSERT_EQ(container.back(), test::arbitrary_value<TypeParam>(2 * (n - 1)));
+        ASSERT_EQ(*(--container.end()), test::arbitrary_value<TypeParam>(2 * (n - 1)));
+    }
+
+    // get_interval_limits
+    {
+        auto res = container.get_interval_limits(test::arbitrary_timestamp(1001), test::arbitrary_timestamp(3000));
+        ASSERT_EQ(*res.first, test::arbitrary_value<TypeParam>(1002));
+        ASSERT_EQ(*res.second, test::arbitrary_value<TypeParam>(3000));
+        ASSERT_EQ(static_cast<unsigned int>(std::distance(res.first, res.second)), 999u);
+    }
+
+    // get_interval_limits across the boundary of two chunks
+    {
+        auto res = container.get_interval_limits(test::arbitrary_timestamp(2 * (boundary - 1)),
+                        test::arbitrary_timestamp(2 * boundary));
+        ASSERT_EQ(*res.first, test::arbitrary_value<TypeParam>(2 * (boundary - 1)));
+        ASSERT_EQ(*res.second, test::arbitrary_value<TypeParam>(2 * boundary));
+        ASSERT_EQ(std::distance(res.first, res.second), 1);
+    }
+
+    // clear with time in the middle of a chunk
+    {
+        container.clear(test::arbitrary_timestamp(11));
+        ASSERT_EQ(container.size(), n - 6);
+        ASSERT_EQ(container[0], test::arbitrary_value<TypeParam>(12));
+        ASSERT_EQ(*container.begin(), test::arbitrary_value<TypeParam>(12));
+    }
+
+    // clear with time in the last value of a chunk
+    {
+        container.clear(test::arbitrary_timestamp(2 * (boundary - 1)));
+        ASSERT_EQ(container.size(), n - (boundary - 1));
+        ASSERT_EQ(container[0], test::arbitrary_value<TypeParam>(2 * (boundary - 1)));
+        ASSERT_EQ(container[1], test::arbitrary_value<TypeParam>(2 * boundary));
+        ASSERT_EQ(*container.begin(), test::arbitrary_value<TypeParam>(2 * (boundary - 1)));
+        ASSERT_EQ(*(++container.begin()), test::arbitrary_value<TypeParam>(2 * boundary));
+    }
+
+    // clear with time in the first value of a chunk
+    {
+        container.clear(test::arbitrary_timestamp(2 * boundary));
+        ASSERT_EQ(container.size(), n - boundary);
+        ASSERT_EQ(container[0], test::arbitrary_value<TypeParam>(2 * boundary));
+        ASSERT_EQ(*container.begin(), test::arbitrary_value<TypeParam>(2 * boundary));
+        ASSERT_EQ(container[n - boundary - 1], test::arbitrary_value<TypeParam>(2 * (n - 1)));
+        ASSERT_THROW(container[n - boundary], std::out_of_range);
+    }
+
+    // copy
+    {
+        const auto const_container = container;
+        ASSERT_EQ(const_container.size(), container.size());
+        ASSERT_TRUE(std::equal(container.begin(), container.end(), const_container.begin()));
+    }
+
+    // add after clear
+    {
+        container.clear(test::arbitrary_timestamp(2 * n));
+        ASSERT_TRUE(container.empty());
+        container.push_back(test::arbitrary_value<TypeParam>(2 * n));
+        ASSERT_EQ(container.size(), 1u);
+        ASSERT_EQ(container[0], test::arbitrary_value<TypeParam>(2 * n));
+    }
+}
+
+/**
+ * Test DataContainer inserted_after
+ *
+ * CASES:
+ * - empty container
+ * - elements inserted in several epochs
+ * - epoch without elements
+ * - trim and clear the elements of the first epochs
+ * - element given an older epoch
+ * - copy
+ * - clear everything
+ */
+TYPED_TEST_P(DataContainer_tests, inserted_after)
+{
+    details::DataContainer<TypeParam> container;
+    ASSERT_EQ(container.inserted_after(0), container.end());
+
+    // Elements over several chunks in the first epoch, and a few in each of the next ones
+    const unsigned int n = details::DataContainer<TypeParam>::MAX_CHUNK_CAPACITY + 5;
+    uint64_t first_epoch = 1;
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        container.push_back(test::arbitrary_value<TypeParam>(i), first_epoch);
+    }
+    uint64_t second_epoch = first_epoch + 1;
+    container.push_back(test::arbitrary_value<TypeParam>(n), second_epoch);
+    container.push_back(test::arbitrary_value<TypeParam>(n + 1), second_epoch);
+    uint64_t empty_epoch = second_epoch + 1;
+    uint64_t last_epoch = empty_epoch + 1;
+    container.push_back(test::arbitrary_value<TypeParam>(n + 2), last_epoch);
+
+    ASSERT_EQ(container.inserted_after(first_epoch - 1), container.begin());
+    ASSERT_EQ(*container.inserted_after(first_epoch), test::arbitrary_value<TypeParam>(n));
+    ASSERT_EQ(*container.inserted_after(second_epoch), test::arbitrary_value<TypeParam>(n + 2));
+    ASSERT_EQ(*container.inserted_after(empty_epoch), test::arbitrary_value<TypeParam>(n + 2));
+    ASSERT_EQ(container.inserted_after(last_epoch), container.end());
+
+    // Remove every element of the first epoch, and one of the second
+    container.trim(3);
+    ASSERT_EQ(container.inserted_after(first_epoch - 1), container.begin());
+    ASSERT_EQ(container.inserted_after(first_epoch), container.begin());
+    ASSERT_EQ(*container.inserted_after(second_epoch), test::arbitrary_value<TypeParam>(n + 2));
+    container.clear(test::arbitrary_timestamp(n + 1));
+    ASSERT_EQ(container.inserted_after(first_epoch), container.begin());
+    ASSERT_EQ(*container.inserted_after(second_epoch), test::arbitrary_value<TypeParam>(n + 2));
+    ASSERT_EQ(container.inserted_after(last_epoch), container.end());
+
+    // An element given an older epoch belongs to the last one
+    container.push_back(test::arbitrary_value<TypeParam>(n + 3), first_epoch);
+    ASSERT_EQ(*container.inserted_after(second_epoch), test::arbitrary_value<TypeParam>(n + 2));
+    ASSERT_EQ(container.inserted_after(last_epoch), container.end());
+
+    // The copy keeps the epochs of the elements
+    details::DataContainer<TypeParam> copy(container);
+    ASSERT_EQ(*copy.inserted_after(second_epoch), test::arbitrary_value<TypeParam>(n + 2));
+    ASSERT_EQ(copy.inserted_after(last_epoch), copy.end());
+
+    // The elements added after clearing the container are found again
+    container.clear();
+    ASSERT_EQ(container.inserted_after(0), container.end());
+    container.push_back(test::arbitrary_value<TypeParam>(n + 4), first_epoch);
+    ASSERT_EQ(container.inserted_after(first_epoch - 1), container.begin());
+    ASSERT_EQ(container.inserted_after(first_epoch), container.end());
+}
+
 REGISTER_TYPED_TEST_SUITE_P(
     DataContainer_tests,
     trivial,
     clear,
     access_operator,
     get_interval_limits,
-    find_by_timestamp_
+    get_closed_interval_limits,
+    for_each_block,
+    trim,
+    rollups,
+    find_by_timestamp_,
+    chunks,
+    inserted_after
     );
 
 // Set types used in parametrization
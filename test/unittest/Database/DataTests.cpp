@@ -137,6 +137,70 @@ TEST(database, datawriter_data_clear)
     ASSERT_TRUE(data.sample_datas.empty());
 }
 
+TEST(database, datawriter_data_enforce_retention)
+{
+    /* Add 100 samples, one per second, to every series of a DataWriterData */
+    DataWriterData data;
+    Timestamp now = std::chrono::system_clock::now();
+    for (unsigned int i = 0; i < 100; ++i)
+    {
+        EntityDataSample data_sample;
+        data_sample.src_ts = now - std::chrono::seconds(99 - i);
+        data_sample.data = i;
+        EntityCountSample count_sample;
+        count_sample.src_ts = data_sample.src_ts;
+        count_sample.count = i;
+
+        data.publication_throughput.push_back(data_sample);
+        data.resent_datas.push_back(count_sample);
+        data.heartbeat_count.push_back(count_sample);
+        data.gap_count.push_back(count_sample);
+        data.data_count.push_back(count_sample);
+        data.sample_datas[i].push_back(count_sample);
+        data.history2history_latency[EntityId(1)].push_back(data_sample);
+        data.history2history_latency[EntityId(2)].push_back(data_sample);
+    }
+    data.last_reported_data_count.count = 12;
+    std::size_t full_usage = data.memory_usage();
+
+    /* A policy without limits keeps everything */
+    data.enforce_retention(RetentionPolicy(), now, 0.0);
+    ASSERT_EQ(data.publication_throughput.size(), 100u);
+    ASSERT_EQ(data.sample_datas.size(), 100u);
+    ASSERT_EQ(data.memory_usage(), full_usage);
+
+    /* Limit the age of the throughput and the sample datas, and the samples of every series */
+    RetentionPolicy policy;
+    policy.max_age[DataKind::PUBLICATION_THROUGHPUT] = std::chrono::seconds(30);
+    policy.max_age[DataKind::SAMPLE_DATAS] = std::chrono::seconds(20);
+    policy.max_samples_per_series = 50;
+    data.enforce_retention(policy, now, 0.0);
+    ASSERT_EQ(data.publication_throughput.size(), 31u);
+    ASSERT_EQ(data.publication_throughput.front().data, 69.0);
+    ASSERT_EQ(data.resent_datas.size(), 50u);
+    ASSERT_EQ(data.resent_datas.front().count, 50u);
+    ASSERT_EQ(data.heartbeat_count.size(), 50u);
+    ASSERT_EQ(data.gap_count.size(), 50u);
+    ASSERT_EQ(data.data_count.size(), 50u);
+    ASSERT_EQ(data.sample_datas.size(), 21u);
+    ASSERT_EQ(data.sample_datas.begin()->first, 79u);
+    ASSERT_EQ(data.history2history_latency.size(), 2u);
+    ASSERT_EQ(data.history2history_latency[EntityId(1)].size(), 50u);
+    ASSERT_EQ(data.history2history_latency[EntityId(2)].size(), 50u);
+    ASSERT_LT(data.memory_usage(), full_usage);
+
+    /* Remove a proportion of every series */
+    data.enforce_retention(RetentionPolicy(), now, 0.5);
+    ASSERT_EQ(data.publication_throughput.size(), 16u);
+    ASSERT_EQ(data.publication_throughput.back().data, 99.0);
+    ASSERT_EQ(data.resent_datas.size(), 25u);
+    ASSERT_EQ(data.sample_datas.size(), 11u);
+    ASSERT_EQ(data.history2history_latency[EntityId(1)].size(), 25u);
+
+    /* The last reported data is kept */
+    ASSERT_EQ(data.last_reported_data_count.count, 12u);
+}
+
 int main(
         int argc,
         char** argv)
@@ -15,7 +15,9 @@
 #include <chrono>
 #include <fstream>
 #include <memory>
+#include <sstream>
 #include <string>
+#include <vector>
 
 #include <gtest_aux.hpp>
 #include <gtest/gtest.h>
@@ -606,6 +608,43 @@ TEST(database, dump_and_clear_database)
     }
 }
 
+// Test that the dump written to a stream is the same as the dump of the database
+TEST(database, stream_dump_database)
+{
+    struct Scenario
+    {
+        int n_entity;
+        int n_data;
+        bool link_process_participant;
+    };
+
+    for (const Scenario& scenario : std::vector<Scenario>{{0, 0, true}, {1, 0, true}, {1, 1, true}, {1, 1, false},
+                                                          {3, 3, true}})
+    {
+        Database db;
+        initialize_database(db, scenario.n_entity, scenario.n_data, scenario.link_process_participant);
+
+        std::stringstream stream;
+        db.dump_database(stream);
+        ASSERT_EQ(DatabaseDump::parse(stream.str()), db.dump_database());
+    }
+}
+
+// Test the dump of a database to a stream with a clear of the statistics data
+TEST(database, stream_dump_and_clear_database)
+{
+    Database db;
+    initialize_database(db, 1, 1);
+    Database expected_db;
+    initialize_database(expected_db, 1, 1);
+
+    // The dump holds the statistics data, which is then removed
+    std::stringstream stream;
+    db.dump_database(stream, true);
+    ASSERT_EQ(DatabaseDump::parse(stream.str()), expected_db.dump_database(true));
+    ASSERT_EQ(db.dump_database(), expected_db.dump_database());
+}
+
 // Test the database method id_to_string()
 TEST(database, id_to_string)
 {
@@ -81,6 +81,33 @@ void check_erased_database(
         auto locators_by_participant = db.locators_by_participant();
         EXPECT_EQ(locators_by_participant.find(participant_id), locators_by_participant.end());
     }
+
+    // The erased entities cannot be retrieved by their ID nor by their name anymore
+    EXPECT_FALSE(db.is_entity_present(domain_id));
+    for (auto participant : participants)
+    {
+        EXPECT_FALSE(db.is_entity_present(participant->id));
+        for (auto match : db.get_entities_by_name(EntityKind::PARTICIPANT, participant->name))
+        {
+            EXPECT_NE(match.second, participant->id);
+        }
+    }
+    for (auto reader : readers)
+    {
+        EXPECT_FALSE(db.is_entity_present(reader->id));
+        for (auto match : db.get_entities_by_name(EntityKind::DATAREADER, reader->name))
+        {
+            EXPECT_NE(match.second, reader->id);
+        }
+    }
+    for (auto writer : writers)
+    {
+        EXPECT_FALSE(db.is_entity_present(writer->id));
+        for (auto match : db.get_entities_by_name(EntityKind::DATAWRITER, writer->name))
+        {
+            EXPECT_NE(match.second, writer->id);
+        }
+    }
 }
 
 void erase_and_check(
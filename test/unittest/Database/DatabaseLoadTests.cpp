@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <sstream>
+#include <string>
+
 #include <gtest_aux.hpp>
 #include <gtest/gtest.h>
 
@@ -20,6 +23,7 @@
 #include <types/types.hpp>
 
 #include <database/database.hpp>
+#include <database/snapshot.hpp>
 #include <DatabaseUtils.hpp>
 
 using namespace eprosima::statistics_backend;
@@ -136,6 +140,108 @@ TEST(database_load_tests, load_and_dump_complex_erased_database)
     ASSERT_EQ(dump, loadedDump);
 }
 
+/**
+ * Auxiliar function for the stream_load_and_dump tests.
+ * This function:
+ * 1. Read a .json file, and load a database reading the file as a stream, with its containers sorted by name
+ * 2. Load another database reading as a stream the dump written by the first one, with its containers in load order
+ * 3. Compare that the .json dump and the dumps of both databases are the same
+ */
+void stream_load_and_dump(
+        std::string filename)
+{
+    // Read JSON
+    DatabaseDump dump;
+    load_file(filename, dump);
+
+    // Load the dump as written by nlohmann::json
+    Database db;
+    std::stringstream sorted_dump(dump.dump());
+    db.load_database(sorted_dump);
+    ASSERT_EQ(dump, db.dump_database());
+
+    // Load the dump written as the database is visited
+    std::stringstream streamed_dump;
+    db.dump_database(streamed_dump);
+    Database streamed_db;
+    streamed_db.load_database(streamed_dump);
+    ASSERT_EQ(dump, streamed_db.dump_database());
+}
+
+// Test the streamed load of a dump database without any entity
+TEST(database_load_tests, stream_load_and_dump_empty_database)
+{
+    stream_load_and_dump(EMPTY_DUMP_FILE);
+}
+
+// Test the streamed load of a dump database with one entity of each kind
+TEST(database_load_tests, stream_load_and_dump_empty_entities_database)
+{
+    stream_load_and_dump(EMPTY_ENTITIES_DUMP_FILE);
+}
+
+// Test the streamed load of a dump database with one entity of each kind and one data of each kind
+TEST(database_load_tests, stream_load_and_dump_simple_database)
+{
+    stream_load_and_dump(SIMPLE_DUMP_FILE);
+}
+
+// Test the streamed load of a dump database with three entities of each kind and three datas of each kind
+TEST(database_load_tests, stream_load_and_dump_complex_database)
+{
+    stream_load_and_dump(COMPLEX_DUMP_FILE);
+}
+
+// Test the streamed load of an incomplete database because some domain has been erased
+TEST(database_load_tests, stream_load_and_dump_complex_erased_database)
+{
+    stream_load_and_dump(COMPLEX_ERASED_DOMAIN_1_DUMP_FILE);
+}
+
+// Test the streamed load of dumps that are not valid database dumps
+TEST(database_load_tests, stream_load_wrong_dump)
+{
+    // Read JSON
+    DatabaseDump dump;
+    load_file(SIMPLE_DUMP_FILE, dump);
+
+    // Load in a database with entities
+    {
+        Database db;
+        db.load_database(dump);
+        std::stringstream stream(dump.dump());
+        ASSERT_THROW(db.load_database(stream), PreconditionNotMet);
+    }
+
+    // Not a JSON object
+    for (std::string text : {"[]", "\"dump\"", "{\"hosts\": {\"1\": []}}", "{\"hosts\": {\"1\": 1}}"})
+    {
+        std::stringstream stream(text);
+        Database db;
+        ASSERT_THROW(db.load_database(stream), CorruptedFile) << text;
+    }
+
+    // Missing containers
+    for (auto it = dump.begin(); it != dump.end(); ++it)
+    {
+        if (it.key() == VERSION_TAG)
+        {
+            continue;
+        }
+        DatabaseDump dump_copy = dump;
+        dump_copy.erase(it.key());
+        std::stringstream stream(dump_copy.dump());
+        Database db;
+        ASSERT_THROW(db.load_database(stream), CorruptedFile) << it.key();
+    }
+
+    // Truncated JSON
+    std::string text = dump.dump();
+    std::stringstream stream(text.substr(0, text.size() / 2));
+    Database db;
+    ASSERT_ANY_THROW(db.load_database(stream));
+}
+
 // Test the load of a dump database with one entity of each kind
 TEST(database_load_tests, load_twice)
 {
@@ -1090,11 +1196,29 @@ TEST(database_load_tests, load_wrong_values)
             [DATA_KIND_NACKFRAG_COUNT_LAST_REPORTED_TAG][DATA_VALUE_COUNT_TAG]);
 }
 
+// Load the 'dump' in 'db', directly or reading its JSON text from a stream
+void load_dump(
+        Database& db,
+        DatabaseDump const& dump,
+        bool streamed)
+{
+    if (streamed)
+    {
+        std::stringstream stream(dump.dump());
+        db.load_database(stream);
+    }
+    else
+    {
+        db.load_database(dump);
+    }
+}
+
 void check_reference(
         DatabaseDump const&  dump,
         const char* entity_container_tag,
         const char* reference_container_tag,
-        const char* entity_tag)
+        const char* entity_tag,
+        bool streamed = false)
 {
     // Entity -> Reference
     {
@@ -1105,7 +1229,7 @@ void check_reference(
             dump_copy[entity_container_tag].begin().value()[reference_container_tag] = DatabaseDump::array({"1111"});
 
             Database db;
-            ASSERT_THROW(db.load_database(dump_copy), CorruptedFile);
+            ASSERT_THROW(load_dump(db, dump_copy, streamed), CorruptedFile);
         }
 
         // Entity references Reference which does not reference Entity
@@ -1115,7 +1239,7 @@ void check_reference(
             dump_copy[reference_container_tag].begin().value()[entity_tag] = "1111";
 
             Database db;
-            ASSERT_THROW(db.load_database(dump_copy), CorruptedFile);
+            ASSERT_THROW(load_dump(db, dump_copy, streamed), CorruptedFile);
         }
     }
 
@@ -1127,14 +1251,14 @@ void check_reference(
         dump_copy[entity_container_tag].begin().value()[reference_container_tag] = DatabaseDump::array();
         {
             Database db;
-            ASSERT_THROW(db.load_database(dump_copy), CorruptedFile);
+            ASSERT_THROW(load_dump(db, dump_copy, streamed), CorruptedFile);
         }
 
         // Reference references a Entity that does not exist
         dump_copy[reference_container_tag].begin().value()[entity_tag] = "1111";
         {
             Database db;
-            ASSERT_THROW(db.load_database(dump_copy), CorruptedFile);
+            ASSERT_THROW(load_dump(db, dump_copy, streamed), CorruptedFile);
         }
     }
 }
@@ -1142,7 +1266,8 @@ void check_reference(
 void check_multiple_reference(
         DatabaseDump const&  dump,
         const char* entity_container_tag,
-        const char* reference_container_tag)
+        const char* reference_container_tag,
+        bool streamed = false)
 {
     // Entity -> Reference
     {
@@ -1153,7 +1278,7 @@ void check_multiple_reference(
             dump_copy[entity_container_tag].begin().value()[reference_container_tag] = DatabaseDump::array({"1111"});
 
             Database db;
-            ASSERT_THROW(db.load_database(dump_copy), CorruptedFile);
+            ASSERT_THROW(load_dump(db, dump_copy, streamed), CorruptedFile);
         }
 
         // Entity references Reference which does not reference Entity
@@ -1163,7 +1288,7 @@ void check_multiple_reference(
             dump_copy[reference_container_tag].begin().value()[entity_container_tag] = DatabaseDump::array({"1111"});
 
             Database db;
-            ASSERT_THROW(db.load_database(dump_copy), CorruptedFile);
+            ASSERT_THROW(load_dump(db, dump_copy, streamed), CorruptedFile);
         }
     }
 
@@ -1175,14 +1300,14 @@ void check_multiple_reference(
         dump_copy[entity_container_tag].begin().value()[reference_container_tag] = DatabaseDump::array();
         {
             Database db;
-            ASSERT_THROW(db.load_database(dump_copy), CorruptedFile);
+            ASSERT_THROW(load_dump(db, dump_copy, streamed), CorruptedFile);
         }
 
         // Reference references a Entity that does not exist
         dump_copy[reference_container_tag].begin().value()[entity_container_tag] = DatabaseDump::array({"1111"});
         {
             Database db;
-            ASSERT_THROW(db.load_database(dump_copy), CorruptedFile);
+            ASSERT_THROW(load_dump(db, dump_copy, streamed), CorruptedFile);
         }
     }
 }
@@ -1222,6 +1347,518 @@ TEST(database_load_tests, load_wrong_references)
     check_multiple_reference(dump, DATAREADER_CONTAINER_TAG, LOCATOR_CONTAINER_TAG);
 }
 
+// Test the load of a streamed database with wrong references
+TEST(database_load_tests, stream_load_wrong_references)
+{
+    // Read JSON
+    DatabaseDump dump;
+    load_file(SIMPLE_DUMP_FILE, dump);
+
+    // HOST <---> USER
+    check_reference(dump, HOST_CONTAINER_TAG, USER_CONTAINER_TAG, HOST_ENTITY_TAG, true);
+    // USER <---> PROCESS
+    check_reference(dump, USER_CONTAINER_TAG, PROCESS_CONTAINER_TAG, USER_ENTITY_TAG, true);
+    // PROCESS <---> PARTICIPANT
+    check_reference(dump, PROCESS_CONTAINER_TAG, PARTICIPANT_CONTAINER_TAG, PROCESS_ENTITY_TAG, true);
+    // DOMAIN <---> PARTICIPANT
+    check_reference(dump, DOMAIN_CONTAINER_TAG, PARTICIPANT_CONTAINER_TAG, DOMAIN_ENTITY_TAG, true);
+    // DOMAIN <---> TOPIC
+    check_reference(dump, DOMAIN_CONTAINER_TAG, TOPIC_CONTAINER_TAG, DOMAIN_ENTITY_TAG, true);
+    // TOPIC <---> DATAWRITER
+    check_reference(dump, TOPIC_CONTAINER_TAG, DATAWRITER_CONTAINER_TAG, TOPIC_ENTITY_TAG, true);
+    // TOPIC <---> DATAREADDER
+    check_reference(dump, TOPIC_CONTAINER_TAG, DATAREADER_CONTAINER_TAG, TOPIC_ENTITY_TAG, true);
+    // PARTICIPANT <---> DATAWRITER
+    check_reference(dump, PARTICIPANT_CONTAINER_TAG, DATAWRITER_CONTAINER_TAG, PARTICIPANT_ENTITY_TAG, true);
+    // PARTICIPANT <---> DATAREADDER
+    check_reference(dump, PARTICIPANT_CONTAINER_TAG, DATAREADER_CONTAINER_TAG, PARTICIPANT_ENTITY_TAG, true);
+    // LOCATOR <---> DATAWRITER
+    check_multiple_reference(dump, LOCATOR_CONTAINER_TAG, DATAWRITER_CONTAINER_TAG, true);
+    // LOCATOR <---> DATAREADDER
+    check_multiple_reference(dump, LOCATOR_CONTAINER_TAG, DATAREADER_CONTAINER_TAG, true);
+    // DATAWRITER <---> LOCATOR
+    check_multiple_reference(dump, DATAWRITER_CONTAINER_TAG, LOCATOR_CONTAINER_TAG, true);
+    // DATAREADDER <---> LOCATOR
+    check_multiple_reference(dump, DATAREADER_CONTAINER_TAG, LOCATOR_CONTAINER_TAG, true);
+}
+
+/**
+ * Auxiliar function for the snapshot tests.
+ * This function:
+ * 1. Read a .json file, and load it in a database
+ * 2. Write a binary snapshot of the database
+ * 3. Load a new database with the snapshot
+ * 4. Compare that the .json dump and the dump of the database loaded from the snapshot is the same
+ */
+void snapshot_and_load(
+        std::string filename)
+{
+    // Read JSON
+    DatabaseDump dump;
+    load_file(filename, dump);
+
+    // Create database
+    Database db;
+    db.load_database(dump);
+
+    // Write the snapshot
+    std::stringstream snapshot;
+    db.dump_snapshot(snapshot);
+    ASSERT_TRUE(SnapshotReader::is_snapshot(snapshot));
+
+    // Load the snapshot in a new database
+    Database loaded_db;
+    loaded_db.load_snapshot(snapshot);
+
+    // Compare two dumps
+    ASSERT_EQ(dump, loaded_db.dump_database());
+}
+
+// Test the snapshot of a database without any entity
+TEST(database_load_tests, snapshot_and_load_empty_database)
+{
+    snapshot_and_load(EMPTY_DUMP_FILE);
+}
+
+// Test the snapshot of a database with one entity of each kind
+TEST(database_load_tests, snapshot_and_load_empty_entities_database)
+{
+    snapshot_and_load(EMPTY_ENTITIES_DUMP_FILE);
+}
+
+// Test the snapshot of a database with one entity of each kind and one data of each kind
+TEST(database_load_tests, snapshot_and_load_simple_database)
+{
+    snapshot_and_load(SIMPLE_DUMP_FILE);
+}
+
+// Test the snapshot of a database with three entities of each kind and three datas of each kind
+TEST(database_load_tests, snapshot_and_load_complex_database)
+{
+    snapshot_and_load(COMPLEX_DUMP_FILE);
+}
+
+// Test the snapshot of a database some of whose entities have been erased
+TEST(database_load_tests, snapshot_and_load_complex_erased_database)
+{
+    snapshot_and_load(COMPLEX_ERASED_DOMAIN_1_DUMP_FILE);
+}
+
+// Test that a snapshot can only be loaded in an empty database, and that the data is cleared if requested
+TEST(database_load_tests, snapshot_twice)
+{
+    // Read JSON
+    DatabaseDump dump;
+    load_file(SIMPLE_DUMP_FILE, dump);
+
+    Database db;
+    db.load_database(dump);
+
+    // Write the snapshot, clearing the data of the database
+    std::stringstream snapshot;
+    db.dump_snapshot(snapshot, true);
+
+    // The database has been cleared, but not the snapshot
+    ASSERT_NE(dump, db.dump_database());
+    Database loaded_db;
+    loaded_db.load_snapshot(snapshot);
+    ASSERT_EQ(dump, loaded_db.dump_database());
+
+    // Load in a database with entities
+    snapshot.clear();
+    snapshot.seekg(0);
+    ASSERT_THROW(loaded_db.load_snapshot(snapshot), PreconditionNotMet);
+}
+
+// Test the load of truncated or invalid snapshots
+TEST(database_load_tests, load_wrong_snapshot)
+{
+    // Read JSON
+    DatabaseDump dump;
+    load_file(SIMPLE_DUMP_FILE, dump);
+
+    std::string snapshot;
+    {
+        Database db;
+        db.load_database(dump);
+        std::stringstream stream;
+        db.dump_snapshot(stream);
+        snapshot = stream.str();
+    }
+
+    // Every truncated snapshot is corrupted
+    for (std::size_t size = 0; size < snapshot.size(); ++size)
+    {
+        std::stringstream stream(snapshot.substr(0, size));
+        Database db;
+        ASSERT_THROW(db.load_snapshot(stream), CorruptedFile) << "Snapshot truncated to " << size << " bytes";
+    }
+
+    // Wrong magic bytes
+    {
+        std::string wrong = snapshot;
+        wrong[0] = 'X';
+        std::stringstream stream(wrong);
+        ASSERT_FALSE(SnapshotReader::is_snapshot(stream));
+        Database db;
+        ASSERT_THROW(db.load_snapshot(stream), CorruptedFile);
+    }
+
+    // Unsupported version
+    {
+        std::string wrong = snapshot;
+        wrong[SNAPSHOT_MAGIC_SIZE] = static_cast<char>(SNAPSHOT_VERSION + 1);
+        std::stringstream stream(wrong);
+        ASSERT_TRUE(SnapshotReader::is_snapshot(stream));
+        Database db;
+        ASSERT_THROW(db.load_snapshot(stream), CorruptedFile);
+    }
+
+    // A JSON dump is not a snapshot
+    {
+        std::stringstream stream(dump.dump());
+        ASSERT_FALSE(SnapshotReader::is_snapshot(stream));
+    }
+}
+
+/**
+ * Auxiliar function for the delta tests.
+ * Insert samples with a source timestamp of \c time nanoseconds in participant2, datawriter2 and datareader2
+ * of a database populated by PopulateDatabase.
+ */
+void insert_delta_samples(
+        Database& db,
+        std::map<PopulateDatabase::TestId, std::shared_ptr<const Entity>>& entities,
+        uint64_t time)
+{
+    EntityId domain_id = entities[8]->id;
+
+    PdpCountSample pdp_packets;
+    pdp_packets.src_ts = nanoseconds_to_systemclock(time);
+    pdp_packets.count = time;
+    db.insert(domain_id, entities[10]->id, pdp_packets);
+
+    RtpsPacketsSentSample rtps_packets_sent;
+    rtps_packets_sent.src_ts = nanoseconds_to_systemclock(time);
+    rtps_packets_sent.count = time;
+    rtps_packets_sent.remote_locator = entities[16]->id;
+    db.insert(domain_id, entities[10]->id, rtps_packets_sent);
+
+    HeartbeatCountSample heartbeats;
+    heartbeats.src_ts = nanoseconds_to_systemclock(time);
+    heartbeats.count = time;
+    db.insert(domain_id, entities[19]->id, heartbeats);
+
+    SampleDatasCountSample sample_datas;
+    sample_datas.src_ts = nanoseconds_to_systemclock(time);
+    sample_datas.count = 1;
+    sample_datas.sequence_number = time;
+    db.insert(domain_id, entities[19]->id, sample_datas);
+
+    AcknackCountSample acknacks;
+    acknacks.src_ts = nanoseconds_to_systemclock(time);
+    acknacks.count = time;
+    db.insert(domain_id, entities[15]->id, acknacks);
+}
+
+/**
+ * Auxiliar function for the delta tests.
+ * Load a new database from a stream with an incremental dump followed by other incremental dumps,
+ * and compare its dump with the dump of the database from which they were taken.
+ */
+void load_delta_chain(
+        Database& db,
+        std::stringstream& chain)
+{
+    Database merged_db;
+    merged_db.load_database(chain);
+    chain >> std::ws;
+    while (chain.peek() != std::char_traits<char>::eof())
+    {
+        merged_db.load_database_delta(chain);
+        chain >> std::ws;
+    }
+
+    ASSERT_EQ(db.dump_database(), merged_db.dump_database());
+}
+
+// Test that a chain of incremental dumps holds the same database as a whole dump
+TEST(database_load_tests, delta_load_and_dump)
+{
+    Database db;
+    auto entities = PopulateDatabase::populate_database(db);
+    std::stringstream chain;
+
+    // The first incremental dump holds the whole database
+    DumpWatermark watermark = db.dump_database_delta(chain);
+    {
+        DatabaseDump delta = DatabaseDump::parse(chain.str());
+        DatabaseDump dump = db.dump_database();
+        for (auto it = dump.begin(); it != dump.end(); ++it)
+        {
+            ASSERT_EQ(*it, delta.at(it.key()));
+        }
+    }
+    ASSERT_LT(0u, watermark.epoch);
+
+    // New samples of the existing entities
+    insert_delta_samples(db, entities, 10);
+
+    // New entities, with samples older than the watermark
+    std::shared_ptr<Domain> domain = std::const_pointer_cast<Domain>(
+        std::static_pointer_cast<const Domain>(entities[8]));
+    std::shared_ptr<Topic> topic = std::const_pointer_cast<Topic>(
+        std::static_pointer_cast<const Topic>(entities[12]));
+    Qos qos;
+    qos["qos"] = "empty";
+    auto participant = std::make_shared<DomainParticipant>(
+        "participant3", qos, "01.0f.00.00.00.00.00.00.00.00.00.03|0.0.1.c1", nullptr, domain);
+    db.insert(participant);
+    db.link_participant_with_process(participant->id, entities[5]->id);
+    auto datawriter = std::make_shared<DataWriter>(
+        "datawriter3", qos, "01.0f.00.00.00.00.00.00.00.00.00.03|0.0.0.3", participant, topic);
+    std::shared_ptr<Locator> locator = std::const_pointer_cast<Locator>(
+        std::static_pointer_cast<const Locator>(entities[18]));
+    datawriter->locators[locator->id] = locator;
+    db.insert(datawriter);
+    PublicationThroughputSample throughput;
+    throughput.src_ts = nanoseconds_to_systemclock(1);
+    throughput.data = 3.3;
+    db.insert(domain->id, datawriter->id, throughput);
+
+    // New alias of an existing entity
+    std::const_pointer_cast<Entity>(entities[1])->alias = "host1_alias";
+
+    DumpWatermark previous_watermark = watermark;
+    watermark = db.dump_database_delta(chain, watermark);
+    ASSERT_LT(previous_watermark.epoch, watermark.epoch);
+
+    // The next incremental dump only holds the samples newer than the watermark
+    insert_delta_samples(db, entities, 20);
+    std::stringstream delta_stream;
+    previous_watermark = watermark;
+    watermark = db.dump_database_delta(delta_stream, watermark);
+    ASSERT_LT(previous_watermark.epoch, watermark.epoch);
+    {
+        DatabaseDump delta = DatabaseDump::parse(delta_stream.str());
+        const DatabaseDump& datawriter_data =
+                delta[DATAWRITER_CONTAINER_TAG][std::to_string(entities[19]->id.value())][DATA_CONTAINER_TAG];
+        ASSERT_EQ(1u, datawriter_data[DATA_KIND_HEARTBEAT_COUNT_TAG].size());
+        ASSERT_TRUE(datawriter_data[DATA_KIND_PUBLICATION_THROUGHPUT_TAG].empty());
+        ASSERT_TRUE(delta[DATAWRITER_CONTAINER_TAG][std::to_string(datawriter->id.value())][DATA_CONTAINER_TAG]
+                [DATA_KIND_PUBLICATION_THROUGHPUT_TAG].empty());
+        ASSERT_EQ(1u, delta[DATAREADER_CONTAINER_TAG][std::to_string(entities[15]->id.value())][DATA_CONTAINER_TAG]
+                [DATA_KIND_ACKNACK_COUNT_TAG].size());
+    }
+    chain << delta_stream.str();
+
+    // Without new samples, the watermark does not change
+    DumpWatermark last_watermark = db.dump_database_delta(chain, watermark);
+    ASSERT_EQ(watermark.epoch, last_watermark.epoch);
+    ASSERT_EQ(watermark.next_entity_id, last_watermark.next_entity_id);
+
+    load_delta_chain(db, chain);
+}
+
+// Test that the incremental dumps hold the samples of sources with unsynchronized clocks, received out of order
+TEST(database_load_tests, delta_out_of_order)
+{
+    Database db;
+    auto entities = PopulateDatabase::populate_database(db);
+    EntityId domain_id = entities[8]->id;
+    std::stringstream chain;
+    DumpWatermark watermark = db.dump_database_delta(chain);
+
+    auto insert_throughput = [&](const std::shared_ptr<const Entity>& datawriter, uint64_t time)
+            {
+                PublicationThroughputSample throughput;
+                throughput.src_ts = nanoseconds_to_systemclock(time);
+                throughput.data = static_cast<double>(time);
+                db.insert(domain_id, datawriter->id, throughput);
+            };
+
+    // The clock of datawriter1 is ahead of the clock of datawriter2, and their samples are received interleaved
+    insert_throughput(entities[17], 100);
+    insert_throughput(entities[19], 10);
+    insert_throughput(entities[17], 110);
+    watermark = db.dump_database_delta(chain, watermark);
+
+    // The samples of datawriter2 received after the dump are older than those of datawriter1 already dumped
+    insert_throughput(entities[19], 20);
+    insert_throughput(entities[17], 120);
+    insert_throughput(entities[19], 30);
+    std::stringstream delta_stream;
+    db.dump_database_delta(delta_stream, watermark);
+    {
+        DatabaseDump delta = DatabaseDump::parse(delta_stream.str());
+        const DatabaseDump& datawriter1_data =
+                delta[DATAWRITER_CONTAINER_TAG][std::to_string(entities[17]->id.value())][DATA_CONTAINER_TAG];
+        const DatabaseDump& datawriter2_data =
+                delta[DATAWRITER_CONTAINER_TAG][std::to_string(entities[19]->id.value())][DATA_CONTAINER_TAG];
+        ASSERT_EQ(1u, datawriter1_data[DATA_KIND_PUBLICATION_THROUGHPUT_TAG].size());
+        ASSERT_EQ(2u, datawriter2_data[DATA_KIND_PUBLICATION_THROUGHPUT_TAG].size());
+    }
+    chain << delta_stream.str();
+
+    load_delta_chain(db, chain);
+}
+
+// Test that a database loaded from a chain of incremental dumps continues the chain, as after a restart
+TEST(database_load_tests, delta_continued_after_load)
+{
+    Database db;
+    auto entities = PopulateDatabase::populate_database(db);
+    std::stringstream chain;
+    DumpWatermark watermark = db.dump_database_delta(chain);
+    insert_delta_samples(db, entities, 10);
+    watermark = db.dump_database_delta(chain, watermark);
+
+    Database restarted_db;
+    {
+        std::stringstream loaded_chain(chain.str());
+        restarted_db.load_database(loaded_chain);
+        loaded_chain >> std::ws;
+        restarted_db.load_database_delta(loaded_chain);
+    }
+
+    // The loaded samples are not dumped again
+    std::stringstream empty_stream;
+    DumpWatermark restarted_watermark = restarted_db.dump_database_delta(empty_stream, watermark);
+    ASSERT_EQ(watermark.epoch, restarted_watermark.epoch);
+
+    // The samples inserted after the load are dumped
+    insert_delta_samples(db, entities, 20);
+    insert_delta_samples(restarted_db, entities, 20);
+    std::stringstream delta_stream;
+    restarted_watermark = restarted_db.dump_database_delta(delta_stream, restarted_watermark);
+    ASSERT_LT(watermark.epoch, restarted_watermark.epoch);
+    {
+        DatabaseDump delta = DatabaseDump::parse(delta_stream.str());
+        const DatabaseDump& datawriter_data =
+                delta[DATAWRITER_CONTAINER_TAG][std::to_string(entities[19]->id.value())][DATA_CONTAINER_TAG];
+        ASSERT_EQ(1u, datawriter_data[DATA_KIND_HEARTBEAT_COUNT_TAG].size());
+        ASSERT_TRUE(datawriter_data[DATA_KIND_PUBLICATION_THROUGHPUT_TAG].empty());
+    }
+    chain << delta_stream.str();
+
+    load_delta_chain(db, chain);
+}
+
+// Test the incremental dumps of a database whose participant is linked with a process after the first dump
+TEST(database_load_tests, delta_process_link)
+{
+    // Read JSON
+    DatabaseDump dump;
+    load_file(NO_PROCESS_PARTICIPANT_LINK_DUMP_FILE, dump);
+
+    Database db;
+    db.load_database(dump);
+    std::stringstream chain;
+    DumpWatermark watermark = db.dump_database_delta(chain);
+
+    // Link the participant with a process created after the first dump
+    auto user = std::const_pointer_cast<User>(std::static_pointer_cast<const User>(db.get_entity(EntityId(2))));
+    auto process = std::make_shared<Process>("process_1", "36001", user);
+    db.insert(process);
+    db.link_participant_with_process(EntityId(6), process->id);
+    db.dump_database_delta(chain, watermark);
+
+    load_delta_chain(db, chain);
+}
+
+// Test the incremental dumps of a database some of whose entities are removed after the first dump
+TEST(database_load_tests, delta_erased_entities)
+{
+    DataBaseTest db;
+    auto entities = PopulateDatabase::populate_database(db);
+    std::stringstream chain;
+    DumpWatermark watermark = db.dump_database_delta(chain);
+
+    // Erase a domain, and the entities left inactive
+    EntityId domain_id = entities[8]->id;
+    db.erase(domain_id);
+    db.clear_inactive_entities();
+    ASSERT_TRUE(db.hosts().size() < 2u);
+
+    // Discover the domain and one of its participants again
+    auto domain = std::make_shared<Domain>("domain2");
+    db.insert(domain);
+    Qos qos;
+    qos["qos"] = "empty";
+    auto participant = std::make_shared<DomainParticipant>("participant2", qos,
+                    std::static_pointer_cast<const DomainParticipant>(entities[10])->guid, nullptr, domain);
+    db.insert(participant);
+    watermark = db.dump_database_delta(chain, watermark);
+
+    load_delta_chain(db, chain);
+}
+
+// Test that incremental dumps are only merged in the database they were taken from
+TEST(database_load_tests, delta_wrong_chain)
+{
+    Database db;
+    PopulateDatabase::populate_database(db);
+
+    std::stringstream base;
+    DumpWatermark watermark = db.dump_database_delta(base);
+    std::stringstream first;
+    watermark = db.dump_database_delta(first, watermark);
+    db.insert(std::make_shared<Host>("host3"));
+    std::stringstream second;
+    watermark = db.dump_database_delta(second, watermark);
+    std::stringstream third;
+    db.dump_database_delta(third, watermark);
+
+    auto load = [](Database& database, std::stringstream& stream)
+            {
+                stream.clear();
+                stream.seekg(0);
+                database.load_database_delta(stream);
+            };
+
+    // Incremental dump without the previous ones
+    {
+        Database merged_db;
+        first.seekg(0);
+        ASSERT_THROW(merged_db.load_database(first), CorruptedFile);
+    }
+
+    // Incremental dump merged twice
+    {
+        Database merged_db;
+        load(merged_db, base);
+        load(merged_db, first);
+        load(merged_db, second);
+        ASSERT_THROW(load(merged_db, second), CorruptedFile);
+    }
+
+    // Incremental dump after a missing one
+    {
+        Database merged_db;
+        load(merged_db, base);
+        ASSERT_THROW(load(merged_db, third), CorruptedFile);
+    }
+
+    // Whole dump merged in a database with entities
+    {
+        Database merged_db;
+        load(merged_db, base);
+        std::stringstream dump_stream;
+        db.dump_database(dump_stream);
+        ASSERT_THROW(load(merged_db, dump_stream), CorruptedFile);
+    }
+
+    // Wrong watermark
+    {
+        DatabaseDump delta = DatabaseDump::parse(first.str());
+        delta[DELTA_SINCE_TAG][WATERMARK_EPOCH_TAG] = "epoch";
+        std::stringstream stream(delta.dump());
+        Database merged_db;
+        load(merged_db, base);
+        ASSERT_THROW(merged_db.load_database_delta(stream), CorruptedFile);
+    }
+}
+
 // Test the database method string_to_int()
 TEST(database_load_tests, string_to_int)
 {
@@ -12,9 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
+#include <algorithm>
 #include <chrono>
 #include <memory>
 #include <string>
+#include <thread>
 
 #include <gtest_aux.hpp>
 #include <gtest/gtest.h>
@@ -2418,6 +2421,137 @@ TEST_F(database_tests, insert_sample_valid_wrong_domain)
     ASSERT_THROW(db.insert(db.generate_entity_id(), writer_id, sample), BadParameter);
 }
 
+TEST_F(database_tests, insert_sample_batch)
+{
+    std::vector<Database::SampleInsertion> samples(3);
+
+    std::unique_ptr<HistoryLatencySample> sample(new HistoryLatencySample());
+    sample->reader = reader_id;
+    sample->data = 12;
+    sample->src_ts = std::chrono::system_clock::now();
+    samples[0].domain_id = domain_id;
+    samples[0].entity_id = writer_id;
+    samples[0].sample = std::move(sample);
+
+    // A sample of an unknown entity does not prevent the insertion of the rest
+    sample.reset(new HistoryLatencySample());
+    sample->reader = reader_id;
+    sample->data = 13;
+    samples[1].domain_id = domain_id;
+    samples[1].entity_id = db.generate_entity_id();
+    samples[1].sample = std::move(sample);
+
+    sample.reset(new HistoryLatencySample());
+    sample->reader = reader_id;
+    sample->data = 14;
+    sample->src_ts = samples[0].sample->src_ts + std::chrono::seconds(1);
+    samples[2].domain_id = domain_id;
+    samples[2].entity_id = writer_id;
+    samples[2].sample = std::move(sample);
+
+    ASSERT_NO_THROW(db.insert(samples));
+
+    EXPECT_TRUE(samples[0].error.empty());
+    EXPECT_FALSE(samples[1].error.empty());
+    EXPECT_TRUE(samples[2].error.empty());
+
+    ASSERT_EQ(writer->data.history2history_latency[reader_id].size(), 2u);
+    ASSERT_EQ(writer->data.history2history_latency[reader_id][0],
+            static_cast<const EntityDataSample&>(*samples[0].sample));
+    ASSERT_EQ(writer->data.history2history_latency[reader_id][1],
+            static_cast<const EntityDataSample&>(*samples[2].sample));
+}
+
+TEST_F(database_tests, insert_sample_batch_unknown_remote_locator)
+{
+    EntityId remote_id = db.generate_entity_id();
+    std::vector<Database::SampleInsertion> samples(3);
+
+    std::unique_ptr<RtpsPacketsSentSample> sample(new RtpsPacketsSentSample());
+    sample->remote_locator = remote_id;
+    sample->count = 12;
+    samples[0].domain_id = domain_id;
+    samples[0].entity_id = participant_id;
+    samples[0].sample = std::move(sample);
+
+    std::unique_ptr<PublicationThroughputSample> throughput(new PublicationThroughputSample());
+    throughput->data = 15;
+    samples[1].domain_id = domain_id;
+    samples[1].entity_id = writer_id;
+    samples[1].sample = std::move(throughput);
+
+    sample.reset(new RtpsPacketsSentSample());
+    sample->remote_locator = remote_id;
+    sample->count = 20;
+    samples[2].domain_id = domain_id;
+    samples[2].entity_id = participant_id;
+    samples[2].sample = std::move(sample);
+
+    ASSERT_THROW(db.get_entity(remote_id), BadParameter);
+    ASSERT_NO_THROW(db.insert(samples));
+    ASSERT_NO_THROW(db.get_entity(remote_id));
+
+    EXPECT_TRUE(samples[0].error.empty());
+    EXPECT_TRUE(samples[1].error.empty());
+    EXPECT_TRUE(samples[2].error.empty());
+
+    // The samples that create the locator keep their order
+    ASSERT_EQ(writer->data.publication_throughput.size(), 1u);
+    ASSERT_EQ(participant->data.rtps_packets_sent[remote_id].size(), 2u);
+    ASSERT_EQ(participant->data.rtps_packets_sent[remote_id][0].count, 12u);
+    ASSERT_EQ(participant->data.rtps_packets_sent[remote_id][1].count, 8u);
+    ASSERT_EQ(participant->data.last_reported_rtps_packets_sent_count[remote_id].count, 20u);
+}
+
+TEST_F(database_tests, insert_select_concurrent)
+{
+    constexpr uint64_t num_samples = 2000;
+    Timestamp first_ts = std::chrono::system_clock::now();
+
+    // Insertions on different entities, and selections on them, run concurrently
+    std::thread writer_thread([&]()
+            {
+                for (uint64_t i = 0; i < num_samples; ++i)
+                {
+                    PublicationThroughputSample sample;
+                    sample.data = static_cast<double>(i);
+                    sample.src_ts = first_ts + std::chrono::milliseconds(i);
+                    db.insert(domain_id, writer_id, sample);
+                }
+            });
+    std::thread reader_thread([&]()
+            {
+                for (uint64_t i = 0; i < num_samples; ++i)
+                {
+                    SubscriptionThroughputSample sample;
+                    sample.data = static_cast<double>(i);
+                    sample.src_ts = first_ts + std::chrono::milliseconds(i);
+                    db.insert(domain_id, reader_id, sample);
+                }
+            });
+
+    Timestamp last_ts = first_ts + std::chrono::milliseconds(num_samples);
+    std::size_t last_size = 0;
+    while (last_size < num_samples)
+    {
+        auto selected = db.select(DataKind::PUBLICATION_THROUGHPUT, writer_id, first_ts, last_ts);
+        ASSERT_GE(selected.size(), last_size);
+        for (std::size_t i = 0; i < selected.size(); ++i)
+        {
+            ASSERT_EQ(static_cast<const EntityDataSample*>(selected[i])->data, static_cast<double>(i));
+        }
+        last_size = selected.size();
+        db.select(DataKind::SUBSCRIPTION_THROUGHPUT, reader_id, first_ts, last_ts);
+        db.get_entities(EntityKind::DATAWRITER, domain_id);
+    }
+
+    writer_thread.join();
+    reader_thread.join();
+
+    EXPECT_EQ(db.select(DataKind::PUBLICATION_THROUGHPUT, writer_id, first_ts, last_ts).size(), num_samples);
+    EXPECT_EQ(db.select(DataKind::SUBSCRIPTION_THROUGHPUT, reader_id, first_ts, last_ts).size(), num_samples);
+}
+
 TEST_F(database_tests, get_entity_host)
 {
     auto local_host = db.get_entity(host_id);
@@ -2708,6 +2842,34 @@ TEST_F(database_tests, get_entities_by_name_other_kind)
     EXPECT_THROW(db.get_entities_by_name(static_cast<EntityKind>(127), "some_name"), BadParameter);
 }
 
+TEST_F(database_tests, get_topic_by_name_and_type)
+{
+    /* Check that the inserted topic is retrieved correctly */
+    EXPECT_EQ(db.get_topic_by_name_and_type(domain_id, topic_name, topic_type), topic_id);
+
+    /* Insert another one with the same name but a different type and check that each one is retrieved correctly */
+    auto topic_2 = std::make_shared<Topic>(topic_name, "test_topic_type_2", domain);
+    auto topic_id_2 = db.insert(topic_2);
+    EXPECT_EQ(db.get_topic_by_name_and_type(domain_id, topic_name, topic_type), topic_id);
+    EXPECT_EQ(db.get_topic_by_name_and_type(domain_id, topic_name, "test_topic_type_2"), topic_id_2);
+
+    /* Insert another one with the same name and type in another domain and check that each one is retrieved */
+    auto domain_2 = std::make_shared<Domain>("domain_2");
+    auto domain_id_2 = db.insert(domain_2);
+    auto topic_3 = std::make_shared<Topic>(topic_name, topic_type, domain_2);
+    auto topic_id_3 = db.insert(topic_3);
+    EXPECT_EQ(db.get_topic_by_name_and_type(domain_id, topic_name, topic_type), topic_id);
+    EXPECT_EQ(db.get_topic_by_name_and_type(domain_id_2, topic_name, topic_type), topic_id_3);
+}
+
+TEST_F(database_tests, get_topic_by_name_and_type_wrong_parameters)
+{
+    EXPECT_FALSE(db.get_topic_by_name_and_type(domain_id, "wrong_name", topic_type).is_valid());
+    EXPECT_FALSE(db.get_topic_by_name_and_type(domain_id, topic_name, "wrong_type").is_valid());
+    EXPECT_FALSE(db.get_topic_by_name_and_type(participant_id, topic_name, topic_type).is_valid());
+    EXPECT_FALSE(db.get_topic_by_name_and_type(EntityId::invalid(), topic_name, topic_type).is_valid());
+}
+
 TEST_F(database_tests, get_entity_kind)
 {
     EXPECT_EQ(EntityKind::HOST, db.get_entity_kind(host_id));
@@ -4127,6 +4289,327 @@ TEST_F(database_tests, select_sample_datas)
     EXPECT_EQ(*sample1, sample_3);
 }
 
+TEST_F(database_tests, select_spans)
+{
+    // The blocks keep the data of the entity locked, so they are released before inserting more data
+    {
+        SampleSpans spans;
+        ASSERT_NO_THROW(spans = db.select_spans(DataKind::PUBLICATION_THROUGHPUT, writer_id, src_ts, end_ts));
+        EXPECT_TRUE(spans.spans.empty());
+    }
+
+    // Enough samples to be stored in several blocks
+    constexpr unsigned int num_samples = 5000;
+    for (unsigned int i = 0; i < num_samples; ++i)
+    {
+        PublicationThroughputSample sample;
+        sample.data = i;
+        sample.src_ts = src_ts + std::chrono::milliseconds(i);
+        ASSERT_NO_THROW(db.insert(domain_id, writer_id, sample));
+    }
+
+    // The blocks hold the same samples returned by select, in the same order
+    {
+        Timestamp t_from = src_ts + std::chrono::milliseconds(100);
+        Timestamp t_to = src_ts + std::chrono::milliseconds(4000);
+        ASSERT_NO_THROW(data_output = db.select(DataKind::PUBLICATION_THROUGHPUT, writer_id, t_from, t_to));
+        SampleSpans spans;
+        ASSERT_NO_THROW(spans = db.select_spans(DataKind::PUBLICATION_THROUGHPUT, writer_id, t_from, t_to));
+        ASSERT_GT(spans.spans.size(), 1u);
+        std::vector<const StatisticsSample*> flattened;
+        for (const auto& span : spans.spans)
+        {
+            const EntityDataSample* samples = span.data<EntityDataSample>();
+            for (size_t i = 0; i < span.size; ++i)
+            {
+                flattened.push_back(&samples[i]);
+            }
+        }
+        ASSERT_EQ(flattened.size(), 3901u);
+        EXPECT_EQ(flattened, data_output);
+        EXPECT_EQ(static_cast<const EntityDataSample*>(flattened.front())->data, 100);
+        EXPECT_EQ(static_cast<const EntityDataSample*>(flattened.back())->data, 4000);
+    }
+
+    {
+        SampleSpans spans;
+        ASSERT_NO_THROW(spans = db.select_spans(DataKind::PUBLICATION_THROUGHPUT, writer_id, mid3_ts, end_ts));
+        EXPECT_TRUE(spans.spans.empty());
+    }
+
+    // Discovery times are stored with their own type
+    DiscoveryTimeSample discovery_sample;
+    discovery_sample.remote_entity = reader_id;
+    discovery_sample.time = std::chrono::system_clock::now();
+    discovery_sample.discovered = true;
+    discovery_sample.src_ts = sample1_ts;
+    ASSERT_NO_THROW(db.insert(domain_id, participant_id, discovery_sample));
+    {
+        SampleSpans spans;
+        ASSERT_NO_THROW(spans = db.select_spans(DataKind::DISCOVERY_TIME, participant_id, reader_id, src_ts, end_ts));
+        ASSERT_EQ(spans.spans.size(), 1u);
+        ASSERT_EQ(spans.spans[0].size, 1u);
+        EXPECT_EQ(spans.spans[0].data<DiscoveryTimeSample>()[0], discovery_sample);
+    }
+
+    // Sample datas are sorted by source timestamp
+    SampleDatasCountSample sample_datas_1;
+    sample_datas_1.count = 5;
+    sample_datas_1.sequence_number = 5;
+    sample_datas_1.src_ts = sample2_ts;
+    ASSERT_NO_THROW(db.insert(domain_id, writer_id, sample_datas_1));
+    SampleDatasCountSample sample_datas_2;
+    sample_datas_2.count = 10;
+    sample_datas_2.sequence_number = 3;
+    sample_datas_2.src_ts = sample3_ts;
+    ASSERT_NO_THROW(db.insert(domain_id, writer_id, sample_datas_2));
+    {
+        SampleSpans spans;
+        ASSERT_NO_THROW(spans = db.select_spans(DataKind::SAMPLE_DATAS, writer_id, src_ts, end_ts));
+        ASSERT_EQ(spans.spans.size(), 2u);
+        EXPECT_EQ(spans.spans[0].data<EntityCountSample>()->count, 5u);
+        EXPECT_EQ(spans.spans[1].data<EntityCountSample>()->count, 10u);
+    }
+
+    EXPECT_THROW(db.select_spans(DataKind::PUBLICATION_THROUGHPUT, writer_id, end_ts, src_ts), BadParameter);
+    EXPECT_THROW(db.select_spans(DataKind::FASTDDS_LATENCY, writer_id, src_ts, end_ts), BadParameter);
+}
+
+TEST_F(database_tests, select_spans_keep_samples)
+{
+    SampleDatasCountSample sample_datas;
+    sample_datas.count = 5;
+    sample_datas.sequence_number = 5;
+    sample_datas.src_ts = sample1_ts;
+    ASSERT_NO_THROW(db.insert(domain_id, writer_id, sample_datas));
+
+    SampleSpans spans = db.select_spans(DataKind::SAMPLE_DATAS, writer_id, src_ts, end_ts);
+    ASSERT_EQ(spans.spans.size(), 1u);
+    const EntityCountSample* selected = spans.spans[0].data<EntityCountSample>();
+
+    // The database is not kept locked, so it can be modified while the blocks are alive
+    ASSERT_NO_THROW(db.insert(std::make_shared<Host>("other_host")));
+
+    // Neither replacing the sample of the same sequence number nor clearing the data removes the selected sample
+    // while the blocks are alive
+    std::atomic<bool> replaced(false);
+    std::thread replace([&]()
+            {
+                SampleDatasCountSample new_sample_datas = sample_datas;
+                new_sample_datas.count = 10;
+                new_sample_datas.src_ts = sample2_ts;
+                db.insert(domain_id, writer_id, new_sample_datas);
+                replaced = true;
+            });
+    std::atomic<bool> cleared(false);
+    std::thread clear([&]()
+            {
+                db.clear_statistics_data(end_ts);
+                cleared = true;
+            });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_FALSE(replaced);
+    EXPECT_FALSE(cleared);
+    EXPECT_EQ(selected->count, 5u);
+    EXPECT_EQ(selected->src_ts, sample1_ts);
+
+    spans = SampleSpans();
+    replace.join();
+    clear.join();
+    EXPECT_TRUE(replaced);
+    EXPECT_TRUE(cleared);
+}
+
+TEST_F(database_tests, select_summaries)
+{
+    constexpr unsigned int num_samples = 5000;
+    for (unsigned int i = 0; i < num_samples; ++i)
+    {
+        PublicationThroughputSample sample;
+        sample.data = i % 97;
+        sample.src_ts = src_ts + std::chrono::milliseconds(10 * i);
+        ASSERT_NO_THROW(db.insert(domain_id, writer_id, sample));
+    }
+
+    // Summaries of the bins computed from the selected samples
+    auto expected_bins = [&](
+        const details::RollupBins& bins)
+            {
+                std::vector<details::RollupSummary> summaries(bins.summaries.size());
+                for (size_t i = 0; i < summaries.size(); ++i)
+                {
+                    for (auto sample : db.select(DataKind::PUBLICATION_THROUGHPUT, writer_id, bins.bin_start(i),
+                            bins.bin_end(i) - std::chrono::nanoseconds(1)))
+                    {
+                        summaries[i].add(static_cast<const EntityDataSample*>(sample)->data);
+                    }
+                }
+                return summaries;
+            };
+    auto check_bins = [&](
+        const details::RollupBins& bins)
+            {
+                auto expected = expected_bins(bins);
+                for (size_t i = 0; i < expected.size(); ++i)
+                {
+                    EXPECT_EQ(bins.summaries[i].count, expected[i].count);
+                    EXPECT_DOUBLE_EQ(bins.summaries[i].sum, expected[i].sum);
+                    EXPECT_DOUBLE_EQ(bins.summaries[i].sum_sq, expected[i].sum_sq);
+                    EXPECT_EQ(bins.summaries[i].min, expected[i].min);
+                    EXPECT_EQ(bins.summaries[i].max, expected[i].max);
+                }
+            };
+
+    // Rollups are disabled by default
+    Timestamp aligned_ts = src_ts - src_ts.time_since_epoch() % std::chrono::seconds(1) + std::chrono::seconds(1);
+    details::RollupBins bins(10, aligned_ts, aligned_ts + std::chrono::seconds(40));
+    EXPECT_FALSE(db.select_summaries(DataKind::PUBLICATION_THROUGHPUT, writer_id, bins));
+    EXPECT_FALSE(bins.complete);
+
+    // Enabling them summarizes the data already inserted
+    db.set_rollup_resolutions({std::chrono::milliseconds(100), std::chrono::seconds(1)});
+
+    // Bins aligned with the buckets
+    bins = details::RollupBins(10, aligned_ts, aligned_ts + std::chrono::seconds(40));
+    ASSERT_TRUE(db.select_summaries(DataKind::PUBLICATION_THROUGHPUT, writer_id, bins));
+    check_bins(bins);
+
+    // Bins not aligned with the buckets
+    bins = details::RollupBins(20, src_ts + std::chrono::milliseconds(1234), src_ts + std::chrono::milliseconds(41234));
+    ASSERT_TRUE(db.select_summaries(DataKind::PUBLICATION_THROUGHPUT, writer_id, bins));
+    check_bins(bins);
+
+    // Data inserted after enabling them
+    for (unsigned int i = num_samples; i < 2 * num_samples; ++i)
+    {
+        PublicationThroughputSample sample;
+        sample.data = i % 89;
+        sample.src_ts = src_ts + std::chrono::milliseconds(10 * i);
+        ASSERT_NO_THROW(db.insert(domain_id, writer_id, sample));
+    }
+    bins = details::RollupBins(5, aligned_ts + std::chrono::seconds(30), aligned_ts + std::chrono::seconds(80));
+    ASSERT_TRUE(db.select_summaries(DataKind::PUBLICATION_THROUGHPUT, writer_id, bins));
+    check_bins(bins);
+
+    // The duration of the bins is not a multiple of any resolution
+    bins = details::RollupBins(7, aligned_ts, aligned_ts + std::chrono::seconds(10));
+    EXPECT_FALSE(db.select_summaries(DataKind::PUBLICATION_THROUGHPUT, writer_id, bins));
+    EXPECT_FALSE(bins.complete);
+
+    EXPECT_THROW(db.select_summaries(DataKind::FASTDDS_LATENCY, writer_id, bins), BadParameter);
+
+    // Data not summarized
+    bins = details::RollupBins(10, aligned_ts, aligned_ts + std::chrono::seconds(40));
+    EXPECT_FALSE(db.select_summaries(DataKind::SAMPLE_DATAS, writer_id, bins));
+
+    // Disabling them
+    db.set_rollup_resolutions({});
+    bins = details::RollupBins(10, aligned_ts, aligned_ts + std::chrono::seconds(40));
+    EXPECT_FALSE(db.select_summaries(DataKind::PUBLICATION_THROUGHPUT, writer_id, bins));
+}
+
+TEST_F(database_tests, enforce_retention)
+{
+    // Without limits, there is nothing to enforce
+    EXPECT_TRUE(db.enforce_retention());
+    EXPECT_EQ(db.retained_memory_usage(), 0u);
+
+    Timestamp now = std::chrono::system_clock::now();
+    constexpr unsigned int num_samples = 20000;
+    for (unsigned int i = 0; i < num_samples; ++i)
+    {
+        PublicationThroughputSample sample;
+        sample.data = i;
+        sample.src_ts = now - std::chrono::milliseconds(num_samples - i);
+        ASSERT_NO_THROW(db.insert(domain_id, writer_id, sample));
+        SubscriptionThroughputSample reader_sample;
+        reader_sample.data = i;
+        reader_sample.src_ts = sample.src_ts;
+        ASSERT_NO_THROW(db.insert(domain_id, reader_id, reader_sample));
+    }
+
+    // Limit the age of the publication throughput and the samples of every series
+    RetentionPolicy policy;
+    policy.max_age[DataKind::PUBLICATION_THROUGHPUT] = std::chrono::seconds(10);
+    policy.max_samples_per_series = 15000;
+    ASSERT_NO_THROW(db.set_retention_policy(policy));
+    while (!db.enforce_retention())
+    {
+    }
+    data_output = db.select(DataKind::PUBLICATION_THROUGHPUT, writer_id, now - std::chrono::hours(1), now);
+    EXPECT_LE(data_output.size(), 10000u);
+    EXPECT_GT(data_output.size(), 9000u);
+    EXPECT_EQ(static_cast<const EntityDataSample*>(data_output.back())->data, num_samples - 1);
+    data_output = db.select(DataKind::SUBSCRIPTION_THROUGHPUT, reader_id, now - std::chrono::hours(1), now);
+    EXPECT_EQ(data_output.size(), 15000u);
+    EXPECT_EQ(static_cast<const EntityDataSample*>(data_output.front())->data, 5000);
+    std::size_t memory_usage = db.retained_memory_usage();
+    EXPECT_GT(memory_usage, 0u);
+
+    // Limit the memory to half of the one used, which is met after a few visits to every entity
+    policy = RetentionPolicy();
+    policy.memory_budget = memory_usage / 2;
+    ASSERT_NO_THROW(db.set_retention_policy(policy));
+    for (unsigned int visit = 0; visit < 10 && (0 == db.retained_memory_usage() ||
+            db.retained_memory_usage() > policy.memory_budget); ++visit)
+    {
+        while (!db.enforce_retention())
+        {
+        }
+    }
+    EXPECT_GT(db.retained_memory_usage(), 0u);
+    EXPECT_LE(db.retained_memory_usage(), policy.memory_budget);
+    data_output = db.select(DataKind::SUBSCRIPTION_THROUGHPUT, reader_id, now - std::chrono::hours(1), now);
+    EXPECT_LT(data_output.size(), 7500u);
+    EXPECT_GT(data_output.size(), 0u);
+    EXPECT_EQ(static_cast<const EntityDataSample*>(data_output.back())->data, num_samples - 1);
+
+    // The samples being read by a query are not removed until the query finishes
+    policy = RetentionPolicy();
+    policy.max_samples_per_series = 1;
+    ASSERT_NO_THROW(db.set_retention_policy(policy));
+    {
+        SampleSpans spans =
+                db.select_spans(DataKind::SUBSCRIPTION_THROUGHPUT, reader_id, now - std::chrono::hours(1), now);
+        const EntityDataSample* first = spans.spans.front().data<EntityDataSample>();
+        double first_data = first->data;
+        std::atomic<bool> enforced(false);
+        std::thread enforce([&]()
+                {
+                    while (!db.enforce_retention())
+                    {
+                    }
+                    enforced = true;
+                });
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        EXPECT_FALSE(enforced);
+        EXPECT_EQ(first->data, first_data);
+
+        spans = SampleSpans();
+        enforce.join();
+        EXPECT_TRUE(enforced);
+    }
+    data_output = db.select(DataKind::SUBSCRIPTION_THROUGHPUT, reader_id, now - std::chrono::hours(1), now);
+    EXPECT_EQ(data_output.size(), 1u);
+
+    // Disabling the limits
+    ASSERT_NO_THROW(db.set_retention_policy(RetentionPolicy()));
+    EXPECT_TRUE(db.enforce_retention());
+    EXPECT_EQ(db.retained_memory_usage(), 0u);
+
+    // Wrong policies
+    policy = RetentionPolicy();
+    policy.slice_duration = std::chrono::microseconds(0);
+    EXPECT_THROW(db.set_retention_policy(policy), BadParameter);
+    policy = RetentionPolicy();
+    policy.enforcement_period = std::chrono::milliseconds(0);
+    EXPECT_THROW(db.set_retention_policy(policy), BadParameter);
+    policy = RetentionPolicy();
+    policy.max_age[DataKind::FASTDDS_LATENCY] = -std::chrono::seconds(1);
+    EXPECT_THROW(db.set_retention_policy(policy), BadParameter);
+}
+
 TEST_F(database_tests, get_entity_by_guid_host)
 {
     EXPECT_THROW(db.get_entity_by_guid(EntityKind::HOST, "any_guid"), BadParameter);
@@ -4191,6 +4674,78 @@ TEST_F(database_tests, get_entity_by_guid_datareader_wrong_guid)
     EXPECT_THROW(db.get_entity_by_guid(EntityKind::DATAREADER, "wrong_guid"), BadParameter);
 }
 
+TEST_F(database_tests, get_entity_by_guid_binary)
+{
+    /* Check that the inserted entities are retrieved correctly from their binary GUID */
+    eprosima::fastrtps::rtps::GUID_t guid;
+    const eprosima::fastrtps::rtps::octet prefix[] =
+    {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x10, 0x11, 0x12};
+    std::copy(std::begin(prefix), std::end(prefix), guid.guidPrefix.value);
+
+    guid.entityId.value[3] = 0x01;
+    auto datawriter = db.get_entity_by_guid(EntityKind::DATAWRITER, guid);
+    EXPECT_EQ(datawriter.first, domain_id);
+    EXPECT_EQ(datawriter.second, writer_id);
+
+    guid.entityId.value[3] = 0x02;
+    auto datareader = db.get_entity_by_guid(EntityKind::DATAREADER, guid);
+    EXPECT_EQ(datareader.first, domain_id);
+    EXPECT_EQ(datareader.second, reader_id);
+
+    /* The reader GUID does not belong to any DataWriter */
+    EXPECT_THROW(db.get_entity_by_guid(EntityKind::DATAWRITER, guid), BadParameter);
+    EXPECT_THROW(db.get_entity_by_guid(EntityKind::TOPIC, guid), BadParameter);
+}
+
+TEST_F(database_tests, get_entity_by_guid_binary_removed_entities)
+{
+    eprosima::fastrtps::rtps::GUID_t writer_binary_guid;
+    const eprosima::fastrtps::rtps::octet prefix[] =
+    {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x10, 0x11, 0x12};
+    std::copy(std::begin(prefix), std::end(prefix), writer_binary_guid.guidPrefix.value);
+    writer_binary_guid.entityId.value[3] = 0x01;
+    eprosima::fastrtps::rtps::GUID_t reader_binary_guid = writer_binary_guid;
+    reader_binary_guid.entityId.value[3] = 0x02;
+
+    ASSERT_EQ(db.get_entity_by_guid(EntityKind::DATAWRITER, writer_binary_guid).second, writer_id);
+    ASSERT_EQ(db.get_entity_by_guid(EntityKind::DATAREADER, reader_binary_guid).second, reader_id);
+
+    /* Clearing an inactive entity removes it from the binary GUID index */
+    db.change_entity_status(writer_id, false);
+    db.clear_inactive_entities();
+    EXPECT_THROW(db.get_entity_by_guid(EntityKind::DATAWRITER, writer_binary_guid), BadParameter);
+    EXPECT_THROW(db.get_entity_by_guid(EntityKind::DATAWRITER, writer_guid), BadParameter);
+    EXPECT_EQ(db.get_entity_by_guid(EntityKind::DATAREADER, reader_binary_guid).second, reader_id);
+
+    /* Erasing a domain removes its entities from the binary GUID index */
+    db.erase(domain_id);
+    EXPECT_THROW(db.get_entity_by_guid(EntityKind::DATAREADER, reader_binary_guid), BadParameter);
+    EXPECT_THROW(db.get_entity_by_guid(EntityKind::DATAREADER, reader_guid), BadParameter);
+}
+
+TEST_F(database_tests, get_entity_by_guid_binary_rediscovered_entity)
+{
+    eprosima::fastrtps::rtps::GUID_t writer_binary_guid;
+    const eprosima::fastrtps::rtps::octet prefix[] =
+    {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x10, 0x11, 0x12};
+    std::copy(std::begin(prefix), std::end(prefix), writer_binary_guid.guidPrefix.value);
+    writer_binary_guid.entityId.value[3] = 0x01;
+
+    /* The writer is rediscovered with another spelling of the same GUID while the old one is still inactive */
+    db.change_entity_status(writer_id, false);
+    std::string rediscovered_guid = "1.2.3.4.5.6.7.8.9.10.11.12|0.0.0.1";
+    auto rediscovered = std::make_shared<DataWriter>(writer_name, db.test_qos, rediscovered_guid, participant, topic);
+    rediscovered->locators[writer_locator->id] = writer_locator;
+    auto rediscovered_id = db.insert(rediscovered);
+    ASSERT_EQ(db.get_entity_by_guid(EntityKind::DATAWRITER, writer_binary_guid).second, rediscovered_id);
+
+    /* Clearing the old writer keeps the rediscovered one in the GUID indexes */
+    db.clear_inactive_entities();
+    EXPECT_THROW(db.get_entity_by_guid(EntityKind::DATAWRITER, writer_guid), BadParameter);
+    EXPECT_EQ(db.get_entity_by_guid(EntityKind::DATAWRITER, rediscovered_guid).second, rediscovered_id);
+    EXPECT_EQ(db.get_entity_by_guid(EntityKind::DATAWRITER, writer_binary_guid).second, rediscovered_id);
+}
+
 TEST_F(database_tests, get_entity_by_guid_locator)
 {
     EXPECT_THROW(db.get_entity_by_guid(EntityKind::LOCATOR, "any_guid"), BadParameter);
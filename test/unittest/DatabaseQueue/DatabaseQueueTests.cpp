@@ -12,8 +12,15 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <chrono>
+#include <future>
 #include <iostream>
 #include <functional>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
 
 #include <gtest_aux.hpp>
 #include <gtest/gtest.h>
@@ -49,14 +56,14 @@ public:
     {
     }
 
-    const std::queue<queue_item_type> get_foreground_queue()
+    const std::deque<queue_item_type>& get_foreground_queue()
     {
-        return *foreground_queue_;
+        return foreground_queue_;
     }
 
-    const std::queue<queue_item_type> get_background_queue()
+    const details::MPSCRingBuffer<queue_item_type>& get_background_queue()
     {
-        return *background_queue_;
+        return background_queue_;
     }
 
     void do_swap()
@@ -93,19 +100,22 @@ class DatabaseDataQueueWrapper : public DatabaseDataQueue
 public:
 
     DatabaseDataQueueWrapper(
-            Database* database)
-        : DatabaseDataQueue(database)
+            Database* database,
+            std::size_t parking_capacity = DEFAULT_PARKING_CAPACITY,
+            std::chrono::milliseconds parking_timeout = DEFAULT_PARKING_TIMEOUT)
+        : DatabaseDataQueue(database, DEFAULT_CAPACITY, details::OverflowPolicy::BLOCK, DEFAULT_BATCH_SIZE,
+                parking_capacity, parking_timeout)
     {
     }
 
-    const std::queue<queue_item_type> get_foreground_queue()
+    const std::deque<queue_item_type>& get_foreground_queue()
     {
-        return *foreground_queue_;
+        return foreground_queue_;
     }
 
-    const std::queue<queue_item_type> get_background_queue()
+    const details::MPSCRingBuffer<queue_item_type>& get_background_queue()
     {
-        return *background_queue_;
+        return background_queue_;
     }
 
     void do_swap()
@@ -133,6 +143,11 @@ public:
         return true;
     }
 
+    std::size_t do_process_batch()
+    {
+        return process_batch();
+    }
+
     void do_process_sample_type(
             EntityId& domain,
             EntityId& entity,
@@ -225,14 +240,14 @@ public:
 
     MOCK_METHOD0(process_sample, void());
 
-    const std::queue<queue_item_type> get_foreground_queue()
+    const std::deque<queue_item_type>& get_foreground_queue()
     {
-        return *foreground_queue_;
+        return foreground_queue_;
     }
 
-    const std::queue<queue_item_type> get_background_queue()
+    const details::MPSCRingBuffer<queue_item_type>& get_background_queue()
     {
-        return *background_queue_;
+        return background_queue_;
     }
 
 };
@@ -296,6 +311,32 @@ TEST_F(database_queue_tests, start_stop_flush)
     EXPECT_TRUE(int_queue.get_background_queue().empty());
 }
 
+TEST_F(database_queue_tests, wait_consumed)
+{
+    IntegerQueue int_queue;
+    std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now();
+
+    // Nothing pushed, nothing to wait for
+    EXPECT_EQ(0u, int_queue.pushed());
+    EXPECT_TRUE(int_queue.wait_consumed(int_queue.pushed(), std::chrono::milliseconds(0)));
+
+    // Wait for the items pushed so far
+    EXPECT_CALL(int_queue, process_sample()).Times(3);
+    int_queue.push(timestamp, 1);
+    int_queue.push(timestamp, 2);
+    int_queue.push(timestamp, 3);
+    EXPECT_EQ(3u, int_queue.pushed());
+    EXPECT_TRUE(int_queue.wait_consumed(int_queue.pushed(), std::chrono::seconds(10)));
+    EXPECT_EQ(3u, int_queue.consumed());
+
+    // A stopped consumer does not make the waiting thread block until the timeout
+    EXPECT_CALL(int_queue, process_sample()).Times(0);
+    EXPECT_TRUE(int_queue.stop_consumer());
+    int_queue.push(timestamp, 4);
+    EXPECT_FALSE(int_queue.wait_consumed(int_queue.pushed(), std::chrono::hours(1)));
+    EXPECT_EQ(3u, int_queue.consumed());
+}
+
 TEST_F(database_queue_tests, push_participant)
 {
     std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now();
@@ -1776,9 +1817,10 @@ TEST_F(database_queue_tests, push_network_latency_no_destination_locator)
     EXPECT_CALL(database, get_entity_by_guid(EntityKind::PARTICIPANT, src_locator_str)).Times(AnyNumber())
             .WillOnce(Return(std::pair<EntityId, EntityId>(std::make_pair(EntityId(0), EntityId(1)))));
 
-    // Precondition: The destination locator does not exist the first time
+    // Precondition: The destination locator does not exist the first time, nor when looked up again before creating it
     // Precondition: The destination locator exists and has ID 2
     EXPECT_CALL(database, get_entities_by_name(EntityKind::LOCATOR, dst_locator_str)).Times(AnyNumber())
+            .WillOnce(Return(std::vector<std::pair<EntityId, EntityId>>()))
             .WillOnce(Return(std::vector<std::pair<EntityId, EntityId>>()))
             .WillRepeatedly(Return(std::vector<std::pair<EntityId, EntityId>>(1,
             std::make_pair(EntityId(0), EntityId(2)))));
@@ -2203,9 +2245,10 @@ TEST_F(database_queue_tests, push_rtps_sent_no_locator)
     EXPECT_CALL(database, get_entity_by_guid(EntityKind::DATAWRITER, writer_guid_str)).Times(AnyNumber())
             .WillRepeatedly(Return(std::make_pair(EntityId(0), EntityId(1))));
 
-    // Precondition: The destination locator does not exist the first time
+    // Precondition: The destination locator does not exist the first time, nor when looked up again before creating it
     // Precondition: The destination locator exists and has ID 2
     EXPECT_CALL(database, get_entities_by_name(EntityKind::LOCATOR, dst_locator_str)).Times(AnyNumber())
+            .WillOnce(Return(std::vector<std::pair<EntityId, EntityId>>()))
             .WillOnce(Return(std::vector<std::pair<EntityId, EntityId>>()))
             .WillRepeatedly(Return(std::vector<std::pair<EntityId, EntityId>>(1,
             std::make_pair(EntityId(0), EntityId(2)))));
@@ -2456,9 +2499,10 @@ TEST_F(database_queue_tests, push_rtps_lost_no_locator)
     EXPECT_CALL(database, get_entity_by_guid(EntityKind::DATAWRITER, writer_guid_str)).Times(AnyNumber())
             .WillRepeatedly(Return(std::make_pair(EntityId(0), EntityId(1))));
 
-    // Precondition: The destination locator does not exist the first time
+    // Precondition: The destination locator does not exist the first time, nor when looked up again before creating it
     // Precondition: The destination locator exists and has ID 2
     EXPECT_CALL(database, get_entities_by_name(EntityKind::LOCATOR, dst_locator_str)).Times(AnyNumber())
+            .WillOnce(Return(std::vector<std::pair<EntityId, EntityId>>()))
             .WillOnce(Return(std::vector<std::pair<EntityId, EntityId>>()))
             .WillRepeatedly(Return(std::vector<std::pair<EntityId, EntityId>>(1,
             std::make_pair(EntityId(0), EntityId(2)))));
@@ -2814,6 +2858,332 @@ TEST_F(database_queue_tests, push_heartbeat_count_no_writer)
     data_queue.flush();
 }
 
+TEST_F(database_queue_tests, push_heartbeat_count_not_delayed_by_discovery)
+{
+    std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now();
+
+    std::array<uint8_t, 12> prefix = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    std::array<uint8_t, 4> unknown_writer_id = {0, 0, 0, 2};
+    std::array<uint8_t, 4> known_writer_id = {0, 0, 0, 3};
+    std::string unknown_writer_guid_str = "01.02.03.04.05.06.07.08.09.0a.0b.0c|0.0.0.2";
+    std::string known_writer_guid_str = "01.02.03.04.05.06.07.08.09.0a.0b.0c|0.0.0.3";
+    std::string reader_guid_str = "01.02.03.04.05.06.07.08.09.0a.0b.0c|0.0.0.7";
+
+    // Build the Statistics data of both writers
+    DatabaseDataQueue::StatisticsGuidPrefix writer_prefix;
+    writer_prefix.value(prefix);
+    auto make_data = [&writer_prefix](const std::array<uint8_t, 4>& writer_id)
+            {
+                DatabaseDataQueue::StatisticsEntityId writer_entity_id;
+                writer_entity_id.value(writer_id);
+                DatabaseDataQueue::StatisticsGuid writer_guid;
+                writer_guid.guidPrefix(writer_prefix);
+                writer_guid.entityId(writer_entity_id);
+
+                DatabaseDataQueue::StatisticsEntityCount inner_data;
+                inner_data.guid(writer_guid);
+                inner_data.count(1024);
+
+                std::shared_ptr<eprosima::fastdds::statistics::Data> data =
+                        std::make_shared<eprosima::fastdds::statistics::Data>();
+                data->entity_count(inner_data);
+                data->_d(EventKind::HEARTBEAT_COUNT);
+                return data;
+            };
+    std::shared_ptr<eprosima::fastdds::statistics::Data> unknown_data = make_data(unknown_writer_id);
+    std::shared_ptr<eprosima::fastdds::statistics::Data> known_data = make_data(known_writer_id);
+
+    // Build a discovery event that is still being processed when the data is processed
+    EntityDiscoveryInfo info(EntityKind::DATAREADER);
+    info.domain_id = EntityId(0);
+    std::stringstream(reader_guid_str) >> info.guid;
+    info.discovery_status = details::StatisticsBackendData::DiscoveryStatus::UPDATE;
+
+    // The discovery does not finish until the data of the known writer has been inserted
+    std::promise<std::chrono::steady_clock::time_point> known_inserted;
+    std::shared_future<std::chrono::steady_clock::time_point> known_inserted_future =
+            known_inserted.get_future().share();
+    EXPECT_CALL(database, get_entity_by_guid(EntityKind::DATAREADER, reader_guid_str)).Times(1)
+            .WillOnce(Invoke([known_inserted_future](
+                EntityKind,
+                const std::string&) -> std::pair<EntityId, EntityId>
+            {
+                known_inserted_future.wait_for(std::chrono::seconds(10));
+                throw BadParameter("Error");
+            }));
+
+    // Precondition: One writer does not exist, and the other one exists with ID 1
+    EXPECT_CALL(database, get_entity_by_guid(EntityKind::DATAWRITER, unknown_writer_guid_str)).Times(AnyNumber())
+            .WillRepeatedly(Throw(BadParameter("Error")));
+    EXPECT_CALL(database, get_entity_by_guid(EntityKind::DATAWRITER, known_writer_guid_str)).Times(1)
+            .WillOnce(Return(std::make_pair(EntityId(0), EntityId(1))));
+
+    // Expectation: Only the data of the known writer is inserted
+    EXPECT_CALL(database, insert(_, _, _)).Times(1);
+
+    // Expectation: The user is notified of it
+    EXPECT_CALL(*details::StatisticsBackendData::get_instance(),
+            on_data_available(EntityId(0), EntityId(1), DataKind::HEARTBEAT_COUNT)).Times(1)
+            .WillOnce(Invoke([&known_inserted](
+                EntityId,
+                EntityId,
+                DataKind)
+            {
+                known_inserted.set_value(std::chrono::steady_clock::now());
+            }));
+
+    // Add to the queues, the data of the unknown writer first
+    entity_queue.push(timestamp, info);
+    std::chrono::steady_clock::time_point pushed = std::chrono::steady_clock::now();
+    data_queue.push(timestamp, unknown_data);
+    data_queue.push(timestamp, known_data);
+    data_queue.flush();
+
+    // Expectation: The data of the unknown writer is parked right away, without waiting for the discovery,
+    // so the data of the known writer is inserted while the discovery is still being processed
+    ASSERT_EQ(std::future_status::ready, known_inserted_future.wait_for(std::chrono::seconds(10)));
+    EXPECT_LT(known_inserted_future.get() - pushed, std::chrono::milliseconds(250));
+    EXPECT_EQ(1u, data_queue.parked_samples());
+    entity_queue.flush();
+}
+
+TEST_F(database_queue_tests, push_heartbeat_count_parked_until_discovery)
+{
+    std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now();
+
+    std::array<uint8_t, 12> prefix = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    std::array<uint8_t, 4> writer_id = {0, 0, 0, 2};
+    std::string writer_guid_str = "01.02.03.04.05.06.07.08.09.0a.0b.0c|0.0.0.2";
+
+    // Build the writer GUID
+    DatabaseDataQueue::StatisticsGuidPrefix writer_prefix;
+    writer_prefix.value(prefix);
+    DatabaseDataQueue::StatisticsEntityId writer_entity_id;
+    writer_entity_id.value(writer_id);
+    DatabaseDataQueue::StatisticsGuid writer_guid;
+    writer_guid.guidPrefix(writer_prefix);
+    writer_guid.entityId(writer_entity_id);
+
+    GUID_t discovered_guid;
+    std::copy(prefix.begin(), prefix.end(), discovered_guid.guidPrefix.value);
+    std::copy(writer_id.begin(), writer_id.end(), discovered_guid.entityId.value);
+
+    // Build the Statistics data. The newest one is received first
+    DatabaseDataQueue::StatisticsEntityCount newest_inner_data;
+    newest_inner_data.guid(writer_guid);
+    newest_inner_data.count(2);
+    std::shared_ptr<eprosima::fastdds::statistics::Data> newest_data =
+            std::make_shared<eprosima::fastdds::statistics::Data>();
+    newest_data->entity_count(newest_inner_data);
+    newest_data->_d(EventKind::HEARTBEAT_COUNT);
+
+    DatabaseDataQueue::StatisticsEntityCount oldest_inner_data;
+    oldest_inner_data.guid(writer_guid);
+    oldest_inner_data.count(1);
+    std::shared_ptr<eprosima::fastdds::statistics::Data> oldest_data =
+            std::make_shared<eprosima::fastdds::statistics::Data>();
+    oldest_data->entity_count(oldest_inner_data);
+    oldest_data->_d(EventKind::HEARTBEAT_COUNT);
+
+    // Precondition: The writer does not exist until it is discovered, then it has ID 1.
+    // The oldest data is parked behind the newest one without looking up the writer
+    EXPECT_CALL(database, get_entity_by_guid(EntityKind::DATAWRITER, writer_guid_str)).Times(3)
+            .WillOnce(Throw(BadParameter("Error")))
+            .WillRepeatedly(Return(std::make_pair(EntityId(0), EntityId(1))));
+
+    // Expectation: The insert method is not called until the writer is discovered,
+    // then it is called in timestamp order
+    std::vector<uint64_t> inserted_counts;
+    InsertDataArgs args([&](
+                const EntityId& domain_id,
+                const EntityId& entity_id,
+                const StatisticsSample& sample)
+            {
+                EXPECT_EQ(entity_id, 1);
+                EXPECT_EQ(domain_id, 0);
+                EXPECT_EQ(sample.kind, DataKind::HEARTBEAT_COUNT);
+                inserted_counts.push_back(dynamic_cast<const HeartbeatCountSample&>(sample).count);
+            });
+
+    EXPECT_CALL(database, insert(_, _, _)).Times(2)
+            .WillRepeatedly(Invoke(&args, &InsertDataArgs::insert));
+
+    // Expectation: The user is notified of both data once they are inserted
+    std::promise<void> replayed;
+    EXPECT_CALL(*details::StatisticsBackendData::get_instance(),
+            on_data_available(EntityId(0), EntityId(1), DataKind::HEARTBEAT_COUNT)).Times(2)
+            .WillOnce(Return())
+            .WillOnce(Invoke([&replayed](
+                EntityId,
+                EntityId,
+                DataKind)
+            {
+                replayed.set_value();
+            }));
+
+    // Add to the queue and wait to be processed
+    data_queue.push(timestamp + std::chrono::seconds(1), newest_data);
+    data_queue.push(timestamp, oldest_data);
+    data_queue.flush();
+    EXPECT_EQ(2u, data_queue.parked_samples());
+    EXPECT_EQ(0u, data_queue.replayed_samples());
+
+    // Discover the writer and wait for the data to be replayed
+    data_queue.entity_discovered(discovered_guid);
+    ASSERT_EQ(std::future_status::ready, replayed.get_future().wait_for(std::chrono::seconds(10)));
+
+    EXPECT_EQ(std::vector<uint64_t>({1, 2}), inserted_counts);
+    EXPECT_EQ(2u, data_queue.parked_samples());
+    EXPECT_EQ(2u, data_queue.replayed_samples());
+    EXPECT_EQ(0u, data_queue.expired_samples());
+}
+
+TEST_F(database_queue_tests, push_heartbeat_count_parked_behind_older_data)
+{
+    std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now();
+
+    std::array<uint8_t, 12> prefix = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    std::array<uint8_t, 4> writer_id = {0, 0, 0, 2};
+    std::string writer_guid_str = "01.02.03.04.05.06.07.08.09.0a.0b.0c|0.0.0.2";
+
+    // Build the writer GUID
+    DatabaseDataQueue::StatisticsGuidPrefix writer_prefix;
+    writer_prefix.value(prefix);
+    DatabaseDataQueue::StatisticsEntityId writer_entity_id;
+    writer_entity_id.value(writer_id);
+    DatabaseDataQueue::StatisticsGuid writer_guid;
+    writer_guid.guidPrefix(writer_prefix);
+    writer_guid.entityId(writer_entity_id);
+
+    GUID_t discovered_guid;
+    std::copy(prefix.begin(), prefix.end(), discovered_guid.guidPrefix.value);
+    std::copy(writer_id.begin(), writer_id.end(), discovered_guid.entityId.value);
+
+    // Build the Statistics data. The oldest one is received first
+    DatabaseDataQueue::StatisticsEntityCount oldest_inner_data;
+    oldest_inner_data.guid(writer_guid);
+    oldest_inner_data.count(1);
+    std::shared_ptr<eprosima::fastdds::statistics::Data> oldest_data =
+            std::make_shared<eprosima::fastdds::statistics::Data>();
+    oldest_data->entity_count(oldest_inner_data);
+    oldest_data->_d(EventKind::HEARTBEAT_COUNT);
+
+    DatabaseDataQueue::StatisticsEntityCount newest_inner_data;
+    newest_inner_data.guid(writer_guid);
+    newest_inner_data.count(2);
+    std::shared_ptr<eprosima::fastdds::statistics::Data> newest_data =
+            std::make_shared<eprosima::fastdds::statistics::Data>();
+    newest_data->entity_count(newest_inner_data);
+    newest_data->_d(EventKind::HEARTBEAT_COUNT);
+
+    // Precondition: The writer does not exist when the oldest data is processed,
+    // then it is inserted in the database before the newest data arrives, with ID 1.
+    // The newest data is not processed while the oldest one is parked
+    EXPECT_CALL(database, get_entity_by_guid(EntityKind::DATAWRITER, writer_guid_str)).Times(3)
+            .WillOnce(Throw(BadParameter("Error")))
+            .WillRepeatedly(Return(std::make_pair(EntityId(0), EntityId(1))));
+
+    // Expectation: The insert method is not called until the discovery is notified,
+    // then it is called in timestamp order
+    std::vector<uint64_t> inserted_counts;
+    InsertDataArgs args([&](
+                const EntityId& domain_id,
+                const EntityId& entity_id,
+                const StatisticsSample& sample)
+            {
+                EXPECT_EQ(entity_id, 1);
+                EXPECT_EQ(domain_id, 0);
+                EXPECT_EQ(sample.kind, DataKind::HEARTBEAT_COUNT);
+                inserted_counts.push_back(dynamic_cast<const HeartbeatCountSample&>(sample).count);
+            });
+
+    EXPECT_CALL(database, insert(_, _, _)).Times(2)
+            .WillRepeatedly(Invoke(&args, &InsertDataArgs::insert));
+
+    // Expectation: The user is notified of both data once they are inserted
+    std::promise<void> replayed;
+    EXPECT_CALL(*details::StatisticsBackendData::get_instance(),
+            on_data_available(EntityId(0), EntityId(1), DataKind::HEARTBEAT_COUNT)).Times(2)
+            .WillOnce(Return())
+            .WillOnce(Invoke([&replayed](
+                EntityId,
+                EntityId,
+                DataKind)
+            {
+                replayed.set_value();
+            }));
+
+    // Add to the queue and wait to be processed
+    data_queue.push(timestamp, oldest_data);
+    data_queue.flush();
+    EXPECT_EQ(1u, data_queue.parked_samples());
+
+    // The newest data arrives after the writer is inserted, but before its discovery is notified
+    data_queue.push(timestamp + std::chrono::seconds(1), newest_data);
+    data_queue.flush();
+    EXPECT_TRUE(inserted_counts.empty());
+    EXPECT_EQ(2u, data_queue.parked_samples());
+    EXPECT_EQ(0u, data_queue.replayed_samples());
+
+    // Notify the discovery and wait for the data to be replayed
+    data_queue.entity_discovered(discovered_guid);
+    ASSERT_EQ(std::future_status::ready, replayed.get_future().wait_for(std::chrono::seconds(10)));
+
+    EXPECT_EQ(std::vector<uint64_t>({1, 2}), inserted_counts);
+    EXPECT_EQ(2u, data_queue.replayed_samples());
+    EXPECT_EQ(0u, data_queue.expired_samples());
+}
+
+TEST_F(database_queue_tests, push_heartbeat_count_parking_expired)
+{
+    std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now();
+
+    std::array<uint8_t, 12> prefix = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    std::array<uint8_t, 4> writer_id = {0, 0, 0, 2};
+    std::string writer_guid_str = "01.02.03.04.05.06.07.08.09.0a.0b.0c|0.0.0.2";
+
+    // Build the writer GUID
+    DatabaseDataQueue::StatisticsGuidPrefix writer_prefix;
+    writer_prefix.value(prefix);
+    DatabaseDataQueue::StatisticsEntityId writer_entity_id;
+    writer_entity_id.value(writer_id);
+    DatabaseDataQueue::StatisticsGuid writer_guid;
+    writer_guid.guidPrefix(writer_prefix);
+    writer_guid.entityId(writer_entity_id);
+
+    // Build the Statistics data
+    DatabaseDataQueue::StatisticsEntityCount inner_data;
+    inner_data.guid(writer_guid);
+    inner_data.count(1024);
+
+    std::shared_ptr<eprosima::fastdds::statistics::Data> data = std::make_shared<eprosima::fastdds::statistics::Data>();
+    data->entity_count(inner_data);
+    data->_d(EventKind::HEARTBEAT_COUNT);
+
+    // Precondition: The writer does not exist.
+    // The second data would be parked behind the first one, so the writer is looked up only once
+    EXPECT_CALL(database, get_entity_by_guid(EntityKind::DATAWRITER, writer_guid_str)).Times(1)
+            .WillRepeatedly(Throw(BadParameter("Error")));
+
+    // Expectation: The insert method is never called, data dropped
+    EXPECT_CALL(database, insert(_, _, _)).Times(0);
+
+    // Expectation: The user is not notified
+    EXPECT_CALL(*details::StatisticsBackendData::get_instance(), on_data_available(_, _, _)).Times(0);
+
+    // Only one data can be parked, and it expires right away.
+    // Both data are pushed with the consumer stopped, so they are processed in the same batch
+    DatabaseDataQueueWrapper parking_queue(&database, 1, std::chrono::milliseconds(0));
+    parking_queue.stop_consumer();
+    parking_queue.push(timestamp, data);
+    parking_queue.push(timestamp, data);
+    parking_queue.start_consumer();
+    parking_queue.flush();
+    EXPECT_EQ(1u, parking_queue.parked_samples());
+    EXPECT_EQ(2u, parking_queue.expired_samples());
+    EXPECT_EQ(0u, parking_queue.replayed_samples());
+}
+
 TEST_F(database_queue_tests, push_acknack_count)
 {
     std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now();
@@ -4521,6 +4891,353 @@ TEST_F(database_queue_tests, push_physical_data_wrong_processname_format)
     data_queue.flush();
 }
 
+TEST_F(database_queue_tests, push_batch)
+{
+    std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now();
+
+    std::array<uint8_t, 12> prefix = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    std::array<uint8_t, 4> writer_id = {0, 0, 0, 2};
+    std::string writer_guid_str = "01.02.03.04.05.06.07.08.09.0a.0b.0c|0.0.0.2";
+
+    // Build the writer GUID
+    DatabaseDataQueue::StatisticsGuidPrefix writer_prefix;
+    writer_prefix.value(prefix);
+    DatabaseDataQueue::StatisticsEntityId writer_entity_id;
+    writer_entity_id.value(writer_id);
+    DatabaseDataQueue::StatisticsGuid writer_guid;
+    writer_guid.guidPrefix(writer_prefix);
+    writer_guid.entityId(writer_entity_id);
+
+    // Stop the consumer so every data is processed in the same batch
+    data_queue.stop_consumer();
+    for (uint64_t count = 1; count <= 3; ++count)
+    {
+        DatabaseDataQueue::StatisticsEntityCount inner_data;
+        inner_data.guid(writer_guid);
+        inner_data.count(count);
+
+        std::shared_ptr<eprosima::fastdds::statistics::Data> data =
+                std::make_shared<eprosima::fastdds::statistics::Data>();
+        data->entity_count(inner_data);
+        data->_d(EventKind::HEARTBEAT_COUNT);
+        data_queue.push(timestamp, data);
+    }
+    data_queue.do_swap();
+    EXPECT_EQ(3u, data_queue.get_foreground_queue().size());
+
+    // Precondition: The writer exists and has ID 1
+    EXPECT_CALL(database, get_entity_by_guid(EntityKind::DATAWRITER, writer_guid_str)).Times(3)
+            .WillRepeatedly(Return(std::make_pair(EntityId(0), EntityId(1))));
+
+    // Expectation: The samples are inserted in order, and the failure of one of them does not prevent
+    // the insertion of the rest
+    std::vector<uint64_t> inserted_counts;
+    InsertDataArgs args([&](
+                const EntityId& domain_id,
+                const EntityId& entity_id,
+                const StatisticsSample& sample)
+            {
+                EXPECT_EQ(entity_id, 1);
+                EXPECT_EQ(domain_id, 0);
+                EXPECT_EQ(sample.kind, DataKind::HEARTBEAT_COUNT);
+                inserted_counts.push_back(dynamic_cast<const HeartbeatCountSample&>(sample).count);
+                if (2u == inserted_counts.back())
+                {
+                    throw BadParameter("Error");
+                }
+            });
+
+    EXPECT_CALL(database, insert(_, _, _)).Times(3)
+            .WillRepeatedly(Invoke(&args, &InsertDataArgs::insert));
+
+    // Expectation: The user is notified only of the inserted samples
+    EXPECT_CALL(*details::StatisticsBackendData::get_instance(),
+            on_data_available(EntityId(0), EntityId(1), DataKind::HEARTBEAT_COUNT)).Times(2);
+
+    EXPECT_EQ(3u, data_queue.do_process_batch());
+    EXPECT_EQ(std::vector<uint64_t>({1, 2, 3}), inserted_counts);
+}
+
+TEST_F(database_queue_tests, sharded_queue)
+{
+    std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now();
+    constexpr uint8_t writers = 8;
+    constexpr uint64_t data_per_writer = 50;
+
+    // Precondition: Each writer exists, with an ID given by the order in which they are looked up
+    std::mutex mutex;
+    std::map<std::string, EntityId> writer_ids;
+    EXPECT_CALL(database, get_entity_by_guid(EntityKind::DATAWRITER, _)).Times(AnyNumber())
+            .WillRepeatedly(Invoke([&](
+                EntityKind,
+                const std::string& guid) -> std::pair<EntityId, EntityId>
+            {
+                std::lock_guard<std::mutex> guard(mutex);
+                auto it = writer_ids.emplace(guid, EntityId(static_cast<int64_t>(writer_ids.size()) + 1)).first;
+                return std::make_pair(EntityId(0), it->second);
+            }));
+
+    // Expectation: The data of each writer are inserted in the order they were pushed
+    std::map<EntityId, std::vector<uint64_t>> inserted_counts;
+    InsertDataArgs args([&](
+                const EntityId&,
+                const EntityId& entity_id,
+                const StatisticsSample& sample)
+            {
+                std::lock_guard<std::mutex> guard(mutex);
+                inserted_counts[entity_id].push_back(dynamic_cast<const HeartbeatCountSample&>(sample).count);
+            });
+
+    EXPECT_CALL(database, insert(_, _, _)).Times(writers * data_per_writer)
+            .WillRepeatedly(Invoke(&args, &InsertDataArgs::insert));
+
+    // Expectation: The user is notified
+    EXPECT_CALL(*details::StatisticsBackendData::get_instance(),
+            on_data_available(EntityId(0), _, DataKind::HEARTBEAT_COUNT)).Times(writers * data_per_writer);
+
+    ShardedDatabaseDataQueue sharded_queue(&database, 4);
+    EXPECT_EQ(4u, sharded_queue.shard_count());
+
+    // Add the data of every writer to the queue and wait to be processed
+    for (uint64_t count = 0; count < data_per_writer; ++count)
+    {
+        for (uint8_t writer = 0; writer < writers; ++writer)
+        {
+            DatabaseDataQueue::StatisticsGuidPrefix writer_prefix;
+            writer_prefix.value({writer, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12});
+            DatabaseDataQueue::StatisticsEntityId writer_entity_id;
+            writer_entity_id.value({0, 0, 0, 2});
+            DatabaseDataQueue::StatisticsGuid writer_guid;
+            writer_guid.guidPrefix(writer_prefix);
+            writer_guid.entityId(writer_entity_id);
+
+            DatabaseDataQueue::StatisticsEntityCount inner_data;
+            inner_data.guid(writer_guid);
+            inner_data.count(count);
+
+            std::shared_ptr<eprosima::fastdds::statistics::Data> data =
+                    std::make_shared<eprosima::fastdds::statistics::Data>();
+            data->entity_count(inner_data);
+            data->_d(EventKind::HEARTBEAT_COUNT);
+            EXPECT_TRUE(sharded_queue.push(timestamp, data));
+        }
+    }
+    sharded_queue.flush();
+
+    std::vector<uint64_t> expected_counts(data_per_writer);
+    for (uint64_t count = 0; count < data_per_writer; ++count)
+    {
+        expected_counts[count] = count;
+    }
+    ASSERT_EQ(writers, inserted_counts.size());
+    for (const auto& it : inserted_counts)
+    {
+        EXPECT_EQ(expected_counts, it.second);
+    }
+
+    // The data of each writer go to a single shard, and the work is spread among several shards
+    std::size_t busy_shards = 0;
+    for (std::size_t i = 0; i < sharded_queue.shard_count(); ++i)
+    {
+        EXPECT_EQ(0u, sharded_queue.shard(i).consumed() % data_per_writer);
+        if (sharded_queue.shard(i).consumed() > 0)
+        {
+            ++busy_shards;
+        }
+    }
+    EXPECT_LT(1u, busy_shards);
+
+    // Changing the number of shards keeps the queue usable
+    sharded_queue.set_shard_count(0);
+    EXPECT_EQ(1u, sharded_queue.shard_count());
+}
+
+TEST_F(database_queue_tests, recycle_data)
+{
+    std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now();
+    constexpr uint64_t data_count = 10;
+    std::string writer_guid_str = "01.02.03.04.05.06.07.08.09.0a.0b.0c|0.0.0.2";
+
+    // Build the writer GUID
+    DatabaseDataQueue::StatisticsGuidPrefix writer_prefix;
+    writer_prefix.value({1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12});
+    DatabaseDataQueue::StatisticsEntityId writer_entity_id;
+    writer_entity_id.value({0, 0, 0, 2});
+    DatabaseDataQueue::StatisticsGuid writer_guid;
+    writer_guid.guidPrefix(writer_prefix);
+    writer_guid.entityId(writer_entity_id);
+
+    // Precondition: The writer exists and has ID 1
+    EXPECT_CALL(database, get_entity_by_guid(EntityKind::DATAWRITER, writer_guid_str)).Times(data_count + 1)
+            .WillRepeatedly(Return(std::make_pair(EntityId(0), EntityId(1))));
+
+    // Expectation: Every sample is inserted, with its own value even if the data was recycled
+    std::vector<uint64_t> inserted_counts;
+    InsertDataArgs args([&](
+                const EntityId&,
+                const EntityId&,
+                const StatisticsSample& sample)
+            {
+                inserted_counts.push_back(dynamic_cast<const HeartbeatCountSample&>(sample).count);
+            });
+
+    EXPECT_CALL(database, insert(_, _, _)).Times(data_count + 1)
+            .WillRepeatedly(Invoke(&args, &InsertDataArgs::insert));
+    EXPECT_CALL(*details::StatisticsBackendData::get_instance(),
+            on_data_available(EntityId(0), EntityId(1), DataKind::HEARTBEAT_COUNT)).Times(data_count + 1);
+
+    ShardedDatabaseDataQueue sharded_queue(&database);
+    details::ObjectPool<eprosima::fastdds::statistics::Data>& pool = sharded_queue.data_pool();
+    EXPECT_EQ(ShardedDatabaseDataQueue::DEFAULT_DATA_POOL_CAPACITY, pool.capacity());
+
+    auto push_count = [&](
+        uint64_t count) -> std::shared_ptr<eprosima::fastdds::statistics::Data>
+            {
+                DatabaseDataQueue::StatisticsEntityCount inner_data;
+                inner_data.guid(writer_guid);
+                inner_data.count(count);
+
+                std::shared_ptr<eprosima::fastdds::statistics::Data> data = pool.acquire();
+                data->entity_count(inner_data);
+                data->_d(EventKind::HEARTBEAT_COUNT);
+                sharded_queue.push(timestamp, data);
+                return data;
+            };
+
+    // Push the data with the consumer stopped, so the producer has released them once they are processed
+    sharded_queue.stop_consumer();
+    for (uint64_t count = 0; count < data_count; ++count)
+    {
+        push_count(count);
+    }
+    sharded_queue.start_consumer();
+    sharded_queue.flush();
+
+    // Expectation: The processed data are given back to the pool
+    EXPECT_EQ(data_count, pool.created());
+    EXPECT_EQ(data_count, pool.size());
+
+    // Expectation: A data still referenced by its producer is not recycled
+    std::shared_ptr<eprosima::fastdds::statistics::Data> kept = push_count(data_count);
+    sharded_queue.flush();
+    EXPECT_EQ(data_count, pool.created());
+    EXPECT_EQ(1u, pool.recycled());
+    EXPECT_EQ(data_count - 1, pool.size());
+    EXPECT_EQ(data_count, kept->entity_count().count());
+
+    std::vector<uint64_t> expected_counts(data_count + 1);
+    for (uint64_t count = 0; count <= data_count; ++count)
+    {
+        expected_counts[count] = count;
+    }
+    EXPECT_EQ(expected_counts, inserted_counts);
+}
+
+TEST_F(database_queue_tests, recycle_dropped_data)
+{
+    std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now();
+    std::string writer_guid_str = "01.02.03.04.05.06.07.08.09.0a.0b.0c|0.0.0.2";
+
+    // Build the writer GUID
+    DatabaseDataQueue::StatisticsGuidPrefix writer_prefix;
+    writer_prefix.value({1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12});
+    DatabaseDataQueue::StatisticsEntityId writer_entity_id;
+    writer_entity_id.value({0, 0, 0, 2});
+    DatabaseDataQueue::StatisticsGuid writer_guid;
+    writer_guid.guidPrefix(writer_prefix);
+    writer_guid.entityId(writer_entity_id);
+
+    // Precondition: The writer exists and has ID 1
+    EXPECT_CALL(database, get_entity_by_guid(EntityKind::DATAWRITER, writer_guid_str)).Times(2)
+            .WillRepeatedly(Return(std::make_pair(EntityId(0), EntityId(1))));
+
+    // Expectation: Only the data that fit in the queue are inserted
+    std::vector<uint64_t> inserted_counts;
+    InsertDataArgs args([&](
+                const EntityId&,
+                const EntityId&,
+                const StatisticsSample& sample)
+            {
+                inserted_counts.push_back(dynamic_cast<const HeartbeatCountSample&>(sample).count);
+            });
+
+    EXPECT_CALL(database, insert(_, _, _)).Times(2)
+            .WillRepeatedly(Invoke(&args, &InsertDataArgs::insert));
+    EXPECT_CALL(*details::StatisticsBackendData::get_instance(),
+            on_data_available(EntityId(0), EntityId(1), DataKind::HEARTBEAT_COUNT)).Times(2);
+
+    auto pool = std::make_shared<details::ObjectPool<eprosima::fastdds::statistics::Data>>(4);
+    DatabaseDataQueue dropping_queue(&database, 2, details::OverflowPolicy::DROP_OLDEST);
+    dropping_queue.set_data_pool(pool);
+
+    // Push more data than fit in the queue with the consumer stopped
+    dropping_queue.stop_consumer();
+    for (uint64_t count = 0; count < 3; ++count)
+    {
+        DatabaseDataQueue::StatisticsEntityCount inner_data;
+        inner_data.guid(writer_guid);
+        inner_data.count(count);
+
+        std::shared_ptr<eprosima::fastdds::statistics::Data> data = pool->acquire();
+        data->entity_count(inner_data);
+        data->_d(EventKind::HEARTBEAT_COUNT);
+        EXPECT_TRUE(dropping_queue.push(timestamp, data));
+    }
+
+    // Expectation: The oldest data is dropped and given back to the pool
+    EXPECT_EQ(1u, dropping_queue.dropped());
+    EXPECT_EQ(1u, pool->size());
+
+    // Expectation: The rest of the data are processed and given back to the pool too
+    dropping_queue.start_consumer();
+    dropping_queue.flush();
+    EXPECT_EQ(std::vector<uint64_t>({1, 2}), inserted_counts);
+    EXPECT_EQ(3u, pool->size());
+}
+
+TEST_F(database_queue_tests, enforce_retention_while_idle)
+{
+    // Restart the consumer so it waits for a short enforcement period
+    data_queue.stop_consumer();
+    database.retention_period_ = std::chrono::milliseconds(10);
+    uint64_t calls = database.enforce_retention_calls_.load();
+    data_queue.start_consumer();
+
+    // Expectation: The retention policy is enforced periodically without pushing any data
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (database.enforce_retention_calls_.load() < calls + 5 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_GE(database.enforce_retention_calls_.load(), calls + 5);
+
+    // Expectation: The slices are paced by the enforcement period, even if they do not finish a visit
+    data_queue.stop_consumer();
+    database.retention_period_ = std::chrono::milliseconds(50);
+    calls = database.enforce_retention_calls_.load();
+    data_queue.start_consumer();
+    std::this_thread::sleep_for(std::chrono::milliseconds(120));
+    EXPECT_LE(database.enforce_retention_calls_.load(), calls + 4);
+
+    // Expectation: The queue does not wake up while the retention policy has no limits
+    data_queue.stop_consumer();
+    database.retention_period_ = std::chrono::milliseconds(10);
+    database.retention_enabled_ = false;
+    data_queue.start_consumer();
+    calls = database.enforce_retention_calls_.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(calls, database.enforce_retention_calls_.load());
+    database.retention_enabled_ = true;
+
+    // Expectation: A queue that does not enforce the retention policy does not wake up for it
+    data_queue.stop_consumer();
+    data_queue.set_retention_enforcement(false);
+    calls = database.enforce_retention_calls_.load();
+    data_queue.start_consumer();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(calls, database.enforce_retention_calls_.load());
+}
+
 int main(
         int argc,
         char** argv)
@@ -0,0 +1,360 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <types/MPSCRingBuffer.hpp>
+
+using namespace eprosima::statistics_backend::details;
+
+namespace {
+
+//! Consume every element in the buffer, returning them in order
+template<typename T>
+std::vector<T> consume_all(
+        MPSCRingBuffer<T>& buffer)
+{
+    std::vector<T> items;
+    buffer.consume(
+        [&items](T&& item)
+        {
+            items.push_back(std::move(item));
+        },
+        buffer.capacity());
+    return items;
+}
+
+//! Type without default constructor, like the items of the discovery queue
+struct NoDefault
+{
+    explicit NoDefault(
+            int value)
+        : value(value)
+    {
+    }
+
+    int value;
+};
+
+} // namespace
+
+TEST(mpsc_ring_buffer_tests, fifo)
+{
+    MPSCRingBuffer<int> buffer(8);
+    EXPECT_TRUE(buffer.empty());
+
+    // Several laps around the buffer keep the order
+    int next_pushed = 0;
+    int next_consumed = 0;
+    for (int lap = 0; lap < 5; ++lap)
+    {
+        for (int i = 0; i < 6; ++i)
+        {
+            EXPECT_TRUE(buffer.push(next_pushed++));
+        }
+        EXPECT_EQ(6u, buffer.size());
+
+        // Consume only part of the elements
+        std::size_t consumed = buffer.consume(
+            [&next_consumed](int&& item)
+            {
+                EXPECT_EQ(next_consumed++, item);
+            },
+            4);
+        EXPECT_EQ(4u, consumed);
+        EXPECT_EQ(2u, buffer.size());
+
+        for (int item : consume_all(buffer))
+        {
+            EXPECT_EQ(next_consumed++, item);
+        }
+        EXPECT_TRUE(buffer.empty());
+    }
+    EXPECT_EQ(next_pushed, next_consumed);
+
+    // Consuming an empty buffer does nothing
+    EXPECT_EQ(0u, buffer.consume([](int&&)
+            {
+                FAIL();
+            }, 10));
+    EXPECT_EQ(0u, buffer.dropped());
+}
+
+TEST(mpsc_ring_buffer_tests, capacity)
+{
+    EXPECT_EQ(2u, MPSCRingBuffer<int>(0).capacity());
+    EXPECT_EQ(2u, MPSCRingBuffer<int>(1).capacity());
+    EXPECT_EQ(8u, MPSCRingBuffer<int>(8).capacity());
+    EXPECT_EQ(16u, MPSCRingBuffer<int>(9).capacity());
+    EXPECT_EQ(1024u, MPSCRingBuffer<int>(1000).capacity());
+}
+
+TEST(mpsc_ring_buffer_tests, drop_newest)
+{
+    MPSCRingBuffer<int> buffer(4, OverflowPolicy::DROP_NEWEST);
+    EXPECT_EQ(OverflowPolicy::DROP_NEWEST, buffer.policy());
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(buffer.push(i));
+    }
+    EXPECT_FALSE(buffer.push(4));
+    EXPECT_FALSE(buffer.push(5));
+    EXPECT_EQ(2u, buffer.dropped());
+
+    EXPECT_EQ(std::vector<int>({0, 1, 2, 3}), consume_all(buffer));
+
+    // There is room again
+    EXPECT_TRUE(buffer.push(6));
+    EXPECT_EQ(std::vector<int>({6}), consume_all(buffer));
+    EXPECT_EQ(2u, buffer.dropped());
+}
+
+TEST(mpsc_ring_buffer_tests, drop_oldest)
+{
+    MPSCRingBuffer<int> buffer(4, OverflowPolicy::DROP_OLDEST);
+    for (int i = 0; i < 7; ++i)
+    {
+        EXPECT_TRUE(buffer.push(i));
+    }
+    EXPECT_EQ(4u, buffer.size());
+    EXPECT_EQ(3u, buffer.dropped());
+
+    EXPECT_EQ(std::vector<int>({3, 4, 5, 6}), consume_all(buffer));
+}
+
+TEST(mpsc_ring_buffer_tests, drop_oldest_handler)
+{
+    // The elements dropped to make room are handed to the handler instead of destroyed
+    MPSCRingBuffer<int> buffer(4, OverflowPolicy::DROP_OLDEST);
+    std::vector<int> dropped;
+    for (int i = 0; i < 7; ++i)
+    {
+        EXPECT_TRUE(buffer.push(i, [&dropped](int&& item)
+                {
+                    dropped.push_back(item);
+                }));
+    }
+    EXPECT_EQ(std::vector<int>({0, 1, 2}), dropped);
+    EXPECT_EQ(3u, buffer.dropped());
+
+    EXPECT_EQ(std::vector<int>({3, 4, 5, 6}), consume_all(buffer));
+}
+
+TEST(mpsc_ring_buffer_tests, block)
+{
+    MPSCRingBuffer<int> buffer(2, OverflowPolicy::BLOCK);
+    EXPECT_TRUE(buffer.push(0));
+    EXPECT_TRUE(buffer.push(1));
+
+    std::atomic<bool> pushed(false);
+    std::thread producer([&]()
+            {
+                EXPECT_TRUE(buffer.push(2));
+                pushed = true;
+            });
+
+    // The producer waits while the buffer is full
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(pushed);
+
+    std::vector<int> items;
+    EXPECT_EQ(1u, buffer.consume(
+                [&items](int&& item)
+                {
+                    items.push_back(item);
+                }, 1));
+    producer.join();
+    EXPECT_TRUE(pushed);
+
+    for (int item : consume_all(buffer))
+    {
+        items.push_back(item);
+    }
+    EXPECT_EQ(std::vector<int>({0, 1, 2}), items);
+    EXPECT_EQ(0u, buffer.dropped());
+}
+
+TEST(mpsc_ring_buffer_tests, non_default_constructible)
+{
+    MPSCRingBuffer<NoDefault> buffer(4, OverflowPolicy::DROP_OLDEST);
+    for (int i = 0; i < 6; ++i)
+    {
+        buffer.push(NoDefault(i));
+    }
+
+    std::vector<int> values;
+    for (const auto& item : consume_all(buffer))
+    {
+        values.push_back(item.value);
+    }
+    EXPECT_EQ(std::vector<int>({2, 3, 4, 5}), values);
+}
+
+TEST(mpsc_ring_buffer_tests, destroy_pending)
+{
+    // Elements are destroyed when consumed, dropped, or when the buffer is destroyed
+    auto tracker = std::make_shared<int>(0);
+    {
+        MPSCRingBuffer<std::shared_ptr<int>> buffer(2, OverflowPolicy::DROP_OLDEST);
+        buffer.push(tracker);
+        buffer.push(tracker);
+        buffer.push(tracker);
+        EXPECT_EQ(3, tracker.use_count());
+
+        consume_all(buffer);
+        EXPECT_EQ(1, tracker.use_count());
+
+        buffer.push(tracker);
+        buffer.push(tracker);
+        EXPECT_EQ(3, tracker.use_count());
+    }
+    EXPECT_EQ(1, tracker.use_count());
+}
+
+TEST(mpsc_ring_buffer_tests, throwing_consumer)
+{
+    // An element whose consumer throws is removed, and the rest of the buffer is still usable
+    MPSCRingBuffer<int> buffer(2, OverflowPolicy::DROP_NEWEST);
+    EXPECT_TRUE(buffer.push(0));
+    EXPECT_TRUE(buffer.push(1));
+
+    EXPECT_THROW(buffer.consume(
+                [](int&&)
+                {
+                    throw std::runtime_error("consumer error");
+                }, 1), std::runtime_error);
+    EXPECT_EQ(1u, buffer.size());
+
+    EXPECT_TRUE(buffer.push(2));
+    EXPECT_FALSE(buffer.push(3));
+    EXPECT_EQ(std::vector<int>({1, 2}), consume_all(buffer));
+    EXPECT_TRUE(buffer.push(4));
+    EXPECT_EQ(std::vector<int>({4}), consume_all(buffer));
+}
+
+TEST(mpsc_ring_buffer_tests, multiple_producers)
+{
+    constexpr int producers = 4;
+    constexpr int items_per_producer = 20000;
+
+    for (auto policy : {OverflowPolicy::BLOCK, OverflowPolicy::DROP_OLDEST, OverflowPolicy::DROP_NEWEST})
+    {
+        MPSCRingBuffer<std::pair<int, int>> buffer(64, policy);
+
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p)
+        {
+            threads.emplace_back([&buffer, p]()
+                    {
+                        for (int i = 0; i < items_per_producer; ++i)
+                        {
+                            buffer.push(std::make_pair(p, i));
+                        }
+                    });
+        }
+
+        // Each producer's elements are received in order, and none is lost unless counted as dropped
+        std::vector<int> last(producers, -1);
+        std::size_t received = 0;
+        std::atomic<int> finished(0);
+        std::thread joiner([&]()
+                {
+                    for (auto& thread : threads)
+                    {
+                        thread.join();
+                    }
+                    finished = 1;
+                });
+
+        auto check = [&](std::pair<int, int>&& item)
+                {
+                    EXPECT_LT(last[item.first], item.second);
+                    last[item.first] = item.second;
+                    ++received;
+                };
+        while (!finished)
+        {
+            buffer.consume(check, buffer.capacity());
+        }
+        joiner.join();
+        buffer.consume(check, buffer.capacity());
+
+        EXPECT_TRUE(buffer.empty());
+        EXPECT_EQ(static_cast<std::size_t>(producers * items_per_producer), received + buffer.dropped());
+        if (OverflowPolicy::BLOCK == policy)
+        {
+            EXPECT_EQ(0u, buffer.dropped());
+        }
+    }
+}
+
+TEST(mpsc_ring_buffer_tests, oversubscribed_producers)
+{
+    // With more producers than processors, a producer waiting for a slot held by a preempted thread must let it run
+    const int producers = 2 * static_cast<int>((std::max)(2u, std::thread::hardware_concurrency()));
+    constexpr int items_per_producer = 5000;
+
+    for (auto policy : {OverflowPolicy::BLOCK, OverflowPolicy::DROP_OLDEST})
+    {
+        MPSCRingBuffer<std::string> buffer(2, policy);
+
+        std::atomic<int> running(producers);
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p)
+        {
+            threads.emplace_back([&buffer, &running]()
+                    {
+                        for (int i = 0; i < items_per_producer; ++i)
+                        {
+                            buffer.push(std::to_string(i));
+                        }
+                        --running;
+                    });
+        }
+
+        std::size_t received = 0;
+        while (running > 0)
+        {
+            received += buffer.consume([](std::string&&)
+                            {
+                            }, buffer.capacity());
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        received += buffer.consume([](std::string&&)
+                        {
+                        }, buffer.capacity());
+
+        EXPECT_EQ(static_cast<std::size_t>(producers * items_per_producer), received + buffer.dropped());
+    }
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
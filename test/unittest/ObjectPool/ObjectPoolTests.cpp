@@ -0,0 +1,192 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <types/ObjectPool.hpp>
+
+using namespace eprosima::statistics_backend::details;
+
+TEST(object_pool_tests, recycle)
+{
+    ObjectPool<std::string> pool(4);
+    EXPECT_EQ(4u, pool.capacity());
+    EXPECT_EQ(0u, pool.size());
+
+    std::shared_ptr<std::string> object = pool.acquire();
+    ASSERT_TRUE(object);
+    EXPECT_EQ(1, object.use_count());
+    *object = "recycled value";
+    std::string* address = object.get();
+
+    pool.release(std::move(object));
+    EXPECT_FALSE(object);
+    EXPECT_EQ(1u, pool.size());
+
+    // The same object is handed out again, keeping its value
+    std::shared_ptr<std::string> recycled = pool.acquire();
+    EXPECT_EQ(address, recycled.get());
+    EXPECT_EQ("recycled value", *recycled);
+    EXPECT_EQ(0u, pool.size());
+    EXPECT_EQ(1u, pool.created());
+    EXPECT_EQ(1u, pool.recycled());
+}
+
+TEST(object_pool_tests, create_when_empty)
+{
+    ObjectPool<int> pool(4);
+
+    std::vector<std::shared_ptr<int>> objects;
+    for (int i = 0; i < 3; ++i)
+    {
+        objects.push_back(pool.acquire());
+    }
+    EXPECT_NE(objects[0].get(), objects[1].get());
+    EXPECT_NE(objects[1].get(), objects[2].get());
+    EXPECT_EQ(3u, pool.created());
+    EXPECT_EQ(0u, pool.recycled());
+
+    for (auto& object : objects)
+    {
+        pool.release(std::move(object));
+    }
+    EXPECT_EQ(3u, pool.size());
+
+    // The released objects are recycled before creating new ones
+    for (int i = 0; i < 4; ++i)
+    {
+        objects[i % 3] = pool.acquire();
+    }
+    EXPECT_EQ(4u, pool.created());
+    EXPECT_EQ(3u, pool.recycled());
+}
+
+TEST(object_pool_tests, capacity)
+{
+    ObjectPool<int> pool(2);
+
+    std::vector<std::shared_ptr<int>> objects;
+    for (int i = 0; i < 4; ++i)
+    {
+        objects.push_back(pool.acquire());
+    }
+
+    // Objects released into a full pool are destroyed
+    std::weak_ptr<int> last = objects.back();
+    for (auto& object : objects)
+    {
+        pool.release(std::move(object));
+        EXPECT_FALSE(object);
+    }
+    EXPECT_EQ(2u, pool.size());
+    EXPECT_TRUE(last.expired());
+
+    // A pool without capacity never recycles
+    ObjectPool<int> no_pool(0);
+    std::shared_ptr<int> object = no_pool.acquire();
+    no_pool.release(std::move(object));
+    EXPECT_EQ(0u, no_pool.size());
+    object = no_pool.acquire();
+    EXPECT_EQ(2u, no_pool.created());
+    EXPECT_EQ(0u, no_pool.recycled());
+}
+
+TEST(object_pool_tests, shared_not_recycled)
+{
+    ObjectPool<std::string> pool(4);
+
+    std::shared_ptr<std::string> object = pool.acquire();
+    std::shared_ptr<std::string> other_owner = object;
+    *object = "in use";
+
+    // An object still in use elsewhere cannot be handed out again
+    pool.release(std::move(object));
+    EXPECT_FALSE(object);
+    EXPECT_EQ(0u, pool.size());
+    EXPECT_EQ(1, other_owner.use_count());
+    EXPECT_EQ("in use", *other_owner);
+
+    // Once it is no longer shared, it is recycled
+    pool.release(std::move(other_owner));
+    EXPECT_EQ(1u, pool.size());
+
+    // Objects not acquired from the pool are recycled too
+    pool.release(std::make_shared<std::string>("external"));
+    EXPECT_EQ(2u, pool.size());
+}
+
+TEST(object_pool_tests, release_empty)
+{
+    ObjectPool<int> pool(4);
+
+    pool.release(std::shared_ptr<int>());
+    EXPECT_EQ(0u, pool.size());
+}
+
+TEST(object_pool_tests, multiple_threads)
+{
+    constexpr int threads_count = 4;
+    constexpr int iterations = 10000;
+    constexpr int objects_per_iteration = 4;
+
+    ObjectPool<std::vector<int>> pool(threads_count * objects_per_iteration);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threads_count; ++t)
+    {
+        threads.emplace_back(
+            [&pool, t]()
+            {
+                std::vector<std::shared_ptr<std::vector<int>>> objects(objects_per_iteration);
+                for (int i = 0; i < iterations; ++i)
+                {
+                    for (auto& object : objects)
+                    {
+                        object = pool.acquire();
+                        ASSERT_EQ(1, object.use_count());
+                        object->assign(8, t);
+                    }
+                    for (auto& object : objects)
+                    {
+                        // No other thread got the same object
+                        ASSERT_EQ(std::vector<int>(8, t), *object);
+                        pool.release(std::move(object));
+                    }
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // Every object in the pool was created once, then always recycled
+    EXPECT_LE(pool.created(), static_cast<uint64_t>(threads_count * objects_per_iteration));
+    EXPECT_EQ(static_cast<uint64_t>(threads_count * iterations * objects_per_iteration),
+            pool.created() + pool.recycled());
+    EXPECT_EQ(pool.created(), pool.size());
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -103,6 +103,46 @@ TEST(backend_dump_tests, database_dump_load)
             BadParameter);
 }
 
+// Test the incremental dumps appended to a file, and the load of all of them
+TEST(backend_dump_tests, database_delta_dump_load)
+{
+    constexpr const char* TEST_DUMP_FILE = "test_delta_dump.json";
+    constexpr const char* NON_EXISTENT_FILE = "/this_directory_does_not_exist/test_delta_dump.json";
+
+    // Check if the output file exists (we do not want to overwrite anything)
+    std::ifstream file(TEST_DUMP_FILE);
+    if (file.good())
+    {
+        FAIL() << "File " << TEST_DUMP_FILE << " exists in the testing directory";
+        return;
+    }
+
+    // The first incremental dump holds the whole database
+    StatisticsBackend::load_database(SIMPLE_DUMP_FILE);
+    DatabaseDump expected = details::StatisticsBackendData::get_instance()->database_->dump_database();
+    DumpWatermark watermark = StatisticsBackend::dump_database_delta(TEST_DUMP_FILE);
+
+    // Nothing has changed, so the next one does not move the watermark
+    DumpWatermark next_watermark = StatisticsBackend::dump_database_delta(TEST_DUMP_FILE, watermark);
+    EXPECT_EQ(watermark.epoch, next_watermark.epoch);
+    EXPECT_EQ(watermark.next_entity_id, next_watermark.next_entity_id);
+
+    // Load the base dump followed by the incremental one
+    StatisticsBackend::reset();
+    StatisticsBackend::load_database(TEST_DUMP_FILE);
+    DatabaseDump dump = details::StatisticsBackendData::get_instance()->database_->dump_database();
+    EXPECT_EQ(expected, dump);
+
+    // Remove the dump file
+    std::remove(TEST_DUMP_FILE);
+
+    // Try dumping on a non-existent directory
+    ASSERT_THROW(StatisticsBackend::dump_database_delta(NON_EXISTENT_FILE),
+            BadParameter);
+
+    StatisticsBackend::reset();
+}
+
 // Test the dump of a database with a clear of the statistics data
 TEST(backend_dump_tests, database_dump_and_clear)
 {
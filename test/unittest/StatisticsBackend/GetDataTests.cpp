@@ -2865,6 +2865,210 @@ TEST_P(get_data_with_data_tests, get_median_data)
     }
 }
 
+TEST_P(get_data_with_data_tests, get_percentile_data)
+{
+    DataKind data_type = std::get<0>(GetParam());
+    EntityId entity1 = std::get<1>(GetParam());
+    EntityId entity2 = std::get<2>(GetParam());
+
+    // The expected values of the bins with several samples are given for each of these statistics, in this order.
+    // The percentiles are interpolated between the closest ranks of the samples in the bin, so the bins with a single
+    // sample give that sample for every percentile.
+    const std::vector<StatisticKind> percentiles = {
+        StatisticKind::PERCENTILE_50,
+        StatisticKind::PERCENTILE_90,
+        StatisticKind::PERCENTILE_99,
+        StatisticKind::PERCENTILE_99_9};
+
+    std::vector<StatisticsData> expected;
+    Timestamp start;
+    Timestamp finish;
+
+    bool data_kind = false;
+    switch (data_type)
+    {
+        default:
+            GTEST_SKIP();
+            break;
+
+        case DataKind::RTPS_BYTES_LOST:
+        case DataKind::RTPS_BYTES_SENT:
+        case DataKind::RTPS_PACKETS_LOST:
+        case DataKind::RTPS_PACKETS_SENT:
+        case DataKind::ACKNACK_COUNT:
+        case DataKind::NACKFRAG_COUNT:
+        case DataKind::DATA_COUNT:
+        case DataKind::GAP_COUNT:
+        case DataKind::HEARTBEAT_COUNT:
+        case DataKind::RESENT_DATA:
+        case DataKind::EDP_PACKETS:
+        case DataKind::PDP_PACKETS:
+        case DataKind::SAMPLE_DATAS:
+        case DataKind::DISCOVERY_TIME:
+            break;
+
+        case DataKind::SUBSCRIPTION_THROUGHPUT:
+        case DataKind::PUBLICATION_THROUGHPUT:
+        case DataKind::NETWORK_LATENCY:
+        case DataKind::FASTDDS_LATENCY:
+            data_kind = true;
+            break;
+    }
+
+    for (size_t p = 0; p < percentiles.size(); ++p)
+    {
+        StatisticKind statistic = percentiles[p];
+
+        if (!data_kind)
+        {
+            // The samples alternate between 2 and 0, starting with 2 at 1000 ns
+            double multiplier = (DataKind::DISCOVERY_TIME == data_type) ? 1000.0 : 1.0;
+
+            /************* Time span smaller than available data ******************/
+            start = the_initial_time() + nanoseconds_to_systemclock_duration(4000);
+            finish = the_initial_time() + nanoseconds_to_systemclock_duration(9000);
+
+            // Testing with a single bin: 0, 0, 0, 2, 2
+            fill_expected_result(expected, start, finish, 1);
+            expected[0].second = std::vector<double>{0.0, 2.0, 2.0, 2.0}[p] * multiplier;
+
+            check_get_data(data_type, entity1, entity2, start, finish, 1, statistic, expected);
+
+            // Testing with 5 bins, each with a single sample
+            fill_expected_result(expected, start, finish, 5);
+            expected[0].second = 0.0;
+            expected[1].second = 2.0 * multiplier;
+            expected[2].second = 0.0;
+            expected[3].second = 2.0 * multiplier;
+            expected[4].second = 0.0;
+
+            check_get_data(data_type, entity1, entity2, start, finish, 5, statistic, expected);
+
+            // Testing with 10 bins, half of them empty
+            fill_expected_result(expected, start, finish, 10);
+            expected[0].second = 0.0;
+            expected[2].second = 2.0 * multiplier;
+            expected[4].second = 0.0;
+            expected[6].second = 2.0 * multiplier;
+            expected[8].second = 0.0;
+
+            check_get_data(data_type, entity1, entity2, start, finish, 10, statistic, expected);
+
+            /************* Time span larger than available data ******************/
+            start = the_initial_time() + nanoseconds_to_systemclock_duration(0);
+            finish = the_initial_time() + nanoseconds_to_systemclock_duration(20000);
+
+            // Testing with a single bin: 0, 0, 0, 0, 0, 2, 2, 2, 2, 2
+            fill_expected_result(expected, start, finish, 1);
+            expected[0].second = std::vector<double>{1.0, 2.0, 2.0, 2.0}[p] * multiplier;
+
+            check_get_data(data_type, entity1, entity2, start, finish, 1, statistic, expected);
+
+            // Testing with 5 bins: {0, 2, 2}, {0, 0, 2, 2}, {0, 0, 2} and two empty bins
+            fill_expected_result(expected, start, finish, 5);
+            expected[0].second = 2.0 * multiplier;
+            expected[1].second = std::vector<double>{1.0, 2.0, 2.0, 2.0}[p] * multiplier;
+            expected[2].second = std::vector<double>{0.0, 1.6, 1.96, 1.996}[p] * multiplier;
+
+            check_get_data(data_type, entity1, entity2, start, finish, 5, statistic, expected);
+
+            // Testing with 10 bins: {2}, four times {0, 2}, {0} and four empty bins
+            fill_expected_result(expected, start, finish, 10);
+            expected[0].second = 2.0 * multiplier;
+            for (size_t i = 1; i < 5; ++i)
+            {
+                expected[i].second = std::vector<double>{1.0, 1.8, 1.98, 1.998}[p] * multiplier;
+            }
+            expected[5].second = 0.0;
+
+            check_get_data(data_type, entity1, entity2, start, finish, 10, statistic, expected);
+
+            // Testing with 100 bins, each with a single sample or empty
+            fill_expected_result(expected, start, finish, 100);
+            for (size_t i = 5; i <= 50; i += 10)
+            {
+                expected[i].second = 2.0 * multiplier;
+                expected[i + 5].second = 0.0;
+            }
+
+            check_get_data(data_type, entity1, entity2, start, finish, 100, statistic, expected);
+        }
+        else
+        {
+            // The samples alternate between 1 and 5.5, starting with 1 at 1000 ns
+
+            /************* Time span smaller than available data ******************/
+            start = the_initial_time() + nanoseconds_to_systemclock_duration(4000);
+            finish = the_initial_time() + nanoseconds_to_systemclock_duration(9000);
+
+            // Testing with a single bin: 1, 1, 5.5, 5.5, 5.5
+            fill_expected_result(expected, start, finish, 1);
+            expected[0].second = 5.5;
+
+            check_get_data(data_type, entity1, entity2, start, finish, 1, statistic, expected);
+
+            // Testing with 5 bins, each with a single sample
+            fill_expected_result(expected, start, finish, 5);
+            expected[0].second = 5.5;
+            expected[1].second = 1.0;
+            expected[2].second = 5.5;
+            expected[3].second = 1.0;
+            expected[4].second = 5.5;
+
+            check_get_data(data_type, entity1, entity2, start, finish, 5, statistic, expected);
+
+            // Testing with 10 bins, half of them empty
+            fill_expected_result(expected, start, finish, 10);
+            expected[0].second = 5.5;
+            expected[2].second = 1.0;
+            expected[4].second = 5.5;
+            expected[6].second = 1.0;
+            expected[8].second = 5.5;
+
+            check_get_data(data_type, entity1, entity2, start, finish, 10, statistic, expected);
+
+            /************* Time span larger than available data ******************/
+            start = the_initial_time() + nanoseconds_to_systemclock_duration(0);
+            finish = the_initial_time() + nanoseconds_to_systemclock_duration(20000);
+
+            // Testing with a single bin: 1, 1, 1, 1, 1, 5.5, 5.5, 5.5, 5.5, 5.5
+            fill_expected_result(expected, start, finish, 1);
+            expected[0].second = std::vector<double>{3.25, 5.5, 5.5, 5.5}[p];
+
+            check_get_data(data_type, entity1, entity2, start, finish, 1, statistic, expected);
+
+            // Testing with 5 bins: {1, 1, 5.5}, {1, 1, 5.5, 5.5}, {1, 5.5, 5.5} and two empty bins
+            fill_expected_result(expected, start, finish, 5);
+            expected[0].second = std::vector<double>{1.0, 4.6, 5.41, 5.491}[p];
+            expected[1].second = std::vector<double>{3.25, 5.5, 5.5, 5.5}[p];
+            expected[2].second = 5.5;
+
+            check_get_data(data_type, entity1, entity2, start, finish, 5, statistic, expected);
+
+            // Testing with 10 bins: {1}, four times {1, 5.5}, {5.5} and four empty bins
+            fill_expected_result(expected, start, finish, 10);
+            expected[0].second = 1.0;
+            for (size_t i = 1; i < 5; ++i)
+            {
+                expected[i].second = std::vector<double>{3.25, 5.05, 5.455, 5.4955}[p];
+            }
+            expected[5].second = 5.5;
+
+            check_get_data(data_type, entity1, entity2, start, finish, 10, statistic, expected);
+
+            // Testing with 100 bins, each with a single sample or empty
+            fill_expected_result(expected, start, finish, 100);
+            for (size_t i = 5; i <= 50; i += 10)
+            {
+                expected[i].second = 1.0;
+                expected[i + 5].second = 5.5;
+            }
+
+            check_get_data(data_type, entity1, entity2, start, finish, 100, statistic, expected);
+        }
+    }
+}
+
 TEST_P(get_data_with_data_tests, get_stdev_data)
 {
     DataKind data_type = std::get<0>(GetParam());
@@ -3339,6 +3543,130 @@ TEST_P(get_data_unsupported_entities_tests, unsupported_entity_kind)
     }
 }
 
+class get_data_rollup_tests
+    : public get_data_tests_base
+    , public ::testing::Test
+{
+    // Tests comparing the data computed from the rollups with the data computed from every sample
+};
+
+TEST_F(get_data_rollup_tests, rollups_match_samples)
+{
+    Database* db = details::StatisticsBackendData::get_instance()->database_.get();
+    EntityId writer_id(16);
+    EntityId domain_id = StatisticsBackend::get_entities(EntityKind::DOMAIN, writer_id)[0];
+
+    // Ten seconds of publication throughput, after the one of the loaded database, every 10 milliseconds:
+    //   * The first second has only NaN values.
+    //   * The second second has no values.
+    //   * The third second has the same value repeated, whose variance may be rounded to a negative number.
+    //   * The rest of the seconds have a NaN value every seven, which is the last value of the fourth second.
+    Timestamp start = the_initial_time() + std::chrono::seconds(100);
+    for (int i = 0; i < 1000; ++i)
+    {
+        PublicationThroughputSample sample;
+        sample.src_ts = start + std::chrono::milliseconds(10 * i);
+        if (i < 100 || (i >= 300 && 0 == i % 7))
+        {
+            sample.data = std::numeric_limits<double>::quiet_NaN();
+        }
+        else if (i < 200)
+        {
+            continue;
+        }
+        else if (i < 300)
+        {
+            sample.data = 0.1;
+        }
+        else
+        {
+            sample.data = (i % 11) * 1.5;
+        }
+        db->insert(domain_id, writer_id, sample);
+    }
+
+    const std::vector<StatisticKind> statistics = {
+        StatisticKind::COUNT,
+        StatisticKind::SUM,
+        StatisticKind::MEAN,
+        StatisticKind::MAX,
+        StatisticKind::MIN,
+        StatisticKind::STANDARD_DEVIATION};
+
+    // Bins aligned with the rollups, and bins whose edges are computed from the samples
+    struct Query
+    {
+        Timestamp t_from;
+        Timestamp t_to;
+        uint16_t bins;
+    };
+    const std::vector<Query> queries = {
+        {start, start + std::chrono::seconds(10), 10},
+        {start, start + std::chrono::seconds(10), 20},
+        {start + std::chrono::milliseconds(250), start + std::chrono::milliseconds(9250), 9}};
+
+    auto get_all_data = [&]()
+            {
+                std::vector<std::vector<StatisticsData>> results;
+                for (const Query& query : queries)
+                {
+                    for (StatisticKind statistic : statistics)
+                    {
+                        results.push_back(StatisticsBackend::get_data(DataKind::PUBLICATION_THROUGHPUT,
+                                std::vector<EntityId>(1, writer_id), query.bins, query.t_from, query.t_to, statistic));
+                    }
+                }
+                return results;
+            };
+
+    auto from_samples = get_all_data();
+    StatisticsBackend::set_rollup_resolutions({std::chrono::milliseconds(100), std::chrono::seconds(1)});
+    auto from_rollups = get_all_data();
+
+    ASSERT_EQ(from_samples.size(), from_rollups.size());
+    for (size_t i = 0; i < from_samples.size(); ++i)
+    {
+        ASSERT_EQ(from_samples[i].size(), from_rollups[i].size());
+        for (size_t bin = 0; bin < from_samples[i].size(); ++bin)
+        {
+            EXPECT_EQ(from_samples[i][bin].first, from_rollups[i][bin].first);
+            if (std::isnan(from_samples[i][bin].second))
+            {
+                EXPECT_TRUE(std::isnan(from_rollups[i][bin].second));
+            }
+            else
+            {
+                EXPECT_NEAR(from_samples[i][bin].second, from_rollups[i][bin].second, 1e-6);
+            }
+        }
+    }
+
+    // The NaN values are counted, and the bins whose last value is NaN, like the one with only NaN values,
+    // give NaN as the bin with no values does
+    for (size_t s = 0; s < statistics.size(); ++s)
+    {
+        for (size_t bin : {0, 1, 3})
+        {
+            if (StatisticKind::COUNT == statistics[s])
+            {
+                EXPECT_EQ(1 == bin ? 0.0 : 100.0, from_rollups[s][bin].second);
+            }
+            else
+            {
+                EXPECT_TRUE(std::isnan(from_rollups[s][bin].second));
+            }
+        }
+    }
+
+    // A NaN value restarts the sum, minimum and maximum of the bin, and gives a NaN deviation
+    EXPECT_FALSE(std::isnan(from_rollups[1][4].second));
+    EXPECT_FALSE(std::isnan(from_rollups[4][4].second));
+    EXPECT_TRUE(std::isnan(from_rollups[5][4].second));
+
+    // The bin with the same value repeated has no deviation
+    EXPECT_NEAR(0.0, from_rollups[5][2].second, 1e-6);
+}
+
 int main(
         int argc,
         char** argv)
@@ -57,7 +57,7 @@ public:
         StatisticsBackendTest::set_database(db);
 
         entity_queue = new DatabaseEntityQueue(db);
-        data_queue = new DatabaseDataQueue(db);
+        data_queue = new ShardedDatabaseDataQueue(db);
         participant_listener = new StatisticsParticipantListener(domain->id, db, entity_queue, data_queue);
 
         // Simulate that the backend is monitorizing the domain
@@ -130,7 +130,7 @@ public:
     // Entity queue, attached to the database
     DatabaseEntityQueue* entity_queue = nullptr;
     // Data queue, attached to the database
-    DatabaseDataQueue* data_queue = nullptr;
+    ShardedDatabaseDataQueue* data_queue = nullptr;
     // Statistics participant_, that is supposed to receive the callbacks
     eprosima::fastdds::dds::DomainParticipant statistics_participant;
     // Listener under tests. Will receive a pointer to statistics_participant
@@ -79,7 +79,7 @@ public:
     DatabaseEntityQueue entity_queue;
 
     // Data queue, attached to the mocked database
-    DatabaseDataQueue data_queue;
+    ShardedDatabaseDataQueue data_queue;
 
     // Mocked statistics participant_, that is supposed to receive the callbacks
     eprosima::fastdds::dds::DomainParticipant statistics_participant;
@@ -73,19 +73,30 @@ class statistics_reader_listener_tests : public ::testing::Test
 public:
 
     Database database_;
-    DatabaseDataQueue data_queue_;
+    ShardedDatabaseDataQueue data_queue_;
     eprosima::statistics_backend::DataKindMask data_mask_;
-    StatisticsReaderListener reader_listener_;
+    std::map<std::string, std::unique_ptr<StatisticsReaderListener>> reader_listeners_;
     eprosima::fastdds::dds::DataReader datareader_;
 
     statistics_reader_listener_tests()
         : database_()
         , data_queue_(&database_)
         , data_mask_(eprosima::statistics_backend::DataKindMask::all())
-        , reader_listener_(&data_queue_)
     {
     }
 
+    // Get the listener of the reader of the topic currently set on the datareader
+    StatisticsReaderListener& reader_listener()
+    {
+        std::string topic_name = datareader_.get_topicdescription()->get_name();
+        auto& listener = reader_listeners_[topic_name];
+        if (!listener)
+        {
+            listener.reset(new StatisticsReaderListener(&data_queue_, topic_name));
+        }
+        return *listener;
+    }
+
     void add_sample_to_reader_history(
             std::shared_ptr<StatisticsData> data,
             std::shared_ptr<SampleInfo> info)
@@ -129,7 +140,7 @@ TEST_F(statistics_reader_listener_tests, not_valid_data)
 
         add_sample_to_reader_history(data, info);
         datareader_.set_topic_name(HISTORY_LATENCY_TOPIC);
-        reader_listener_.on_data_available(&datareader_);
+        reader_listener().on_data_available(&datareader_);
         data_queue_.flush();
     }
 
@@ -141,7 +152,7 @@ TEST_F(statistics_reader_listener_tests, not_valid_data)
         // Insert the data on the queue and wait until processed
         add_sample_to_reader_history(data, info);
         datareader_.set_topic_name(NETWORK_LATENCY_TOPIC);
-        reader_listener_.on_data_available(&datareader_);
+        reader_listener().on_data_available(&datareader_);
         data_queue_.flush();
     }
 
@@ -153,13 +164,13 @@ TEST_F(statistics_reader_listener_tests, not_valid_data)
         // Insert the data on the queue and wait until processed
         add_sample_to_reader_history(data, info);
         datareader_.set_topic_name(PUBLICATION_THROUGHPUT_TOPIC);
-        reader_listener_.on_data_available(&datareader_);
+        reader_listener().on_data_available(&datareader_);
         data_queue_.flush();
 
         // Insert the data on the queue and wait until processed
         add_sample_to_reader_history(data, info);
         datareader_.set_topic_name(SUBSCRIPTION_THROUGHPUT_TOPIC);
-        reader_listener_.on_data_available(&datareader_);
+        reader_listener().on_data_available(&datareader_);
         data_queue_.flush();
     }
 
@@ -171,13 +182,13 @@ TEST_F(statistics_reader_listener_tests, not_valid_data)
         // Insert the data on the queue and wait until processed
         add_sample_to_reader_history(data, info);
         datareader_.set_topic_name(RTPS_SENT_TOPIC);
-        reader_listener_.on_data_available(&datareader_);
+        reader_listener().on_data_available(&datareader_);
         data_queue_.flush();
 
         // Insert the data on the queue and wait until processed
         add_sample_to_reader_history(data, info);
         datareader_.set_topic_name(RTPS_LOST_TOPIC);
-        reader_listener_.on_data_available(&datareader_);
+        reader_listener().on_data_available(&datareader_);
         data_queue_.flush();
     }
 
@@ -189,49 +200,49 @@ TEST_F(statistics_reader_listener_tests, not_valid_data)
         // Insert the data on the queue and wait until processed
         add_sample_to_reader_history(data, info);
         datareader_.set_topic_name(RESENT_DATAS_TOPIC);
-        reader_listener_.on_data_available(&datareader_);
+        reader_listener().on_data_available(&datareader_);
         data_queue_.flush();
 
         // Insert the data on the queue and wait until processed
         add_sample_to_reader_history(data, info);
         datareader_.set_topic_name(HEARTBEAT_COUNT_TOPIC);
-        reader_listener_.on_data_available(&datareader_);
+        reader_listener().on_data_available(&datareader_);
         data_queue_.flush();
 
         // Insert the data on the queue and wait until processed
         add_sample_to_reader_history(data, info);
         datareader_.set_topic_name(ACKNACK_COUNT_TOPIC);
-        reader_listener_.on_data_available(&datareader_);
+        reader_listener().on_data_available(&datareader_);
         data_queue_.flush();
 
         // Insert the data on the queue and wait until processed
         add_sample_to_reader_history(data, info);
         datareader_.set_topic_name(NACKFRAG_COUNT_TOPIC);
-        reader_listener_.on_data_available(&datareader_);
+        reader_listener().on_data_available(&datareader_);
         data_queue_.flush();
 
         // Insert the data on the queue and wait until processed
         add_sample_to_reader_history(data, info);
         datareader_.set_topic_name(GAP_COUNT_TOPIC);
-        reader_listener_.on_data_available(&datareader_);
+        reader_listener().on_data_available(&datareader_);
         data_queue_.flush();
 
         // Insert the data on the queue and wait until processed
         add_sample_to_reader_history(data, info);
         datareader_.set_topic_name(DATA_COUNT_TOPIC);
-        reader_listener_.on_data_available(&datareader_);
+        reader_listener().on_data_available(&datareader_);
         data_queue_.flush();
 
         // Insert the data on the queue and wait until processed
         add_sample_to_reader_history(data, info);
         datareader_.set_topic_name(PDP_PACKETS_TOPIC);
-        reader_listener_.on_data_available(&datareader_);
+        reader_listener().on_data_available(&datareader_);
         data_queue_.flush();
 
         // Insert the data on the queue and wait until processed
         add_sample_to_reader_history(data, info);
         datareader_.set_topic_name(EDP_PACKETS_TOPIC);
-        reader_listener_.on_data_available(&datareader_);
+        reader_listener().on_data_available(&datareader_);
         data_queue_.flush();
     }
 
@@ -243,7 +254,7 @@ TEST_F(statistics_reader_listener_tests, not_valid_data)
         // Insert the data on the queue and wait until processed
         add_sample_to_reader_history(data, info);
         datareader_.set_topic_name(DISCOVERY_TOPIC);
-        reader_listener_.on_data_available(&datareader_);
+        reader_listener().on_data_available(&datareader_);
         data_queue_.flush();
     }
 
@@ -255,7 +266,7 @@ TEST_F(statistics_reader_listener_tests, not_valid_data)
         // Insert the data on the queue and wait until processed
         add_sample_to_reader_history(data, info);
         datareader_.set_topic_name(SAMPLE_DATAS_TOPIC);
-        reader_listener_.on_data_available(&datareader_);
+        reader_listener().on_data_available(&datareader_);
         data_queue_.flush();
     }
 
@@ -267,12 +278,12 @@ TEST_F(statistics_reader_listener_tests, not_valid_data)
         // Insert the data on the queue and wait until processed
         add_sample_to_reader_history(data, info);
         datareader_.set_topic_name(PHYSICAL_DATA_TOPIC);
-        reader_listener_.on_data_available(&datareader_);
+        reader_listener().on_data_available(&datareader_);
         data_queue_.flush();
     }
 
     // Try again now with an empty queue
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 }
 
@@ -340,12 +351,12 @@ TEST_F(statistics_reader_listener_tests, new_history_latency_received)
 
     // Insert the data on the queue and wait until processed
     datareader_.set_topic_name(HISTORY_LATENCY_TOPIC);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 
     // Expectation: The insert method is not called if there is no data in the queue
     EXPECT_CALL(database_, insert(_, _, _)).Times(0);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 }
 
@@ -408,12 +419,12 @@ TEST_F(statistics_reader_listener_tests, new_network_latency_received)
 
     // Insert the data on the queue and wait until processed
     datareader_.set_topic_name(NETWORK_LATENCY_TOPIC);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 
     // Expectation: The insert method is not called if there is no data in the queue
     EXPECT_CALL(database_, insert(_, _, _)).Times(0);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 }
 
@@ -464,12 +475,12 @@ TEST_F(statistics_reader_listener_tests, new_publication_throughput_received)
 
     // Insert the data on the queue and wait until processed
     datareader_.set_topic_name(PUBLICATION_THROUGHPUT_TOPIC);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 
     // Expectation: The insert method is not called if there is no data in the queue
     EXPECT_CALL(database_, insert(_, _, _)).Times(0);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 }
 
@@ -520,12 +531,12 @@ TEST_F(statistics_reader_listener_tests, new_subscription_throughput_received)
 
     // Insert the data on the queue and wait until processed
     datareader_.set_topic_name(SUBSCRIPTION_THROUGHPUT_TOPIC);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 
     // Expectation: The insert method is not called if there is no data in the queue
     EXPECT_CALL(database_, insert(_, _, _)).Times(0);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 }
 
@@ -608,12 +619,12 @@ TEST_F(statistics_reader_listener_tests, new_rtps_sent_received)
 
     // Insert the data on the queue and wait until processed
     datareader_.set_topic_name(RTPS_SENT_TOPIC);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 
     // Expectation: The insert method is not called if there is no data in the queue
     EXPECT_CALL(database_, insert(_, _, _)).Times(0);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 }
 
@@ -696,12 +707,12 @@ TEST_F(statistics_reader_listener_tests, new_rtps_lost_received)
 
     // Insert the data on the queue and wait until processed
     datareader_.set_topic_name(RTPS_LOST_TOPIC);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 
     // Expectation: The insert method is not called if there is no data in the queue
     EXPECT_CALL(database_, insert(_, _, _)).Times(0);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 }
 
@@ -752,12 +763,12 @@ TEST_F(statistics_reader_listener_tests, new_resent_datas_received)
 
     // Insert the data on the queue and wait until processed
     datareader_.set_topic_name(RESENT_DATAS_TOPIC);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 
     // Expectation: The insert method is not called if there is no data in the queue
     EXPECT_CALL(database_, insert(_, _, _)).Times(0);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 }
 
@@ -808,12 +819,12 @@ TEST_F(statistics_reader_listener_tests, new_heartbeat_count_received)
 
     // Insert the data on the queue and wait until processed
     datareader_.set_topic_name(HEARTBEAT_COUNT_TOPIC);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 
     // Expectation: The insert method is not called if there is no data in the queue
     EXPECT_CALL(database_, insert(_, _, _)).Times(0);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 }
 
@@ -864,12 +875,12 @@ TEST_F(statistics_reader_listener_tests, new_acknack_count_received)
 
     // Insert the data on the queue and wait until processed
     datareader_.set_topic_name(ACKNACK_COUNT_TOPIC);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 
     // Expectation: The insert method is not called if there is no data in the queue
     EXPECT_CALL(database_, insert(_, _, _)).Times(0);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 }
 
@@ -920,12 +931,12 @@ TEST_F(statistics_reader_listener_tests, new_nackfrag_count_received)
 
     // Insert the data on the queue and wait until processed
     datareader_.set_topic_name(NACKFRAG_COUNT_TOPIC);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 
     // Expectation: The insert method is not called if there is no data in the queue
     EXPECT_CALL(database_, insert(_, _, _)).Times(0);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 }
 
@@ -976,12 +987,12 @@ TEST_F(statistics_reader_listener_tests, new_gap_count_received)
 
     // Insert the data on the queue and wait until processed
     datareader_.set_topic_name(GAP_COUNT_TOPIC);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 
     // Expectation: The insert method is not called if there is no data in the queue
     EXPECT_CALL(database_, insert(_, _, _)).Times(0);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 }
 
@@ -1032,12 +1043,12 @@ TEST_F(statistics_reader_listener_tests, new_data_count_received)
 
     // Insert the data on the queue and wait until processed
     datareader_.set_topic_name(DATA_COUNT_TOPIC);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 
     // Expectation: The insert method is not called if there is no data in the queue
     EXPECT_CALL(database_, insert(_, _, _)).Times(0);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 }
 
@@ -1088,12 +1099,12 @@ TEST_F(statistics_reader_listener_tests, new_pdp_count_received)
 
     // Insert the data on the queue and wait until processed
     datareader_.set_topic_name(PDP_PACKETS_TOPIC);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 
     // Expectation: The insert method is not called if there is no data in the queue
     EXPECT_CALL(database_, insert(_, _, _)).Times(0);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 }
 
@@ -1144,12 +1155,12 @@ TEST_F(statistics_reader_listener_tests, new_edp_count_received)
 
     // Insert the data on the queue and wait until processed
     datareader_.set_topic_name(EDP_PACKETS_TOPIC);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 
     // Expectation: The insert method is not called if there is no data in the queue
     EXPECT_CALL(database_, insert(_, _, _)).Times(0);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 }
 
@@ -1220,12 +1231,12 @@ TEST_F(statistics_reader_listener_tests, new_discovery_times_received)
 
     // Insert the data on the queue and wait until processed
     datareader_.set_topic_name(DISCOVERY_TOPIC);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 
     // Expectation: The insert method is not called if there is no data in the queue
     EXPECT_CALL(database_, insert(_, _, _)).Times(0);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 }
 
@@ -1287,12 +1298,12 @@ TEST_F(statistics_reader_listener_tests, new_sample_datas_received)
 
     // Insert the data on the queue and wait until processed
     datareader_.set_topic_name(SAMPLE_DATAS_TOPIC);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 
     // Expectation: The insert method is not called if there is no data in the queue
     EXPECT_CALL(database_, insert(_, _, _)).Times(0);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 }
 
@@ -1372,15 +1383,87 @@ TEST_F(statistics_reader_listener_tests, new_physical_data_received)
 
     // Insert the data on the queue and wait until processed
     datareader_.set_topic_name(PHYSICAL_DATA_TOPIC);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 
     // Expectation: The insert method is not called if there is no data in the queue
     EXPECT_CALL(database_, insert(_, _, _)).Times(0);
-    reader_listener_.on_data_available(&datareader_);
+    reader_listener().on_data_available(&datareader_);
     data_queue_.flush();
 }
 
+TEST_F(statistics_reader_listener_tests, unknown_topic)
+{
+    EXPECT_THROW(StatisticsReaderListener(&data_queue_, "unknown_topic"),
+            eprosima::statistics_backend::BadParameter);
+}
+
+TEST_F(statistics_reader_listener_tests, several_samples_received)
+{
+    std::array<uint8_t, 12> prefix = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    std::array<uint8_t, 4> writer_id = {0, 0, 0, 2};
+    std::string writer_guid_str = "01.02.03.04.05.06.07.08.09.0a.0b.0c|0.0.0.2";
+
+    // Build the writer GUID
+    DatabaseDataQueue::StatisticsGuidPrefix writer_prefix;
+    writer_prefix.value(prefix);
+    DatabaseDataQueue::StatisticsEntityId writer_entity_id;
+    writer_entity_id.value(writer_id);
+    DatabaseDataQueue::StatisticsGuid writer_guid;
+    writer_guid.guidPrefix(writer_prefix);
+    writer_guid.entityId(writer_entity_id);
+
+    // More samples than those taken at once, one of them not valid
+    constexpr uint64_t num_samples = StatisticsReaderListener::MAX_SAMPLES_PER_TAKE + 2;
+    for (uint64_t i = 1; i <= num_samples; ++i)
+    {
+        DatabaseDataQueue::StatisticsEntityCount inner_data;
+        inner_data.guid(writer_guid);
+        inner_data.count(i);
+
+        std::shared_ptr<eprosima::fastdds::statistics::Data> data =
+                std::make_shared<eprosima::fastdds::statistics::Data>();
+        data->entity_count(inner_data);
+        data->_d(EventKind::HEARTBEAT_COUNT);
+
+        std::shared_ptr<SampleInfo> info = get_default_info();
+        info->valid_data = (i != 2);
+        add_sample_to_reader_history(data, info);
+    }
+
+    // Precondition: The writer exists and has ID 1
+    EXPECT_CALL(database_, get_entity_by_guid(EntityKind::DATAWRITER, writer_guid_str)).Times(AnyNumber())
+            .WillRepeatedly(Return(std::make_pair(EntityId(0), EntityId(1))));
+
+    // Expectation: The insert method is called once per valid sample, in order
+    std::vector<uint64_t> counts;
+    InsertDataArgs args([&](
+                const EntityId& domain_id,
+                const EntityId& entity_id,
+                const StatisticsSample& sample)
+            {
+                EXPECT_EQ(entity_id, 1);
+                EXPECT_EQ(domain_id, 0);
+                EXPECT_EQ(sample.kind, DataKind::HEARTBEAT_COUNT);
+                counts.push_back(dynamic_cast<const HeartbeatCountSample&>(sample).count);
+            });
+
+    EXPECT_CALL(database_, insert(_, _, _)).Times(static_cast<int>(num_samples - 1))
+            .WillRepeatedly(Invoke(&args, &InsertDataArgs::insert));
+
+    // A single notification takes all the samples
+    datareader_.set_topic_name(HEARTBEAT_COUNT_TOPIC);
+    reader_listener().on_data_available(&datareader_);
+    data_queue_.flush();
+
+    ASSERT_EQ(counts.size(), num_samples - 1);
+    EXPECT_EQ(counts.front(), 1u);
+    for (std::size_t i = 1; i < counts.size(); ++i)
+    {
+        EXPECT_EQ(counts[i], i + 2);
+    }
+}
+
 int main(
         int argc,
         char** argv)
@@ -0,0 +1,213 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <detail/TDigest.hpp>
+
+using namespace eprosima::statistics_backend::detail;
+
+namespace {
+
+const std::vector<double> tested_quantiles = {0.5, 0.9, 0.99, 0.999};
+
+/**
+ * @brief Fraction of the sorted values that are lower than or equal to \c value.
+ *
+ * The accuracy of a quantile sketch is measured in rank: the estimate of the quantile q is good if
+ * approximately a fraction q of the values is below it.
+ */
+double rank_of(
+        const std::vector<double>& sorted_values,
+        double value)
+{
+    auto it = std::upper_bound(sorted_values.begin(), sorted_values.end(), value);
+    return static_cast<double>(it - sorted_values.begin()) / static_cast<double>(sorted_values.size());
+}
+
+//! Check that the rank of every tested quantile estimated by \c digest is within \c tolerance
+void check_accuracy(
+        TDigest& digest,
+        std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+    for (double q : tested_quantiles)
+    {
+        // The tails are much more accurate than the center of the distribution
+        double tolerance = 0.02 * q * (1 - q) + 0.0005;
+        EXPECT_NEAR(q, rank_of(values, digest.quantile(q)), tolerance) << "quantile " << q;
+    }
+}
+
+} // namespace
+
+TEST(tdigest_tests, empty)
+{
+    TDigest digest;
+    EXPECT_TRUE(digest.empty());
+    EXPECT_EQ(0u, digest.count());
+    EXPECT_TRUE(std::isnan(digest.quantile(0.5)));
+}
+
+TEST(tdigest_tests, exact_small_sets)
+{
+    TDigest digest;
+    for (double value : {5.0, 1.0, 4.0, 2.0, 3.0})
+    {
+        digest.add(value);
+    }
+    EXPECT_TRUE(digest.is_exact());
+    EXPECT_EQ(5u, digest.count());
+    EXPECT_EQ(3.0, digest.quantile(0.5));
+    EXPECT_EQ(1.0, digest.quantile(0.0));
+    EXPECT_EQ(5.0, digest.quantile(1.0));
+    EXPECT_DOUBLE_EQ(4.6, digest.quantile(0.9));
+
+    // With an even number of values, the median is the mean of the two center values
+    digest.add(10.0);
+    EXPECT_EQ(3.5, digest.quantile(0.5));
+
+    // A single value is every quantile
+    TDigest single;
+    single.add(7.0);
+    for (double q : tested_quantiles)
+    {
+        EXPECT_EQ(7.0, single.quantile(q));
+    }
+
+    // The buffer is kept exact up to its capacity
+    TDigest full(100.0, 1000);
+    std::vector<double> values;
+    for (int i = 0; i < 1000; ++i)
+    {
+        values.push_back((i * 7919) % 1000);
+        full.add(values.back());
+    }
+    EXPECT_TRUE(full.is_exact());
+    EXPECT_EQ(499.5, full.quantile(0.5));
+    EXPECT_DOUBLE_EQ(998.001, full.quantile(0.999));
+
+    // And is summarized once it has to hold more values
+    full.add(1000.0);
+    EXPECT_FALSE(full.is_exact());
+    EXPECT_EQ(1001u, full.count());
+}
+
+TEST(tdigest_tests, nan_ignored)
+{
+    TDigest digest;
+    digest.add(std::numeric_limits<double>::quiet_NaN());
+    EXPECT_TRUE(digest.empty());
+
+    digest.add(1.0);
+    digest.add(std::numeric_limits<double>::quiet_NaN());
+    digest.add(3.0);
+    EXPECT_EQ(2u, digest.count());
+    EXPECT_EQ(2.0, digest.quantile(0.5));
+}
+
+TEST(tdigest_tests, bounded_centroids)
+{
+    const double compression = 100.0;
+    TDigest digest(compression, 500);
+    std::mt19937_64 generator(42);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+    for (int i = 0; i < 1000000; ++i)
+    {
+        digest.add(distribution(generator));
+    }
+    EXPECT_EQ(1000000u, digest.count());
+    EXPECT_LE(digest.centroid_count(), static_cast<size_t>(compression));
+    EXPECT_GE(digest.centroid_count(), static_cast<size_t>(compression / 4));
+}
+
+TEST(tdigest_tests, uniform_accuracy)
+{
+    TDigest digest;
+    std::mt19937_64 generator(1);
+    std::uniform_real_distribution<double> distribution(0.0, 1000.0);
+
+    std::vector<double> values;
+    for (int i = 0; i < 100000; ++i)
+    {
+        values.push_back(distribution(generator));
+        digest.add(values.back());
+    }
+    ASSERT_FALSE(digest.is_exact());
+    check_accuracy(digest, values);
+}
+
+TEST(tdigest_tests, exponential_accuracy)
+{
+    // Latency-like distribution, with a long tail
+    TDigest digest;
+    std::mt19937_64 generator(2);
+    std::exponential_distribution<double> distribution(1.0 / 200.0);
+
+    std::vector<double> values;
+    for (int i = 0; i < 100000; ++i)
+    {
+        values.push_back(distribution(generator));
+        digest.add(values.back());
+    }
+    ASSERT_FALSE(digest.is_exact());
+    check_accuracy(digest, values);
+
+    // Values added in order are the worst case for the buffer, as every merge only covers the tail
+    TDigest sorted_digest;
+    std::sort(values.begin(), values.end());
+    for (double value : values)
+    {
+        sorted_digest.add(value);
+    }
+    check_accuracy(sorted_digest, values);
+}
+
+TEST(tdigest_tests, extremes)
+{
+    TDigest digest;
+    for (int i = 0; i < 10000; ++i)
+    {
+        digest.add(static_cast<double>(i % 100) - 50.0);
+    }
+    digest.add(1e6);
+    digest.add(-1e6);
+
+    // Minimum and maximum are exact
+    EXPECT_EQ(-1e6, digest.quantile(0.0));
+    EXPECT_EQ(1e6, digest.quantile(1.0));
+
+    // Estimations never go outside the range of the values
+    for (double q = 0.0; q <= 1.0; q += 0.001)
+    {
+        double value = digest.quantile(q);
+        EXPECT_GE(value, -1e6);
+        EXPECT_LE(value, 1e6);
+    }
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}